@@ -19,6 +19,9 @@ SOURCES +=\
     src/cartridge/ngp_cartridge.cpp \
     src/cartridge/cartridge_descriptor.cpp \
     src/cartridge/ngp_chip.cpp \
+    src/cartridge/block_cache.cpp \
+    src/cartridge/content_hash.cpp \
+    src/cartridge/save_manifest.cpp \
     src/linkmasta/ngp_linkmasta_device.cpp \
     src/linkmasta/ngp_linkmasta_messages.cpp \
     src/task/forwarding_task_controller.cpp \
@@ -50,25 +53,39 @@ SOURCES +=\
     src/ui/qt/task/ws_cartridge_backup_save_task.cpp \
     src/ui/qt/task/ws_cartridge_backup_task.cpp \
     src/ui/qt/task/ws_cartridge_flash_task.cpp \
+    src/ui/qt/task/ws_cartridge_multi_flash_task.cpp \
     src/ui/qt/task/ws_cartridge_restore_save_task.cpp \
     src/ui/qt/task/ws_cartridge_task.cpp \
     src/ui/qt/task/ws_cartridge_verify_task.cpp \
     src/linkmasta/device_manager.cpp \
     src/linkmasta/libusb_device_manager.cpp \
+    src/linkmasta/batch_tuner.cpp \
     src/ui/qt/detail/fm_cartridge_slot_widget.cpp \
     src/ui/qt/flash_masta_app.cpp \
     src/ui/qt/detail/cartridge_widget.cpp \
     src/ui/qt/worker/lm_cartridge_fetching_worker.cpp \
     src/ui/qt/worker/lm_cartridge_polling_worker.cpp \
+    src/ui/qt/worker/lm_cartridge_prefetch_worker.cpp \
     src/ui/qt/detail/lm_detail_widget.cpp \
     src/ui/qt/detail/cartridge_info_widget.cpp \
     src/game/game_descriptor.cpp \
     src/sqlite/sqlite3.c \
     src/game/ws_game_catalog.cpp \
     src/game/ngp_game_catalog.cpp \
+    src/game/ngp_game_table.cpp \
+    src/game/content_index.cpp \
+    src/game/ws_game_table.cpp \
     src/ui/qt/task/ngp_cartridge_verify_save_task.cpp \
     src/ui/qt/task/ws_cartridge_verify_save_task.cpp \
-    src/common/log.cpp
+    src/common/log.cpp \
+    src/common/crc32.cpp \
+    src/common/sha1.cpp \
+    src/common/byte_kernels.cpp \
+    src/common/mapped_file.cpp \
+    src/common/image_source.cpp \
+    src/common/image_sink.cpp \
+    src/common/backup_store.cpp \
+    src/common/block_buffer_pool.cpp
 
 HEADERS  +=\
     src/cartridge/cartridge.h \
@@ -76,9 +93,15 @@ HEADERS  +=\
     src/common/types.h \
     src/cartridge/cartridge_descriptor.h \
     src/cartridge/ngp_chip.h \
+    src/cartridge/flash_chip_engine.h \
+    src/cartridge/block_cache.h \
+    src/cartridge/content_hash.h \
+    src/cartridge/save_manifest.h \
     src/linkmasta/linkmasta_device.h \
+    src/linkmasta/linkmasta_packet.h \
     src/linkmasta/ngp_linkmasta_device.h \
     src/linkmasta/ngp_linkmasta_messages.h \
+    src/linkmasta/ngp_linkmasta_packets.h \
     src/task/forwarding_task_controller.h \
     src/task/task_controller.h \
     src/usb/exception/busy_exception.h \
@@ -97,6 +120,7 @@ HEADERS  +=\
     src/ui/qt/main_window.h \
     src/linkmasta/ws_linkmasta_device.h \
     src/linkmasta/ws_linkmasta_messages.h \
+    src/linkmasta/ws_linkmasta_packets.h \
     src/cartridge/ws_cartridge.h \
     src/cartridge/ws_rom_chip.h \
     src/cartridge/ws_sram_chip.h \
@@ -109,16 +133,19 @@ HEADERS  +=\
     src/ui/qt/task/ws_cartridge_backup_save_task.h \
     src/ui/qt/task/ws_cartridge_backup_task.h \
     src/ui/qt/task/ws_cartridge_flash_task.h \
+    src/ui/qt/task/ws_cartridge_multi_flash_task.h \
     src/ui/qt/task/ws_cartridge_restore_save_task.h \
     src/ui/qt/task/ws_cartridge_task.h \
     src/ui/qt/task/ws_cartridge_verify_task.h \
     src/linkmasta/device_manager.h \
     src/linkmasta/libusb_device_manager.h \
+    src/linkmasta/batch_tuner.h \
     src/ui/qt/detail/fm_cartridge_slot_widget.h \
     src/ui/qt/flash_masta_app.h \
     src/ui/qt/detail/cartridge_widget.h \
     src/ui/qt/worker/lm_cartridge_fetching_worker.h \
     src/ui/qt/worker/lm_cartridge_polling_worker.h \
+    src/ui/qt/worker/lm_cartridge_prefetch_worker.h \
     src/ui/qt/detail/lm_detail_widget.h \
     src/ui/qt/detail/cartridge_info_widget.h \
     src/game/game_catalog.h \
@@ -127,9 +154,19 @@ HEADERS  +=\
     src/sqlite/sqlite3ext.h \
     src/game/ws_game_catalog.h \
     src/game/ngp_game_catalog.h \
+    src/game/game_table.h \
+    src/game/content_index.h \
     src/ui/qt/task/ngp_cartridge_verify_save_task.h \
     src/ui/qt/task/ws_cartridge_verify_save_task.h \
-    src/common/log.h
+    src/common/log.h \
+    src/common/crc32.h \
+    src/common/sha1.h \
+    src/common/byte_kernels.h \
+    src/common/mapped_file.h \
+    src/common/image_source.h \
+    src/common/image_sink.h \
+    src/common/backup_store.h \
+    src/common/block_buffer_pool.h
 
 FORMS    +=\
     src/ui/qt/main_window.ui \
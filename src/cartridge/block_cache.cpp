@@ -0,0 +1,108 @@
+/*! \file
+ *  \brief File containing the implementation of \ref block_cache.
+ *  
+ *  File containing the implementation of \ref block_cache.
+ *  
+ *  See corresponding header file to view documentation for class, its methods,
+ *  and its member variables.
+ *  
+ *  \see block_cache
+ *  
+ *  \author Daniel Andrus
+ *  \date 2015-09-14
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#include "block_cache.h"
+#include <cstring>
+
+using namespace std;
+
+block_cache::block_cache()
+  : m_blocks(), m_signature(), m_num_bytes(0)
+{
+  // Nothing else to do
+}
+
+block_cache::~block_cache()
+{
+  // Nothing else to do
+}
+
+
+
+bool block_cache::lookup(unsigned int chip_i, address_t address, unsigned char* buffer, unsigned int num_bytes) const
+{
+  lock_guard<mutex> lock(m_mutex);
+  
+  auto it = m_blocks.find(block_key_t(chip_i, address));
+  if (it == m_blocks.end() || it->second.size() < num_bytes)
+  {
+    return false;
+  }
+  
+  memcpy(buffer, it->second.data(), num_bytes);
+  return true;
+}
+
+bool block_cache::contains(unsigned int chip_i, address_t address, unsigned int num_bytes) const
+{
+  lock_guard<mutex> lock(m_mutex);
+  
+  auto it = m_blocks.find(block_key_t(chip_i, address));
+  return it != m_blocks.end() && it->second.size() >= num_bytes;
+}
+
+void block_cache::store(unsigned int chip_i, address_t address, const unsigned char* buffer, unsigned int num_bytes)
+{
+  lock_guard<mutex> lock(m_mutex);
+  
+  vector<unsigned char>& block = m_blocks[block_key_t(chip_i, address)];
+  m_num_bytes -= block.size();
+  block.assign(buffer, buffer + num_bytes);
+  m_num_bytes += num_bytes;
+}
+
+void block_cache::invalidate(unsigned int chip_i, address_t address)
+{
+  lock_guard<mutex> lock(m_mutex);
+  
+  auto it = m_blocks.find(block_key_t(chip_i, address));
+  if (it != m_blocks.end())
+  {
+    m_num_bytes -= it->second.size();
+    m_blocks.erase(it);
+  }
+}
+
+void block_cache::clear()
+{
+  lock_guard<mutex> lock(m_mutex);
+  
+  m_blocks.clear();
+  m_signature.clear();
+  m_num_bytes = 0;
+}
+
+bool block_cache::validate(const std::vector<unsigned char>& signature)
+{
+  lock_guard<mutex> lock(m_mutex);
+  
+  if (m_signature == signature)
+  {
+    return true;
+  }
+  
+  // Either we've never seen a cartridge or it's been swapped out from under us
+  bool was_empty = m_signature.empty() && m_blocks.empty();
+  m_blocks.clear();
+  m_num_bytes = 0;
+  m_signature = signature;
+  return was_empty;
+}
+
+unsigned int block_cache::num_bytes() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_num_bytes;
+}
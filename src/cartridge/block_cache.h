@@ -0,0 +1,144 @@
+/*! \file
+ *  \brief File containing the declaration of the \ref block_cache class.
+ *  
+ *  File containing the header information and declaration of the
+ *  \ref block_cache class. This file includes the minimal number of files
+ *  necessary to use any instance of the \ref block_cache class.
+ *  
+ *  \author Daniel Andrus
+ *  \date 2015-09-14
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#ifndef __BLOCK_CACHE_H__
+#define __BLOCK_CACHE_H__
+
+#include "common/types.h"
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/*! \class block_cache
+ *  \brief In-memory copy of blocks previously read from a cartridge.
+ *  
+ *  Stores copies of cartridge blocks keyed by chip index and block base
+ *  address so that repeated backups and verifications of the same cartridge
+ *  can be served without going back over the wire. The cache is meant to
+ *  outlive individual \ref cartridge objects and is typically owned by
+ *  whoever owns the \ref linkmasta_device the cartridge is connected through.
+ *  
+ *  Every cache carries a signature describing the cartridge the cached data
+ *  came from. Before trusting the cache, a cartridge re-reads a small portion
+ *  of itself, builds a fresh signature, and passes it to
+ *  \ref validate(const std::vector<unsigned char>&), which drops all cached
+ *  data if the signatures differ. Blocks that get erased or programmed must be
+ *  dropped with \ref invalidate(unsigned int, address_t).
+ *  
+ *  This class is thread-safe.
+ */
+class block_cache
+{
+public:
+  
+  /*! \brief Constructs an empty cache with no signature. */
+                        block_cache();
+  
+  /*! \brief Destructor for this object. Releases all cached blocks. */
+                        ~block_cache();
+  
+  
+  
+  /*! \brief Copies a cached block into the provided buffer.
+   *  
+   *  Looks up the block stored for the given chip at the given address. The
+   *  lookup only succeeds if at least the requested number of bytes were
+   *  cached for that address.
+   *  
+   *  \param [in] chip_i The index of the chip the block belongs to.
+   *  \param [in] address The address the block was read from.
+   *  \param [out] buffer Buffer to copy the cached bytes into. Must be able to
+   *         hold at least `num_bytes` bytes.
+   *  \param [in] num_bytes The number of bytes to copy.
+   *  
+   *  \returns **true** The bytes were found and copied into `buffer`.
+   *  \returns **false** The bytes are not cached. `buffer` is left untouched.
+   */
+  bool                  lookup(unsigned int chip_i, address_t address, unsigned char* buffer, unsigned int num_bytes) const;
+  
+  /*! \brief Checks whether at least the given number of bytes are cached for
+   *         the given chip and address.
+   *  
+   *  \param [in] chip_i The index of the chip the block belongs to.
+   *  \param [in] address The address the block was read from.
+   *  \param [in] num_bytes The minimum number of bytes that must be cached.
+   */
+  bool                  contains(unsigned int chip_i, address_t address, unsigned int num_bytes) const;
+  
+  /*! \brief Stores a copy of a block that was just read from the cartridge.
+   *  
+   *  Replaces any block previously stored for the same chip and address.
+   *  
+   *  \param [in] chip_i The index of the chip the block was read from.
+   *  \param [in] address The address the block was read from.
+   *  \param [in] buffer The bytes read from the cartridge.
+   *  \param [in] num_bytes The number of bytes in `buffer`.
+   */
+  void                  store(unsigned int chip_i, address_t address, const unsigned char* buffer, unsigned int num_bytes);
+  
+  /*! \brief Drops the block stored for the given chip and address, if any.
+   *  
+   *  Must be called before a block is erased or programmed.
+   *  
+   *  \param [in] chip_i The index of the chip the block belongs to.
+   *  \param [in] address The base address of the block.
+   */
+  void                  invalidate(unsigned int chip_i, address_t address);
+  
+  /*! \brief Drops all cached blocks and forgets the cartridge signature. */
+  void                  clear();
+  
+  /*! \brief Compares the signature of the connected cartridge to the one the
+   *         cached data belongs to.
+   *  
+   *  If the cache has no signature yet, adopts the provided one. If the cache
+   *  has a different signature, all cached blocks are dropped and the provided
+   *  signature is adopted.
+   *  
+   *  \param [in] signature Bytes identifying the cartridge currently connected.
+   *  
+   *  \returns **true** The cached data belongs to the connected cartridge.
+   *  \returns **false** The cached data was discarded.
+   */
+  bool                  validate(const std::vector<unsigned char>& signature);
+  
+  /*! \brief Gets the total number of bytes currently cached. */
+  unsigned int          num_bytes() const;
+
+
+
+private:
+  
+  /*! \brief Copy constructor. Deleted. */
+                        block_cache(const block_cache& other) = delete;
+  
+  /*! \brief Copy assignment operator. Deleted. */
+  block_cache&          operator=(const block_cache& other) = delete;
+  
+  /*! \brief Type used for identifying a block by chip index and address. */
+  typedef std::pair<unsigned int, address_t> block_key_t;
+  
+  /*! \brief Cached block contents, keyed by chip index and address. */
+  std::map<block_key_t, std::vector<unsigned char>> m_blocks;
+  
+  /*! \brief Signature of the cartridge the cached blocks were read from. */
+  std::vector<unsigned char> m_signature;
+  
+  /*! \brief Running total of cached bytes. */
+  unsigned int          m_num_bytes;
+  
+  /*! \brief Data lock used to make this class thread-safe. */
+  mutable std::mutex    m_mutex;
+};
+
+#endif /* defined(__BLOCK_CACHE_H__) */
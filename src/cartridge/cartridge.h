@@ -15,10 +15,14 @@
 
 #include "common/types.h"
 #include "cartridge_descriptor.h"
+#include "content_hash.h"
 #include <iosfwd>
 #include <string>
+#include <vector>
 
 class task_controller;
+class image_source;
+class image_sink;
 
 
 
@@ -150,6 +154,25 @@ public:
    */
   virtual void        backup_cartridge_game_data(std::ostream& fout, int slot = SLOT_ALL, task_controller* controller = nullptr) = 0;
   
+  /*! \brief Writes a cartridge's game data to an image sink.
+   *  
+   *  Behaves exactly like
+   *  \ref backup_cartridge_game_data(std::ostream&, int, task_controller*),
+   *  except that data read from the cartridge is placed directly into the
+   *  sink's memory when the sink allows it, e.g. a \ref mapped_image_sink. The
+   *  sink is finished at the number of bytes actually read, even if the
+   *  operation fails or is cancelled.
+   *  
+   *  \param [out] sink The image sink to write to.
+   *  \param [in] slot The game slot on the cartridge to back up. Set to
+   *         \ref SLOT_ALL to backup the entire cartridge.
+   *  \param [in,out] controller (optional) The controller object to send
+   *         progress updates. **nullptr** is an accepted value.
+   *  
+   *  \see image_sink
+   */
+  virtual void        backup_cartridge_game_data(image_sink& sink, int slot = SLOT_ALL, task_controller* controller = nullptr) = 0;
+  
   /*! \brief Overwrites a cartridge's game data with data from an input stream.
    *  
    *  Replaces game data on the cartridge with the content of an input stream.
@@ -187,6 +210,23 @@ public:
    */
   virtual void        restore_cartridge_game_data(std::istream& fin, int slot = SLOT_ALL, task_controller* controller = nullptr) = 0;
   
+  /*! \brief Overwrites a cartridge's game data with data from an image source.
+   *  
+   *  Behaves exactly like
+   *  \ref restore_cartridge_game_data(std::istream&, int, task_controller*),
+   *  except that data is sent to the cartridge straight from the source's
+   *  memory when the source allows it, e.g. a \ref mapped_image_source.
+   *  
+   *  \param [in] source The image source to read from.
+   *  \param [in] slot The game slot on the cartridge to write to. Set to
+   *         \ref SLOT_ALL to overwrite the entire cartridge.
+   *  \param [in,out] controller (optional) The controller object to send
+   *         progress updates. **nullptr** is an accepted value.
+   *  
+   *  \see image_source
+   */
+  virtual void        restore_cartridge_game_data(image_source& source, int slot = SLOT_ALL, task_controller* controller = nullptr) = 0;
+  
   /*! \brief Compares the cartridge's game data with the contents of an input
    *         stream.
    *  
@@ -229,6 +269,28 @@ public:
    */
   virtual bool        compare_cartridge_game_data(std::istream& fin, int slot = SLOT_ALL, task_controller* controller = nullptr) = 0;
   
+  /*! \brief Compares the cartridge's game data with the contents of an image
+   *         source.
+   *  
+   *  Behaves exactly like
+   *  \ref compare_cartridge_game_data(std::istream&, int, task_controller*),
+   *  except that data is compared straight from the source's memory when the
+   *  source allows it, e.g. a \ref mapped_image_source.
+   *  
+   *  \param [in] source The image source to read from.
+   *  \param [in] slot The game slot on the cartridge to compare. Set to
+   *         \ref SLOT_ALL to compare the entire cartridge.
+   *  \param [in,out] controller (optional) The controller object to send
+   *         progress updates. **nullptr** is an accepted value.
+   *  
+   *  \returns **true** The cartridge game data and image contents match.
+   *  \returns **false** The cartridge game data and image contents do not
+   *           match.
+   *  
+   *  \see image_source
+   */
+  virtual bool        compare_cartridge_game_data(image_source& source, int slot = SLOT_ALL, task_controller* controller = nullptr) = 0;
+  
   /*! \brief Saves a cartridge's game save data to an output stream.
    *
    *  Extracts the game save data from a cartridge and writes its contents to an
@@ -377,6 +439,47 @@ public:
    *           gone on the cartridge.
    */
   virtual std::string  fetch_game_name(int slot) = 0;
+  
+  /*! \brief Gets the content hashes of the game data read by the most recent
+   *         backup or comparison.
+   *  
+   *  Game data is hashed as it's read by
+   *  \ref backup_cartridge_game_data(std::ostream&, int, task_controller*) and
+   *  \ref compare_cartridge_game_data(std::istream&, int, task_controller*),
+   *  so exact identification costs no extra reads from the cartridge. Hashes
+   *  are only kept if every byte of the requested slot was read, and are
+   *  cleared at the start of each such operation.
+   *  
+   *  \returns The recorded hashes, or an empty vector if the last operation
+   *           did not read the whole slot.
+   *  
+   *  \see content_hasher
+   */
+  virtual const std::vector<content_hash>& content_hashes() const = 0;
+  
+  /*! \brief Checks whether game data is verified as it's written.
+   *  
+   *  \see set_verify_writes(bool)
+   */
+  virtual bool        verify_writes() const = 0;
+  
+  /*! \brief Enables or disables verifying game data as it's written.
+   *  
+   *  When enabled,
+   *  \ref restore_cartridge_game_data(std::istream&, int, task_controller*)
+   *  reads back every block right after programming it and compares it to the
+   *  data it just wrote, which is still in memory. This makes a separate
+   *  verification pass unnecessary and costs only the time to read the
+   *  cartridge, which is far less than the time to program it.
+   *  
+   *  The first mismatching address of a failed block is logged and only that
+   *  block is erased and programmed again, up to the cartridge's retry limit.
+   *  If the block still doesn't match, the operation fails with an exception
+   *  naming the address. Disabled by default.
+   *  
+   *  \param [in] verify true to verify writes, false to skip verification.
+   */
+  virtual void        set_verify_writes(bool verify) = 0;
 };
 
 #endif // defined(__CARTRIDGE_H__)
@@ -0,0 +1,74 @@
+/*! \file
+ *  \brief File containing the implementation of \ref content_hasher.
+ *  
+ *  File containing the implementation of \ref content_hasher.
+ *  
+ *  \see content_hasher
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-08
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#include "content_hash.h"
+
+#define CONTENT_HASH_INTERVAL 0x10000
+
+content_hasher::content_hasher()
+  : m_crc32(), m_sha1(), m_num_bytes(0), m_hashes()
+{
+  // Nothing else to do
+}
+
+void content_hasher::update(const unsigned char* data, unsigned int num_bytes)
+{
+  while (num_bytes > 0)
+  {
+    // Feed up to the next boundary, then take a snapshot there
+    unsigned int n = CONTENT_HASH_INTERVAL - (m_num_bytes % CONTENT_HASH_INTERVAL);
+    if (n > num_bytes) n = num_bytes;
+    
+    m_crc32.update(data, n);
+    m_sha1.update(data, n);
+    m_num_bytes += n;
+    data += n;
+    num_bytes -= n;
+    
+    if (m_num_bytes % CONTENT_HASH_INTERVAL == 0)
+    {
+      record();
+    }
+  }
+}
+
+void content_hasher::finish()
+{
+  if (m_num_bytes > 0 && (m_hashes.empty() || m_hashes.back().num_bytes != m_num_bytes))
+  {
+    record();
+  }
+}
+
+const std::vector<content_hash>& content_hasher::hashes() const
+{
+  return m_hashes;
+}
+
+void content_hasher::reset()
+{
+  m_crc32.reset();
+  m_sha1.reset();
+  m_num_bytes = 0;
+  m_hashes.clear();
+}
+
+
+
+void content_hasher::record()
+{
+  content_hash hash;
+  hash.num_bytes = m_num_bytes;
+  hash.crc32 = m_crc32.value();
+  m_sha1.digest(hash.sha1_digest);
+  m_hashes.push_back(hash);
+}
@@ -0,0 +1,87 @@
+/*! \file
+ *  \brief File containing the declaration of the \ref content_hash struct and
+ *         the \ref content_hasher class.
+ *  
+ *  File containing the header information and declaration of the
+ *  \ref content_hash struct and the \ref content_hasher class.
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-08
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#ifndef __CONTENT_HASH_H__
+#define __CONTENT_HASH_H__
+
+#include "common/crc32.h"
+#include "common/sha1.h"
+#include <cstdint>
+#include <vector>
+
+/*! \struct content_hash
+ *  \brief Hashes of the first \ref num_bytes bytes of some cartridge content.
+ */
+struct content_hash
+{
+  /*! \brief Number of bytes covered by the hashes. */
+  unsigned int          num_bytes;
+  
+  /*! \brief CRC-32 of the covered bytes. */
+  uint32_t              crc32;
+  
+  /*! \brief SHA-1 digest of the covered bytes. */
+  unsigned char         sha1_digest[sha1::DIGEST_SIZE];
+};
+
+
+
+/*! \class content_hasher
+ *  \brief Hashes cartridge content as it streams past during a read.
+ *  
+ *  Because a cartridge slot is usually larger than the game stored in it, the
+ *  exact size of the game isn't known while reading. Instead of a single hash
+ *  of everything read, this class records a \ref content_hash of every prefix
+ *  that ends on a 64 KiB boundary, plus one of the entire content once
+ *  \ref finish() is called. Whatever the size of the dump in a database, one
+ *  of these will cover exactly the same bytes.
+ */
+class content_hasher
+{
+public:
+  
+  /*! \brief Constructs a hasher for empty content. */
+                        content_hasher();
+  
+  /*! \brief Feeds the next bytes of content into the hasher. */
+  void                  update(const unsigned char* data, unsigned int num_bytes);
+  
+  /*! \brief Records the hashes of the entire content fed in so far, if not
+   *         already recorded.
+   */
+  void                  finish();
+  
+  /*! \brief Gets the recorded hashes, ordered by increasing size. */
+  const std::vector<content_hash>& hashes() const;
+  
+  /*! \brief Forgets all content and recorded hashes. */
+  void                  reset();
+
+private:
+  
+  /*! \brief Records the hashes of all content fed in so far. */
+  void                  record();
+  
+  /*! \brief Running CRC-32 calculation. */
+  crc32                 m_crc32;
+  
+  /*! \brief Running SHA-1 calculation. */
+  sha1                  m_sha1;
+  
+  /*! \brief Number of bytes fed in so far. */
+  unsigned int          m_num_bytes;
+  
+  /*! \brief Hashes recorded so far. */
+  std::vector<content_hash> m_hashes;
+};
+
+#endif /* defined(__CONTENT_HASH_H__) */
@@ -0,0 +1,736 @@
+/*! \file
+ *  \brief File containing the declaration and implementation of the
+ *         \ref flash_chip_engine class template.
+ *  
+ *  File containing the declaration and implementation of the
+ *  \ref flash_chip_engine class template, which holds the command logic
+ *  shared by the AMD-style flash chips found on Neo Geo Pocket and WonderSwan
+ *  cartridges.
+ *  
+ *  \see ngp_chip
+ *  \see ws_rom_chip
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-21
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#ifndef __FLASH_CHIP_ENGINE_H__
+#define __FLASH_CHIP_ENGINE_H__
+
+#include "linkmasta/linkmasta_device.h"
+#include "task/task_controller.h"
+#include "task/forwarding_task_controller.h"
+#include <stdexcept>
+#include <type_traits>
+
+/*! \enum flash_chip_mode
+ *  \brief Enumeration representing the assumed state of a flash chip.
+ *  
+ *  \see flash_chip_engine::current_mode()
+ */
+enum class flash_chip_mode
+{
+  /*! \brief Device is in the default read mode. */
+  READ,
+  
+  /*! \brief Device is in autoselect mode, ready for metadata queries. */
+  AUTOSELECT,
+  
+  /*! \brief Device is in bypass mode, ready for swift programming. */
+  BYPASS,
+  
+  /*! \brief Device is busy erasing. */
+  ERASE
+};
+
+
+
+/*! \class flash_chip_engine
+ *  \brief Command logic for an AMD-style flash chip, specialized at compile
+ *         time for one kind of chip.
+ *  
+ *  Handles mode tracking, autoselect queries, unlock bypass, erasing, and
+ *  batch reads and programming for a chip, talking to it through a
+ *  \ref linkmasta_device. Everything that differs between chips is taken from
+ *  `Traits`, which must provide:
+ *  
+ *  - `word_t`: the type of a word on the chip's data bus.
+ *  - `COMMAND_ADDRESS_1` and `COMMAND_ADDRESS_2`: the addresses of the unlock
+ *    cycles. The command itself is written to `COMMAND_ADDRESS_1`.
+ *  - `SECTOR_MASK`: mask giving the start of the sector holding an address.
+ *  - `DEVICE_ID_ADDRESS`: the autoselect address of the device id.
+ *  - `ALWAYS_BYPASS`: whether every chip of this kind supports unlock bypass.
+ *    If not, `BYPASS_ID_ADDRESS` must give the autoselect address of the word
+ *    telling whether the chip does, and `static bool supports_bypass(word_t)`
+ *    must check that word.
+ *  - `HAS_BLOCK_PROTECTION`: whether sectors report their protection through
+ *    autoselect.
+ *  - `EXIT_BYPASS_ON_RESET`: whether bypass mode must be left explicitly
+ *    before a reset.
+ *  - `TOGGLE_BIT_POLLING`: whether erase completion is detected with the
+ *    toggle bit rather than by reading back erased data.
+ *  
+ *  Since the traits are constants, every test on them folds away and each
+ *  chip gets its own straight-line command sequences. What the Linkmasta
+ *  supports is asked once, on construction, rather than on every operation.
+ *  
+ *  This class is *not* thread-safe. Use caution when working in a multithreaded
+ *  environment.
+ */
+template <class Traits>
+class flash_chip_engine
+{
+public:
+  
+  /*! \brief Type used for data content. */
+  typedef unsigned char                data_t;
+  
+  /*! \brief Type used for sending commands and reading words from the chip. */
+  typedef typename Traits::word_t      word_t;
+  
+  /*! \brief Type used for specifying the index of the device on the cartridge. */
+  typedef linkmasta_device::chip_index chip_index_t;
+  
+  /*! \brief Type used for specifying an address on the device. */
+  typedef unsigned int                 address_t;
+  
+  /*! \brief Type used for the assumed state of the device. */
+  typedef flash_chip_mode              chip_mode;
+  
+  
+  
+  /*! \brief Constructs an engine for the chip with the given index.
+   *  
+   *  \param [in] linkmasta The linkmasta device to communicate with the
+   *         hardware through. Must be a pointer to a valid object in memory.
+   *  \param [in] chip_num The chip's index on the cartridge.
+   */
+                          flash_chip_engine(linkmasta_device* linkmasta, chip_index_t chip_num);
+  
+  
+  
+  /*! \brief Reads a single word from the chip. */
+  word_t                  read(address_t address);
+  
+  /*! \brief Writes a single word to the chip. */
+  void                    write(address_t address, word_t data);
+  
+  /*! \brief Returns the chip to \ref chip_mode::READ mode.
+   *  
+   *  \throws std::runtime_error If the chip is busy erasing.
+   */
+  void                    reset();
+  
+  /*! \brief Gets the chip's manufacturer id. */
+  unsigned int            get_manufacturer_id();
+  
+  /*! \brief Gets the chip's device id. */
+  unsigned int            get_device_id();
+  
+  /*! \brief Checks whether the sector holding an address is write protected.
+   *  
+   *  Always false for chips without block protection.
+   */
+  bool                    get_block_protection(address_t sector_address);
+  
+  /*! \brief Enters autoselect mode if necessary and reads a word of metadata,
+   *         as a single script.
+   */
+  word_t                  read_autoselect(address_t address);
+  
+  /*! \brief Programs a single word, using the bypass command if the chip is in
+   *         \ref chip_mode::BYPASS mode.
+   */
+  void                    program_word(address_t address, word_t data);
+  
+  /*! \brief Puts the chip in \ref chip_mode::BYPASS mode if it supports it. */
+  void                    unlock_bypass();
+  
+  /*! \brief Starts erasing the whole chip. */
+  void                    erase_chip();
+  
+  /*! \brief Starts erasing the sector holding an address. */
+  void                    erase_block(address_t block_address);
+  
+  
+  
+  /*! \brief Gets the assumed state of the chip. */
+  chip_mode               current_mode() const;
+  
+  /*! \brief Gets the cached result of \ref test_bypass_support(). */
+  bool                    supports_bypass() const;
+  
+  /*! \brief Asks the chip whether it supports unlock bypass and caches the
+   *         answer.
+   */
+  bool                    test_bypass_support();
+  
+  /*! \brief Checks the cached mode for whether the chip is erasing. */
+  bool                    is_erasing() const;
+  
+  /*! \brief Polls the chip for whether an erase is still in progress. */
+  bool                    test_erasing();
+  
+  /*! \brief Reads a run of bytes, in a batch if the Linkmasta supports it. */
+  unsigned int            read_bytes(address_t address, data_t* data, unsigned int num_bytes, task_controller* controller = nullptr);
+  
+  /*! \brief Programs a run of bytes, in a batch if the Linkmasta supports it. */
+  unsigned int            program_bytes(address_t address, const data_t* data, unsigned int num_bytes, task_controller* controller = nullptr);
+  
+  
+  
+  /*! \brief Gets the linkmasta device used to talk to the chip. */
+  linkmasta_device*       linkmasta() const;
+
+private:
+  
+  /*! \brief Throws if the chip is busy erasing. */
+  void                    ensure_not_erasing() const;
+  
+  /*! \brief Appends the unlock cycles and the given command to a script. */
+  void                    add_command(linkmasta_device::command_script& script, word_t command) const;
+  
+  /*! \brief Bypass support of a kind of chip that always has it. */
+  bool                    probe_bypass(std::true_type always);
+  
+  /*! \brief Asks the chip itself whether it supports bypass. */
+  bool                    probe_bypass(std::false_type always);
+  
+  /*! \brief Brings the chip back to \ref chip_mode::READ mode unless it's
+   *         already there.
+   */
+  void                    ensure_read_mode();
+  
+  
+  
+  /*! \brief The assumed state of the chip. */
+  chip_mode               m_mode;
+  
+  /*! \brief Address of the last erase, polled by \ref test_erasing(). */
+  address_t               m_last_erased_addr;
+  
+  /*! \brief Cached result of \ref test_bypass_support(). */
+  bool                    m_supports_bypass;
+  
+  /*! \brief The Linkmasta used to talk to the chip. */
+  linkmasta_device* const m_linkmasta;
+  
+  /*! \brief The chip's index on the cartridge. */
+  chip_index_t const      m_chip_num;
+  
+  /*! \brief Whether the Linkmasta reads in batches. */
+  bool const              m_can_read_bytes;
+  
+  /*! \brief Whether the Linkmasta programs in batches. */
+  bool const              m_can_program_bytes;
+  
+  /*! \brief Whether the Linkmasta erases chips itself. */
+  bool const              m_can_erase_chip;
+  
+  /*! \brief Whether the Linkmasta reads manufacturer ids itself. */
+  bool const              m_can_read_manufacturer_id;
+  
+  /*! \brief Whether the Linkmasta reads device ids itself. */
+  bool const              m_can_read_device_id;
+  
+  /*! \brief Whether the Linkmasta reads block protection itself. */
+  bool const              m_can_read_block_protection;
+};
+
+
+
+template <class Traits>
+flash_chip_engine<Traits>::flash_chip_engine(linkmasta_device* linkmasta, chip_index_t chip_num)
+  : m_mode(chip_mode::READ), m_last_erased_addr(0), m_supports_bypass(false),
+    m_linkmasta(linkmasta), m_chip_num(chip_num),
+    m_can_read_bytes(linkmasta->supports_read_bytes()),
+    m_can_program_bytes(linkmasta->supports_program_bytes()),
+    m_can_erase_chip(linkmasta->supports_erase_chip()),
+    m_can_read_manufacturer_id(linkmasta->supports_read_manufacturer_id()),
+    m_can_read_device_id(linkmasta->supports_read_device_id()),
+    m_can_read_block_protection(linkmasta->supports_read_block_protection())
+{
+  // Nothing else to do
+}
+
+
+
+template <class Traits>
+typename flash_chip_engine<Traits>::word_t flash_chip_engine<Traits>::read(address_t address)
+{
+  return (word_t) m_linkmasta->read_word(m_chip_num, address);
+}
+
+template <class Traits>
+void flash_chip_engine<Traits>::write(address_t address, word_t data)
+{
+  m_linkmasta->write_word(m_chip_num, address, data);
+}
+
+
+
+template <class Traits>
+void flash_chip_engine<Traits>::reset()
+{
+  ensure_not_erasing();
+  
+  linkmasta_device::command_script script;
+  
+  if (Traits::EXIT_BYPASS_ON_RESET && m_mode == chip_mode::BYPASS)
+  {
+    // If we're in bypass mode, do something special to exit it
+    script.write_word(m_chip_num, 0, 0x90)
+          .write_word(m_chip_num, 0, 0x00);
+  }
+  
+  // Send the full command
+  add_command(script, 0xF0);
+  m_linkmasta->run_script(script);
+  
+  // Update the cached mode
+  m_mode = chip_mode::READ;
+}
+
+template <class Traits>
+unsigned int flash_chip_engine<Traits>::get_manufacturer_id()
+{
+  ensure_not_erasing();
+  
+  if (m_can_read_manufacturer_id)
+  {
+    ensure_read_mode();
+    return m_linkmasta->read_manufacturer_id(m_chip_num);
+  }
+  return read_autoselect(0x0000);
+}
+
+template <class Traits>
+unsigned int flash_chip_engine<Traits>::get_device_id()
+{
+  ensure_not_erasing();
+  
+  if (m_can_read_device_id)
+  {
+    ensure_read_mode();
+    return m_linkmasta->read_device_id(m_chip_num);
+  }
+  return read_autoselect(Traits::DEVICE_ID_ADDRESS);
+}
+
+template <class Traits>
+bool flash_chip_engine<Traits>::get_block_protection(address_t sector_address)
+{
+  if (!Traits::HAS_BLOCK_PROTECTION)
+  {
+    return false;
+  }
+  
+  ensure_not_erasing();
+  
+  if (m_can_read_block_protection)
+  {
+    // Ensure the chip's been reset before passing control to Linkmasta
+    ensure_read_mode();
+    return m_linkmasta->read_block_protection(m_chip_num, sector_address);
+  }
+  return (read_autoselect((sector_address & Traits::SECTOR_MASK) | 0x00000002) != 0);
+}
+
+template <class Traits>
+typename flash_chip_engine<Traits>::word_t flash_chip_engine<Traits>::read_autoselect(address_t address)
+{
+  ensure_not_erasing();
+  
+  // Enter autoselect mode and read in a single batch
+  linkmasta_device::command_script script;
+  if (m_mode != chip_mode::AUTOSELECT)
+  {
+    add_command(script, 0x90);
+  }
+  script.read_word(m_chip_num, address);
+  
+  word_t result = (word_t) m_linkmasta->run_script(script).front();
+  m_mode = chip_mode::AUTOSELECT;
+  return result;
+}
+
+template <class Traits>
+void flash_chip_engine<Traits>::program_word(address_t address, word_t data)
+{
+  ensure_not_erasing();
+  
+  // Reset if in autoselect mode
+  if (m_mode != chip_mode::BYPASS && m_mode != chip_mode::READ)
+  {
+    reset();
+  }
+  
+  // Write prefix based on whether or not in bypass mode
+  linkmasta_device::command_script script;
+  if (m_mode == chip_mode::BYPASS)
+  {
+    script.write_word(m_chip_num, 0, 0xA0);
+  }
+  else
+  {
+    add_command(script, 0xA0);
+  }
+  
+  script.write_word(m_chip_num, address, data);
+  m_linkmasta->run_script(script);
+}
+
+template <class Traits>
+void flash_chip_engine<Traits>::unlock_bypass()
+{
+  ensure_not_erasing();
+  
+  // Ensure that we actually support bypass mode before doing anything
+  if (!m_supports_bypass || m_mode == chip_mode::BYPASS)
+  {
+    return;
+  }
+  
+  ensure_read_mode();
+  
+  linkmasta_device::command_script script;
+  add_command(script, 0x20);
+  m_linkmasta->run_script(script);
+  
+  m_mode = chip_mode::BYPASS;
+}
+
+template <class Traits>
+void flash_chip_engine<Traits>::erase_chip()
+{
+  ensure_not_erasing();
+  ensure_read_mode();
+  
+  m_last_erased_addr = 0;
+  
+  if (m_can_erase_chip)
+  {
+    m_linkmasta->erase_chip(m_chip_num);
+  }
+  else
+  {
+    // Send the nuke command sequence to chip
+    linkmasta_device::command_script script;
+    add_command(script, 0x80);
+    add_command(script, 0x10);
+    m_linkmasta->run_script(script);
+  }
+  
+  m_mode = chip_mode::ERASE;
+}
+
+template <class Traits>
+void flash_chip_engine<Traits>::erase_block(address_t block_address)
+{
+  ensure_not_erasing();
+  ensure_read_mode();
+  
+  m_last_erased_addr = block_address & Traits::SECTOR_MASK;
+  
+  if (m_can_erase_chip)
+  {
+    m_linkmasta->erase_chip(m_chip_num);
+  }
+  else
+  {
+    // Send the sector erase command sequence to chip
+    linkmasta_device::command_script script;
+    add_command(script, 0x80);
+    script.write_word(m_chip_num, Traits::COMMAND_ADDRESS_1, 0xAA)
+          .write_word(m_chip_num, Traits::COMMAND_ADDRESS_2, 0x55)
+          .write_word(m_chip_num, m_last_erased_addr, 0x30);
+    m_linkmasta->run_script(script);
+  }
+  
+  m_mode = chip_mode::ERASE;
+}
+
+
+
+template <class Traits>
+typename flash_chip_engine<Traits>::chip_mode flash_chip_engine<Traits>::current_mode() const
+{
+  return m_mode;
+}
+
+template <class Traits>
+bool flash_chip_engine<Traits>::supports_bypass() const
+{
+  return m_supports_bypass;
+}
+
+template <class Traits>
+bool flash_chip_engine<Traits>::test_bypass_support()
+{
+  ensure_not_erasing();
+  
+  m_supports_bypass = probe_bypass(std::integral_constant<bool, Traits::ALWAYS_BYPASS>());
+  return m_supports_bypass;
+}
+
+template <class Traits>
+bool flash_chip_engine<Traits>::is_erasing() const
+{
+  return (m_mode == chip_mode::ERASE);
+}
+
+template <class Traits>
+bool flash_chip_engine<Traits>::test_erasing()
+{
+  if (m_mode != chip_mode::ERASE)
+  {
+    return false;
+  }
+  
+  bool done;
+  if (Traits::TOGGLE_BIT_POLLING)
+  {
+    // Two reads in a row show whether the toggle bit is still toggling
+    linkmasta_device::command_script script;
+    script.read_word(m_chip_num, m_last_erased_addr)
+          .read_word(m_chip_num, m_last_erased_addr);
+    std::vector<linkmasta_device::word_t> results = m_linkmasta->run_script(script);
+    done = ((word_t) results[0] == (word_t) results[1]);
+  }
+  else
+  {
+    // Erased data reads back as all ones
+    done = (read(m_last_erased_addr) == (word_t) ~(word_t) 0);
+  }
+  
+  m_mode = (done ? chip_mode::READ : chip_mode::ERASE);
+  return is_erasing();
+}
+
+template <class Traits>
+unsigned int flash_chip_engine<Traits>::read_bytes(address_t address, data_t* data, unsigned int num_bytes, task_controller* controller)
+{
+  ensure_not_erasing();
+  ensure_read_mode();
+  
+  if (m_can_read_bytes)
+  {
+    // Use Linkmasta's built-in support for batch reads
+    if (controller == nullptr)
+    {
+      return m_linkmasta->read_bytes(m_chip_num, address, data, num_bytes);
+    }
+    
+    // Create temporary forwarding controller to pass to linkmasta
+    forwarding_task_controller fwd_controller(controller);
+    fwd_controller.scale_work_to(num_bytes);
+    controller->on_task_start(num_bytes);
+    
+    unsigned int result = 0;
+    
+    // Request read from linkmasta, forwarding task progress updates
+    if (!controller->is_task_cancelled())
+    {
+      try
+      {
+        result = m_linkmasta->read_bytes(m_chip_num, address, data, num_bytes, &fwd_controller);
+      }
+      catch (std::exception& ex)
+      {
+        (void) ex;
+        controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
+        throw;
+      }
+    }
+    
+    // Inform controller that task has ended
+    controller->on_task_end(controller->is_task_cancelled() && result < num_bytes ? task_status::CANCELLED : task_status::COMPLETED, result);
+    return result;
+  }
+  
+  // Inform controller that task has started
+  if (controller != nullptr)
+  {
+    controller->on_task_start(num_bytes);
+  }
+  
+  // Linkmasta does not support batch reading; to it manually
+  unsigned int i;
+  for (i = 0; i < num_bytes && (controller == nullptr || !controller->is_task_cancelled()); ++i, ++address)
+  {
+    try
+    {
+      data[i] = read(address);
+    }
+    catch (std::exception& ex)
+    {
+      (void) ex;
+      // Inform controller that an error has occured and pass exception up
+      if (controller != nullptr)
+      {
+        controller->on_task_end(task_status::ERROR, i);
+      }
+      throw;
+    }
+    
+    // Update controller on task progress
+    if (controller != nullptr)
+    {
+      controller->on_task_update(task_status::RUNNING, 1);
+    }
+  }
+  
+  // Inform controller that task is complete
+  if (controller != nullptr)
+  {
+    controller->on_task_end(controller->is_task_cancelled() && i < num_bytes ? task_status::CANCELLED : task_status::COMPLETED, num_bytes);
+  }
+  return i;
+}
+
+template <class Traits>
+unsigned int flash_chip_engine<Traits>::program_bytes(address_t address, const data_t* data, unsigned int num_bytes, task_controller* controller)
+{
+  ensure_not_erasing();
+  
+  if (m_can_program_bytes)
+  {
+    // Ensure we're in default mode before passing command along to Linkmasta
+    ensure_read_mode();
+    
+    // Use Linkmasta's built-in support for batch programming
+    if (controller == nullptr)
+    {
+      return m_linkmasta->program_bytes(m_chip_num, address, data, num_bytes, m_supports_bypass);
+    }
+    
+    // Create temporary forwarding controller to pass to linkmasta
+    forwarding_task_controller fwd_controller(controller);
+    fwd_controller.scale_work_to(num_bytes);
+    controller->on_task_start(num_bytes);
+    
+    unsigned int result = 0;
+    
+    // Request program from linkmasta, forwarding task progress updates
+    if (!controller->is_task_cancelled())
+    {
+      try
+      {
+        result = m_linkmasta->program_bytes(m_chip_num, address, data, num_bytes, m_supports_bypass, &fwd_controller);
+      }
+      catch (std::exception& ex)
+      {
+        (void) ex;
+        controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
+        throw;
+      }
+    }
+    
+    // Inform controller of task end
+    controller->on_task_end(controller->is_task_cancelled() && result < num_bytes ? task_status::CANCELLED : task_status::COMPLETED, result);
+    return result;
+  }
+  
+  // Linkmasta does not support batch programming; do it manually, in bypass
+  // mode if the chip allows it
+  if (m_supports_bypass)
+  {
+    unlock_bypass();
+  }
+  else
+  {
+    ensure_read_mode();
+  }
+  
+  // Inform controller of task start
+  if (controller != nullptr)
+  {
+    controller->on_task_start(num_bytes);
+  }
+  
+  // Send data one word at a time
+  unsigned int i;
+  for (i = 0; i < num_bytes && (controller == nullptr || !controller->is_task_cancelled()); ++i, ++address)
+  {
+    try
+    {
+      program_word(address, data[i]);
+    }
+    catch (std::exception& ex)
+    {
+      (void) ex;
+      if (controller != nullptr)
+      {
+        controller->on_task_end(task_status::ERROR, i);
+      }
+      throw;
+    }
+    
+    // Inform controller of task progress
+    if (controller != nullptr)
+    {
+      controller->on_task_update(task_status::RUNNING, 1);
+    }
+  }
+  
+  // Inform controller of task end
+  if (controller != nullptr)
+  {
+    controller->on_task_end(controller->is_task_cancelled() && i < num_bytes ? task_status::CANCELLED : task_status::COMPLETED, num_bytes);
+  }
+  return num_bytes;
+}
+
+
+
+template <class Traits>
+linkmasta_device* flash_chip_engine<Traits>::linkmasta() const
+{
+  return m_linkmasta;
+}
+
+
+
+template <class Traits>
+void flash_chip_engine<Traits>::ensure_not_erasing() const
+{
+  if (m_mode == chip_mode::ERASE)
+  {
+    // We can only issue commands when we're not erasing
+    throw std::runtime_error("Chip is busy erasing");
+  }
+}
+
+template <class Traits>
+void flash_chip_engine<Traits>::add_command(linkmasta_device::command_script& script, word_t command) const
+{
+  script.write_word(m_chip_num, Traits::COMMAND_ADDRESS_1, 0xAA)
+        .write_word(m_chip_num, Traits::COMMAND_ADDRESS_2, 0x55)
+        .write_word(m_chip_num, Traits::COMMAND_ADDRESS_1, command);
+}
+
+template <class Traits>
+bool flash_chip_engine<Traits>::probe_bypass(std::true_type always)
+{
+  (void) always;
+  return true;
+}
+
+template <class Traits>
+bool flash_chip_engine<Traits>::probe_bypass(std::false_type always)
+{
+  (void) always;
+  return Traits::supports_bypass(read_autoselect(Traits::BYPASS_ID_ADDRESS));
+}
+
+template <class Traits>
+void flash_chip_engine<Traits>::ensure_read_mode()
+{
+  if (m_mode != chip_mode::READ)
+  {
+    reset();
+  }
+}
+
+#endif /* defined(__FLASH_CHIP_ENGINE_H__) */
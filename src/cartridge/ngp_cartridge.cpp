@@ -18,14 +18,31 @@
 #include "ngp_cartridge.h"
 #include "linkmasta/linkmasta_device.h"
 #include "ngp_chip.h"
+#include "block_cache.h"
+#include "save_manifest.h"
 #include "task/task_controller.h"
 #include "task/forwarding_task_controller.h"
+#include "common/log.h"
+#include "common/byte_kernels.h"
+#include "common/image_source.h"
+#include "common/image_sink.h"
+#include <chrono>
 #include <iostream>
+#include <sstream>
 
 using namespace std;
 
 #define DEFAULT_BLOCK_SIZE 0x10000
 #define NGF_HEADER_VERSION 0x0053
+#define DEFAULT_BLOCK_RETRIES 3
+#define MAX_RETRY_TIMEOUT 30000
+#define MAX_ERASE_TIME 30000
+#define PROBE_ADDRESS 0x5555
+#define PROBE_COMMAND 0xF0
+#define CACHE_SAMPLE_SIZE 64
+#define MIN_GAME_SIZE 0x80000
+#define EXTENT_SAMPLE_SIZE 64
+#define EXTENT_SAMPLE_STRIDE 0x1000
 
 struct NGFheader
 {
@@ -44,7 +61,9 @@ struct NGFblock
 
 ngp_cartridge::ngp_cartridge(linkmasta_device* linkmasta)
   : m_was_init(false),
-    m_linkmasta(linkmasta), m_descriptor(nullptr), m_num_chips(0)
+    m_linkmasta(linkmasta), m_descriptor(nullptr), m_num_chips(0),
+    m_block_retries(DEFAULT_BLOCK_RETRIES), m_retries_performed(0),
+    m_cache(nullptr), m_sync_manifest(nullptr), m_verify_writes(false), m_game_size_hints()
 {
   for (unsigned int i = 0; i < MAX_NUM_CHIPS; ++i)
   {
@@ -106,6 +125,12 @@ void ngp_cartridge::init()
 }
 
 void ngp_cartridge::backup_cartridge_game_data(std::ostream& fout, int slot, task_controller* controller)
+{
+  stream_image_sink sink(fout);
+  backup_cartridge_game_data(sink, slot, controller);
+}
+
+void ngp_cartridge::backup_cartridge_game_data(image_sink& sink, int slot, task_controller* controller)
 {
   // Ensure class was initialized
   if (!m_was_init)
@@ -143,14 +168,22 @@ void ngp_cartridge::backup_cartridge_game_data(std::ostream& fout, int slot, tas
     bytes_total += descriptor()->chips[i]->num_bytes;
   }
   
+  // Leave out the blank space after the game
+  bytes_total = find_game_extent(slot, chip_lower_bound, bytes_total);
+  
   // Initialize markers
   unsigned int curr_chip = chip_lower_bound;
   unsigned int curr_block = 0;
   
-  // Allocate a buffer with max size of a block
+  // Borrow a buffer with max size of a block from the device's pool
   const unsigned int BUFFER_MAX_SIZE = DEFAULT_BLOCK_SIZE;
   unsigned int       buffer_size = 0;
-  unsigned char*     buffer = new unsigned char[BUFFER_MAX_SIZE];
+  block_buffer_pool::buffer buffer_handle = m_linkmasta->buffer_pool().acquire(BUFFER_MAX_SIZE);
+  unsigned char*     buffer = buffer_handle.data();
+  
+  // Hash the content as it goes by
+  content_hasher     hasher;
+  m_content_hashes.clear();
   
   // Inform controller that task is starting
   if (controller != nullptr)
@@ -161,8 +194,11 @@ void ngp_cartridge::backup_cartridge_game_data(std::ostream& fout, int slot, tas
   // Begin writing data block-by-block
   try
   {
+    sink.begin(bytes_total);
+    
     // Open connection to NGP chip
     m_linkmasta->open();
+    validate_cache();
     
     while (bytes_written < bytes_total && curr_chip < chip_upper_bound && (controller == nullptr || !controller->is_task_cancelled()))
     {
@@ -183,27 +219,9 @@ void ngp_cartridge::backup_cartridge_game_data(std::ostream& fout, int slot, tas
         bytes_expected = bytes_total - bytes_written;
       }
       
-      // Attempt to read bytes from cartridge
-      if (controller == nullptr)
-      {
-        buffer_size = m_chips[curr_chip]->read_bytes(block->base_address, buffer, bytes_expected);
-      }
-      else
-      {
-        // Create a forwarding controller to pass progress updates to
-        forwarding_task_controller fwd_controller(controller);
-        fwd_controller.scale_work_to(bytes_expected);
-        try
-        {
-          buffer_size = m_chips[curr_chip]->read_bytes(block->base_address, buffer, bytes_expected, &fwd_controller);
-        }
-        catch (std::exception& ex)
-        {
-          (void) ex;
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-          throw;
-        }
-      }
+      // Attempt to read bytes from cartridge, straight into the image if possible
+      unsigned char* data = sink.acquire(bytes_written, bytes_expected, buffer);
+      buffer_size = read_block(curr_chip, block->base_address, data, bytes_expected, controller);
       
       // Check for errors
       if (buffer_size != bytes_expected)
@@ -214,17 +232,10 @@ void ngp_cartridge::backup_cartridge_game_data(std::ostream& fout, int slot, tas
         }
         throw std::runtime_error("ERROR");
       }
-      if (!fout.good())
-      {
-        if (controller != nullptr)
-        {
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-        }
-        throw std::runtime_error("ERROR");
-      }
       
       // Write buffer to file
-      fout.write((char*) buffer, buffer_size);
+      sink.commit(bytes_written, data, buffer_size);
+      hasher.update(data, buffer_size);
       
       // Update markers
       bytes_written += buffer_size;
@@ -238,6 +249,7 @@ void ngp_cartridge::backup_cartridge_game_data(std::ostream& fout, int slot, tas
     
     // Clean up before returning
     m_linkmasta->close();
+    sink.end(bytes_written);
   }
   catch (std::exception& ex)
   {
@@ -267,12 +279,19 @@ void ngp_cartridge::backup_cartridge_game_data(std::ostream& fout, int slot, tas
       // Well... this is awkward
     }
     
+    try {
+      // Keep whatever was read before things went wrong
+      sink.end(bytes_written);
+    } catch (std::exception& ex2) {
+      (void) ex2;
+      // Well... this is awkward
+    }
+    
     // Inform controller of task end
     if (controller != nullptr)
     {
       controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
     }
-    delete [] buffer;
     throw;
   }
   
@@ -281,17 +300,23 @@ void ngp_cartridge::backup_cartridge_game_data(std::ostream& fout, int slot, tas
   {
     controller->on_task_end(controller->is_task_cancelled() && bytes_written < bytes_total ? task_status::CANCELLED : task_status::COMPLETED, bytes_written);
   }
-  delete [] buffer;
+  
+  // Only keep hashes of complete reads
+  if (bytes_written == bytes_total)
+  {
+    hasher.finish();
+    m_content_hashes = hasher.hashes();
+  }
 }
 
 void ngp_cartridge::restore_cartridge_game_data(std::istream& fin, int slot, task_controller* controller)
 {
-  // Ensure argument type is not the standard input
-  if (&fin == &std::cin)
-  {
-    throw std::invalid_argument("Standard input cannot be used in cartridge operations");
-  }
-  
+  stream_image_source source(fin);
+  restore_cartridge_game_data(source, slot, controller);
+}
+
+void ngp_cartridge::restore_cartridge_game_data(image_source& source, int slot, task_controller* controller)
+{
   // Ensure class was initialized
   if (!m_was_init)
   {
@@ -321,10 +346,8 @@ void ngp_cartridge::restore_cartridge_game_data(std::istream& fin, int slot, tas
   }
   
   // Determine the total number of bytes to write
-  fin.seekg(0, fin.end);
   unsigned int bytes_written = 0;
-  unsigned int bytes_total = (unsigned int) fin.tellg();
-  fin.seekg(0, fin.beg);
+  unsigned int bytes_total = source.size();
   
   unsigned int bytes_chip_sum  = 0;
   for (unsigned int i = chip_lower_bound; i < chip_upper_bound; ++i)
@@ -342,10 +365,11 @@ void ngp_cartridge::restore_cartridge_game_data(std::istream& fin, int slot, tas
   unsigned int curr_chip = chip_lower_bound;
   unsigned int curr_block = 0;
   
-  // Allocate a buffer with max size of a block
+  // Borrow a buffer with max size of a block from the device's pool
   const unsigned int BUFFER_MAX_SIZE = DEFAULT_BLOCK_SIZE;
   unsigned int       buffer_size = 0;
-  unsigned char*     buffer = new unsigned char[BUFFER_MAX_SIZE];
+  block_buffer_pool::buffer buffer_handle = m_linkmasta->buffer_pool().acquire(BUFFER_MAX_SIZE);
+  unsigned char*     buffer = buffer_handle.data();
   
   // Inform controller that task is starting
   if (controller != nullptr)
@@ -377,59 +401,17 @@ void ngp_cartridge::restore_cartridge_game_data(std::istream& fin, int slot, tas
         bytes_expected = bytes_total - bytes_written;
       }
       
-      // Attempt to read bytes from file
-      fin.read((char*) buffer, bytes_expected);
-      buffer_size = (unsigned int) fin.gcount();
-      
-      // Check for errors
-      if (buffer_size != bytes_expected)
-      {
-        if (controller != nullptr)
-        {
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-        }
-        throw std::runtime_error("ERROR");
-      }
-      if (!fin.good() && (buffer_size + bytes_written) < bytes_total)
-      {
-        if (controller != nullptr)
-        {
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-        }
-        throw std::runtime_error("ERROR");
-      }
-      
-      // Erase block from cartridge
-      m_chips[curr_chip]->erase_block(block->base_address);
+      // Get bytes from file, directly from the image if possible
+      const unsigned char* data = source.view(bytes_written, bytes_expected, buffer);
+      buffer_size = bytes_expected;
       
-      // Wait for erasure to complete
-      while (m_chips[curr_chip]->test_erasing())
-      {
-        if (controller != nullptr)
-        {
-          controller->on_task_update(task_status::RUNNING, 0);
-        }
-      }
+      // Erase block and write buffer to cartridge
+      program_block(curr_chip, block->base_address, block->base_address, data, buffer_size, true, controller);
       
-      // Write buffer to cartridge
-      if (controller == nullptr)
-      {
-        m_chips[curr_chip]->program_bytes(block->base_address, buffer, buffer_size);
-      }
-      else
+      // Read the block back while its contents are still in memory
+      if (m_verify_writes)
       {
-        forwarding_task_controller fwd_controller(controller);
-        fwd_controller.scale_work_to(buffer_size);
-        try
-        {
-          m_chips[curr_chip]->program_bytes(block->base_address, buffer, buffer_size, &fwd_controller);
-        }
-        catch (std::exception& ex)
-        {
-          (void) ex;
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-          throw;
-        }
+        verify_block(curr_chip, block->base_address, data, buffer_size, controller);
       }
       
       // Update markers
@@ -476,7 +458,6 @@ void ngp_cartridge::restore_cartridge_game_data(std::istream& fin, int slot, tas
     {
       controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
     }
-    delete [] buffer;
     throw;
   }
   
@@ -485,17 +466,16 @@ void ngp_cartridge::restore_cartridge_game_data(std::istream& fin, int slot, tas
   {
     controller->on_task_end(controller->is_task_cancelled() && bytes_written < bytes_total ? task_status::CANCELLED : task_status::COMPLETED, bytes_written);
   }
-  delete [] buffer;
 }
 
 bool ngp_cartridge::compare_cartridge_game_data(std::istream& fin, int slot, task_controller* controller)
 {
-  // Ensure argument type is not the standard input
-  if (&fin == &std::cin)
-  {
-    throw std::invalid_argument("Standard input cannot be used in cartridge operations");
-  }
-  
+  stream_image_source source(fin);
+  return compare_cartridge_game_data(source, slot, controller);
+}
+
+bool ngp_cartridge::compare_cartridge_game_data(image_source& source, int slot, task_controller* controller)
+{
   // Ensure class was initialized
   if (!m_was_init)
   {
@@ -525,10 +505,8 @@ bool ngp_cartridge::compare_cartridge_game_data(std::istream& fin, int slot, tas
   }
   
   // determine the total number of bytes to compare
-  fin.seekg(0, fin.end);
   unsigned int bytes_compared = 0;
-  unsigned int bytes_total = (unsigned int) fin.tellg();
-  fin.seekg(0, fin.beg);
+  unsigned int bytes_total = source.size();
   
   unsigned int bytes_chip_sum  = 0;
   for (unsigned int i = chip_lower_bound; i < chip_upper_bound; ++i)
@@ -547,12 +525,18 @@ bool ngp_cartridge::compare_cartridge_game_data(std::istream& fin, int slot, tas
   unsigned int curr_block = 0;
   bool         matched = true;
   
-  // Allocate a buffer with max size of a block
+  // Borrow a buffer with max size of a block from the device's pool
   const unsigned int BUFFER_MAX_SIZE = DEFAULT_BLOCK_SIZE;
   unsigned int       f_buffer_size = 0;
-  unsigned char*     f_buffer = new unsigned char[BUFFER_MAX_SIZE];
+  block_buffer_pool::buffer f_buffer_handle = m_linkmasta->buffer_pool().acquire(BUFFER_MAX_SIZE);
+  unsigned char*     f_buffer = f_buffer_handle.data();
   unsigned int       c_buffer_size = 0;
-  unsigned char*     c_buffer = new unsigned char[BUFFER_MAX_SIZE];
+  block_buffer_pool::buffer c_buffer_handle = m_linkmasta->buffer_pool().acquire(BUFFER_MAX_SIZE);
+  unsigned char*     c_buffer = c_buffer_handle.data();
+  
+  // Hash the content as it goes by
+  content_hasher     hasher;
+  m_content_hashes.clear();
   
   // Inform controller that task is starting
   if (controller != nullptr)
@@ -565,6 +549,7 @@ bool ngp_cartridge::compare_cartridge_game_data(std::istream& fin, int slot, tas
   {
     // Open connection to NGP chip
     m_linkmasta->open();
+    validate_cache();
     
     while (bytes_compared < bytes_total && matched && (controller == nullptr || !controller->is_task_cancelled()))
     {
@@ -585,50 +570,12 @@ bool ngp_cartridge::compare_cartridge_game_data(std::istream& fin, int slot, tas
         bytes_expected = bytes_total - bytes_compared;
       }
       
-      // Attempt to read bytes from file
-      fin.read((char*) f_buffer, bytes_expected);
-      f_buffer_size = (unsigned int) fin.gcount();
-      
-      // Check for errors
-      if (f_buffer_size != bytes_expected)
-      {
-        if (controller != nullptr)
-        {
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-        }
-        throw std::runtime_error("ERROR");
-      }
-      if (!fin.good() && (f_buffer_size + bytes_compared) < bytes_total)
-      {
-        if (controller != nullptr)
-        {
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-        }
-        throw std::runtime_error("ERROR");
-      }
+      // Get bytes from file, directly from the image if possible
+      const unsigned char* f_data = source.view(bytes_compared, bytes_expected, f_buffer);
+      f_buffer_size = bytes_expected;
       
       // Attempt to read bytes from cartridge
-      if (controller == nullptr)
-      {
-        c_buffer_size = m_chips[curr_chip]->read_bytes(block->base_address, c_buffer, bytes_expected);
-      }
-      else
-      {
-        // Use a forwarding controller to pass progress updates to our controller
-        forwarding_task_controller fwd_controller(controller);
-        fwd_controller.scale_work_to(bytes_expected);
-        try
-        {
-          c_buffer_size = m_chips[curr_chip]->read_bytes(block->base_address, c_buffer, bytes_expected, &fwd_controller);
-        }
-        catch (std::exception& ex)
-        {
-          (void) ex;
-          // Inform controller of error
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-          throw;
-        }
-      }
+      c_buffer_size = read_block(curr_chip, block->base_address, c_buffer, bytes_expected, controller);
       
       // Check for errors
       if (c_buffer_size != bytes_expected)
@@ -640,14 +587,17 @@ bool ngp_cartridge::compare_cartridge_game_data(std::istream& fin, int slot, tas
         throw std::runtime_error("ERROR");
       }
       
+      hasher.update(c_buffer, c_buffer_size);
+      
       // Compare contents of buffers
-      for (unsigned int i = 0; i < f_buffer_size && i < c_buffer_size; ++i)
+      unsigned int mismatch = find_mismatch(f_data, c_buffer, f_buffer_size);
+      if (mismatch < f_buffer_size)
       {
-        if (f_buffer[i] != c_buffer[i])
-        {
-          matched = false;
-          break;
-        }
+        matched = false;
+        
+        std::ostringstream message;
+        message << "Data mismatch at file offset 0x" << std::hex << (bytes_compared + mismatch);
+        log(log_level::INFO, message.str().c_str());
       }
       
       // Update markers
@@ -693,8 +643,6 @@ bool ngp_cartridge::compare_cartridge_game_data(std::istream& fin, int slot, tas
     {
       controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
     }
-    delete [] f_buffer;
-    delete [] c_buffer;
     throw;
   }
   
@@ -703,8 +651,13 @@ bool ngp_cartridge::compare_cartridge_game_data(std::istream& fin, int slot, tas
   {
     controller->on_task_end(controller->is_task_cancelled() && bytes_compared < bytes_total ? task_status::CANCELLED : task_status::COMPLETED, bytes_compared);
   }
-  delete [] f_buffer;
-  delete [] c_buffer;
+  
+  // Only keep hashes of complete, matching reads
+  if (matched && bytes_compared == bytes_total)
+  {
+    hasher.finish();
+    m_content_hashes = hasher.hashes();
+  }
   return matched;
 }
 
@@ -763,6 +716,31 @@ void ngp_cartridge::backup_cartridge_save_data(std::ostream& fout, int slot, tas
   file_header.num_bytes += sizeof(block_header) * blocks_total;
   file_header.num_blocks = blocks_total;
   
+  // Only rewrite changed blocks if the manifest describes this very layout
+  bool incremental = false;
+  if (m_sync_manifest != nullptr)
+  {
+    incremental = (m_sync_manifest->file_size() == file_header.num_bytes
+                   && m_sync_manifest->num_blocks() == blocks_total);
+    for (unsigned int i = chip_lower_bound; i < chip_upper_bound && incremental; ++i)
+    {
+      for (unsigned int j = 0; j < descriptor()->chips[i]->num_blocks && incremental; ++j)
+      {
+        const cartridge_descriptor::chip_descriptor::block_descriptor* block = descriptor()->chips[i]->blocks[j];
+        if (!block->is_protected)
+        {
+          incremental = m_sync_manifest->contains(block->base_address + 0x200000 + 0x600000 * (i - chip_lower_bound), block->num_bytes);
+        }
+      }
+    }
+    
+    if (!incremental)
+    {
+      m_sync_manifest->clear();
+    }
+    m_sync_manifest->set_file_size(file_header.num_bytes);
+  }
+  
   // Write header to file
   fout.write((char*) &file_header, sizeof(file_header));	
   
@@ -770,10 +748,11 @@ void ngp_cartridge::backup_cartridge_save_data(std::ostream& fout, int slot, tas
   unsigned int curr_chip = chip_lower_bound;
   unsigned int curr_block = 0;
   
-  // Allocate a buffer with max size of a block
+  // Borrow a buffer with max size of a block from the device's pool
   const unsigned int BUFFER_MAX_SIZE = DEFAULT_BLOCK_SIZE;
   unsigned int       buffer_size = 0;
-  unsigned char*     buffer = new unsigned char[BUFFER_MAX_SIZE];
+  block_buffer_pool::buffer buffer_handle = m_linkmasta->buffer_pool().acquire(BUFFER_MAX_SIZE);
+  unsigned char*     buffer = buffer_handle.data();
   
   // Inform controller that task is starting
   if (controller != nullptr)
@@ -786,6 +765,7 @@ void ngp_cartridge::backup_cartridge_save_data(std::ostream& fout, int slot, tas
   {
     // Open connection to NGP chip
     m_linkmasta->open();
+    validate_cache();
     
     while (bytes_written < bytes_total && curr_chip < chip_upper_bound && (controller == nullptr || !controller->is_task_cancelled()))
     {
@@ -809,10 +789,6 @@ void ngp_cartridge::backup_cartridge_save_data(std::ostream& fout, int slot, tas
         // Adjust for NGP virtual address offset
         block_header.address += 0x200000 + 0x600000 * (curr_chip - chip_lower_bound);
         
-        // Write block header to file
-        fout.write((char*) &block_header, sizeof(block_header));
-        
-        
         // Calculate number of expected bytes
         unsigned int bytes_expected = block->num_bytes;
         if (bytes_expected > bytes_total - bytes_written)
@@ -821,26 +797,7 @@ void ngp_cartridge::backup_cartridge_save_data(std::ostream& fout, int slot, tas
         }
         
         // Attempt to read bytes from cartridge
-        if (controller == nullptr)
-        {
-          buffer_size = m_chips[curr_chip]->read_bytes(block->base_address, buffer, bytes_expected);
-        }
-        else
-        {
-          // Create a forwarding controller to pass progress updates to
-          forwarding_task_controller fwd_controller(controller);
-          fwd_controller.scale_work_to(bytes_expected);
-          try
-          {
-            buffer_size = m_chips[curr_chip]->read_bytes(block->base_address, buffer, bytes_expected, &fwd_controller);
-          }
-          catch (std::exception& ex)
-          {
-            (void) ex;
-            controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-            throw;
-          }
-        }
+        buffer_size = read_block(curr_chip, block->base_address, buffer, bytes_expected, controller);
         
         // Check for errors
         if (buffer_size != bytes_expected)
@@ -860,8 +817,28 @@ void ngp_cartridge::backup_cartridge_save_data(std::ostream& fout, int slot, tas
           throw std::runtime_error("ERROR");
         }
         
-        // Write buffer to file
-        fout.write((char*) buffer, buffer_size);
+        // Write block header and buffer to file, skipping over unchanged
+        // blocks when synchronizing
+        content_hash hash;
+        if (m_sync_manifest != nullptr)
+        {
+          hash = save_manifest::hash(buffer, buffer_size);
+        }
+        
+        if (incremental && m_sync_manifest->matches(block_header.address, hash))
+        {
+          fout.seekp(sizeof(block_header) + buffer_size, std::ios::cur);
+        }
+        else
+        {
+          fout.write((char*) &block_header, sizeof(block_header));
+          fout.write((char*) buffer, buffer_size);
+          
+          if (m_sync_manifest != nullptr)
+          {
+            m_sync_manifest->update(block_header.address, hash);
+          }
+        }
         bytes_written += buffer_size;
       }
       
@@ -909,7 +886,6 @@ void ngp_cartridge::backup_cartridge_save_data(std::ostream& fout, int slot, tas
     {
       controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
     }
-    delete [] buffer;
     throw;
   }
   
@@ -918,7 +894,6 @@ void ngp_cartridge::backup_cartridge_save_data(std::ostream& fout, int slot, tas
   {
     controller->on_task_end(controller->is_task_cancelled() && bytes_written < bytes_total ? task_status::CANCELLED : task_status::COMPLETED, bytes_written);
   }
-  delete [] buffer;
 }
 
 void ngp_cartridge::restore_cartridge_save_data(std::istream& fin, int slot, task_controller* controller)
@@ -975,10 +950,19 @@ void ngp_cartridge::restore_cartridge_save_data(std::istream& fin, int slot, tas
   unsigned int curr_chip = 0;
   unsigned int curr_block = 0;
   
-  // Allocate a buffer with max size of a block
+  // Borrow a buffer with max size of a block from the device's pool
   const unsigned int BUFFER_MAX_SIZE = DEFAULT_BLOCK_SIZE;
   unsigned int       buffer_size = 0;
-  unsigned char*     buffer = new unsigned char[BUFFER_MAX_SIZE];
+  block_buffer_pool::buffer buffer_handle = m_linkmasta->buffer_pool().acquire(BUFFER_MAX_SIZE);
+  unsigned char*     buffer = buffer_handle.data();
+  
+  // When synchronizing, blocks are read back to see if they need writing
+  block_buffer_pool::buffer current;
+  if (m_sync_manifest != nullptr)
+  {
+    m_sync_manifest->clear();
+    current = m_linkmasta->buffer_pool().acquire(BUFFER_MAX_SIZE);
+  }
   
   // Inform controller that task is starting
   if (controller != nullptr)
@@ -999,11 +983,19 @@ void ngp_cartridge::restore_cartridge_save_data(std::istream& fin, int slot, tas
     }
   }
   
+  // What's been programmed into each erased block so far, keyed by chip and
+  // block, so a retry that has to erase a block again can put it all back
+  std::map<std::pair<unsigned int, unsigned int>, std::vector<block_segment>> written_segments;
+  
   // Begin writing data block-by-block
   try
   {
     // Open connection to NGP chip
     m_linkmasta->open();
+    if (m_sync_manifest != nullptr)
+    {
+      validate_cache();
+    }
     
     // Loop through all segments in file
     for (unsigned int i = 0; i < file_header.num_blocks; ++i)
@@ -1016,6 +1008,7 @@ void ngp_cartridge::restore_cartridge_save_data(std::istream& fin, int slot, tas
       fin.read((char*) &block_header, sizeof(block_header));
       
       // Account for Neo Geo Pocket virtual address offset
+      uint32_t file_address = block_header.address;
       block_header.address -= 0x200000;
       
       // Determine the chip on which the block resides
@@ -1082,42 +1075,33 @@ void ngp_cartridge::restore_cartridge_save_data(std::istream& fin, int slot, tas
         throw std::runtime_error("ERROR");
       }
       
-      // Erase block from cartridge if not already erased
-      if (erased_blocks[curr_chip][curr_block] == false)
+      // When synchronizing, leave whole blocks alone if they already match
+      bool unchanged = false;
+      if (m_sync_manifest != nullptr)
       {
-        m_chips[curr_chip]->erase_block(block->base_address);
-        
-        // Wait for erasure to complete
-        while (m_chips[curr_chip]->test_erasing())
+        if (block_header.address == block->base_address && buffer_size == block->num_bytes
+            && !erased_blocks[curr_chip][curr_block])
         {
-          if (controller != nullptr)
-          {
-            controller->on_task_update(task_status::RUNNING, 0);
-          }
+          read_block(curr_chip, block->base_address, current.data(), buffer_size, nullptr);
+          unchanged = (find_mismatch(buffer, current.data(), buffer_size) == buffer_size);
         }
-        
-        erased_blocks[curr_chip][curr_block] = true;
+        m_sync_manifest->update(file_address, save_manifest::hash(buffer, buffer_size));
       }
       
-      // Write buffer to cartridge
-      if (controller == nullptr)
+      if (unchanged)
       {
-        m_chips[curr_chip]->program_bytes(block_header.address, buffer, buffer_size);
+        if (controller != nullptr)
+        {
+          controller->on_task_update(task_status::RUNNING, buffer_size);
+        }
       }
       else
       {
-        forwarding_task_controller fwd_controller(controller);
-        fwd_controller.scale_work_to(buffer_size);
-        try
-        {
-          m_chips[curr_chip]->program_bytes(block_header.address, buffer, buffer_size, &fwd_controller);
-        }
-        catch (std::exception& ex)
-        {
-          (void) ex;
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-          throw;
-        }
+        // Write buffer to cartridge, erasing block first if not already erased
+        std::vector<block_segment>& written = written_segments[std::make_pair(curr_chip, curr_block)];
+        program_block(curr_chip, block->base_address, block_header.address, buffer, buffer_size, !erased_blocks[curr_chip][curr_block], controller, &written);
+        erased_blocks[curr_chip][curr_block] = true;
+        written.push_back(block_segment{block_header.address, std::vector<unsigned char>(buffer, buffer + buffer_size)});
       }
       
       bytes_written += buffer_size;
@@ -1125,6 +1109,10 @@ void ngp_cartridge::restore_cartridge_save_data(std::istream& fin, int slot, tas
     
     // Clean up before returning
     m_linkmasta->close();
+    if (m_sync_manifest != nullptr)
+    {
+      m_sync_manifest->set_file_size(file_header.num_bytes);
+    }
   }
   catch (std::exception& ex)
   {
@@ -1160,7 +1148,6 @@ void ngp_cartridge::restore_cartridge_save_data(std::istream& fin, int slot, tas
       delete [] erased_blocks[c];
     }
     delete [] erased_blocks;
-    delete [] buffer;
     
     throw;
   }
@@ -1175,7 +1162,6 @@ void ngp_cartridge::restore_cartridge_save_data(std::istream& fin, int slot, tas
     delete [] erased_blocks[c];
   }
   delete [] erased_blocks;
-  delete [] buffer;
 }
 
 bool ngp_cartridge::compare_cartridge_save_data(std::istream& fin, int slot, task_controller* controller)
@@ -1233,12 +1219,14 @@ bool ngp_cartridge::compare_cartridge_save_data(std::istream& fin, int slot, tas
   unsigned int curr_block = 0;
   bool         matched = true;
   
-  // Allocate a buffer with max size of a block
+  // Borrow a buffer with max size of a block from the device's pool
   const unsigned int BUFFER_MAX_SIZE = DEFAULT_BLOCK_SIZE;
   unsigned int       f_buffer_size = 0;
-  unsigned char*     f_buffer = new unsigned char[BUFFER_MAX_SIZE];
+  block_buffer_pool::buffer f_buffer_handle = m_linkmasta->buffer_pool().acquire(BUFFER_MAX_SIZE);
+  unsigned char*     f_buffer = f_buffer_handle.data();
   unsigned int       c_buffer_size = 0;
-  unsigned char*     c_buffer = new unsigned char[BUFFER_MAX_SIZE];
+  block_buffer_pool::buffer c_buffer_handle = m_linkmasta->buffer_pool().acquire(BUFFER_MAX_SIZE);
+  unsigned char*     c_buffer = c_buffer_handle.data();
   
   // Inform controller that task is starting
   if (controller != nullptr)
@@ -1251,6 +1239,7 @@ bool ngp_cartridge::compare_cartridge_save_data(std::istream& fin, int slot, tas
   {
     // Open connection to NGP chip
     m_linkmasta->open();
+    validate_cache();
     
     
     // Loop through all blocks in file
@@ -1333,27 +1322,7 @@ bool ngp_cartridge::compare_cartridge_save_data(std::istream& fin, int slot, tas
       }
       
       // Attempt to read bytes from cartridge
-      if (controller == nullptr)
-      {
-        c_buffer_size = m_chips[curr_chip]->read_bytes(block->base_address, c_buffer, bytes_expected);
-      }
-      else
-      {
-        // Use a forwarding controller to pass progress updates to our controller
-        forwarding_task_controller fwd_controller(controller);
-        fwd_controller.scale_work_to(bytes_expected);
-        try
-        {
-          c_buffer_size = m_chips[curr_chip]->read_bytes(block->base_address, c_buffer, bytes_expected, &fwd_controller);
-        }
-        catch (std::exception& ex)
-        {
-          (void) ex;
-          // Inform controller of error
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-          throw;
-        }
-      }
+      c_buffer_size = read_block(curr_chip, block->base_address, c_buffer, bytes_expected, controller);
       
       // Check for errors
       if (c_buffer_size != bytes_expected)
@@ -1367,13 +1336,14 @@ bool ngp_cartridge::compare_cartridge_save_data(std::istream& fin, int slot, tas
       
       
       // Compare contents of buffers
-      for (unsigned int i = 0; i < f_buffer_size && i < c_buffer_size; ++i)
+      unsigned int mismatch = find_mismatch(f_buffer, c_buffer, f_buffer_size);
+      if (mismatch < f_buffer_size)
       {
-        if (f_buffer[i] != c_buffer[i])
-        {
-          matched = false;
-          break;
-        }
+        matched = false;
+        
+        std::ostringstream message;
+        message << "Data mismatch at file offset 0x" << std::hex << (bytes_written + mismatch);
+        log(log_level::INFO, message.str().c_str());
       }
       
       bytes_written += f_buffer_size;
@@ -1410,8 +1380,6 @@ bool ngp_cartridge::compare_cartridge_save_data(std::istream& fin, int slot, tas
     {
       controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
     }
-    delete [] f_buffer;
-    delete [] c_buffer;
     throw;
   }
   
@@ -1421,8 +1389,6 @@ bool ngp_cartridge::compare_cartridge_save_data(std::istream& fin, int slot, tas
     controller->on_task_end(controller->is_task_cancelled() && bytes_written < bytes_total ? task_status::CANCELLED : task_status::COMPLETED, bytes_written);
   }
   
-  delete [] f_buffer;
-  delete [] c_buffer;
   return matched;
 }
 
@@ -1501,6 +1467,11 @@ std::string ngp_cartridge::fetch_game_name(int slot)
   return s;
 }
 
+const std::vector<content_hash>& ngp_cartridge::content_hashes() const
+{
+  return m_content_hashes;
+}
+
 const ngp_cartridge::game_metadata* ngp_cartridge::get_game_metadata(int slot) const
 {
   // Ensure class was initialized
@@ -1518,35 +1489,171 @@ const ngp_cartridge::game_metadata* ngp_cartridge::get_game_metadata(int slot) c
   return &m_metadata[slot];
 }
 
+unsigned int ngp_cartridge::block_retries() const
+{
+  return m_block_retries;
+}
 
+void ngp_cartridge::set_block_retries(unsigned int retries)
+{
+  m_block_retries = retries;
+}
 
-bool ngp_cartridge::test_for_cartridge(linkmasta_device* linkmasta)
+unsigned int ngp_cartridge::num_retries_performed() const
 {
-  bool exists;
-  
-  // Check the device id and manufacturer id and see if they are invalid
-  linkmasta->open();
-  ngp_chip chip(linkmasta, 0);
-  chip.reset();
-  exists = !(chip.get_device_id() == 0x90 || chip.get_manufacturer_id() == 0x90);
-  linkmasta->close();
-  
-  return exists;
+  return m_retries_performed;
+}
+
+bool ngp_cartridge::verify_writes() const
+{
+  return m_verify_writes;
+}
+
+void ngp_cartridge::set_verify_writes(bool verify)
+{
+  m_verify_writes = verify;
 }
 
+block_cache* ngp_cartridge::cache() const
+{
+  return m_cache;
+}
 
+void ngp_cartridge::set_cache(block_cache* cache)
+{
+  m_cache = cache;
+}
 
-void ngp_cartridge::build_cartridge_destriptor()
+save_manifest* ngp_cartridge::sync_manifest() const
 {
-  if (m_descriptor != nullptr)
+  return m_sync_manifest;
+}
+
+void ngp_cartridge::set_sync_manifest(save_manifest* manifest)
+{
+  m_sync_manifest = manifest;
+}
+
+unsigned int ngp_cartridge::game_size_hint(int slot) const
+{
+  auto it = m_game_size_hints.find(slot);
+  return (it == m_game_size_hints.end() ? 0 : it->second);
+}
+
+void ngp_cartridge::set_game_size_hint(int slot, unsigned int num_bytes)
+{
+  if (num_bytes == 0)
   {
-    delete m_descriptor;
-    m_descriptor = nullptr;
+    m_game_size_hints.erase(slot);
   }
-  
-  ngp_chip* chip;
-  
-  for (unsigned int i = 0; i < MAX_NUM_CHIPS; ++i)
+  else
+  {
+    m_game_size_hints[slot] = num_bytes;
+  }
+}
+
+bool ngp_cartridge::prefetch_block()
+{
+  // Ensure class was initialized
+  if (!m_was_init)
+  {
+    throw std::runtime_error("Cartridge not initialized");
+  }
+  
+  if (m_cache == nullptr)
+  {
+    return false;
+  }
+  
+  std::vector<unsigned char> buffer;
+  
+  m_linkmasta->open();
+  try
+  {
+    validate_cache();
+    
+    // Find the first block that hasn't been cached yet
+    for (unsigned int c = 0; c < descriptor()->num_chips; ++c)
+    {
+      cartridge_descriptor::chip_descriptor* chip = descriptor()->chips[c];
+      
+      for (unsigned int b = 0; b < chip->num_blocks; ++b)
+      {
+        cartridge_descriptor::chip_descriptor::block_descriptor* block = chip->blocks[b];
+        
+        if (m_cache->contains(c, block->base_address, block->num_bytes))
+        {
+          continue;
+        }
+        
+        // read_block() stores the result in the cache for us
+        buffer.resize(block->num_bytes);
+        read_block(c, block->base_address, buffer.data(), block->num_bytes, nullptr);
+        m_linkmasta->close();
+        return true;
+      }
+    }
+  }
+  catch (std::exception& ex)
+  {
+    (void) ex;
+    
+    try {
+      m_linkmasta->close();
+    } catch (std::exception& ex2) {
+      (void) ex2;
+      // Well... this is awkward
+    }
+    throw;
+  }
+  
+  m_linkmasta->close();
+  return false;
+}
+
+
+
+bool ngp_cartridge::test_for_cartridge(linkmasta_device* linkmasta)
+{
+  bool exists;
+  
+  // Check the device id and manufacturer id and see if they are invalid
+  linkmasta->open();
+  ngp_chip chip(linkmasta, 0);
+  chip.reset();
+  exists = !(chip.get_device_id() == 0x90 || chip.get_manufacturer_id() == 0x90);
+  linkmasta->close();
+  
+  return exists;
+}
+
+bool ngp_cartridge::probe_for_cartridge(linkmasta_device* linkmasta)
+{
+  bool exists;
+  
+  // A lone reset command is harmless to a chip in read mode and leaves its
+  // value on the bus if nothing is there to drive it
+  linkmasta->open();
+  linkmasta->write_word(0, PROBE_ADDRESS, PROBE_COMMAND);
+  exists = (linkmasta->read_word(0, 0x00000000) != PROBE_COMMAND);
+  linkmasta->close();
+  
+  return exists;
+}
+
+
+
+void ngp_cartridge::build_cartridge_destriptor()
+{
+  if (m_descriptor != nullptr)
+  {
+    delete m_descriptor;
+    m_descriptor = nullptr;
+  }
+  
+  ngp_chip* chip;
+  
+  for (unsigned int i = 0; i < MAX_NUM_CHIPS; ++i)
   {
     chip = new ngp_chip(m_linkmasta, i);
     
@@ -1715,12 +1822,497 @@ void ngp_cartridge::build_game_metadata(int slot)
   else if (slot >= 0 && slot < (int) m_metadata.size())
   {
     // Read metadata from cartridge and build metadata from it
-    unsigned char* buffer = new unsigned char[64];
+    block_buffer_pool::buffer buffer = m_linkmasta->buffer_pool().acquire(64);
+    
+    m_chips[slot]->read_bytes(0, buffer.data(), 64);
+    
+    m_metadata[slot].read_from_data_array(buffer.data());
+  }
+}
+
+void ngp_cartridge::validate_cache()
+{
+  if (m_cache == nullptr)
+  {
+    return;
+  }
+  
+  // Sample the start and end of every chip. A swapped or externally flashed
+  // cartridge is all but guaranteed to differ in its header or its tail.
+  std::vector<unsigned char> signature;
+  unsigned char sample[CACHE_SAMPLE_SIZE];
+  
+  for (unsigned int c = 0; c < descriptor()->num_chips; ++c)
+  {
+    const cartridge_descriptor::chip_descriptor* chip = descriptor()->chips[c];
+    
+    signature.push_back((unsigned char) chip->manufacturer_id);
+    signature.push_back((unsigned char) chip->device_id);
+    
+    if (m_chips[c]->read_bytes(0, sample, CACHE_SAMPLE_SIZE) != CACHE_SAMPLE_SIZE)
+    {
+      throw std::runtime_error("Short read from cartridge");
+    }
+    signature.insert(signature.end(), sample, sample + CACHE_SAMPLE_SIZE);
+    
+    if (m_chips[c]->read_bytes(chip->num_bytes - CACHE_SAMPLE_SIZE, sample, CACHE_SAMPLE_SIZE) != CACHE_SAMPLE_SIZE)
+    {
+      throw std::runtime_error("Short read from cartridge");
+    }
+    signature.insert(signature.end(), sample, sample + CACHE_SAMPLE_SIZE);
+  }
+  
+  if (!m_cache->validate(signature))
+  {
+    log(log_level::INFO, "Cartridge changed; discarding cached blocks");
+  }
+}
+
+unsigned int ngp_cartridge::find_game_extent(int slot, unsigned int chip_i, unsigned int num_bytes)
+{
+  unsigned int hint = game_size_hint(slot);
+  if (hint >= num_bytes)
+  {
+    return num_bytes;
+  }
+  
+  unsigned int extent = MIN_GAME_SIZE;
+  while (extent < num_bytes)
+  {
+    extent <<= 1;
+  }
+  
+  unsigned char sample[EXTENT_SAMPLE_SIZE];
+  bool          hint_taken = false;
+  bool          hint_rejected = false;
+  
+  m_linkmasta->open();
+  try
+  {
+    // Catalog sizes are matched on the header alone, so a hack or translation
+    // that kept the original header may run past the size given. Only take
+    // the hint if what follows it is blank.
+    if (hint != 0)
+    {
+      if (is_block_blank(chip_i, hint))
+      {
+        extent = hint;
+        hint_taken = true;
+      }
+      else
+      {
+        std::ostringstream message;
+        message << "Found data past the 0x" << std::hex << hint << " bytes expected for this game, looking for its end";
+        log(log_level::INFO, message.str().c_str());
+        hint_rejected = true;
+      }
+    }
+    
+    while (!hint_taken && extent > MIN_GAME_SIZE)
+    {
+      unsigned int half = extent / 2;
+      unsigned int end = (extent < num_bytes ? extent : num_bytes);
+      bool         blank = true;
+      
+      // Sample the upper half until something turns up in it
+      unsigned int curr_chip = chip_i;
+      unsigned int chip_offset = 0;
+      for (unsigned int offset = half; offset < end && blank; offset += EXTENT_SAMPLE_STRIDE)
+      {
+        while (offset - chip_offset >= descriptor()->chips[curr_chip]->num_bytes)
+        {
+          chip_offset += descriptor()->chips[curr_chip]->num_bytes;
+          curr_chip++;
+        }
+        
+        if (m_chips[curr_chip]->read_bytes(offset - chip_offset, sample, EXTENT_SAMPLE_SIZE) != EXTENT_SAMPLE_SIZE)
+        {
+          throw std::runtime_error("Short read from cartridge");
+        }
+        blank = is_blank(sample, EXTENT_SAMPLE_SIZE);
+        
+        // Also check the end of the stride, where data that stops just short
+        // of the next sample would otherwise go unnoticed
+        unsigned int last = offset + EXTENT_SAMPLE_STRIDE;
+        last = (last < end ? last : end) - EXTENT_SAMPLE_SIZE;
+        if (blank && last > offset)
+        {
+          if (m_chips[curr_chip]->read_bytes(last - chip_offset, sample, EXTENT_SAMPLE_SIZE) != EXTENT_SAMPLE_SIZE)
+          {
+            throw std::runtime_error("Short read from cartridge");
+          }
+          blank = is_blank(sample, EXTENT_SAMPLE_SIZE);
+        }
+      }
+      
+      if (!blank)
+      {
+        break;
+      }
+      extent = half;
+    }
+    
+    // Samples can still miss data between them, so read the block right after
+    // the cut in full before trusting it. Better to dump padding than to lose
+    // part of a game. A cut at or below a rejected hint is known to be wrong.
+    if (!hint_taken && extent < num_bytes
+        && ((hint_rejected && extent <= hint) || !is_block_blank(chip_i, extent)))
+    {
+      std::ostringstream message;
+      message << "Found data at 0x" << std::hex << (hint_rejected && extent <= hint ? hint : extent) << " that sampling missed, reading the whole slot";
+      log(log_level::INFO, message.str().c_str());
+      extent = num_bytes;
+    }
+    
+    m_linkmasta->close();
+  }
+  catch (std::exception& ex)
+  {
+    (void) ex;
+    try {
+      m_linkmasta->close();
+    } catch (std::exception& ex2) {
+      (void) ex2;
+      // Well... this is awkward
+    }
+    throw;
+  }
+  
+  if (extent < num_bytes)
+  {
+    std::ostringstream message;
+    message << "Skipping 0x" << std::hex << (num_bytes - extent) << " blank bytes after the game";
+    log(log_level::INFO, message.str().c_str());
+  }
+  return (extent < num_bytes ? extent : num_bytes);
+}
+
+bool ngp_cartridge::is_block_blank(unsigned int chip_i, unsigned int offset)
+{
+  unsigned int curr_chip = chip_i;
+  unsigned int chip_offset = 0;
+  while (offset - chip_offset >= descriptor()->chips[curr_chip]->num_bytes)
+  {
+    chip_offset += descriptor()->chips[curr_chip]->num_bytes;
+    curr_chip++;
+  }
+  
+  // Stop at the end of the chip, the block can't be any bigger anyway
+  unsigned int block_size = descriptor()->chips[curr_chip]->num_bytes - (offset - chip_offset);
+  if (block_size > DEFAULT_BLOCK_SIZE)
+  {
+    block_size = DEFAULT_BLOCK_SIZE;
+  }
+  
+  block_buffer_pool::buffer block = m_linkmasta->buffer_pool().acquire(block_size);
+  if (m_chips[curr_chip]->read_bytes(offset - chip_offset, block.data(), block_size) != block_size)
+  {
+    throw std::runtime_error("Short read from cartridge");
+  }
+  return is_blank(block.data(), block_size);
+}
+
+unsigned int ngp_cartridge::read_block(unsigned int chip_i, address_t address, unsigned char* buffer, unsigned int num_bytes, task_controller* controller)
+{
+  // Serve from the cache if we've seen this block before
+  if (m_cache != nullptr && m_cache->lookup(chip_i, address, buffer, num_bytes))
+  {
+    if (controller != nullptr)
+    {
+      controller->on_task_update(task_status::RUNNING, num_bytes);
+    }
+    return num_bytes;
+  }
+  
+  const unsigned int base_timeout = m_linkmasta->timeout();
+  unsigned int attempt = 0;
+  
+  while (true)
+  {
+    int work_before = (controller == nullptr ? 0 : controller->get_task_work_progress());
+    
+    try
+    {
+      unsigned int bytes_read;
+      
+      if (controller == nullptr)
+      {
+        bytes_read = m_chips[chip_i]->read_bytes(address, buffer, num_bytes);
+      }
+      else
+      {
+        // Create a forwarding controller to pass progress updates to
+        forwarding_task_controller fwd_controller(controller);
+        fwd_controller.scale_work_to(num_bytes);
+        bytes_read = m_chips[chip_i]->read_bytes(address, buffer, num_bytes, &fwd_controller);
+      }
+      
+      // Treat short reads the same as communication errors
+      if (bytes_read != num_bytes)
+      {
+        throw std::runtime_error("Short read from cartridge");
+      }
+      
+      if (m_cache != nullptr)
+      {
+        m_cache->store(chip_i, address, buffer, bytes_read);
+      }
+      
+      if (attempt > 0)
+      {
+        m_linkmasta->set_timeout(base_timeout);
+      }
+      return bytes_read;
+    }
+    catch (std::exception& ex)
+    {
+      // Give up if out of retries or the user wants out
+      if (attempt >= m_block_retries || (controller != nullptr && controller->is_task_cancelled()))
+      {
+        if (attempt > 0)
+        {
+          try {
+            m_linkmasta->set_timeout(base_timeout);
+          } catch (std::exception& ex2) {
+            (void) ex2;
+            // Well... this is awkward
+          }
+        }
+        throw;
+      }
+      
+      attempt++;
+      m_retries_performed++;
+      std::ostringstream message;
+      message << "Retrying read of chip " << chip_i << " at 0x" << std::hex << address << std::dec
+              << " (attempt " << attempt << " of " << m_block_retries << "): " << ex.what();
+      log(log_level::INFO, message.str().c_str());
+      
+      // Withdraw any progress reported by the failed attempt
+      if (controller != nullptr)
+      {
+        controller->on_task_update(task_status::RUNNING, work_before - controller->get_task_work_progress());
+      }
+      
+      recover_from_block_error(chip_i, attempt, base_timeout);
+    }
+  }
+}
+
+void ngp_cartridge::program_block(unsigned int chip_i, address_t block_address, address_t address, const unsigned char* buffer, unsigned int num_bytes, bool erase, task_controller* controller, const std::vector<block_segment>* written)
+{
+  // Whatever happens next, the cached copy of this block is no good anymore
+  if (m_cache != nullptr)
+  {
+    m_cache->invalidate(chip_i, block_address);
+  }
+  
+  const unsigned int base_timeout = m_linkmasta->timeout();
+  unsigned int attempt = 0;
+  
+  while (true)
+  {
+    int work_before = (controller == nullptr ? 0 : controller->get_task_work_progress());
+    
+    try
+    {
+      // Only erase again on a retry if that won't lose anything we can't put
+      // back; otherwise program over the partial attempt
+      bool restore_written = (attempt > 0 && !erase && written != nullptr && !written->empty());
+      if (erase || restore_written)
+      {
+        m_chips[chip_i]->erase_block(block_address);
+        
+        // Wait for erasure to complete
+        if (!wait_for_erase(chip_i, controller))
+        {
+          throw std::runtime_error("Timed out waiting for block to erase");
+        }
+      }
+      
+      // Put back whatever was already in the block before the erase
+      if (restore_written)
+      {
+        for (const block_segment& segment : *written)
+        {
+          m_chips[chip_i]->program_bytes(segment.address, segment.data.data(), (unsigned int) segment.data.size());
+        }
+      }
+      
+      if (controller == nullptr)
+      {
+        m_chips[chip_i]->program_bytes(address, buffer, num_bytes);
+      }
+      else
+      {
+        forwarding_task_controller fwd_controller(controller);
+        fwd_controller.scale_work_to(num_bytes);
+        m_chips[chip_i]->program_bytes(address, buffer, num_bytes, &fwd_controller);
+      }
+      
+      if (attempt > 0)
+      {
+        m_linkmasta->set_timeout(base_timeout);
+      }
+      return;
+    }
+    catch (std::exception& ex)
+    {
+      // Give up if out of retries or the user wants out
+      if (attempt >= m_block_retries || (controller != nullptr && controller->is_task_cancelled()))
+      {
+        if (attempt > 0)
+        {
+          try {
+            m_linkmasta->set_timeout(base_timeout);
+          } catch (std::exception& ex2) {
+            (void) ex2;
+            // Well... this is awkward
+          }
+        }
+        throw;
+      }
+      
+      attempt++;
+      m_retries_performed++;
+      std::ostringstream message;
+      message << "Retrying program of chip " << chip_i << " at 0x" << std::hex << address << std::dec
+              << " (attempt " << attempt << " of " << m_block_retries << "): " << ex.what();
+      log(log_level::INFO, message.str().c_str());
+      
+      // Withdraw any progress reported by the failed attempt
+      if (controller != nullptr)
+      {
+        controller->on_task_update(task_status::RUNNING, work_before - controller->get_task_work_progress());
+      }
+      
+      recover_from_block_error(chip_i, attempt, base_timeout);
+    }
+  }
+}
+
+void ngp_cartridge::verify_block(unsigned int chip_i, address_t block_address, const unsigned char* buffer, unsigned int num_bytes, task_controller* controller)
+{
+  block_buffer_pool::buffer readback = m_linkmasta->buffer_pool().acquire(num_bytes);
+  unsigned int attempt = 0;
+  
+  while (true)
+  {
+    // Read-back isn't counted towards progress, and must come from the chip
+    if (m_cache != nullptr)
+    {
+      m_cache->invalidate(chip_i, block_address);
+    }
+    read_block(chip_i, block_address, readback.data(), num_bytes, nullptr);
+    
+    unsigned int mismatch = find_mismatch(buffer, readback.data(), num_bytes);
+    if (mismatch >= num_bytes)
+    {
+      return;
+    }
+    
+    std::ostringstream message;
+    message << "Verification failed on chip " << chip_i << " at 0x" << std::hex << (block_address + mismatch)
+            << ": expected 0x" << (unsigned int) buffer[mismatch] << ", read 0x" << (unsigned int) readback.data()[mismatch] << std::dec;
+    log(log_level::INFO, message.str().c_str());
     
-    m_chips[slot]->read_bytes(0, buffer, 64);
+    // Give up if out of retries or the user wants out
+    if (attempt >= m_block_retries || (controller != nullptr && controller->is_task_cancelled()))
+    {
+      throw std::runtime_error(message.str());
+    }
+    
+    attempt++;
+    m_retries_performed++;
     
-    m_metadata[slot].read_from_data_array(buffer);
-    delete [] buffer;
+    // Reprogram only the failing block, without counting it twice
+    int work_before = (controller == nullptr ? 0 : controller->get_task_work_progress());
+    program_block(chip_i, block_address, block_address, buffer, num_bytes, true, controller);
+    if (controller != nullptr)
+    {
+      controller->on_task_update(task_status::RUNNING, work_before - controller->get_task_work_progress());
+    }
+  }
+}
+
+bool ngp_cartridge::wait_for_erase(unsigned int chip_i, task_controller* controller)
+{
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(MAX_ERASE_TIME);
+  
+  while (m_chips[chip_i]->test_erasing())
+  {
+    if (std::chrono::steady_clock::now() >= deadline)
+    {
+      return false;
+    }
+    
+    // Give UI an opportunity to update
+    if (controller != nullptr)
+    {
+      controller->on_task_update(task_status::RUNNING, 0);
+    }
+  }
+  return true;
+}
+
+void ngp_cartridge::recover_from_block_error(unsigned int chip_i, unsigned int attempt, unsigned int base_timeout)
+{
+  bool erase_stuck = false;
+  try {
+    // Give any erase in progress a chance to finish
+    erase_stuck = !wait_for_erase(chip_i, nullptr);
+  } catch (std::exception& ex) {
+    (void) ex;
+    // Well... this is awkward
+  }
+  
+  // No amount of retrying gets past a chip that never finishes erasing
+  if (erase_stuck)
+  {
+    try {
+      m_linkmasta->set_timeout(base_timeout);
+    } catch (std::exception& ex) {
+      (void) ex;
+      // Well... this is awkward
+    }
+    
+    std::ostringstream message;
+    message << "Chip " << chip_i << " is stuck erasing";
+    throw std::runtime_error(message.str());
+  }
+  
+  try {
+    // Drop and reestablish the connection to clear any stale transfers, even
+    // if a session is holding it open
+    m_linkmasta->reconnect();
+  } catch (std::exception& ex) {
+    (void) ex;
+    // Well... this is awkward
+  }
+  
+  try {
+    m_chips[chip_i]->reset();
+  } catch (std::exception& ex) {
+    (void) ex;
+    // Well... this is awkward
+  }
+  
+  // Double the timeout for each consecutive retry, within reason. A timeout of
+  // 0 means no timeout at all, so there's nothing to escalate.
+  if (base_timeout != 0)
+  {
+    unsigned long long timeout = (unsigned long long) base_timeout << (attempt < 16 ? attempt : 16);
+    if (timeout > MAX_RETRY_TIMEOUT)
+    {
+      timeout = (base_timeout > MAX_RETRY_TIMEOUT ? base_timeout : MAX_RETRY_TIMEOUT);
+    }
+    
+    try {
+      m_linkmasta->set_timeout((unsigned int) timeout);
+    } catch (std::exception& ex) {
+      (void) ex;
+      // Well... this is awkward
+    }
   }
 }
 
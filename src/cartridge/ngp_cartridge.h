@@ -14,10 +14,13 @@
 #define __NGP_CARTRIDGE_H__
 
 #include "cartridge.h"
+#include <map>
 #include <vector>
 
 class linkmasta_device;
 class ngp_chip;
+class block_cache;
+class save_manifest;
 
 /*! \class ngp_cartridge
  *  \brief Class representing a Neo Geo Pocket game cartridge.
@@ -123,16 +126,31 @@ public:
    */
   void                  backup_cartridge_game_data(std::ostream& fout, int slot = SLOT_ALL, task_controller* controller = nullptr);
   
+  /*!
+   *  \see cartridge::backup_cartridge_game_data(image_sink&, int, task_controller*)
+   */
+  void                  backup_cartridge_game_data(image_sink& sink, int slot = SLOT_ALL, task_controller* controller = nullptr);
+  
   /*!
    *  \see cartridge::restore_cartridge_game_data(std::istream& fin, task_controller* controller = nullptr)
    */
   void                  restore_cartridge_game_data(std::istream& fin, int slot = SLOT_ALL, task_controller* controller = nullptr);
   
+  /*!
+   *  \see cartridge::restore_cartridge_game_data(image_source&, int, task_controller*)
+   */
+  void                  restore_cartridge_game_data(image_source& source, int slot = SLOT_ALL, task_controller* controller = nullptr);
+  
   /*!
    *  \see cartridge::compare_cartridge_game_data(std::istream& fin, task_controller* controller = nullptr)
    */
   bool                  compare_cartridge_game_data(std::istream& fin, int slot = SLOT_ALL, task_controller* controller = nullptr);
   
+  /*!
+   *  \see cartridge::compare_cartridge_game_data(image_source&, int, task_controller*)
+   */
+  bool                  compare_cartridge_game_data(image_source& source, int slot = SLOT_ALL, task_controller* controller = nullptr);
+  
   /*!
    *  \see cartridge::backup_cartridge_save_data(std::ostream& fout, task_controller* controller = nullptr)
    */
@@ -163,6 +181,21 @@ public:
    */
   std::string           fetch_game_name(int slot);
   
+  /*!
+   *  \see cartridge::content_hashes()
+   */
+  const std::vector<content_hash>& content_hashes() const;
+  
+  /*!
+   *  \see cartridge::verify_writes()
+   */
+  bool                  verify_writes() const;
+  
+  /*!
+   *  \see cartridge::set_verify_writes(bool)
+   */
+  void                  set_verify_writes(bool verify);
+  
   /*!
    * \brief Gets the parsed metadata of the game in the given slot.
    * 
@@ -183,6 +216,121 @@ public:
    */
   const game_metadata*  get_game_metadata(int slot) const;
   
+  /*! \brief Gets the number of times a failed block will be retried before
+   *         an operation is aborted.
+   *  
+   *  Gets the number of times a single block will be retried after a transient
+   *  error (e.g. a USB timeout or a short read) before the error is passed on
+   *  to the caller.
+   *  
+   *  \see set_block_retries(unsigned int retries)
+   */
+  unsigned int          block_retries() const;
+  
+  /*! \brief Sets the number of times a failed block will be retried before
+   *         an operation is aborted.
+   *  
+   *  Sets the number of times a single block will be retried after a transient
+   *  error before the error is passed on to the caller. Before each retry the
+   *  chip is reset, the connection to the \ref linkmasta_device is reopened,
+   *  and the device timeout is doubled for the duration of the retried block.
+   *  Blocks being programmed are always erased again before being
+   *  reprogrammed. A value of 0 disables retrying entirely.
+   *  
+   *  \param [in] retries The maximum number of retries per block.
+   */
+  void                  set_block_retries(unsigned int retries);
+  
+  /*! \brief Gets the total number of block retries performed by this instance.
+   *  
+   *  Gets the total number of block retries that have been performed by this
+   *  instance since construction, across all operations. Useful for reporting
+   *  the health of the connection after long unattended runs.
+   */
+  unsigned int          num_retries_performed() const;
+  
+  /*! \brief Gets the block cache used by this instance, if any.
+   *  
+   *  \see set_cache(block_cache* cache)
+   */
+  block_cache*          cache() const;
+  
+  /*! \brief Sets the block cache to serve reads from and to fill.
+   *  
+   *  Sets a \ref block_cache that outlives this object. Blocks read from the
+   *  cartridge are stored in the cache, and subsequent backups and
+   *  verifications are served from it instead of the cartridge. Before every
+   *  operation the cache is re-checked against a small sample of the cartridge
+   *  and discarded if it no longer matches. Blocks are dropped from the cache
+   *  as they are erased or programmed.
+   *  
+   *  This object does not take ownership of the cache. Pass **nullptr** to
+   *  stop using a cache.
+   *  
+   *  \param [in] cache The cache to use, or **nullptr**.
+   */
+  void                  set_cache(block_cache* cache);
+  
+  /*! \brief Gets the manifest used to synchronize save data, if any.
+   *  
+   *  \see set_sync_manifest(save_manifest* manifest)
+   */
+  save_manifest*        sync_manifest() const;
+  
+  /*! \brief Sets the manifest to synchronize save data against.
+   *  
+   *  With a manifest set, \ref backup_cartridge_save_data() expects the stream
+   *  to be positioned at the start of the save file the manifest describes,
+   *  opened for writing without truncation. Every block is still read from
+   *  the cartridge, but only blocks that changed since the manifest was last
+   *  updated are written to the stream. If the manifest doesn't describe the
+   *  blocks being backed up, it is cleared and the whole file is written.
+   *  
+   *  \ref restore_cartridge_save_data() reads each whole block back from the
+   *  cartridge first and only erases and programs it if it differs from the
+   *  file.
+   *  
+   *  Both operations leave the manifest describing the file and the
+   *  cartridge as they are afterwards. This object does not take ownership of
+   *  the manifest. Pass **nullptr** to do full backups and restores.
+   *  
+   *  \param [in] manifest The manifest to use, or **nullptr**.
+   */
+  void                  set_sync_manifest(save_manifest* manifest);
+  
+  /*! \brief Reads the next uncached block on the cartridge into the cache.
+   *  
+   *  Intended to be called repeatedly while the device is otherwise idle in
+   *  order to speculatively fill the cache ahead of a backup or verification.
+   *  Only one block is read per call so that the caller can hand the device
+   *  over to a real operation between calls. Opens and closes the associated
+   *  \ref linkmasta_device on its own.
+   *  
+   *  \returns **true** A block was read and more may remain.
+   *  \returns **false** Every block is already cached, or there is no cache.
+   */
+  bool                  prefetch_block();
+  
+  /*! \brief Gets the game size set for a slot with
+   *         \ref set_game_size_hint(int, unsigned int), or 0 if none was set.
+   */
+  unsigned int          game_size_hint(int slot) const;
+  
+  /*! \brief Tells the cartridge how many bytes the game in a slot occupies.
+   *  
+   *  Neo Geo Pocket headers don't record the size of the game, so unless told
+   *  otherwise, \ref backup_cartridge_game_data() probes for blank space at
+   *  the end of the slot and leaves it out of the backup. Callers that know
+   *  the size of the game, e.g. from a \ref game_catalog, can provide it here
+   *  so that only the game itself is read and no probing is needed.
+   *  
+   *  \param [in] slot The slot the game is in, or \ref SLOT_ALL for a game
+   *         that spans the whole cartridge.
+   *  \param [in] num_bytes The size of the game in bytes, or 0 to forget a
+   *         previously set size.
+   */
+  void                  set_game_size_hint(int slot, unsigned int num_bytes);
+  
   
   
   /*! \brief Tests the provided \ref linkmasta_device for whether or not a
@@ -208,10 +356,43 @@ public:
    */
   static bool           test_for_cartridge(linkmasta_device* linkmasta);
   
+  /*! \brief Quickly checks the provided \ref linkmasta_device for the presence
+   *         of a cartridge.
+   *  
+   *  A lightweight alternative to \ref test_for_cartridge() intended for
+   *  frequent polling. Rather than querying the chip's device and manufacturer
+   *  IDs, this function sends a single reset command and reads back a single
+   *  byte. With no cartridge present the data bus is left floating and reads
+   *  back the reset command itself, whereas a present cartridge in read mode
+   *  returns the first byte of its header (or 0xFF when blank), neither of
+   *  which can equal the reset command.
+   *  
+   *  Does not initialize the supplied \ref linkmasta_device.
+   *  
+   *  \param linkmasta The \ref linkmasta_device to use to test if a cartridge
+   *         is present.
+   *  
+   *  \returns **true** A cartridge is likely present.
+   *  \returns **false** A cartridge is likely not present.
+   */
+  static bool           probe_for_cartridge(linkmasta_device* linkmasta);
+
   
   
 protected:
   
+  /*! \brief Bytes already programmed into a block, kept so they can be
+   *         programmed again if the block has to be erased during a retry.
+   */
+  struct block_segment
+  {
+    /*! \brief The chip address the bytes were programmed at. */
+    address_t                  address;
+    
+    /*! \brief The bytes that were programmed. */
+    std::vector<unsigned char> data;
+  };
+  
   /*! \brief Constructs a \ref cartridge_descriptor struct using information
    *         gathered from the associated \ref linkmasta_device.
    *  
@@ -306,6 +487,144 @@ protected:
    */
   void                  build_game_metadata(int slot = -1);
   
+  /*! \brief Re-checks the block cache against the connected cartridge.
+   *  
+   *  Cheaply samples the first and last packet of every chip, combines them
+   *  with the chip IDs into a signature, and hands it to
+   *  \ref block_cache::validate(), discarding stale cached data. Does nothing
+   *  if no cache is set. Expects the \ref linkmasta_device to be open.
+   */
+  void                  validate_cache();
+  
+  /*! \brief Determines how many bytes of a slot hold game data.
+   *  
+   *  Uses the size set with \ref set_game_size_hint(int, unsigned int) when
+   *  there is one and the block right after it is blank. Otherwise, halves
+   *  the extent, starting from the smallest
+   *  power of two that covers the slot, for as long as the upper half is
+   *  blank. Each half is checked by sampling a packet at both ends of every
+   *  few kilobytes, which is far quicker than reading it. The block right
+   *  after the cut is then read in full, and the whole slot is kept if it
+   *  turns out not to be blank. Game sizes are powers of two, so nothing but
+   *  padding after the game is ever left out.
+   *  
+   *  Opens and closes the \ref linkmasta_device on its own.
+   *  
+   *  \param [in] slot The slot being backed up, or \ref SLOT_ALL.
+   *  \param [in] chip_i The index of the first chip in the slot.
+   *  \param [in] num_bytes The number of bytes in the slot.
+   *  
+   *  \returns The number of bytes from the start of the slot that must be
+   *           read to capture the whole game. Never more than `num_bytes`.
+   */
+  unsigned int          find_game_extent(int slot, unsigned int chip_i, unsigned int num_bytes);
+  
+  /*! \brief Checks whether the block at an offset into a slot is blank.
+   *  
+   *  Reads up to 64 KiB in full, stopping at the end of the chip. Expects the
+   *  \ref linkmasta_device to be open.
+   *  
+   *  \param [in] chip_i The index of the first chip in the slot.
+   *  \param [in] offset The offset of the block from the start of the slot.
+   */
+  bool                  is_block_blank(unsigned int chip_i, unsigned int offset);
+  
+  /*! \brief Reads a single block from the cartridge, retrying on failure.
+   *  
+   *  Reads the requested bytes from the given chip, treating any exception or
+   *  short read as a transient failure. Failed attempts are retried up to
+   *  \ref block_retries() times, recovering the chip and connection between
+   *  attempts with \ref recover_from_block_error(). Any progress reported by a
+   *  failed attempt is withdrawn from the controller before retrying.
+   *  
+   *  If a cache is set, the block is served from it when available and stored
+   *  in it after being read from the cartridge.
+   *  
+   *  \param [in] chip_i The index of the chip to read from.
+   *  \param [in] address The chip address to start reading from.
+   *  \param [out] buffer The buffer to write the data to.
+   *  \param [in] num_bytes The number of bytes to read.
+   *  \param [in,out] controller Optional controller to forward progress to.
+   *  
+   *  \returns The number of bytes read. Will always equal \ref num_bytes.
+   */
+  unsigned int          read_block(unsigned int chip_i, address_t address, unsigned char* buffer, unsigned int num_bytes, task_controller* controller);
+  
+  /*! \brief Erases and programs a single block on the cartridge, retrying on
+   *         failure.
+   *  
+   *  Optionally erases the block at the given base address, then programs the
+   *  provided bytes. If any step fails, the chip and connection are recovered
+   *  with \ref recover_from_block_error() before trying again.
+   *  
+   *  Flash bits that were partially programmed cannot be set back to 1
+   *  without an erase, so a retry erases the block again if this call erased
+   *  it, or if `written` lists bytes programmed into the block earlier. Those
+   *  bytes are programmed again after the erase, without counting towards
+   *  progress. Otherwise the bytes are simply programmed again over the
+   *  partial attempt, leaving the rest of the block untouched.
+   *  
+   *  \param [in] chip_i The index of the chip to program.
+   *  \param [in] block_address The base address of the block to erase.
+   *  \param [in] address The chip address to start programming at.
+   *  \param [in] buffer The data to program.
+   *  \param [in] num_bytes The number of bytes to program.
+   *  \param [in] erase Whether to erase the block before the first attempt.
+   *  \param [in,out] controller Optional controller to forward progress to.
+   *  \param [in] written Optional list of the bytes programmed into the block
+   *         since it was last erased, to restore if it has to be erased again.
+   */
+  void                  program_block(unsigned int chip_i, address_t block_address, address_t address, const unsigned char* buffer, unsigned int num_bytes, bool erase, task_controller* controller, const std::vector<block_segment>* written = nullptr);
+  
+  /*! \brief Reads back a freshly programmed block and reprograms it until it
+   *         matches.
+   *  
+   *  Compares the block to the data that was just programmed. On a mismatch,
+   *  logs the first differing address, then erases and reprograms the block
+   *  with \ref program_block() and checks it again, up to
+   *  \ref block_retries() times. Progress reported while reprogramming is
+   *  withdrawn so the operation's total stays accurate.
+   *  
+   *  \param [in] chip_i The index of the chip the block is on.
+   *  \param [in] block_address The base address of the block.
+   *  \param [in] buffer The data that was programmed.
+   *  \param [in] num_bytes The number of bytes that were programmed.
+   *  \param [in,out] controller Optional controller to forward progress to.
+   *  
+   *  \throws std::runtime_error The block still doesn't match after all
+   *           retries.
+   */
+  void                  verify_block(unsigned int chip_i, address_t block_address, const unsigned char* buffer, unsigned int num_bytes, task_controller* controller);
+  
+  /*! \brief Attempts to bring the chip and linkmasta back into a known state
+   *         after a failed block operation.
+   *  
+   *  Waits for any pending erase to settle, reopens the connection to the
+   *  \ref linkmasta_device, resets the chip, and escalates the device timeout
+   *  based on the attempt number. Errors encountered here are swallowed; the
+   *  subsequent retry will surface them if the device is truly unavailable.
+   *  
+   *  \param [in] chip_i The index of the chip to recover.
+   *  \param [in] attempt The number of the upcoming retry, starting at 1.
+   *  \param [in] base_timeout The device timeout in use before any retries.
+   *  
+   *  \throws std::runtime_error If the chip is still erasing after
+   *          \ref wait_for_erase() gives up. The device timeout is restored to
+   *          `base_timeout` first.
+   */
+  void                  recover_from_block_error(unsigned int chip_i, unsigned int attempt, unsigned int base_timeout);
+  
+  /*! \brief Waits for an erase on a chip to complete, for up to 30 seconds.
+   *  
+   *  \param [in] chip_i The index of the chip being erased.
+   *  \param [in,out] controller Told about each poll so the UI stays
+   *         responsive. Can be nullptr.
+   *  
+   *  \returns true if the erase completed, false if the chip was still erasing
+   *           when time ran out.
+   */
+  bool                  wait_for_erase(unsigned int chip_i, task_controller* controller);
+
   
   
 private:
@@ -415,6 +734,48 @@ private:
    *  \see game_metadata
    */
   std::vector<game_metadata> m_metadata;
+  
+  /*! \brief The maximum number of times a failed block will be retried.
+   *  
+   *  \see set_block_retries(unsigned int retries)
+   */
+  unsigned int          m_block_retries;
+  
+  /*! \brief Running count of block retries performed by this instance.
+   *  
+   *  \see num_retries_performed()
+   */
+  unsigned int          m_retries_performed;
+  
+  /*! \brief Optional cache of previously read blocks. Not owned.
+   *  
+   *  \see set_cache(block_cache* cache)
+   */
+  block_cache*          m_cache;
+  
+  /*! \brief Optional manifest to synchronize save data against. Not owned.
+   *  
+   *  \see set_sync_manifest(save_manifest* manifest)
+   */
+  save_manifest*        m_sync_manifest;
+  
+  /*! \brief Content hashes recorded by the most recent full game data read.
+   *  
+   *  \see content_hashes()
+   */
+  std::vector<content_hash> m_content_hashes;
+  
+  /*! \brief Whether written game data is read back and verified.
+   *  
+   *  \see set_verify_writes(bool)
+   */
+  bool                  m_verify_writes;
+  
+  /*! \brief Known game sizes, keyed by slot.
+   *  
+   *  \see set_game_size_hint(int, unsigned int)
+   */
+  std::map<int, unsigned int> m_game_size_hints;
 };
 
 #endif /* defined(__NGP_CARTRIDGE_H__) */
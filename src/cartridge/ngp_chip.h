@@ -12,8 +12,33 @@
 #ifndef __NGP_CHIP_H__
 #define __NGP_CHIP_H__
 
-class linkmasta_device;
-class task_controller;
+#include "flash_chip_engine.h"
+
+/*! \struct ngp_chip_traits
+ *  \brief Compile-time description of the flash chips on Neo Geo Pocket
+ *         cartridges, for \ref flash_chip_engine.
+ */
+struct ngp_chip_traits
+{
+  typedef unsigned char         word_t;
+  
+  static constexpr unsigned int COMMAND_ADDRESS_1    = 0x00005555;
+  static constexpr unsigned int COMMAND_ADDRESS_2    = 0x00002AAA;
+  static constexpr unsigned int SECTOR_MASK          = 0x001FE000;
+  static constexpr unsigned int DEVICE_ID_ADDRESS    = 0x0001;
+  static constexpr unsigned int BYPASS_ID_ADDRESS    = 0x0003;
+  static constexpr bool         ALWAYS_BYPASS        = false;
+  static constexpr bool         HAS_BLOCK_PROTECTION = true;
+  static constexpr bool         EXIT_BYPASS_ON_RESET = true;
+  static constexpr bool         TOGGLE_BIT_POLLING   = false;
+  
+  /*! \brief Checks the factoryProt word against the chips known to support
+   *         unlock bypass.
+   */
+  static bool                   supports_bypass(word_t factory_prot);
+};
+
+
 
 /*! \class ngp_chip
  *  \brief Class for controlling and interacting with a flash storage chip on a
@@ -28,6 +53,9 @@ class task_controller;
  *  and stores very little information about the current state of the device
  *  that it represents.
  *  
+ *  The command logic itself lives in \ref flash_chip_engine, which this class
+ *  specializes with \ref ngp_chip_traits.
+ *  
  *  This class is *not* thread-safe. Use caution when working in a multithreaded
  *  environment.
  */
@@ -64,27 +92,11 @@ public:
   /*! \brief Type used for specifying an address on the device. */
   typedef unsigned int     address_t;
   
-  /*! \enum chip_mode
-   *  \brief Enumeration representing the assumed state of the device.
-   *  
-   *  Enumeration representing the current assumed state of the device.
+  /*! \brief Enumeration representing the assumed state of the device.
    *  
    *  \see current_mode()
    */
-  enum chip_mode
-  {
-    /*! \brief Device is in the default read mode. */
-    READ,
-    
-    /*! \brief Device is in autoselect mode, ready for metadata queries. */
-    AUTOSELECT,
-    
-    /*! \brief Device is in bypass mode, ready for swift programming. */
-    BYPASS,
-    
-    /*! \brief Device is busy erasing. */
-    ERASE
-  };
+  typedef flash_chip_mode  chip_mode;
   
   
   
@@ -523,77 +535,12 @@ public:
   
 private:
   
-  /*! \brief Send the command sequence to enter \ref chip_mode::AUTOSELECT mode
-   *         to the chip.
-   *  
-   *  Sends the \ref chip_mode::AUTOSELECT mode command sequence to the chip.
-   *  This will send reset the device if necessary.
-   *  
-   *  This function is a blocking function that can take several seconds to
-   *  complete.
-   *  
-   *  Causes the device to enter \ref chip_mode::AUTOSELECT mode.
-   *  
-   *  \see chip_mode
-   */
-  void                    enter_autoselect();
-  
-  
-  
-  /*! \brief The currently predicted mode of the chip.
-   *  
-   *  The currently predicted mode the hardware device is in. This value is
-   *  to track the state of the chip and must be actively maintained when
-   *  passing commands that could alter the state of the device. This value is
-   *  initialized to \ref chip_mode::READ.
-   *  
-   *  \see chip_mode
-   */
-  chip_mode               m_mode;
-  
-  /*! \brief The address of the last block erased.
-   *  
-   *  The last address passed to the \ref erase_block(address_t block_address)
-   *  function. This value is used for testing whether the chip has finished
-   *  erasing or not.
-   *  
-   *  \ref address_t
-   *  \ref erase_block(address_t block_address)
-   */
-  address_t               m_last_erased_addr;
-  
-  /*! \brief Boolean value indicating whether or not the device supports bypass
-   *         mode.
-   *  
-   *  Boolean value indicating whether or not the device supports bypass mode.
-   *  This value is set in the \ref init() and automatically detected based on
-   *  the device's manufacturer and product IDs.
-   *  
-   *  \ref init()
-   */
-  bool                    m_supports_bypass;
-  
-  /*! \brief A pointer to the \ref linkmasta_device used for communicating with
-   *         the chip.
-   *  
-   *  A constant pointer to the \ref linkmasta_device used for communicating
-   *  with the chip. The pointer to this device is const but the device itself
-   *  is not protected from modification. When this object is deallocated, this
-   *  pointer's target will not be deleted.
-   *  
-   *  \see linkmasta_device
-   */
-  linkmasta_device* const m_linkmasta;
-  
-  /*! \brief The index number of the chip on the cartridge.
-   *  
-   *  The index number of this device on the cartridge. Used for specifying the
-   *  hardware device to communicated with through the assigned \ref m_linkmasta
-   *  device.
+  /*! \brief The command logic doing the actual work, specialized for this
+   *         kind of chip.
    *  
-   *  \see chip_index_t
+   *  \see ngp_chip_traits
    */
-  chip_index_t const      m_chip_num;
+  flash_chip_engine<ngp_chip_traits> m_engine;
 };
 
 #endif /* defined(__NGP_CHIP_H__) */
@@ -0,0 +1,268 @@
+/*! \file
+ *  \brief File containing the implementation of \ref save_manifest.
+ *  
+ *  File containing the implementation of \ref save_manifest.
+ *  
+ *  \see save_manifest
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-18
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#include "save_manifest.h"
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#define MANIFEST_EXTENSION ".manifest"
+#define MANIFEST_MAGIC     "ngf-manifest"
+#define MANIFEST_VERSION   2
+#define FILE_CHUNK_SIZE    0x10000
+
+/*! \brief Checks whether two hashes describe the same content. */
+static bool same_hash(const content_hash& a, const content_hash& b)
+{
+  return a.num_bytes == b.num_bytes
+         && a.crc32 == b.crc32
+         && memcmp(a.sha1_digest, b.sha1_digest, sha1::DIGEST_SIZE) == 0;
+}
+
+/*! \brief Writes a SHA-1 digest as hexadecimal. */
+static void write_digest(std::ostream& out, const unsigned char* digest)
+{
+  for (unsigned int i = 0; i < sha1::DIGEST_SIZE; ++i)
+  {
+    out << std::hex << std::setfill('0') << std::setw(2) << (unsigned int) digest[i];
+  }
+}
+
+/*! \brief Reads a SHA-1 digest written by \ref write_digest(). */
+static bool read_digest(const std::string& text, unsigned char* digest)
+{
+  if (text.size() != sha1::DIGEST_SIZE * 2)
+  {
+    return false;
+  }
+  for (unsigned int i = 0; i < sha1::DIGEST_SIZE; ++i)
+  {
+    digest[i] = (unsigned char) std::stoul(text.substr(i * 2, 2), nullptr, 16);
+  }
+  return true;
+}
+
+/*! \brief Hashes a whole file the same way \ref save_manifest::hash() hashes
+ *         a block.
+ */
+static bool hash_file(const std::string& filename, content_hash& result)
+{
+  std::ifstream fin(filename.c_str(), std::ios::binary);
+  if (!fin.is_open())
+  {
+    return false;
+  }
+  
+  crc32 crc;
+  sha1  sha;
+  std::vector<unsigned char> chunk(FILE_CHUNK_SIZE);
+  result.num_bytes = 0;
+  while (fin)
+  {
+    fin.read((char*) chunk.data(), chunk.size());
+    unsigned int count = (unsigned int) fin.gcount();
+    crc.update(chunk.data(), count);
+    sha.update(chunk.data(), count);
+    result.num_bytes += count;
+  }
+  if (fin.bad())
+  {
+    return false;
+  }
+  
+  result.crc32 = crc.value();
+  sha.digest(result.sha1_digest);
+  return true;
+}
+
+
+
+save_manifest::save_manifest()
+  : m_file_size(0), m_file_hash(), m_blocks()
+{
+  // Nothing else to do
+}
+
+
+
+std::string save_manifest::filename_for(const std::string& save_filename)
+{
+  return save_filename + MANIFEST_EXTENSION;
+}
+
+content_hash save_manifest::hash(const unsigned char* data, unsigned int num_bytes)
+{
+  content_hash result;
+  crc32        crc;
+  sha1         sha;
+  
+  crc.update(data, num_bytes);
+  sha.update(data, num_bytes);
+  
+  result.num_bytes = num_bytes;
+  result.crc32 = crc.value();
+  sha.digest(result.sha1_digest);
+  return result;
+}
+
+
+
+bool save_manifest::load(const std::string& filename)
+{
+  clear();
+  
+  std::ifstream fin(filename.c_str());
+  if (!fin.is_open())
+  {
+    return false;
+  }
+  
+  // Header line names the format and version, the next ones the size and
+  // hash of the whole file
+  std::string  magic;
+  unsigned int version;
+  std::string  size_label;
+  unsigned int file_size;
+  std::string  hash_label;
+  content_hash file_hash;
+  std::string  file_digest;
+  fin >> magic >> version >> size_label >> std::hex >> file_size
+      >> hash_label >> file_hash.crc32 >> file_digest;
+  if (fin.fail() || magic != MANIFEST_MAGIC || version != MANIFEST_VERSION
+      || size_label != "file_size" || hash_label != "file_hash"
+      || !read_digest(file_digest, file_hash.sha1_digest))
+  {
+    return false;
+  }
+  file_hash.num_bytes = file_size;
+  
+  // Then one line per block: address, size, CRC-32 and SHA-1
+  std::string line;
+  std::getline(fin, line);
+  while (std::getline(fin, line))
+  {
+    if (line.empty()) continue;
+    
+    std::istringstream in(line);
+    uint32_t     address;
+    content_hash entry;
+    std::string  digest;
+    in >> std::hex >> address >> entry.num_bytes >> entry.crc32 >> digest;
+    if (in.fail() || !read_digest(digest, entry.sha1_digest))
+    {
+      clear();
+      return false;
+    }
+    m_blocks[address] = entry;
+  }
+  
+  m_file_size = file_size;
+  m_file_hash = file_hash;
+  return true;
+}
+
+void save_manifest::save(const std::string& filename) const
+{
+  std::ofstream fout(filename.c_str(), std::ios::trunc);
+  if (!fout.is_open())
+  {
+    throw std::runtime_error("Unable to write manifest");
+  }
+  
+  fout << MANIFEST_MAGIC << " " << MANIFEST_VERSION << "\n";
+  fout << "file_size " << std::hex << m_file_size << "\n";
+  fout << "file_hash " << std::setfill('0') << std::setw(8) << m_file_hash.crc32 << " ";
+  write_digest(fout, m_file_hash.sha1_digest);
+  fout << "\n";
+  for (auto it = m_blocks.begin(); it != m_blocks.end(); ++it)
+  {
+    fout << std::setfill('0') << std::setw(8) << it->first << " "
+         << std::setw(0) << it->second.num_bytes << " "
+         << std::setw(8) << it->second.crc32 << " ";
+    write_digest(fout, it->second.sha1_digest);
+    fout << "\n";
+  }
+  
+  fout.flush();
+  if (!fout.good())
+  {
+    throw std::runtime_error("Unable to write manifest");
+  }
+}
+
+void save_manifest::clear()
+{
+  m_file_size = 0;
+  m_file_hash = content_hash();
+  m_blocks.clear();
+}
+
+void save_manifest::record_file(const std::string& save_filename)
+{
+  content_hash file_hash;
+  if (!hash_file(save_filename, file_hash))
+  {
+    throw std::runtime_error("Unable to read save file");
+  }
+  
+  m_file_size = file_hash.num_bytes;
+  m_file_hash = file_hash;
+}
+
+bool save_manifest::describes_file(const std::string& save_filename) const
+{
+  // Nothing recorded, nothing to describe
+  if (m_file_hash.num_bytes == 0 || m_file_hash.num_bytes != m_file_size)
+  {
+    return false;
+  }
+  
+  content_hash file_hash;
+  return hash_file(save_filename, file_hash) && same_hash(file_hash, m_file_hash);
+}
+
+
+
+unsigned int save_manifest::file_size() const
+{
+  return m_file_size;
+}
+
+void save_manifest::set_file_size(unsigned int num_bytes)
+{
+  m_file_size = num_bytes;
+}
+
+unsigned int save_manifest::num_blocks() const
+{
+  return (unsigned int) m_blocks.size();
+}
+
+bool save_manifest::contains(uint32_t address, unsigned int num_bytes) const
+{
+  auto it = m_blocks.find(address);
+  return it != m_blocks.end() && it->second.num_bytes == num_bytes;
+}
+
+bool save_manifest::matches(uint32_t address, const content_hash& hash) const
+{
+  auto it = m_blocks.find(address);
+  return it != m_blocks.end() && same_hash(it->second, hash);
+}
+
+void save_manifest::update(uint32_t address, const content_hash& hash)
+{
+  m_blocks[address] = hash;
+}
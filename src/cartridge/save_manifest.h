@@ -0,0 +1,136 @@
+/*! \file
+ *  \brief File containing the declaration of the \ref save_manifest class.
+ *  
+ *  File containing the header information and declaration of the
+ *  \ref save_manifest class.
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-18
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#ifndef __SAVE_MANIFEST_H__
+#define __SAVE_MANIFEST_H__
+
+#include "content_hash.h"
+#include <cstdint>
+#include <map>
+#include <string>
+
+/*! \class save_manifest
+ *  \brief Record of the hash of every block in a save file as of the last
+ *         time it was synchronized with a cartridge.
+ *  
+ *  Kept in a small text file next to the save file it describes. Blocks are
+ *  keyed by the address stored in the save file's block headers. After a
+ *  sync, both the save file and the cartridge hold exactly the content
+ *  described here, so the next sync only needs to touch blocks whose content
+ *  no longer matches.
+ *  
+ *  A manifest only describes the exact save file it was recorded for with
+ *  \ref record_file(const std::string&). If anything else has written to the
+ *  file since, its blocks can no longer be trusted to hold what the manifest
+ *  says, so callers should \ref clear() the manifest unless
+ *  \ref describes_file(const std::string&) const holds.
+ */
+class save_manifest
+{
+public:
+  
+  /*! \brief Constructs an empty manifest. */
+                        save_manifest();
+  
+  
+  
+  /*! \brief Gets the name of the manifest file kept for a save file. */
+  static std::string    filename_for(const std::string& save_filename);
+  
+  /*! \brief Computes the hash of a block as stored in a manifest. */
+  static content_hash   hash(const unsigned char* data, unsigned int num_bytes);
+  
+  
+  
+  /*! \brief Reads a manifest from a file, replacing the current contents.
+   *  
+   *  \param [in] filename The path of the file to read.
+   *  
+   *  \returns **true** The manifest was read.
+   *  \returns **false** The file doesn't exist or isn't a manifest. The
+   *           manifest is left empty.
+   */
+  bool                  load(const std::string& filename);
+  
+  /*! \brief Writes the manifest to a file, replacing its previous contents.
+   *  
+   *  \param [in] filename The path of the file to write.
+   *  
+   *  \throws std::runtime_error If the file could not be written.
+   */
+  void                  save(const std::string& filename) const;
+  
+  /*! \brief Forgets all blocks and everything recorded about the file. */
+  void                  clear();
+  
+  /*! \brief Records the size and content of a save file as it is on disk.
+   *  
+   *  Call once the file has been synced and closed, before saving the
+   *  manifest.
+   *  
+   *  \param [in] save_filename The path of the save file.
+   *  
+   *  \throws std::runtime_error If the file could not be read.
+   */
+  void                  record_file(const std::string& save_filename);
+  
+  /*! \brief Checks whether a save file on disk is still exactly the one
+   *         recorded with \ref record_file(const std::string&).
+   *  
+   *  Compares both the size and a hash of the whole file, so a file rewritten
+   *  by something else, such as an emulator, is caught even if its size
+   *  didn't change.
+   *  
+   *  \param [in] save_filename The path of the save file.
+   */
+  bool                  describes_file(const std::string& save_filename) const;
+  
+  
+  
+  /*! \brief Gets the size of the save file the manifest describes, or 0 if
+   *         it describes none.
+   */
+  unsigned int          file_size() const;
+  
+  /*! \brief Sets the size of the save file the manifest describes. */
+  void                  set_file_size(unsigned int num_bytes);
+  
+  /*! \brief Gets the number of blocks in the manifest. */
+  unsigned int          num_blocks() const;
+  
+  /*! \brief Checks whether the manifest has a block of the given size at the
+   *         given address.
+   */
+  bool                  contains(uint32_t address, unsigned int num_bytes) const;
+  
+  /*! \brief Checks whether the manifest records exactly the given content for
+   *         the block at the given address.
+   */
+  bool                  matches(uint32_t address, const content_hash& hash) const;
+  
+  /*! \brief Records new content for the block at the given address. */
+  void                  update(uint32_t address, const content_hash& hash);
+
+private:
+  
+  /*! \brief Size of the described save file in bytes. */
+  unsigned int          m_file_size;
+  
+  /*! \brief Hash of the whole save file as last recorded. Covers 0 bytes if
+   *         none was.
+   */
+  content_hash          m_file_hash;
+  
+  /*! \brief Hash of each block, keyed by address. */
+  std::map<uint32_t, content_hash> m_blocks;
+};
+
+#endif /* defined(__SAVE_MANIFEST_H__) */
@@ -19,9 +19,15 @@
 #include "ws_sram_chip.h"
 #include "task/task_controller.h"
 #include "task/forwarding_task_controller.h"
+#include "common/log.h"
+#include "common/byte_kernels.h"
+#include "common/image_source.h"
+#include "common/image_sink.h"
 #include <fstream>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <chrono>
 
 //#ifdef VERBOSE
 #include <iostream>
@@ -31,12 +37,20 @@ using namespace std;
 
 #define DEFAULT_BLOCK_SIZE 0x20000
 #define DEFAULT_SRAM_SIZE  0x400000
+#define DEFAULT_BLOCK_RETRIES 3
+#define MAX_RETRY_TIMEOUT  30000
+#define MAX_ERASE_TIME     30000
+#define MIN_GAME_SIZE      0x80000
+#define EXTENT_SAMPLE_SIZE 64
+#define EXTENT_SAMPLE_STRIDE 0x1000
 
 
 
 ws_cartridge::ws_cartridge(linkmasta_device* linkmasta)
   : m_was_init(false), m_linkmasta(linkmasta), m_descriptor(nullptr),
-    m_rom_chip(new ws_rom_chip(m_linkmasta)), m_sram_chip(new ws_sram_chip(m_linkmasta))
+    m_rom_chip(new ws_rom_chip(m_linkmasta)), m_sram_chip(new ws_sram_chip(m_linkmasta)),
+    m_block_retries(DEFAULT_BLOCK_RETRIES), m_retries_performed(0),
+    m_verify_writes(false)
 {
   // Nothing else to do
 }
@@ -103,6 +117,12 @@ void ws_cartridge::init()
 }
 
 void ws_cartridge::backup_cartridge_game_data(std::ostream& fout, int slot, task_controller* controller)
+{
+  stream_image_sink sink(fout);
+  backup_cartridge_game_data(sink, slot, controller);
+}
+
+void ws_cartridge::backup_cartridge_game_data(image_sink& sink, int slot, task_controller* controller)
 {
   // Wonderswan games are stored in the upper addresses of a chip. That means
   // game metadata is stored at the very top (highest addresses) and the rest
@@ -118,6 +138,12 @@ void ws_cartridge::backup_cartridge_game_data(std::ostream& fout, int slot, task
     throw std::runtime_error("Cartridge not initialized");
   }
   
+  // A cartridge with a single slot holds a single game, so treat it as such
+  if (slot == SLOT_ALL && num_slots() == 1)
+  {
+    slot = 0;
+  }
+  
   m_linkmasta->open();
   
   // Validate arguments
@@ -146,37 +172,7 @@ void ws_cartridge::backup_cartridge_game_data(std::ostream& fout, int slot, task
   }
   else
   {
-    const game_metadata* metadata = get_game_metadata(slot);
-    switch (metadata->rom_size)
-    {
-      case 0x0002:
-        bytes_total = 0x80000; // 4Mbit (512KB)
-        break;
-        
-      case 0x0003:
-        bytes_total = 0x100000; // 8Mbit (1MB)
-        break;
-        
-      case 0x0004:
-        bytes_total = 0x200000; // 16Mbit (2MB)
-        break;
-        
-      case 0x0006:
-        bytes_total = 0x400000; // 32Mbit (4MB)
-        break;
-        
-      case 0x0008:
-        bytes_total = 0x800000; // 64Mbit (8MB)
-        break;
-        
-      case 0x0009:
-        bytes_total = 0x1000000; // 128Mbit (16MB)
-        break;
-        
-      default:
-        bytes_total = slot_size;
-        break;
-    }
+    bytes_total = find_game_extent(slot);
   }
   
   // Initialize markers
@@ -206,10 +202,19 @@ void ws_cartridge::backup_cartridge_game_data(std::ostream& fout, int slot, task
     }
   }
   
-  // Allocate a buffer with max size of a block
+  // Borrow a buffer with max size of a block from the device's pool
   const unsigned int BUFFER_MAX_SIZE = DEFAULT_BLOCK_SIZE;
   unsigned int       buffer_size = 0;
-  unsigned char*     buffer = new unsigned char[BUFFER_MAX_SIZE];
+  block_buffer_pool::buffer buffer_handle = m_linkmasta->buffer_pool().acquire(BUFFER_MAX_SIZE);
+  unsigned char*     buffer = buffer_handle.data();
+  
+  // Hash the content as it goes by
+  content_hasher     hasher;
+  m_content_hashes.clear();
+  
+  // The header checksum is the sum of every byte but the checksum itself
+  uint32_t           checksum = 0;
+  const unsigned int checksum_bytes = (bytes_total >= 2 ? bytes_total - 2 : 0);
   
   // Inform controller that task is starting
   if (controller != nullptr)
@@ -220,6 +225,8 @@ void ws_cartridge::backup_cartridge_game_data(std::ostream& fout, int slot, task
   // Begin writing data block-by-block
   try
   {
+    sink.begin(bytes_total);
+    
     // Open connection to NGP chip
     m_linkmasta->open();
     
@@ -253,27 +260,9 @@ void ws_cartridge::backup_cartridge_game_data(std::ostream& fout, int slot, task
         bytes_expected = BUFFER_MAX_SIZE;
       }
       
-      // Attempt to read bytes from cartridge
-      if (controller == nullptr)
-      {
-        buffer_size = m_rom_chip->read_bytes(curr_offset, buffer, bytes_expected);
-      }
-      else
-      {
-        // Create a forwarding controller to pass progress updates to
-        forwarding_task_controller fwd_controller(controller);
-        fwd_controller.scale_work_to(bytes_expected);
-        try
-        {
-          buffer_size = m_rom_chip->read_bytes(curr_offset, buffer, bytes_expected, &fwd_controller);
-        }
-        catch (std::exception& ex)
-        {
-          (void) ex;
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-          throw;
-        }
-      }
+      // Attempt to read bytes from cartridge, straight into the image if possible
+      unsigned char* data = sink.acquire(bytes_written, bytes_expected, buffer);
+      buffer_size = read_block(false, curr_offset, data, bytes_expected, controller);
       
       // Check for errors
       if (buffer_size != bytes_expected)
@@ -284,17 +273,14 @@ void ws_cartridge::backup_cartridge_game_data(std::ostream& fout, int slot, task
         }
         throw std::runtime_error("ERROR");
       }
-      if (!fout.good())
-      {
-        if (controller != nullptr)
-        {
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-        }
-        throw std::runtime_error("ERROR");
-      }
       
       // Write buffer to file
-      fout.write((char*) buffer, buffer_size);
+      sink.commit(bytes_written, data, buffer_size);
+      hasher.update(data, buffer_size);
+      if (bytes_written < checksum_bytes)
+      {
+        checksum += byte_sum(data, std::min(buffer_size, checksum_bytes - bytes_written));
+      }
       
       // Update markers
       bytes_written += buffer_size;
@@ -323,6 +309,7 @@ void ws_cartridge::backup_cartridge_game_data(std::ostream& fout, int slot, task
     
     // Clean up before returning
     m_linkmasta->close();
+    sink.end(bytes_written);
   }
   catch (std::exception& ex)
   {
@@ -351,12 +338,19 @@ void ws_cartridge::backup_cartridge_game_data(std::ostream& fout, int slot, task
       // Well... this is awkward
     }
     
+    try {
+      // Keep whatever was read before things went wrong
+      sink.end(bytes_written);
+    } catch (std::exception& ex2) {
+      (void) ex2;
+      // Well... this is awkward
+    }
+    
     // Inform controller of task end
     if (controller != nullptr)
     {
       controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
     }
-    delete [] buffer;
     throw;
   }
   
@@ -365,10 +359,31 @@ void ws_cartridge::backup_cartridge_game_data(std::ostream& fout, int slot, task
   {
     controller->on_task_end(controller->is_task_cancelled() && bytes_written < bytes_total ? task_status::CANCELLED : task_status::COMPLETED, bytes_written);
   }
-  delete [] buffer;
+  
+  // Only keep hashes of complete reads
+  if (bytes_written == bytes_total)
+  {
+    hasher.finish();
+    m_content_hashes = hasher.hashes();
+    
+    // Only single games carry a checksum over exactly what we read
+    if (slot != SLOT_ALL && (uint16_t) checksum != get_game_metadata(slot)->checksum)
+    {
+      std::ostringstream message;
+      message << "Header checksum 0x" << std::hex << get_game_metadata(slot)->checksum
+              << " does not match calculated checksum 0x" << (uint16_t) checksum;
+      log(log_level::INFO, message.str().c_str());
+    }
+  }
 }
 
 void ws_cartridge::restore_cartridge_game_data(std::istream& fin, int slot, task_controller* controller)
+{
+  stream_image_source source(fin);
+  restore_cartridge_game_data(source, slot, controller);
+}
+
+void ws_cartridge::restore_cartridge_game_data(image_source& source, int slot, task_controller* controller)
 {
   // Due to how WonderSwan games are read and stored on a cart, the game's meta
   // data is stored in the upper addresses. Because of how cartridges are made,
@@ -387,6 +402,12 @@ void ws_cartridge::restore_cartridge_game_data(std::istream& fin, int slot, task
     throw std::runtime_error("Cartridge not initialized");
   }
   
+  // A cartridge with a single slot holds a single game, so treat it as such
+  if (slot == SLOT_ALL && num_slots() == 1)
+  {
+    slot = 0;
+  }
+  
   m_linkmasta->open();
   
   // Validate arguments
@@ -396,10 +417,8 @@ void ws_cartridge::restore_cartridge_game_data(std::istream& fin, int slot, task
   }
   
   // Determine the total number of bytes to write
-  fin.seekg(0, fin.end);
   unsigned int bytes_written = 0;
-  unsigned int bytes_total = (unsigned int) fin.tellg();
-  fin.seekg(0, fin.beg);
+  unsigned int bytes_total = source.size();
   
   // Ensure file will fit
   unsigned int curr_slot = (slot == SLOT_ALL ? 0 : (unsigned int) slot);
@@ -439,10 +458,11 @@ void ws_cartridge::restore_cartridge_game_data(std::istream& fin, int slot, task
     }
   }
   
-  // Allocate a buffer with max size of a block
+  // Borrow a buffer with max size of a block from the device's pool
   const unsigned int BUFFER_MAX_SIZE = DEFAULT_BLOCK_SIZE;
   unsigned int       buffer_size = 0;
-  unsigned char*     buffer = new unsigned char[BUFFER_MAX_SIZE];
+  block_buffer_pool::buffer buffer_handle = m_linkmasta->buffer_pool().acquire(BUFFER_MAX_SIZE);
+  unsigned char*     buffer = buffer_handle.data();
   
   // Inform controller that task is starting
   if (controller != nullptr)
@@ -483,60 +503,17 @@ void ws_cartridge::restore_cartridge_game_data(std::istream& fin, int slot, task
         bytes_expected = slot_size - curr_offset;
       }
       
-      // Attempt to read bytes from file
-      fin.read((char*) buffer, bytes_expected);
-      buffer_size = ((unsigned int) fin.tellg()) - bytes_written;
-      
-      // Check for errors
-      if (buffer_size != bytes_expected)
-      {
-        if (controller != nullptr)
-        {
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-        }
-        throw std::runtime_error("ERROR");
-      }
-      if (!fin.good() && (buffer_size + bytes_written) < bytes_total)
-      {
-        if (controller != nullptr)
-        {
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-        }
-        throw std::runtime_error("ERROR");
-      }
-      
-      // Erase block from cartridge
-      m_rom_chip->erase_block(block->base_address);
+      // Get bytes from file, directly from the image if possible
+      const unsigned char* data = source.view(bytes_written, bytes_expected, buffer);
+      buffer_size = bytes_expected;
       
-      // Wait for erasure to complete
-      while (m_rom_chip->test_erasing())
-      {
-        // Give UI an opportunity to update
-        if (controller != nullptr)
-        {
-          controller->on_task_update(task_status::RUNNING, 0);
-        }
-      }
+      // Erase block and write buffer to cartridge
+      program_block(false, block->base_address, curr_offset, data, buffer_size, true, controller);
       
-      // Write buffer to cartridge
-      if (controller == nullptr)
+      // Read the block back while its contents are still in memory
+      if (m_verify_writes)
       {
-        m_rom_chip->program_bytes(curr_offset, buffer, buffer_size);
-      }
-      else
-      {
-        forwarding_task_controller fwd_controller(controller);
-        fwd_controller.scale_work_to(buffer_size);
-        try
-        {
-          m_rom_chip->program_bytes(curr_offset, buffer, buffer_size, &fwd_controller);
-        }
-        catch (std::exception& ex)
-        {
-          (void) ex;
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-          throw;
-        }
+        verify_block(block->base_address, curr_offset, data, buffer_size, controller);
       }
       
       // Update markers
@@ -599,7 +576,6 @@ void ws_cartridge::restore_cartridge_game_data(std::istream& fin, int slot, task
       std::cout << controller->get_task_work_progress() << std::endl;
       controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
     }
-    delete [] buffer;
     throw;
   }
   
@@ -608,10 +584,115 @@ void ws_cartridge::restore_cartridge_game_data(std::istream& fin, int slot, task
   {
     controller->on_task_end(controller->is_task_cancelled() && bytes_written < bytes_total ? task_status::CANCELLED : task_status::COMPLETED, bytes_written);
   }
-  delete [] buffer;
+}
+
+void ws_cartridge::restore_cartridge_slots(const std::vector<slot_image>& images, task_controller* controller)
+{
+  if (!m_was_init)
+  {
+    throw std::runtime_error("Cartridge not initialized");
+  }
+  
+  // Check every image before touching the cartridge
+  unsigned int bytes_total = 0;
+  for (const slot_image& image : images)
+  {
+    if (image.slot < 0 || image.slot >= (int) m_slots.size())
+    {
+      throw std::invalid_argument("invalid slot number: " + std::to_string(image.slot));
+    }
+    if (image.source->size() > slot_size(image.slot))
+    {
+      throw std::runtime_error("File too large for slot " + std::to_string(image.slot));
+    }
+    bytes_total += image.source->size();
+  }
+  
+  std::vector<slot_image> plan = plan_slot_images(images, (int) m_rom_chip->selected_slot());
+  
+  // Keep the connection open from one image to the next
+  linkmasta_session session(m_linkmasta);
+  
+  if (controller != nullptr)
+  {
+    controller->on_task_start(bytes_total);
+  }
+  
+  unsigned int bytes_written = 0;
+  try
+  {
+    for (const slot_image& image : plan)
+    {
+      if (controller != nullptr && controller->is_task_cancelled())
+      {
+        break;
+      }
+      
+      if (controller == nullptr)
+      {
+        restore_cartridge_game_data(*image.source, image.slot);
+      }
+      else
+      {
+        // Report each image's progress as its share of the whole
+        forwarding_task_controller fwd_controller(controller);
+        fwd_controller.scale_work_to(image.source->size());
+        restore_cartridge_game_data(*image.source, image.slot, &fwd_controller);
+      }
+      
+      bytes_written += image.source->size();
+    }
+  }
+  catch (std::exception& ex)
+  {
+    (void) ex;
+    if (controller != nullptr)
+    {
+      controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
+    }
+    throw;
+  }
+  
+  if (controller != nullptr)
+  {
+    controller->on_task_end(controller->is_task_cancelled() && bytes_written < bytes_total ? task_status::CANCELLED : task_status::COMPLETED, bytes_written);
+  }
+}
+
+std::vector<ws_cartridge::slot_image> ws_cartridge::plan_slot_images(const std::vector<slot_image>& images, int selected_slot)
+{
+  std::vector<slot_image> plan(images);
+  
+  // Ascending order visits each slot once, and starting with the slot that's
+  // already selected saves one more switch
+  std::stable_sort(plan.begin(), plan.end(), [selected_slot](const slot_image& a, const slot_image& b)
+  {
+    if ((a.slot == selected_slot) != (b.slot == selected_slot))
+    {
+      return a.slot == selected_slot;
+    }
+    return a.slot < b.slot;
+  });
+  
+  // Writing a slot twice would only erase the first image again
+  for (unsigned int i = 1; i < plan.size(); ++i)
+  {
+    if (plan[i].slot == plan[i - 1].slot)
+    {
+      throw std::invalid_argument("slot " + std::to_string(plan[i].slot) + " given more than once");
+    }
+  }
+  
+  return plan;
 }
 
 bool ws_cartridge::compare_cartridge_game_data(std::istream& fin, int slot, task_controller* controller)
+{
+  stream_image_source source(fin);
+  return compare_cartridge_game_data(source, slot, controller);
+}
+
+bool ws_cartridge::compare_cartridge_game_data(image_source& source, int slot, task_controller* controller)
 {
   // WonderSwan games store their metadata at the top of the chip on which they
   // reside. Thus, we only compare the contents of the file with the upper-most
@@ -627,6 +708,12 @@ bool ws_cartridge::compare_cartridge_game_data(std::istream& fin, int slot, task
     throw std::runtime_error("Cartridge not initialized");
   }
   
+  // A cartridge with a single slot holds a single game, so treat it as such
+  if (slot == SLOT_ALL && num_slots() == 1)
+  {
+    slot = 0;
+  }
+  
   m_linkmasta->open();
   
   // Validate arguments
@@ -643,10 +730,8 @@ bool ws_cartridge::compare_cartridge_game_data(std::istream& fin, int slot, task
   }
   
   // determine the total number of bytes to compare
-  fin.seekg(0, fin.end);
   unsigned int bytes_compared = 0;
-  unsigned int bytes_total = (unsigned int) fin.tellg();
-  fin.seekg(0, fin.beg);
+  unsigned int bytes_total = source.size();
   
   // Ensure file will fit
   if (bytes_total > (slot == SLOT_ALL ? descriptor()->num_bytes : slot_size))
@@ -684,12 +769,18 @@ bool ws_cartridge::compare_cartridge_game_data(std::istream& fin, int slot, task
   
   m_linkmasta->close();
   
-  // Allocate a buffer with max size of a block
+  // Borrow a buffer with max size of a block from the device's pool
   const unsigned int BUFFER_MAX_SIZE = DEFAULT_BLOCK_SIZE;
   unsigned int       f_buffer_size = 0;
-  unsigned char*     f_buffer = new unsigned char[BUFFER_MAX_SIZE];
+  block_buffer_pool::buffer f_buffer_handle = m_linkmasta->buffer_pool().acquire(BUFFER_MAX_SIZE);
+  unsigned char*     f_buffer = f_buffer_handle.data();
   unsigned int       c_buffer_size = 0;
-  unsigned char*     c_buffer = new unsigned char[BUFFER_MAX_SIZE];
+  block_buffer_pool::buffer c_buffer_handle = m_linkmasta->buffer_pool().acquire(BUFFER_MAX_SIZE);
+  unsigned char*     c_buffer = c_buffer_handle.data();
+  
+  // Hash the content as it goes by
+  content_hasher     hasher;
+  m_content_hashes.clear();
   
   // Inform controller that task is starting
   if (controller != nullptr)
@@ -726,56 +817,14 @@ bool ws_cartridge::compare_cartridge_game_data(std::istream& fin, int slot, task
         bytes_expected = slot_size - curr_offset;
       }
       
-      // Attempt to read bytes from file
-      if (slot != SLOT_ALL)
-      {
-        fin.seekg(-((int) (slot_size - curr_offset)), fin.end);
-      }
-      streamoff f_start = fin.tellg();
-      fin.read((char*) f_buffer, bytes_expected);
-      streamoff f_end = fin.tellg();
-      f_buffer_size = (unsigned int) (f_end - f_start);
-      
-      // Check for errors
-      if (f_buffer_size != bytes_expected)
-      {
-        if (controller != nullptr)
-        {
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-        }
-        throw std::runtime_error("ERROR");
-      }
-      if (!fin.good() && (f_buffer_size + bytes_compared) < bytes_total)
-      {
-        if (controller != nullptr)
-        {
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-        }
-        throw std::runtime_error("ERROR");
-      }
+      // Get bytes from file, directly from the image if possible. Single slots
+      // are compared from the top down, so line the file up with the top too.
+      unsigned int f_offset = (slot == SLOT_ALL ? bytes_compared : bytes_total - (slot_size - curr_offset));
+      const unsigned char* f_data = source.view(f_offset, bytes_expected, f_buffer);
+      f_buffer_size = bytes_expected;
       
       // Attempt to read bytes from cartridge
-      if (controller == nullptr)
-      {
-        c_buffer_size = m_rom_chip->read_bytes(curr_offset, c_buffer, bytes_expected);
-      }
-      else
-      {
-        // Use a forwarding controller to pass progress updates to our controller
-        forwarding_task_controller fwd_controller(controller);
-        fwd_controller.scale_work_to(bytes_expected);
-        try
-        {
-          c_buffer_size = m_rom_chip->read_bytes(curr_offset, c_buffer, bytes_expected, &fwd_controller);
-        }
-        catch (std::exception& ex)
-        {
-          (void) ex;
-          // Inform controller of error
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-          throw;
-        }
-      }
+      c_buffer_size = read_block(false, curr_offset, c_buffer, bytes_expected, controller);
       
       // Check for errors
       if (c_buffer_size != bytes_expected)
@@ -787,14 +836,17 @@ bool ws_cartridge::compare_cartridge_game_data(std::istream& fin, int slot, task
         throw std::runtime_error("ERROR");
       }
       
+      hasher.update(c_buffer, c_buffer_size);
+      
       // Compare contents of buffers
-      for (unsigned int i = 0; i < f_buffer_size && i < c_buffer_size; ++i)
+      unsigned int mismatch = find_mismatch(f_data, c_buffer, f_buffer_size);
+      if (mismatch < f_buffer_size)
       {
-        if (f_buffer[i] != c_buffer[i])
-        {
-          matched = false;
-          break;
-        }
+        matched = false;
+        
+        std::ostringstream message;
+        message << "Data mismatch at file offset 0x" << std::hex << (f_offset + mismatch);
+        log(log_level::INFO, message.str().c_str());
       }
       
       // Update markers
@@ -867,8 +919,6 @@ bool ws_cartridge::compare_cartridge_game_data(std::istream& fin, int slot, task
     {
       controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
     }
-    delete [] f_buffer;
-    delete [] c_buffer;
     throw;
   }
   
@@ -877,8 +927,13 @@ bool ws_cartridge::compare_cartridge_game_data(std::istream& fin, int slot, task
   {
     controller->on_task_end(controller->is_task_cancelled() && bytes_compared < bytes_total ? task_status::CANCELLED : task_status::COMPLETED, bytes_compared);
   }
-  delete [] f_buffer;
-  delete [] c_buffer;
+  
+  // Only keep hashes of complete, matching reads
+  if (matched && bytes_compared == bytes_total)
+  {
+    hasher.finish();
+    m_content_hashes = hasher.hashes();
+  }
   return matched;
 }
 
@@ -896,10 +951,11 @@ void ws_cartridge::backup_cartridge_save_data(std::ostream& fout, int slot, task
   unsigned int bytes_written = 0;
   unsigned int bytes_total = DEFAULT_SRAM_SIZE; // Always assume 4 Mib chip
   
-  // Allocate a buffer with max size of a block
+  // Borrow a buffer with max size of a block from the device's pool
   const unsigned int BUFFER_MAX_SIZE = DEFAULT_BLOCK_SIZE;
   unsigned int       buffer_size = 0;
-  unsigned char*     buffer = new unsigned char[BUFFER_MAX_SIZE];
+  block_buffer_pool::buffer buffer_handle = m_linkmasta->buffer_pool().acquire(BUFFER_MAX_SIZE);
+  unsigned char*     buffer = buffer_handle.data();
   
   // Inform controller that task is starting
   if (controller != nullptr)
@@ -927,26 +983,7 @@ void ws_cartridge::backup_cartridge_save_data(std::ostream& fout, int slot, task
       }
       
       // Attempt to read bytes from cartridge
-      if (controller == nullptr)
-      {
-        buffer_size = m_sram_chip->read_bytes(bytes_written, buffer, bytes_expected);
-      }
-      else
-      {
-        // Create a forwarding controller to pass progress updates to
-        forwarding_task_controller fwd_controller(controller);
-        fwd_controller.scale_work_to(bytes_expected);
-        try
-        {
-          buffer_size = m_sram_chip->read_bytes(bytes_written, buffer, bytes_expected, &fwd_controller);
-        }
-        catch (std::exception& ex)
-        {
-          (void) ex;
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-          throw;
-        }
-      }
+      buffer_size = read_block(true, bytes_written, buffer, bytes_expected, controller);
       
       // Check for errors
       if (buffer_size != bytes_expected)
@@ -992,7 +1029,6 @@ void ws_cartridge::backup_cartridge_save_data(std::ostream& fout, int slot, task
     {
       controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
     }
-    delete [] buffer;
     throw;
   }
   
@@ -1001,7 +1037,6 @@ void ws_cartridge::backup_cartridge_save_data(std::ostream& fout, int slot, task
   {
     controller->on_task_end(controller->is_task_cancelled() && bytes_written < bytes_total ? task_status::CANCELLED : task_status::COMPLETED, bytes_written);
   }
-  delete [] buffer;
 }
 
 void ws_cartridge::restore_cartridge_save_data(std::istream& fin, int slot, task_controller* controller)
@@ -1020,10 +1055,11 @@ void ws_cartridge::restore_cartridge_save_data(std::istream& fin, int slot, task
   unsigned int bytes_total = (unsigned int) fin.tellg();
   fin.seekg(0, fin.beg);
   
-  // Allocate a buffer with max size of a block
+  // Borrow a buffer with max size of a block from the device's pool
   const unsigned int BUFFER_MAX_SIZE = DEFAULT_BLOCK_SIZE;
   unsigned int       buffer_size = 0;
-  unsigned char*     buffer = new unsigned char[BUFFER_MAX_SIZE];
+  block_buffer_pool::buffer buffer_handle = m_linkmasta->buffer_pool().acquire(BUFFER_MAX_SIZE);
+  unsigned char*     buffer = buffer_handle.data();
   
   // Inform controller that task is starting
   if (controller != nullptr)
@@ -1073,25 +1109,7 @@ void ws_cartridge::restore_cartridge_save_data(std::istream& fin, int slot, task
       }
       
       // Write buffer to cartridge
-      if (controller == nullptr)
-      {
-        m_sram_chip->program_bytes(bytes_written, buffer, buffer_size);
-      }
-      else
-      {
-        forwarding_task_controller fwd_controller(controller);
-        fwd_controller.scale_work_to(buffer_size);
-        try
-        {
-          m_sram_chip->program_bytes(bytes_written, buffer, buffer_size, &fwd_controller);
-        }
-        catch (std::exception& ex)
-        {
-          (void) ex;
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-          throw;
-        }
-      }
+      program_block(true, 0, bytes_written, buffer, buffer_size, false, controller);
       
       // Update markers
       bytes_written += buffer_size;
@@ -1115,7 +1133,6 @@ void ws_cartridge::restore_cartridge_save_data(std::istream& fin, int slot, task
     {
       controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
     }
-    delete [] buffer;
     throw;
   }
   
@@ -1124,7 +1141,6 @@ void ws_cartridge::restore_cartridge_save_data(std::istream& fin, int slot, task
   {
     controller->on_task_end(controller->is_task_cancelled() && bytes_written < bytes_total ? task_status::CANCELLED : task_status::COMPLETED, bytes_written);
   }
-  delete [] buffer;
 }
 
 bool ws_cartridge::compare_cartridge_save_data(std::istream& fin, int slot, task_controller* controller)
@@ -1146,12 +1162,14 @@ bool ws_cartridge::compare_cartridge_save_data(std::istream& fin, int slot, task
   // Initialize markers
   bool         matched = true;
   
-  // Allocate a buffer with max size of a block
+  // Borrow a buffer with max size of a block from the device's pool
   const unsigned int BUFFER_MAX_SIZE = DEFAULT_BLOCK_SIZE;
   unsigned int       f_buffer_size = 0;
-  unsigned char*     f_buffer = new unsigned char[BUFFER_MAX_SIZE];
+  block_buffer_pool::buffer f_buffer_handle = m_linkmasta->buffer_pool().acquire(BUFFER_MAX_SIZE);
+  unsigned char*     f_buffer = f_buffer_handle.data();
   unsigned int       c_buffer_size = 0;
-  unsigned char*     c_buffer = new unsigned char[BUFFER_MAX_SIZE];
+  block_buffer_pool::buffer c_buffer_handle = m_linkmasta->buffer_pool().acquire(BUFFER_MAX_SIZE);
+  unsigned char*     c_buffer = c_buffer_handle.data();
   
   // Inform controller that task is starting
   if (controller != nullptr)
@@ -1201,27 +1219,7 @@ bool ws_cartridge::compare_cartridge_save_data(std::istream& fin, int slot, task
       }
       
       // Attempt to read bytes from cartridge
-      if (controller == nullptr)
-      {
-        c_buffer_size = m_sram_chip->read_bytes(bytes_compared, c_buffer, bytes_expected);
-      }
-      else
-      {
-        // Use a forwarding controller to pass progress updates to our controller
-        forwarding_task_controller fwd_controller(controller);
-        fwd_controller.scale_work_to(bytes_expected);
-        try
-        {
-          c_buffer_size = m_sram_chip->read_bytes(bytes_compared, c_buffer, bytes_expected, &fwd_controller);
-        }
-        catch (std::exception& ex)
-        {
-          (void) ex;
-          // Inform controller of error
-          controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
-          throw;
-        }
-      }
+      c_buffer_size = read_block(true, bytes_compared, c_buffer, bytes_expected, controller);
       
       // Check for errors
       if (c_buffer_size != bytes_expected)
@@ -1234,13 +1232,14 @@ bool ws_cartridge::compare_cartridge_save_data(std::istream& fin, int slot, task
       }
       
       // Compare contents of buffers
-      for (unsigned int i = 0; i < f_buffer_size && i < c_buffer_size; ++i)
+      unsigned int mismatch = find_mismatch(f_buffer, c_buffer, f_buffer_size);
+      if (mismatch < f_buffer_size)
       {
-        if (f_buffer[i] != c_buffer[i])
-        {
-          matched = false;
-          break;
-        }
+        matched = false;
+        
+        std::ostringstream message;
+        message << "Data mismatch at file offset 0x" << std::hex << (bytes_compared + mismatch);
+        log(log_level::INFO, message.str().c_str());
       }
       
       // Update markers
@@ -1266,8 +1265,6 @@ bool ws_cartridge::compare_cartridge_save_data(std::istream& fin, int slot, task
     {
       controller->on_task_end(task_status::ERROR, controller->get_task_work_progress());
     }
-    delete [] f_buffer;
-    delete [] c_buffer;
     throw;
   }
   
@@ -1276,8 +1273,6 @@ bool ws_cartridge::compare_cartridge_save_data(std::istream& fin, int slot, task
   {
     controller->on_task_end(controller->is_task_cancelled() && bytes_compared < bytes_total ? task_status::CANCELLED : task_status::COMPLETED, bytes_compared);
   }
-  delete [] f_buffer;
-  delete [] c_buffer;
   return matched;
 }
 
@@ -1357,6 +1352,11 @@ std::string ws_cartridge::fetch_game_name(int slot)
   return std::string(r.str());
 }
 
+const std::vector<content_hash>& ws_cartridge::content_hashes() const
+{
+  return m_content_hashes;
+}
+
 const ws_cartridge::game_metadata* ws_cartridge::get_game_metadata(int slot) const
 {
   if (slot < 0 || slot >= (int) m_metadata.size()) return nullptr;
@@ -1398,6 +1398,31 @@ unsigned int ws_cartridge::calculate_game_size(int size_code)
   }
 }
 
+unsigned int ws_cartridge::block_retries() const
+{
+  return m_block_retries;
+}
+
+void ws_cartridge::set_block_retries(unsigned int retries)
+{
+  m_block_retries = retries;
+}
+
+unsigned int ws_cartridge::num_retries_performed() const
+{
+  return m_retries_performed;
+}
+
+bool ws_cartridge::verify_writes() const
+{
+  return m_verify_writes;
+}
+
+void ws_cartridge::set_verify_writes(bool verify)
+{
+  m_verify_writes = verify;
+}
+
 
 
 void ws_cartridge::build_cartridge_destriptor()
@@ -1517,13 +1542,410 @@ void ws_cartridge::build_game_metadata(int slot)
   }
   else if (slot >= 0 && slot < (int) m_metadata.size())
   {
-    unsigned char* buffer = new unsigned char[10];
+    block_buffer_pool::buffer buffer = m_linkmasta->buffer_pool().acquire(10);
     
     m_rom_chip->select_slot(slot);
-    m_rom_chip->read_bytes(slot_size(slot) - 10, buffer, 10);
+    m_rom_chip->read_bytes(slot_size(slot) - 10, buffer.data(), 10);
+    
+    m_metadata[slot].read_from_data_array(buffer.data());
+  }
+}
+
+unsigned int ws_cartridge::find_game_extent(int slot)
+{
+  unsigned int slot_size = this->slot_size(slot);
+  
+  // The header is the quickest way to know
+  unsigned int game_size = get_game_size(slot);
+  if (game_size != 0 && game_size <= slot_size)
+  {
+    return game_size;
+  }
+  
+  // Otherwise, look for blank space below the game
+  unsigned int  extent = slot_size;
+  unsigned char sample[EXTENT_SAMPLE_SIZE];
+  
+  m_linkmasta->open();
+  try
+  {
+    if (m_rom_chip->selected_slot() != (unsigned int) slot && !m_rom_chip->select_slot(slot))
+    {
+      throw std::runtime_error("Error occured while attempting to switch slot");
+    }
     
-    m_metadata[slot].read_from_data_array(buffer);
-    delete [] buffer;
+    while (extent > MIN_GAME_SIZE)
+    {
+      unsigned int half = extent / 2;
+      bool         blank = true;
+      
+      // Sample the lower half until something turns up in it
+      for (unsigned int offset = slot_size - extent; offset < slot_size - half && blank; offset += EXTENT_SAMPLE_STRIDE)
+      {
+        if (m_rom_chip->read_bytes(offset, sample, EXTENT_SAMPLE_SIZE) != EXTENT_SAMPLE_SIZE)
+        {
+          throw std::runtime_error("Short read from cartridge");
+        }
+        blank = is_blank(sample, EXTENT_SAMPLE_SIZE);
+        
+        // Also check the end of the stride, where data that stops just short
+        // of the next sample would otherwise go unnoticed
+        unsigned int last = offset + EXTENT_SAMPLE_STRIDE;
+        last = (last < slot_size - half ? last : slot_size - half) - EXTENT_SAMPLE_SIZE;
+        if (blank && last > offset)
+        {
+          if (m_rom_chip->read_bytes(last, sample, EXTENT_SAMPLE_SIZE) != EXTENT_SAMPLE_SIZE)
+          {
+            throw std::runtime_error("Short read from cartridge");
+          }
+          blank = is_blank(sample, EXTENT_SAMPLE_SIZE);
+        }
+      }
+      
+      if (!blank)
+      {
+        break;
+      }
+      extent = half;
+    }
+    
+    // Samples can still miss data between them, so read the block right below
+    // the cut in full before trusting it. Better to dump padding than to lose
+    // part of a game.
+    if (extent < slot_size)
+    {
+      unsigned int block_size = slot_size - extent;
+      if (block_size > DEFAULT_BLOCK_SIZE)
+      {
+        block_size = DEFAULT_BLOCK_SIZE;
+      }
+      
+      block_buffer_pool::buffer block = m_linkmasta->buffer_pool().acquire(block_size);
+      if (m_rom_chip->read_bytes(slot_size - extent - block_size, block.data(), block_size) != block_size)
+      {
+        throw std::runtime_error("Short read from cartridge");
+      }
+      if (!is_blank(block.data(), block_size))
+      {
+        std::ostringstream message;
+        message << "Found data below 0x" << std::hex << (slot_size - extent) << " that sampling missed, reading the whole slot";
+        log(log_level::INFO, message.str().c_str());
+        extent = slot_size;
+      }
+    }
+    
+    m_linkmasta->close();
+  }
+  catch (std::exception& ex)
+  {
+    (void) ex;
+    try {
+      m_linkmasta->close();
+    } catch (std::exception& ex2) {
+      (void) ex2;
+      // Well... this is awkward
+    }
+    throw;
+  }
+  
+  if (extent < slot_size)
+  {
+    std::ostringstream message;
+    message << "Unrecognized ROM size, skipping 0x" << std::hex << (slot_size - extent) << " blank bytes below the game";
+    log(log_level::INFO, message.str().c_str());
+  }
+  return extent;
+}
+
+unsigned int ws_cartridge::read_block(bool sram, address_t address, unsigned char* buffer, unsigned int num_bytes, task_controller* controller)
+{
+  const unsigned int base_timeout = m_linkmasta->timeout();
+  unsigned int attempt = 0;
+  
+  while (true)
+  {
+    int work_before = (controller == nullptr ? 0 : controller->get_task_work_progress());
+    
+    try
+    {
+      unsigned int bytes_read;
+      
+      if (controller == nullptr)
+      {
+        bytes_read = (sram ? m_sram_chip->read_bytes(address, buffer, num_bytes)
+                           : m_rom_chip->read_bytes(address, buffer, num_bytes));
+      }
+      else
+      {
+        // Create a forwarding controller to pass progress updates to
+        forwarding_task_controller fwd_controller(controller);
+        fwd_controller.scale_work_to(num_bytes);
+        bytes_read = (sram ? m_sram_chip->read_bytes(address, buffer, num_bytes, &fwd_controller)
+                           : m_rom_chip->read_bytes(address, buffer, num_bytes, &fwd_controller));
+      }
+      
+      // Treat short reads the same as communication errors
+      if (bytes_read != num_bytes)
+      {
+        throw std::runtime_error("Short read from cartridge");
+      }
+      
+      if (attempt > 0)
+      {
+        m_linkmasta->set_timeout(base_timeout);
+      }
+      return bytes_read;
+    }
+    catch (std::exception& ex)
+    {
+      // Give up if out of retries or the user wants out
+      if (attempt >= m_block_retries || (controller != nullptr && controller->is_task_cancelled()))
+      {
+        if (attempt > 0)
+        {
+          try {
+            m_linkmasta->set_timeout(base_timeout);
+          } catch (std::exception& ex2) {
+            (void) ex2;
+            // Well... this is awkward
+          }
+        }
+        throw;
+      }
+      
+      attempt++;
+      m_retries_performed++;
+      std::ostringstream message;
+      message << "Retrying " << (sram ? "SRAM" : "ROM") << " read at 0x" << std::hex << address << std::dec
+              << " (attempt " << attempt << " of " << m_block_retries << "): " << ex.what();
+      log(log_level::INFO, message.str().c_str());
+      
+      // Withdraw any progress reported by the failed attempt
+      if (controller != nullptr)
+      {
+        controller->on_task_update(task_status::RUNNING, work_before - controller->get_task_work_progress());
+      }
+      
+      recover_from_block_error(attempt, base_timeout);
+    }
+  }
+}
+
+void ws_cartridge::program_block(bool sram, address_t block_address, address_t address, const unsigned char* buffer, unsigned int num_bytes, bool erase, task_controller* controller, const std::vector<block_segment>* written)
+{
+  const unsigned int base_timeout = m_linkmasta->timeout();
+  unsigned int attempt = 0;
+  
+  while (true)
+  {
+    int work_before = (controller == nullptr ? 0 : controller->get_task_work_progress());
+    
+    try
+    {
+      // Only erase again on a retry if that won't lose anything we can't put
+      // back; otherwise program over the partial attempt
+      bool restore_written = (!sram && attempt > 0 && !erase && written != nullptr && !written->empty());
+      if (!sram && (erase || restore_written))
+      {
+        m_rom_chip->erase_block(block_address);
+        
+        // Wait for erasure to complete
+        if (!wait_for_erase(controller))
+        {
+          throw std::runtime_error("Timed out waiting for block to erase");
+        }
+      }
+      
+      // Put back whatever was already in the block before the erase
+      if (restore_written)
+      {
+        for (const block_segment& segment : *written)
+        {
+          m_rom_chip->program_bytes(segment.address, segment.data.data(), (unsigned int) segment.data.size());
+        }
+      }
+      
+      if (controller == nullptr)
+      {
+        if (sram)
+        {
+          m_sram_chip->program_bytes(address, buffer, num_bytes);
+        }
+        else
+        {
+          m_rom_chip->program_bytes(address, buffer, num_bytes);
+        }
+      }
+      else
+      {
+        forwarding_task_controller fwd_controller(controller);
+        fwd_controller.scale_work_to(num_bytes);
+        if (sram)
+        {
+          m_sram_chip->program_bytes(address, buffer, num_bytes, &fwd_controller);
+        }
+        else
+        {
+          m_rom_chip->program_bytes(address, buffer, num_bytes, &fwd_controller);
+        }
+      }
+      
+      if (attempt > 0)
+      {
+        m_linkmasta->set_timeout(base_timeout);
+      }
+      return;
+    }
+    catch (std::exception& ex)
+    {
+      // Give up if out of retries or the user wants out
+      if (attempt >= m_block_retries || (controller != nullptr && controller->is_task_cancelled()))
+      {
+        if (attempt > 0)
+        {
+          try {
+            m_linkmasta->set_timeout(base_timeout);
+          } catch (std::exception& ex2) {
+            (void) ex2;
+            // Well... this is awkward
+          }
+        }
+        throw;
+      }
+      
+      attempt++;
+      m_retries_performed++;
+      std::ostringstream message;
+      message << "Retrying " << (sram ? "SRAM" : "ROM") << " program at 0x" << std::hex << address << std::dec
+              << " (attempt " << attempt << " of " << m_block_retries << "): " << ex.what();
+      log(log_level::INFO, message.str().c_str());
+      
+      // Withdraw any progress reported by the failed attempt
+      if (controller != nullptr)
+      {
+        controller->on_task_update(task_status::RUNNING, work_before - controller->get_task_work_progress());
+      }
+      
+      recover_from_block_error(attempt, base_timeout);
+    }
+  }
+}
+
+void ws_cartridge::verify_block(address_t block_address, address_t address, const unsigned char* buffer, unsigned int num_bytes, task_controller* controller)
+{
+  block_buffer_pool::buffer readback = m_linkmasta->buffer_pool().acquire(num_bytes);
+  unsigned int attempt = 0;
+  
+  while (true)
+  {
+    // Read-back isn't counted towards progress
+    read_block(false, address, readback.data(), num_bytes, nullptr);
+    
+    unsigned int mismatch = find_mismatch(buffer, readback.data(), num_bytes);
+    if (mismatch >= num_bytes)
+    {
+      return;
+    }
+    
+    std::ostringstream message;
+    message << "Verification failed at offset 0x" << std::hex << (address + mismatch)
+            << ": expected 0x" << (unsigned int) buffer[mismatch] << ", read 0x" << (unsigned int) readback.data()[mismatch] << std::dec;
+    log(log_level::INFO, message.str().c_str());
+    
+    // Give up if out of retries or the user wants out
+    if (attempt >= m_block_retries || (controller != nullptr && controller->is_task_cancelled()))
+    {
+      throw std::runtime_error(message.str());
+    }
+    
+    attempt++;
+    m_retries_performed++;
+    
+    // Reprogram only the failing block, without counting it twice
+    int work_before = (controller == nullptr ? 0 : controller->get_task_work_progress());
+    program_block(false, block_address, address, buffer, num_bytes, true, controller);
+    if (controller != nullptr)
+    {
+      controller->on_task_update(task_status::RUNNING, work_before - controller->get_task_work_progress());
+    }
+  }
+}
+
+bool ws_cartridge::wait_for_erase(task_controller* controller)
+{
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(MAX_ERASE_TIME);
+  
+  while (m_rom_chip->test_erasing())
+  {
+    if (std::chrono::steady_clock::now() >= deadline)
+    {
+      return false;
+    }
+    
+    // Give UI an opportunity to update
+    if (controller != nullptr)
+    {
+      controller->on_task_update(task_status::RUNNING, 0);
+    }
+  }
+  return true;
+}
+
+void ws_cartridge::recover_from_block_error(unsigned int attempt, unsigned int base_timeout)
+{
+  bool erase_stuck = false;
+  try {
+    // Give any erase in progress a chance to finish
+    erase_stuck = !wait_for_erase(nullptr);
+  } catch (std::exception& ex) {
+    (void) ex;
+    // Well... this is awkward
+  }
+  
+  // No amount of retrying gets past a chip that never finishes erasing
+  if (erase_stuck)
+  {
+    try {
+      m_linkmasta->set_timeout(base_timeout);
+    } catch (std::exception& ex) {
+      (void) ex;
+      // Well... this is awkward
+    }
+    throw std::runtime_error("ROM chip is stuck erasing");
+  }
+  
+  try {
+    // Drop and reestablish the connection to clear any stale transfers, even
+    // if a session is holding it open
+    m_linkmasta->reconnect();
+  } catch (std::exception& ex) {
+    (void) ex;
+    // Well... this is awkward
+  }
+  
+  try {
+    m_rom_chip->reset();
+  } catch (std::exception& ex) {
+    (void) ex;
+    // Well... this is awkward
+  }
+  
+  // Double the timeout for each consecutive retry, within reason. A timeout of
+  // 0 means no timeout at all, so there's nothing to escalate.
+  if (base_timeout != 0)
+  {
+    unsigned long long timeout = (unsigned long long) base_timeout << (attempt < 16 ? attempt : 16);
+    if (timeout > MAX_RETRY_TIMEOUT)
+    {
+      timeout = (base_timeout > MAX_RETRY_TIMEOUT ? base_timeout : MAX_RETRY_TIMEOUT);
+    }
+    
+    try {
+      m_linkmasta->set_timeout((unsigned int) timeout);
+    } catch (std::exception& ex) {
+      (void) ex;
+      // Well... this is awkward
+    }
   }
 }
 
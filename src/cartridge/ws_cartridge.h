@@ -59,6 +59,18 @@ public:
     unsigned short checksum;
   };
   
+  /*! \brief An image to be written to a particular slot, as part of
+   *         \ref restore_cartridge_slots(const std::vector<slot_image>&, task_controller*).
+   */
+  struct slot_image
+  {
+    /*! \brief The image to write. Must outlive the operation. */
+    image_source*  source;
+    
+    /*! \brief The slot to write the image to. */
+    int            slot;
+  };
+  
   
   
   /*! \brief Class constructor
@@ -112,16 +124,72 @@ public:
    */
   void                  backup_cartridge_game_data(std::ostream& fout, int slot = SLOT_ALL, task_controller* controller = nullptr);
   
+  /*!
+   *  \see cartridge::backup_cartridge_game_data(image_sink&, int, task_controller*)
+   */
+  void                  backup_cartridge_game_data(image_sink& sink, int slot = SLOT_ALL, task_controller* controller = nullptr);
+  
   /*!
    *  \see cartridge::restore_cartridge_game_data(std::istream& fin, task_controller* controller = nullptr)
    */
   void                  restore_cartridge_game_data(std::istream& fin, int slot = SLOT_ALL, task_controller* controller = nullptr);
   
+  /*!
+   *  \see cartridge::restore_cartridge_game_data(image_source&, int, task_controller*)
+   */
+  void                  restore_cartridge_game_data(image_source& source, int slot = SLOT_ALL, task_controller* controller = nullptr);
+  
+  /*!
+   *  \brief Writes several images to their slots as a single operation.
+   *  
+   *  Every image is checked against its slot before anything is written, so
+   *  a mistake in the list doesn't leave some slots erased. The images are
+   *  then written in the order given by
+   *  \ref plan_slot_images(const std::vector<slot_image>&, int), all within
+   *  one session on the \ref linkmasta_device, and progress is reported to
+   *  `controller` as one task covering every image.
+   *  
+   *  This is a blocking function that can take a long time to complete.
+   *  
+   *  \param [in] images The images to write and the slot each goes to.
+   *  \param [in,out] controller The controller to report progress to. May be
+   *         nullptr.
+   *  
+   *  \throws std::invalid_argument If a slot is out of range or appears more
+   *          than once.
+   *  \throws std::runtime_error If an image doesn't fit its slot, or if an
+   *          error occurs while writing. Slots written before the error keep
+   *          their new content.
+   */
+  void                  restore_cartridge_slots(const std::vector<slot_image>& images, task_controller* controller = nullptr);
+  
+  /*!
+   *  \brief Orders a list of images so that writing them takes as few slot
+   *         switches as possible.
+   *  
+   *  Each slot is visited once, starting with the currently selected slot if
+   *  it's in the list and continuing in ascending order.
+   *  
+   *  \param [in] images The images to write and the slot each goes to.
+   *  \param [in] selected_slot The slot currently selected on the cartridge,
+   *         or -1 if unknown.
+   *  
+   *  \return The same images in the order they should be written.
+   *  
+   *  \throws std::invalid_argument If a slot appears more than once.
+   */
+  static std::vector<slot_image> plan_slot_images(const std::vector<slot_image>& images, int selected_slot);
+  
   /*!
    *  \see cartridge::compare_cartridge_game_data(std::istream& fin, task_controller* controller = nullptr)
    */
   bool                  compare_cartridge_game_data(std::istream& fin, int slot = SLOT_ALL, task_controller* controller = nullptr);
   
+  /*!
+   *  \see cartridge::compare_cartridge_game_data(image_source&, int, task_controller*)
+   */
+  bool                  compare_cartridge_game_data(image_source& source, int slot = SLOT_ALL, task_controller* controller = nullptr);
+  
   /*!
    *  \see cartridge::backup_cartridge_save_data(std::ostream& fout, task_controller* controller = nullptr)
    */
@@ -152,6 +220,21 @@ public:
    */
   std::string           fetch_game_name(int slot);
   
+  /*!
+   *  \see cartridge::content_hashes()
+   */
+  const std::vector<content_hash>& content_hashes() const;
+  
+  /*!
+   *  \see cartridge::verify_writes()
+   */
+  bool                  verify_writes() const;
+  
+  /*!
+   *  \see cartridge::set_verify_writes(bool)
+   */
+  void                  set_verify_writes(bool verify);
+  
   /*!
    * \brief Gets the parsed metadata of the game in the given slot.
    * 
@@ -203,10 +286,54 @@ public:
    */
   static unsigned int   calculate_game_size(int size_code);
   
+  /*! \brief Gets the number of times a failed block will be retried before
+   *         an operation is aborted.
+   *  
+   *  Gets the number of times a single block will be retried after a transient
+   *  error (e.g. a USB timeout or a short read) before the error is passed on
+   *  to the caller.
+   *  
+   *  \see set_block_retries(unsigned int retries)
+   */
+  unsigned int          block_retries() const;
+  
+  /*! \brief Sets the number of times a failed block will be retried before
+   *         an operation is aborted.
+   *  
+   *  Sets the number of times a single block will be retried after a transient
+   *  error before the error is passed on to the caller. Before each retry the
+   *  ROM chip is reset, the connection to the \ref linkmasta_device is
+   *  reopened, and the device timeout is doubled for the duration of the
+   *  retried block. ROM blocks are always erased again before being
+   *  reprogrammed. A value of 0 disables retrying entirely.
+   *  
+   *  \param [in] retries The maximum number of retries per block.
+   */
+  void                  set_block_retries(unsigned int retries);
+  
+  /*! \brief Gets the total number of block retries performed by this instance.
+   *  
+   *  Gets the total number of block retries that have been performed by this
+   *  instance since construction, across all operations.
+   */
+  unsigned int          num_retries_performed() const;
+
   
 
 protected:
   
+  /*! \brief Bytes already programmed into a ROM block, kept so they can be
+   *         programmed again if the block has to be erased during a retry.
+   */
+  struct block_segment
+  {
+    /*! \brief The slot-relative address the bytes were programmed at. */
+    address_t                  address;
+    
+    /*! \brief The bytes that were programmed. */
+    std::vector<unsigned char> data;
+  };
+  
   /*! \brief Constructs a \ref cartridge_descriptor struct using information
    *         gathered from the associated \ref linkmasta_device.
    *  
@@ -309,6 +436,122 @@ protected:
    */
   void                  build_game_metadata(int slot = -1);
   
+  /*! \brief Determines how many bytes at the top of a slot hold game data.
+   *  
+   *  Uses the ROM size from the game's header when it is recognized.
+   *  Otherwise, halves the extent, starting from the size of the slot, for as
+   *  long as the lower half is blank. Each half is checked by sampling a
+   *  packet at both ends of every few kilobytes rather than reading all of it.
+   *  The block right below the cut is then read in full, and the whole slot
+   *  is kept if it turns out not to be blank.
+   *  
+   *  Opens and closes the \ref linkmasta_device on its own.
+   *  
+   *  \param [in] slot The slot to check. Must be a valid slot number.
+   *  
+   *  \returns The number of bytes, counting down from the top of the slot,
+   *           that must be read to capture the whole game.
+   */
+  unsigned int          find_game_extent(int slot);
+  
+  /*! \brief Reads a single block from the ROM or SRAM chip, retrying on
+   *         failure.
+   *  
+   *  Reads the requested bytes, treating any exception or short read as a
+   *  transient failure. Failed attempts are retried up to
+   *  \ref block_retries() times, recovering the chip and connection between
+   *  attempts with \ref recover_from_block_error(). Any progress reported by a
+   *  failed attempt is withdrawn from the controller before retrying.
+   *  
+   *  \param [in] sram true to read from the SRAM chip, false for the ROM chip.
+   *  \param [in] address The slot-relative address to start reading from.
+   *  \param [out] buffer The buffer to write the data to.
+   *  \param [in] num_bytes The number of bytes to read.
+   *  \param [in,out] controller Optional controller to forward progress to.
+   *  
+   *  \returns The number of bytes read. Will always equal \ref num_bytes.
+   */
+  unsigned int          read_block(bool sram, address_t address, unsigned char* buffer, unsigned int num_bytes, task_controller* controller);
+  
+  /*! \brief Programs a single block on the ROM or SRAM chip, retrying on
+   *         failure.
+   *  
+   *  Programs the provided bytes, optionally erasing the ROM block at the
+   *  given base address first. If any step fails, the chip and connection are
+   *  recovered with \ref recover_from_block_error() before trying again. SRAM
+   *  is simply rewritten.
+   *  
+   *  Partially programmed flash cannot be overwritten without an erase, so a
+   *  ROM retry erases the block again if this call erased it, or if `written`
+   *  lists bytes programmed into the block earlier. Those bytes are programmed
+   *  again after the erase, without counting towards progress. Otherwise the
+   *  bytes are simply programmed again over the partial attempt, leaving the
+   *  rest of the block untouched.
+   *  
+   *  \param [in] sram true to write to the SRAM chip, false for the ROM chip.
+   *  \param [in] block_address The base address of the ROM block to erase.
+   *         Ignored for SRAM.
+   *  \param [in] address The slot-relative address to start programming at.
+   *  \param [in] buffer The data to program.
+   *  \param [in] num_bytes The number of bytes to program.
+   *  \param [in] erase Whether to erase the ROM block before the first
+   *         attempt. Ignored for SRAM.
+   *  \param [in,out] controller Optional controller to forward progress to.
+   *  \param [in] written Optional list of the bytes programmed into the ROM
+   *         block since it was last erased, to restore if it has to be erased
+   *         again. Ignored for SRAM.
+   */
+  void                  program_block(bool sram, address_t block_address, address_t address, const unsigned char* buffer, unsigned int num_bytes, bool erase, task_controller* controller, const std::vector<block_segment>* written = nullptr);
+  
+  /*! \brief Reads back freshly programmed ROM data and reprograms the block
+   *         until it matches.
+   *  
+   *  Compares the ROM to the data that was just programmed. On a mismatch,
+   *  logs the first differing address, then erases and reprograms the block
+   *  with \ref program_block() and checks it again, up to
+   *  \ref block_retries() times. Progress reported while reprogramming is
+   *  withdrawn so the operation's total stays accurate.
+   *  
+   *  \param [in] block_address The base address of the ROM block.
+   *  \param [in] address The slot-relative address programming started at.
+   *  \param [in] buffer The data that was programmed.
+   *  \param [in] num_bytes The number of bytes that were programmed.
+   *  \param [in,out] controller Optional controller to forward progress to.
+   *  
+   *  \throws std::runtime_error The block still doesn't match after all
+   *           retries.
+   */
+  void                  verify_block(address_t block_address, address_t address, const unsigned char* buffer, unsigned int num_bytes, task_controller* controller);
+  
+  /*! \brief Attempts to bring the ROM chip and linkmasta back into a known
+   *         state after a failed block operation.
+   *  
+   *  Waits for any pending erase to settle, reopens the connection to the
+   *  \ref linkmasta_device, resets the ROM chip, and escalates the device
+   *  timeout based on the attempt number. Errors encountered here are
+   *  swallowed; the subsequent retry will surface them if the device is truly
+   *  unavailable.
+   *  
+   *  \param [in] attempt The number of the upcoming retry, starting at 1.
+   *  \param [in] base_timeout The device timeout in use before any retries.
+   *  
+   *  \throws std::runtime_error If the ROM chip is still erasing after
+   *          \ref wait_for_erase() gives up. The device timeout is restored to
+   *          `base_timeout` first.
+   */
+  void                  recover_from_block_error(unsigned int attempt, unsigned int base_timeout);
+  
+  /*! \brief Waits for an erase on the ROM chip to complete, for up to 30
+   *         seconds.
+   *  
+   *  \param [in,out] controller Told about each poll so the UI stays
+   *         responsive. Can be nullptr.
+   *  
+   *  \returns true if the erase completed, false if the chip was still erasing
+   *           when time ran out.
+   */
+  bool                  wait_for_erase(task_controller* controller);
+
   
   
 private:
@@ -427,6 +670,30 @@ private:
    *  \see game_metadata
    */
   std::vector<game_metadata> m_metadata;
+  
+  /*! \brief The maximum number of times a failed block will be retried.
+   *  
+   *  \see set_block_retries(unsigned int retries)
+   */
+  unsigned int          m_block_retries;
+  
+  /*! \brief Running count of block retries performed by this instance.
+   *  
+   *  \see num_retries_performed()
+   */
+  unsigned int          m_retries_performed;
+  
+  /*! \brief Content hashes recorded by the most recent full game data read.
+   *  
+   *  \see content_hashes()
+   */
+  std::vector<content_hash> m_content_hashes;
+  
+  /*! \brief Whether written game data is read back and verified.
+   *  
+   *  \see set_verify_writes(bool)
+   */
+  bool                  m_verify_writes;
 };
 
 #endif /* defined(__WS_CARTRIDGE_H__) */
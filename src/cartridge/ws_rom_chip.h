@@ -12,8 +12,28 @@
 #ifndef __WS_ROM_CHIP_H__
 #define __WS_ROM_CHIP_H__
 
-class linkmasta_device;
-class task_controller;
+#include "flash_chip_engine.h"
+
+/*! \struct ws_rom_chip_traits
+ *  \brief Compile-time description of the flash chips on WonderSwan
+ *         cartridges, for \ref flash_chip_engine.
+ */
+struct ws_rom_chip_traits
+{
+  typedef unsigned char         word_t;
+  
+  static constexpr unsigned int COMMAND_ADDRESS_1    = 0x00000AAA;
+  static constexpr unsigned int COMMAND_ADDRESS_2    = 0x00000555;
+  static constexpr unsigned int SECTOR_MASK          = 0xFFFE0000;
+  static constexpr unsigned int DEVICE_ID_ADDRESS    = 0x0002;
+  static constexpr bool         ALWAYS_BYPASS        = true;
+  static constexpr bool         HAS_BLOCK_PROTECTION = false;
+  static constexpr bool         EXIT_BYPASS_ON_RESET = false;
+  static constexpr bool         TOGGLE_BIT_POLLING   = true;
+};
+
+
+
 
 /*! \class ws_rom_chip
  *  \brief Class for controlling and interacting with a flash storage chip on a
@@ -29,6 +49,9 @@ class task_controller;
  *  Its functionality is also limited by how the hardware device responds to
  *  certain commands.
  *  
+ *  The command logic itself lives in \ref flash_chip_engine, which this class
+ *  specializes with \ref ws_rom_chip_traits.
+ *  
  *  This class is *not* thread-safe. Use caution when working in a multithreaded
  *  environment.
  */
@@ -62,27 +85,11 @@ public:
   /*! \brief Type used for specifying an address on the device. */
   typedef unsigned int    address_t;
   
-  /*! \enum chip_mode
-   *  \brief Enumeration representing the assumed state of the device.
-   *  
-   *  Enumeration representing the current assume dstate of the device.
+  /*! \brief Enumeration representing the assumed state of the device.
    *  
    *  \see current_mode()
    */
-  enum chip_mode
-  {
-    /*! \brief Device is in the default read mode. */
-    READ,
-    
-    /*! \brief Device is in autoselect mode, ready for metadata queries */
-    AUTOSELECT,
-    
-    /*! \brief Device is in bypass mode, ready for swift programming. */
-    BYPASS,
-    
-    /*! \brief Device is busy erasing. */
-    ERASE
-  };
+  typedef flash_chip_mode chip_mode;
   
   
   
@@ -531,78 +538,12 @@ public:
   
 private:
   
-  /*! \brief Send the command sequence to enter \ref chip_mode::AUTOSELECT mode
-   *         to the chip.
-   *  
-   *  Sends the \ref chip_mode::AUTOSELECT mode command sequence to the chip.
-   *  This will send reset the device if necessary.
-   *  
-   *  This function is a blocking function that can take several seconds to
-   *  complete.
-   *  
-   *  Causes the device to enter \ref chip_mode::AUTOSELECT mode.
-   *  
-   *  \see chip_mode
-   */
-  void                    enter_autoselect();
-  
-  
-  
-private:
-  
-  /*! \brief The currently predicted mode of the chip.
-   *  
-   *  The currently predicted mode the hardware device is in. This value is
-   *  to track the state of the chip and must be actively maintained when
-   *  passing commands that could alter the state of the device. This value is
-   *  initialized to \ref chip_mode::READ.
-   *  
-   *  \see chip_mode
-   */
-  chip_mode               m_mode;
-  
-  /*! \brief The address of the last block erased.
-   *  
-   *  The last address passed to the \ref erase_block(address_t block_address)
-   *  function. This value is used for testing whether the chip has finished
-   *  erasing or not.
-   *  
-   *  \ref address_t
-   *  \ref erase_block(address_t block_address)
-   */
-  address_t               m_last_erased_addr;
-  
-  /*! \brief Boolean indicating whether the chip supports bypass program mode.
-   * 
-   *  Cached value indicating whether the device supports bypass programming,
-   *  allowing for faster data programming. Can be accessed through the
-   *  \ref supports_bypass() method.
-   * 
-   *  \see supports_bypass()
-   */
-  bool                    m_supports_bypass;
-  
-  /*! \brief A pointer to the \ref linkmasta_device used for communicating with
-   *         the chip.
-   *  
-   *  A constant pointer to the \ref linkmasta_device used for communicating
-   *  with the chip. The pointer to this device is const but the device itself
-   *  is not protected from modification. When this object is deallocated, this
-   *  pointer's target will not be deleted.
-   *  
-   *  \see linkmasta_device
-   */
-  linkmasta_device* const m_linkmasta;
-  
-  /*! \brief The index number of the chip on the cartridge.
-   *  
-   *  The index number of this device on the cartridge. Used for specifying the
-   *  hardware device to communicated with through the assigned \ref m_linkmasta
-   *  device.
+  /*! \brief The command logic doing the actual work, specialized for this
+   *         kind of chip.
    *  
-   *  \see chip_index_t
+   *  \see ws_rom_chip_traits
    */
-  chip_index_t const      m_chip_num;
+  flash_chip_engine<ws_rom_chip_traits> m_engine;
   
   /*! \brief The index number of the slot currently selected on the chip.
    * 
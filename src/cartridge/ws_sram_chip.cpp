@@ -21,6 +21,7 @@
 
 
 #define CHIP_INDEX    1
+#define SCRIPT_LENGTH 64
 
 typedef ws_sram_chip::data_t data_t;
 typedef ws_sram_chip::word_t word_t;
@@ -176,13 +177,26 @@ unsigned int ws_sram_chip::program_bytes(address_t address, const data_t* data,
       controller->on_task_start(num_bytes);
     }
     
-    // Program word of data one at a time
+    // Program words of data in scripts, so the Linkmasta can send several
+    // before waiting on their replies
     unsigned int i;
-    for (i = 0; i < num_bytes && (controller == nullptr || !controller->is_task_cancelled()); i++, address++)
+    for (i = 0; i < num_bytes && (controller == nullptr || !controller->is_task_cancelled()); )
     {
+      unsigned int script_length = num_bytes - i;
+      if (script_length > SCRIPT_LENGTH)
+      {
+        script_length = SCRIPT_LENGTH;
+      }
+      
+      linkmasta_device::command_script script;
+      for (unsigned int j = 0; j < script_length; ++j)
+      {
+        script.write_word(m_chip_num, address + i + j, data[i + j]);
+      }
+      
       try
       {
-        write(address, data[i]);
+        m_linkmasta->run_script(script);
       }
       catch (std::exception& ex)
       {
@@ -195,17 +209,18 @@ unsigned int ws_sram_chip::program_bytes(address_t address, const data_t* data,
       }
       
       // Inform controller of task progress
+      i += script_length;
       if (controller != nullptr)
       {
-        controller->on_task_update(task_status::RUNNING, 1);
+        controller->on_task_update(task_status::RUNNING, script_length);
       }
     }
     
     // Inform controller of task end
     if (controller != nullptr)
     {
-      controller->on_task_end(controller->is_task_cancelled() && i < num_bytes ? task_status::CANCELLED : task_status::COMPLETED, num_bytes);
+      controller->on_task_end(controller->is_task_cancelled() && i < num_bytes ? task_status::CANCELLED : task_status::COMPLETED, i);
     }
-    return num_bytes;
+    return i;
   }
 }
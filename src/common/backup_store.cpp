@@ -0,0 +1,281 @@
+/*! \file
+ *  \brief File containing the implementations of \ref backup_store and
+ *         \ref stored_image_sink.
+ *  
+ *  File containing the implementations of \ref backup_store and
+ *  \ref stored_image_sink.
+ *  
+ *  \see backup_store
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-19
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#include "backup_store.h"
+#include "sha1.h"
+#include "mapped_file.h"
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(OS_WINDOWS)
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+#define MANIFEST_EXTENSION ".stored"
+#define MANIFEST_MAGIC     "stored-image"
+#define MANIFEST_VERSION   1
+
+/*! \brief Gets the key a block with the given content is stored under, the
+ *         hex SHA-1 digest of the content.
+ */
+static std::string key_for(const unsigned char* data, unsigned int num_bytes)
+{
+  unsigned char digest[sha1::DIGEST_SIZE];
+  sha1          sha;
+  sha.update(data, num_bytes);
+  sha.digest(digest);
+  
+  std::ostringstream key;
+  key << std::hex << std::setfill('0');
+  for (unsigned int i = 0; i < sha1::DIGEST_SIZE; ++i)
+  {
+    key << std::setw(2) << (unsigned int) digest[i];
+  }
+  return key.str();
+}
+
+/*! \brief Creates a directory unless it already exists. */
+static void make_directory(const std::string& path)
+{
+#if defined(OS_WINDOWS)
+  int result = _mkdir(path.c_str());
+#else
+  int result = mkdir(path.c_str(), 0755);
+#endif
+  if (result != 0 && errno != EEXIST)
+  {
+    throw std::runtime_error("Unable to create directory " + path);
+  }
+}
+
+
+
+backup_store::backup_store(const std::string& directory)
+  : m_directory(directory)
+{
+  make_directory(m_directory);
+  make_directory(m_directory + "/blocks");
+}
+
+const std::string& backup_store::directory() const
+{
+  return m_directory;
+}
+
+
+
+std::string backup_store::put_block(const unsigned char* data, unsigned int num_bytes)
+{
+  // Name the block after its content
+  std::string key = key_for(data, num_bytes);
+  
+  // Identical blocks are only ever stored once
+  if (has_block(key))
+  {
+    return key;
+  }
+  
+  make_directory(m_directory + "/blocks/" + key.substr(0, 2));
+  
+  // Write to a temporary file first so a block is never seen half-written
+  std::string path = block_path(key);
+  std::string temp_path = path + ".tmp";
+  {
+    std::ofstream fout(temp_path.c_str(), std::ios::binary | std::ios::trunc);
+    fout.write((const char*) data, num_bytes);
+    fout.flush();
+    if (!fout.good())
+    {
+      fout.close();
+      std::remove(temp_path.c_str());
+      throw std::runtime_error("Unable to write block to backup store");
+    }
+  }
+  
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0)
+  {
+    std::remove(temp_path.c_str());
+    if (!has_block(key))
+    {
+      throw std::runtime_error("Unable to write block to backup store");
+    }
+  }
+  
+  return key;
+}
+
+bool backup_store::has_block(const std::string& key) const
+{
+  std::ifstream fin(block_path(key).c_str(), std::ios::binary);
+  return fin.is_open();
+}
+
+void backup_store::get_block(const std::string& key, unsigned char* buffer, unsigned int num_bytes) const
+{
+  std::ifstream fin(block_path(key).c_str(), std::ios::binary);
+  if (!fin.is_open())
+  {
+    throw std::runtime_error("Block " + key + " missing from backup store");
+  }
+  
+  fin.read((char*) buffer, num_bytes);
+  if ((unsigned int) fin.gcount() != num_bytes || fin.peek() != std::char_traits<char>::eof())
+  {
+    throw std::runtime_error("Block " + key + " in backup store has unexpected size");
+  }
+  
+  // The key is the digest of the content, so damage can't go unnoticed
+  if (key_for(buffer, num_bytes) != key)
+  {
+    throw std::runtime_error("Block " + key + " in backup store is corrupt");
+  }
+}
+
+
+
+void backup_store::put_image(const std::string& manifest_filename, const unsigned char* data, unsigned int num_bytes, unsigned int block_size)
+{
+  stored_image_sink sink(*this, manifest_filename);
+  
+  sink.begin(num_bytes);
+  for (unsigned int offset = 0; offset < num_bytes; offset += block_size)
+  {
+    sink.commit(offset, data + offset, (num_bytes - offset < block_size ? num_bytes - offset : block_size));
+  }
+  sink.end(num_bytes);
+}
+
+void backup_store::export_image(const std::string& manifest_filename, const std::string& image_filename) const
+{
+  std::ifstream fin(manifest_filename.c_str());
+  if (!fin.is_open())
+  {
+    throw std::runtime_error("Unable to open manifest");
+  }
+  
+  std::string  magic;
+  unsigned int version;
+  std::string  label;
+  unsigned int num_bytes;
+  fin >> magic >> version >> label >> std::hex >> num_bytes;
+  if (fin.fail() || magic != MANIFEST_MAGIC || version != MANIFEST_VERSION || label != "size")
+  {
+    throw std::runtime_error("Not a backup store manifest");
+  }
+  
+  // Blocks are copied straight into the mapped image
+  mapped_file image;
+  image.create(image_filename);
+  image.resize(num_bytes);
+  
+  unsigned int offset;
+  unsigned int block_size;
+  std::string  key;
+  while (fin >> offset >> block_size >> key)
+  {
+    if (offset > num_bytes || block_size > num_bytes - offset)
+    {
+      throw std::runtime_error("Manifest describes blocks past the end of the image");
+    }
+    get_block(key, image.data() + offset, block_size);
+  }
+  if (!fin.eof())
+  {
+    throw std::runtime_error("Malformed backup store manifest");
+  }
+  
+  image.flush();
+  image.close();
+}
+
+std::string backup_store::manifest_filename_for(const std::string& filename)
+{
+  return filename + MANIFEST_EXTENSION;
+}
+
+
+
+std::string backup_store::block_path(const std::string& key) const
+{
+  return m_directory + "/blocks/" + key.substr(0, 2) + "/" + key;
+}
+
+
+
+stored_image_sink::stored_image_sink(backup_store& store, const std::string& manifest_filename)
+  : m_store(store), m_manifest_filename(manifest_filename), m_entries(), m_next_offset(0)
+{
+  // Nothing else to do
+}
+
+void stored_image_sink::begin(unsigned int num_bytes)
+{
+  (void) num_bytes;
+  
+  m_entries.clear();
+  m_next_offset = 0;
+}
+
+unsigned char* stored_image_sink::acquire(unsigned int offset, unsigned int num_bytes, unsigned char* scratch)
+{
+  (void) offset;
+  (void) num_bytes;
+  
+  return scratch;
+}
+
+void stored_image_sink::commit(unsigned int offset, const unsigned char* data, unsigned int num_bytes)
+{
+  if (offset != m_next_offset)
+  {
+    throw std::runtime_error("Backup store images must be written in order");
+  }
+  
+  entry e;
+  e.offset = offset;
+  e.num_bytes = num_bytes;
+  e.key = m_store.put_block(data, num_bytes);
+  m_entries.push_back(e);
+  
+  m_next_offset += num_bytes;
+}
+
+void stored_image_sink::end(unsigned int num_bytes)
+{
+  std::ofstream fout(m_manifest_filename.c_str(), std::ios::trunc);
+  if (!fout.is_open())
+  {
+    throw std::runtime_error("Unable to write manifest");
+  }
+  
+  fout << MANIFEST_MAGIC << " " << MANIFEST_VERSION << "\n";
+  fout << "size " << std::hex << num_bytes << "\n";
+  for (auto it = m_entries.begin(); it != m_entries.end() && it->offset + it->num_bytes <= num_bytes; ++it)
+  {
+    fout << it->offset << " " << it->num_bytes << " " << it->key << "\n";
+  }
+  
+  fout.flush();
+  if (!fout.good())
+  {
+    throw std::runtime_error("Unable to write manifest");
+  }
+}
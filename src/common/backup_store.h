@@ -0,0 +1,188 @@
+/*! \file
+ *  \brief File containing the declarations of \ref backup_store and
+ *         \ref stored_image_sink.
+ *  
+ *  File containing the header information and declarations of the
+ *  \ref backup_store and \ref stored_image_sink classes.
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-19
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#ifndef __BACKUP_STORE_H__
+#define __BACKUP_STORE_H__
+
+#include "image_sink.h"
+#include <string>
+#include <vector>
+
+/*! \class backup_store
+ *  \brief Directory of backup data stored once per unique block.
+ *  
+ *  Images are split into blocks and every block is saved under the SHA-1
+ *  digest of its content, so a block shared by any number of images is only
+ *  ever stored once. What remains of an image is a small manifest listing the
+ *  blocks it is made of, which \ref export_image(const std::string&, const std::string&) const
+ *  turns back into a flat file.
+ *  
+ *  Blocks live in `blocks/xx/<digest>` below the store's directory, where
+ *  `xx` are the first two characters of the digest. Manifests can be saved
+ *  anywhere.
+ */
+class backup_store
+{
+public:
+  
+  /*! \brief Opens the store in the given directory, creating the directory
+   *         if it doesn't exist.
+   *  
+   *  \param [in] directory The directory holding the store.
+   *  
+   *  \throws std::runtime_error If the directory cannot be created.
+   */
+  explicit              backup_store(const std::string& directory);
+  
+  /*! \brief Gets the directory holding the store. */
+  const std::string&    directory() const;
+  
+  
+  
+  /*! \brief Stores a block unless an identical one is already stored.
+   *  
+   *  \param [in] data The content of the block.
+   *  \param [in] num_bytes The number of bytes in the block.
+   *  
+   *  \returns The key the block is stored under.
+   *  
+   *  \throws std::runtime_error If the block cannot be written.
+   */
+  std::string           put_block(const unsigned char* data, unsigned int num_bytes);
+  
+  /*! \brief Checks whether a block is stored under the given key. */
+  bool                  has_block(const std::string& key) const;
+  
+  /*! \brief Reads a stored block.
+   *  
+   *  \param [in] key The key the block is stored under.
+   *  \param [out] buffer The buffer to read the block into.
+   *  \param [in] num_bytes The size of the block.
+   *  
+   *  \throws std::runtime_error If the block is missing, not of the
+   *          expected size, or its content doesn't match its key.
+   */
+  void                  get_block(const std::string& key, unsigned char* buffer, unsigned int num_bytes) const;
+  
+  
+  
+  /*! \brief Stores an image held in memory, splitting it into blocks of a
+   *         fixed size.
+   *  
+   *  Meant for images that aren't read from the cartridge block by block,
+   *  like save files. Use a \ref stored_image_sink for everything else.
+   *  
+   *  \param [in] manifest_filename The path of the manifest to write.
+   *  \param [in] data The content of the image.
+   *  \param [in] num_bytes The number of bytes in the image.
+   *  \param [in] block_size The size of the blocks to split the image into.
+   *  
+   *  \throws std::runtime_error If a block or the manifest cannot be written.
+   */
+  void                  put_image(const std::string& manifest_filename, const unsigned char* data, unsigned int num_bytes, unsigned int block_size);
+  
+  /*! \brief Rebuilds the flat image described by a manifest.
+   *  
+   *  \param [in] manifest_filename The path of the manifest to read.
+   *  \param [in] image_filename The path of the image to write.
+   *  
+   *  \throws std::runtime_error If the manifest is invalid, a block is
+   *          missing or corrupt, or the image cannot be written.
+   */
+  void                  export_image(const std::string& manifest_filename, const std::string& image_filename) const;
+  
+  /*! \brief Gets the name of the manifest kept for a backup file. */
+  static std::string    manifest_filename_for(const std::string& filename);
+
+private:
+  
+  /*! \brief Gets the path a block is stored at. */
+  std::string           block_path(const std::string& key) const;
+  
+  /*! \brief The directory holding the store. */
+  std::string           m_directory;
+};
+
+
+
+/*! \class stored_image_sink
+ *  \brief \ref image_sink that writes into a \ref backup_store.
+ *  
+ *  Every commit is stored as one block. Cartridges back up game data one
+ *  block at a time as laid out in their \ref cartridge_descriptor, so blocks
+ *  in the store line up with blocks on the cartridge and repeated dumps of
+ *  the same game share all of them. Commits must be made in order.
+ *  
+ *  The manifest is written by \ref end(unsigned int).
+ */
+class stored_image_sink: public image_sink
+{
+public:
+  
+  /*! \brief Constructs a sink storing into the given store.
+   *  
+   *  \param [in] store The store to write blocks to. Must outlive this object.
+   *  \param [in] manifest_filename The path of the manifest to write.
+   */
+                        stored_image_sink(backup_store& store, const std::string& manifest_filename);
+  
+  /*!
+   *  \see image_sink::begin(unsigned int)
+   */
+  void                  begin(unsigned int num_bytes);
+  
+  /*!
+   *  \see image_sink::acquire(unsigned int, unsigned int, unsigned char*)
+   */
+  unsigned char*        acquire(unsigned int offset, unsigned int num_bytes, unsigned char* scratch);
+  
+  /*!
+   *  \see image_sink::commit(unsigned int, const unsigned char*, unsigned int)
+   */
+  void                  commit(unsigned int offset, const unsigned char* data, unsigned int num_bytes);
+  
+  /*!
+   *  \see image_sink::end(unsigned int)
+   */
+  void                  end(unsigned int num_bytes);
+
+private:
+  
+  /*! \struct entry
+   *  \brief A block of the image being stored.
+   */
+  struct entry
+  {
+    /*! \brief Offset of the block in the image. */
+    unsigned int        offset;
+    
+    /*! \brief Size of the block in bytes. */
+    unsigned int        num_bytes;
+    
+    /*! \brief Key the block is stored under. */
+    std::string         key;
+  };
+  
+  /*! \brief The store to write blocks to. */
+  backup_store&         m_store;
+  
+  /*! \brief The path of the manifest to write. */
+  std::string           m_manifest_filename;
+  
+  /*! \brief Blocks committed so far, in order. */
+  std::vector<entry>    m_entries;
+  
+  /*! \brief Offset the next commit is expected at. */
+  unsigned int          m_next_offset;
+};
+
+#endif /* defined(__BACKUP_STORE_H__) */
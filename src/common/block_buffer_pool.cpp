@@ -0,0 +1,197 @@
+/*! \file
+ *  \brief File containing the implementation of \ref block_buffer_pool.
+ *  
+ *  File containing the implementation of \ref block_buffer_pool.
+ *  
+ *  \see block_buffer_pool
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-22
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#include "block_buffer_pool.h"
+#include <cstdlib>
+#include <new>
+
+#if defined(OS_WINDOWS)
+#include <malloc.h>
+#endif
+
+/*! \brief Allocates a block of memory aligned to
+ *         \ref block_buffer_pool::ALIGNMENT bytes.
+ */
+static unsigned char* allocate_aligned(unsigned int num_bytes)
+{
+  void* data = nullptr;
+#if defined(OS_WINDOWS)
+  data = _aligned_malloc(num_bytes, block_buffer_pool::ALIGNMENT);
+#else
+  if (posix_memalign(&data, block_buffer_pool::ALIGNMENT, num_bytes) != 0)
+  {
+    data = nullptr;
+  }
+#endif
+  if (data == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  return (unsigned char*) data;
+}
+
+/*! \brief Frees memory allocated by \ref allocate_aligned(unsigned int). */
+static void free_aligned(unsigned char* data)
+{
+#if defined(OS_WINDOWS)
+  _aligned_free(data);
+#else
+  free(data);
+#endif
+}
+
+
+
+block_buffer_pool::buffer::buffer()
+  : m_pool(nullptr), m_data(nullptr), m_size(0)
+{
+  // Nothing else to do
+}
+
+block_buffer_pool::buffer::buffer(block_buffer_pool* pool, unsigned char* data, unsigned int size)
+  : m_pool(pool), m_data(data), m_size(size)
+{
+  // Nothing else to do
+}
+
+block_buffer_pool::buffer::buffer(buffer&& other)
+  : m_pool(other.m_pool), m_data(other.m_data), m_size(other.m_size)
+{
+  other.m_pool = nullptr;
+  other.m_data = nullptr;
+  other.m_size = 0;
+}
+
+block_buffer_pool::buffer& block_buffer_pool::buffer::operator=(buffer&& other)
+{
+  if (this != &other)
+  {
+    release();
+    m_pool = other.m_pool;
+    m_data = other.m_data;
+    m_size = other.m_size;
+    other.m_pool = nullptr;
+    other.m_data = nullptr;
+    other.m_size = 0;
+  }
+  return *this;
+}
+
+block_buffer_pool::buffer::~buffer()
+{
+  release();
+}
+
+unsigned char* block_buffer_pool::buffer::data() const
+{
+  return m_data;
+}
+
+unsigned int block_buffer_pool::buffer::size() const
+{
+  return m_size;
+}
+
+void block_buffer_pool::buffer::release()
+{
+  if (m_data != nullptr)
+  {
+    m_pool->give_back(m_data, m_size);
+    m_pool = nullptr;
+    m_data = nullptr;
+    m_size = 0;
+  }
+}
+
+
+
+block_buffer_pool::block_buffer_pool()
+  : m_mutex(), m_idle(), m_bytes_in_use(0), m_bytes_allocated(0),
+    m_high_water_mark(0)
+{
+  // Nothing else to do
+}
+
+block_buffer_pool::~block_buffer_pool()
+{
+  trim();
+}
+
+block_buffer_pool::buffer block_buffer_pool::acquire(unsigned int num_bytes)
+{
+  // Whole multiples of the alignment keep neighbouring sizes interchangeable
+  unsigned int size = (num_bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+  if (size == 0)
+  {
+    size = ALIGNMENT;
+  }
+  
+  std::lock_guard<std::mutex> lock(m_mutex);
+  
+  // Reuse the smallest idle buffer that fits, but don't tie up one that's far
+  // bigger than needed
+  auto it = m_idle.lower_bound(size);
+  if (it != m_idle.end() && it->first / 2 <= size)
+  {
+    buffer b(this, it->second, it->first);
+    m_idle.erase(it);
+    m_bytes_in_use += b.size();
+    return b;
+  }
+  
+  buffer b(this, allocate_aligned(size), size);
+  m_bytes_in_use += size;
+  m_bytes_allocated += size;
+  if (m_bytes_allocated > m_high_water_mark)
+  {
+    m_high_water_mark = m_bytes_allocated;
+  }
+  return b;
+}
+
+void block_buffer_pool::trim()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto entry : m_idle)
+  {
+    free_aligned(entry.second);
+    m_bytes_allocated -= entry.first;
+  }
+  m_idle.clear();
+}
+
+unsigned int block_buffer_pool::bytes_in_use() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_bytes_in_use;
+}
+
+unsigned int block_buffer_pool::bytes_allocated() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_bytes_allocated;
+}
+
+unsigned int block_buffer_pool::high_water_mark() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_high_water_mark;
+}
+
+
+
+void block_buffer_pool::give_back(unsigned char* data, unsigned int size)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_idle.insert(std::make_pair(size, data));
+  m_bytes_in_use -= size;
+}
@@ -0,0 +1,158 @@
+/*! \file
+ *  \brief File containing the declaration of the \ref block_buffer_pool
+ *         class.
+ *  
+ *  File containing the header information and declaration of the
+ *  \ref block_buffer_pool class and its \ref block_buffer_pool::buffer
+ *  handles.
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-22
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#ifndef __BLOCK_BUFFER_POOL_H__
+#define __BLOCK_BUFFER_POOL_H__
+
+#include <map>
+#include <mutex>
+
+/*! \class block_buffer_pool
+ *  \brief Keeps the buffers used by cartridge operations around between
+ *         operations so they don't have to be allocated over and over.
+ *  
+ *  Buffers are handed out by \ref acquire(unsigned int) as
+ *  \ref block_buffer_pool::buffer handles, which give the memory back to the
+ *  pool when they go away, including when an exception unwinds through the
+ *  operation using them. Every buffer starts on a \ref ALIGNMENT byte boundary,
+ *  so whole packets can be moved in and out of it efficiently.
+ *  
+ *  Memory is only ever allocated when no idle buffer of a fitting size is
+ *  left, so the memory held by the pool levels off at the most that was in
+ *  use at once, reported by \ref high_water_mark().
+ *  
+ *  This class is thread-safe. The pool must outlive every buffer acquired from
+ *  it.
+ */
+class block_buffer_pool
+{
+public:
+  
+  /*! \brief Boundary in bytes every buffer is aligned to. */
+  static const unsigned int ALIGNMENT = 64;
+  
+  
+  
+  /*! \class buffer
+   *  \brief Handle to a buffer acquired from a \ref block_buffer_pool.
+   *  
+   *  Gives the buffer back to its pool when destroyed. Handles can be moved
+   *  but not copied.
+   */
+  class buffer
+  {
+  public:
+    
+    /*! \brief Constructs a handle that holds no buffer. */
+                        buffer();
+    
+    /*! \brief Takes over the buffer held by another handle. */
+                        buffer(buffer&& other);
+    
+    /*! \brief Gives back the buffer held, then takes over the one held by
+     *         another handle.
+     */
+    buffer&             operator=(buffer&& other);
+    
+    /*! \brief Gives back the buffer held, if any. */
+                        ~buffer();
+    
+    /*! \brief Gets the start of the buffer, or nullptr if none is held. */
+    unsigned char*      data() const;
+    
+    /*! \brief Gets the number of usable bytes in the buffer. This is at least
+     *         the number requested.
+     */
+    unsigned int        size() const;
+    
+    /*! \brief Gives back the buffer held, if any, before the handle goes
+     *         away.
+     */
+    void                release();
+  
+  private:
+    
+    /*! \brief Constructs a handle to a buffer of the given pool. */
+                        buffer(block_buffer_pool* pool, unsigned char* data, unsigned int size);
+    
+                        buffer(const buffer& other) = delete;
+    buffer&             operator=(const buffer& other) = delete;
+    
+    /*! \brief The pool the buffer belongs to. */
+    block_buffer_pool*  m_pool;
+    
+    /*! \brief The start of the buffer. */
+    unsigned char*      m_data;
+    
+    /*! \brief The size of the buffer in bytes. */
+    unsigned int        m_size;
+    
+    friend class block_buffer_pool;
+  };
+  
+  
+  
+  /*! \brief Constructs an empty pool. */
+                        block_buffer_pool();
+  
+  /*! \brief Frees every idle buffer. */
+                        ~block_buffer_pool();
+  
+  /*!
+   *  \brief Gets a buffer of at least the given size, reusing an idle one if
+   *         there is one.
+   *  
+   *  The content of the buffer is undefined.
+   *  
+   *  \param [in] num_bytes The number of bytes needed.
+   *  
+   *  \throws std::bad_alloc If a new buffer is needed and cannot be allocated.
+   */
+  buffer                acquire(unsigned int num_bytes);
+  
+  /*! \brief Frees every idle buffer. Buffers in use are unaffected. */
+  void                  trim();
+  
+  /*! \brief Gets the number of bytes held by buffers currently in use. */
+  unsigned int          bytes_in_use() const;
+  
+  /*! \brief Gets the number of bytes held by the pool, idle or in use. */
+  unsigned int          bytes_allocated() const;
+  
+  /*! \brief Gets the most bytes the pool has ever held at once. */
+  unsigned int          high_water_mark() const;
+
+private:
+  
+  /*! \brief Returns a buffer to the idle list. Called by
+   *         \ref buffer::release().
+   */
+  void                  give_back(unsigned char* data, unsigned int size);
+  
+  /*! \brief Guards the members below. */
+  mutable std::mutex    m_mutex;
+  
+  /*! \brief Idle buffers keyed by size. */
+  std::multimap<unsigned int, unsigned char*> m_idle;
+  
+  /*! \brief Number of bytes held by buffers in use. */
+  unsigned int          m_bytes_in_use;
+  
+  /*! \brief Number of bytes held by the pool. */
+  unsigned int          m_bytes_allocated;
+  
+  /*! \brief Most bytes ever held by the pool. */
+  unsigned int          m_high_water_mark;
+};
+
+#endif /* defined(__BLOCK_BUFFER_POOL_H__) */
@@ -0,0 +1,715 @@
+/*! \file
+ *  \brief File containing the implementation of the byte scanning kernels.
+ *  
+ *  File containing the implementation of the byte scanning kernels.
+ *  
+ *  See corresponding header file to view documentation for the functions.
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-15
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#include "byte_kernels.h"
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#define KERNEL_TARGET(isa)
+#else
+#define KERNEL_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+#define CRC32_POLYNOMIAL 0xEDB88320
+#define BLANK_BYTE       0xFF
+
+namespace
+{
+
+/*! \brief Function table for a single kernel set. */
+struct kernel_table
+{
+  kernel_set   set;
+  unsigned int (*find_mismatch)(const unsigned char*, const unsigned char*, unsigned int);
+  bool         (*is_blank)(const unsigned char*, unsigned int);
+  unsigned int (*count_blank)(const unsigned char*, unsigned int);
+  unsigned int (*count_trailing_blank)(const unsigned char*, unsigned int);
+  uint32_t     (*byte_sum)(const unsigned char*, unsigned int);
+  uint32_t     (*crc32_update)(uint32_t, const unsigned char*, unsigned int);
+};
+
+/*! \brief Processor features relevant to kernel selection. */
+struct cpu_features
+{
+  bool sse2;
+  bool pclmul;
+  bool avx2;
+  
+  cpu_features()
+    : sse2(false), pclmul(false), avx2(false)
+  {
+#ifdef KERNELS_X86
+    unsigned int max_leaf, ecx1, edx1, ebx7 = 0;
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    max_leaf = (unsigned int) info[0];
+    __cpuid(info, 1);
+    ecx1 = (unsigned int) info[2];
+    edx1 = (unsigned int) info[3];
+    if (max_leaf >= 7)
+    {
+      __cpuidex(info, 7, 0);
+      ebx7 = (unsigned int) info[1];
+    }
+#else
+    unsigned int eax, ebx;
+    max_leaf = __get_cpuid_max(0, nullptr);
+    if (max_leaf < 1 || !__get_cpuid(1, &eax, &ebx, &ecx1, &edx1))
+    {
+      return;
+    }
+    if (max_leaf >= 7)
+    {
+      unsigned int ecx7, edx7;
+      __cpuid_count(7, 0, eax, ebx7, ecx7, edx7);
+    }
+#endif
+    
+    sse2 = (edx1 & (1u << 26)) != 0;
+    pclmul = sse2 && (ecx1 & (1u << 1)) != 0;
+    
+    // AVX2 also needs the OS to save the upper halves of the registers
+    bool osxsave = (ecx1 & (1u << 27)) != 0;
+    bool avx = (ecx1 & (1u << 28)) != 0;
+    if (osxsave && avx)
+    {
+#if defined(_MSC_VER)
+      unsigned long long xcr0 = _xgetbv(0);
+#else
+      unsigned int xcr0_lo, xcr0_hi;
+      __asm__ volatile ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+      unsigned long long xcr0 = ((unsigned long long) xcr0_hi << 32) | xcr0_lo;
+#endif
+      avx2 = (xcr0 & 0x6) == 0x6 && (ebx7 & (1u << 5)) != 0;
+    }
+#endif
+  }
+};
+
+const cpu_features& features()
+{
+  static const cpu_features f;
+  return f;
+}
+
+
+
+/*! \brief Lookup tables for slicing-by-8 CRC-32. */
+struct crc32_tables
+{
+  uint32_t entries[8][256];
+  
+  crc32_tables()
+  {
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+      uint32_t c = i;
+      for (int k = 0; k < 8; ++k)
+      {
+        c = (c & 1) ? (CRC32_POLYNOMIAL ^ (c >> 1)) : (c >> 1);
+      }
+      entries[0][i] = c;
+    }
+    
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+      for (int t = 1; t < 8; ++t)
+      {
+        uint32_t prev = entries[t - 1][i];
+        entries[t][i] = (prev >> 8) ^ entries[0][prev & 0xFF];
+      }
+    }
+  }
+};
+
+const crc32_tables& crc_tables()
+{
+  static const crc32_tables t;
+  return t;
+}
+
+inline unsigned int lowest_set_bit(uint32_t mask)
+{
+#if defined(_MSC_VER)
+  unsigned long i;
+  _BitScanForward(&i, mask);
+  return (unsigned int) i;
+#else
+  return (unsigned int) __builtin_ctz(mask);
+#endif
+}
+
+inline unsigned int highest_set_bit(uint32_t mask)
+{
+#if defined(_MSC_VER)
+  unsigned long i;
+  _BitScanReverse(&i, mask);
+  return (unsigned int) i;
+#else
+  return 31 - (unsigned int) __builtin_clz(mask);
+#endif
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Scalar kernels
+////////////////////////////////////////////////////////////////////////////////
+
+inline uint64_t load64(const unsigned char* p)
+{
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+unsigned int scalar_find_mismatch(const unsigned char* a, const unsigned char* b, unsigned int num_bytes)
+{
+  unsigned int i = 0;
+  for (; i + 8 <= num_bytes; i += 8)
+  {
+    if (load64(a + i) != load64(b + i)) break;
+  }
+  for (; i < num_bytes; ++i)
+  {
+    if (a[i] != b[i]) break;
+  }
+  return i;
+}
+
+unsigned int scalar_count_blank(const unsigned char* data, unsigned int num_bytes)
+{
+  unsigned int i = 0;
+  for (; i + 8 <= num_bytes; i += 8)
+  {
+    if (load64(data + i) != ~(uint64_t) 0) break;
+  }
+  for (; i < num_bytes; ++i)
+  {
+    if (data[i] != BLANK_BYTE) break;
+  }
+  return i;
+}
+
+bool scalar_is_blank(const unsigned char* data, unsigned int num_bytes)
+{
+  return scalar_count_blank(data, num_bytes) == num_bytes;
+}
+
+unsigned int scalar_count_trailing_blank(const unsigned char* data, unsigned int num_bytes)
+{
+  unsigned int i = num_bytes;
+  for (; i >= 8; i -= 8)
+  {
+    if (load64(data + i - 8) != ~(uint64_t) 0) break;
+  }
+  for (; i > 0; --i)
+  {
+    if (data[i - 1] != BLANK_BYTE) break;
+  }
+  return num_bytes - i;
+}
+
+uint32_t scalar_byte_sum(const unsigned char* data, unsigned int num_bytes)
+{
+  uint32_t sum = 0;
+  for (unsigned int i = 0; i < num_bytes; ++i)
+  {
+    sum += data[i];
+  }
+  return sum;
+}
+
+uint32_t scalar_crc32_update(uint32_t crc, const unsigned char* data, unsigned int num_bytes)
+{
+  const crc32_tables& t = crc_tables();
+  
+  // Slicing-by-8: eight table lookups per eight bytes instead of one per byte
+  for (; num_bytes >= 8; data += 8, num_bytes -= 8)
+  {
+    uint32_t one = crc ^ ((uint32_t) data[0] | ((uint32_t) data[1] << 8) | ((uint32_t) data[2] << 16) | ((uint32_t) data[3] << 24));
+    uint32_t two = (uint32_t) data[4] | ((uint32_t) data[5] << 8) | ((uint32_t) data[6] << 16) | ((uint32_t) data[7] << 24);
+    crc = t.entries[7][one & 0xFF] ^ t.entries[6][(one >> 8) & 0xFF]
+        ^ t.entries[5][(one >> 16) & 0xFF] ^ t.entries[4][one >> 24]
+        ^ t.entries[3][two & 0xFF] ^ t.entries[2][(two >> 8) & 0xFF]
+        ^ t.entries[1][(two >> 16) & 0xFF] ^ t.entries[0][two >> 24];
+  }
+  for (; num_bytes > 0; ++data, --num_bytes)
+  {
+    crc = t.entries[0][(crc ^ *data) & 0xFF] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+const kernel_table scalar_kernels =
+{
+  kernel_set::SCALAR,
+  scalar_find_mismatch,
+  scalar_is_blank,
+  scalar_count_blank,
+  scalar_count_trailing_blank,
+  scalar_byte_sum,
+  scalar_crc32_update
+};
+
+
+
+#ifdef KERNELS_X86
+
+////////////////////////////////////////////////////////////////////////////////
+// SSE2 kernels
+////////////////////////////////////////////////////////////////////////////////
+
+KERNEL_TARGET("sse2")
+unsigned int sse2_find_mismatch(const unsigned char* a, const unsigned char* b, unsigned int num_bytes)
+{
+  unsigned int i = 0;
+  for (; i + 16 <= num_bytes; i += 16)
+  {
+    __m128i va = _mm_loadu_si128((const __m128i*) (a + i));
+    __m128i vb = _mm_loadu_si128((const __m128i*) (b + i));
+    uint32_t mask = (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) ^ 0xFFFF;
+    if (mask != 0)
+    {
+      return i + lowest_set_bit(mask);
+    }
+  }
+  return i + scalar_find_mismatch(a + i, b + i, num_bytes - i);
+}
+
+KERNEL_TARGET("sse2")
+bool sse2_is_blank(const unsigned char* data, unsigned int num_bytes)
+{
+  const __m128i blank = _mm_set1_epi8((char) BLANK_BYTE);
+  unsigned int i = 0;
+  
+  // AND four vectors together so there's only one test per 64 bytes
+  for (; i + 64 <= num_bytes; i += 64)
+  {
+    __m128i v = _mm_and_si128(
+      _mm_and_si128(_mm_loadu_si128((const __m128i*) (data + i)), _mm_loadu_si128((const __m128i*) (data + i + 16))),
+      _mm_and_si128(_mm_loadu_si128((const __m128i*) (data + i + 32)), _mm_loadu_si128((const __m128i*) (data + i + 48))));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, blank)) != 0xFFFF)
+    {
+      return false;
+    }
+  }
+  return scalar_is_blank(data + i, num_bytes - i);
+}
+
+KERNEL_TARGET("sse2")
+unsigned int sse2_count_blank(const unsigned char* data, unsigned int num_bytes)
+{
+  const __m128i blank = _mm_set1_epi8((char) BLANK_BYTE);
+  unsigned int i = 0;
+  for (; i + 16 <= num_bytes; i += 16)
+  {
+    __m128i v = _mm_loadu_si128((const __m128i*) (data + i));
+    uint32_t mask = (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(v, blank)) ^ 0xFFFF;
+    if (mask != 0)
+    {
+      return i + lowest_set_bit(mask);
+    }
+  }
+  return i + scalar_count_blank(data + i, num_bytes - i);
+}
+
+KERNEL_TARGET("sse2")
+unsigned int sse2_count_trailing_blank(const unsigned char* data, unsigned int num_bytes)
+{
+  const __m128i blank = _mm_set1_epi8((char) BLANK_BYTE);
+  unsigned int i = num_bytes;
+  for (; i >= 16; i -= 16)
+  {
+    __m128i v = _mm_loadu_si128((const __m128i*) (data + i - 16));
+    uint32_t mask = (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(v, blank)) ^ 0xFFFF;
+    if (mask != 0)
+    {
+      return num_bytes - (i - 16 + highest_set_bit(mask) + 1);
+    }
+  }
+  return (num_bytes - i) + scalar_count_trailing_blank(data, i);
+}
+
+KERNEL_TARGET("sse2")
+uint32_t sse2_byte_sum(const unsigned char* data, unsigned int num_bytes)
+{
+  const __m128i zero = _mm_setzero_si128();
+  __m128i acc = _mm_setzero_si128();
+  unsigned int i = 0;
+  
+  // SAD against zero sums each half of the vector into a 64-bit lane
+  for (; i + 16 <= num_bytes; i += 16)
+  {
+    acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_loadu_si128((const __m128i*) (data + i)), zero));
+  }
+  acc = _mm_add_epi64(acc, _mm_srli_si128(acc, 8));
+  return (uint32_t) _mm_cvtsi128_si32(acc) + scalar_byte_sum(data + i, num_bytes - i);
+}
+
+/*!
+ *  \brief CRC-32 by carry-less multiplication, folding four 128-bit lanes at a
+ *         time down to a 32-bit Barrett reduction. `num_bytes` must be a
+ *         multiple of 16 and at least 64.
+ */
+KERNEL_TARGET("sse2,pclmul")
+uint32_t pclmul_crc32_fold(uint32_t crc, const unsigned char* data, unsigned int num_bytes)
+{
+  const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596LL, 0x0154442bd4LL);
+  const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009eLL, 0x01751997d0LL);
+  const __m128i k5k0 = _mm_set_epi64x(0x0000000000LL, 0x0163cd6124LL);
+  const __m128i poly = _mm_set_epi64x(0x01f7011641LL, 0x01db710641LL);
+  const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+  
+  __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+  
+  x1 = _mm_loadu_si128((const __m128i*) (data + 0x00));
+  x2 = _mm_loadu_si128((const __m128i*) (data + 0x10));
+  x3 = _mm_loadu_si128((const __m128i*) (data + 0x20));
+  x4 = _mm_loadu_si128((const __m128i*) (data + 0x30));
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int) crc));
+  data += 64;
+  num_bytes -= 64;
+  
+  // Fold 64 bytes at a time
+  x0 = k1k2;
+  while (num_bytes >= 64)
+  {
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+    x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+    
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+    x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+    x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+    
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i*) (data + 0x00)));
+    x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i*) (data + 0x10)));
+    x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i*) (data + 0x20)));
+    x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i*) (data + 0x30)));
+    
+    data += 64;
+    num_bytes -= 64;
+  }
+  
+  // Fold the four lanes into one
+  x0 = k3k4;
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+  
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+  
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+  
+  // Fold in the remaining 16-byte blocks
+  while (num_bytes >= 16)
+  {
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i*) data)), x5);
+    
+    data += 16;
+    num_bytes -= 16;
+  }
+  
+  // Fold 128 bits down to 64
+  x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+  
+  x0 = k5k0;
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, mask32);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+  
+  // Barrett reduction down to 32 bits
+  x0 = poly;
+  x2 = _mm_and_si128(x1, mask32);
+  x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+  x2 = _mm_and_si128(x2, mask32);
+  x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+  
+  return (uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(x1, 4));
+}
+
+uint32_t sse2_crc32_update(uint32_t crc, const unsigned char* data, unsigned int num_bytes)
+{
+  if (num_bytes >= 64 && features().pclmul)
+  {
+    unsigned int n = num_bytes & ~15u;
+    crc = pclmul_crc32_fold(crc, data, n);
+    data += n;
+    num_bytes -= n;
+  }
+  return scalar_crc32_update(crc, data, num_bytes);
+}
+
+const kernel_table sse2_kernels =
+{
+  kernel_set::SSE2,
+  sse2_find_mismatch,
+  sse2_is_blank,
+  sse2_count_blank,
+  sse2_count_trailing_blank,
+  sse2_byte_sum,
+  sse2_crc32_update
+};
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// AVX2 kernels
+////////////////////////////////////////////////////////////////////////////////
+
+KERNEL_TARGET("avx2")
+unsigned int avx2_find_mismatch(const unsigned char* a, const unsigned char* b, unsigned int num_bytes)
+{
+  unsigned int i = 0;
+  for (; i + 32 <= num_bytes; i += 32)
+  {
+    __m256i va = _mm256_loadu_si256((const __m256i*) (a + i));
+    __m256i vb = _mm256_loadu_si256((const __m256i*) (b + i));
+    uint32_t mask = ~(uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb));
+    if (mask != 0)
+    {
+      return i + lowest_set_bit(mask);
+    }
+  }
+  return i + sse2_find_mismatch(a + i, b + i, num_bytes - i);
+}
+
+KERNEL_TARGET("avx2")
+bool avx2_is_blank(const unsigned char* data, unsigned int num_bytes)
+{
+  const __m256i blank = _mm256_set1_epi8((char) BLANK_BYTE);
+  unsigned int i = 0;
+  
+  // AND four vectors together so there's only one test per 128 bytes
+  for (; i + 128 <= num_bytes; i += 128)
+  {
+    __m256i v = _mm256_and_si256(
+      _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (data + i)), _mm256_loadu_si256((const __m256i*) (data + i + 32))),
+      _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (data + i + 64)), _mm256_loadu_si256((const __m256i*) (data + i + 96))));
+    if (~(uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, blank)) != 0)
+    {
+      return false;
+    }
+  }
+  return sse2_is_blank(data + i, num_bytes - i);
+}
+
+KERNEL_TARGET("avx2")
+unsigned int avx2_count_blank(const unsigned char* data, unsigned int num_bytes)
+{
+  const __m256i blank = _mm256_set1_epi8((char) BLANK_BYTE);
+  unsigned int i = 0;
+  for (; i + 32 <= num_bytes; i += 32)
+  {
+    __m256i v = _mm256_loadu_si256((const __m256i*) (data + i));
+    uint32_t mask = ~(uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, blank));
+    if (mask != 0)
+    {
+      return i + lowest_set_bit(mask);
+    }
+  }
+  return i + sse2_count_blank(data + i, num_bytes - i);
+}
+
+KERNEL_TARGET("avx2")
+unsigned int avx2_count_trailing_blank(const unsigned char* data, unsigned int num_bytes)
+{
+  const __m256i blank = _mm256_set1_epi8((char) BLANK_BYTE);
+  unsigned int i = num_bytes;
+  for (; i >= 32; i -= 32)
+  {
+    __m256i v = _mm256_loadu_si256((const __m256i*) (data + i - 32));
+    uint32_t mask = ~(uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, blank));
+    if (mask != 0)
+    {
+      return num_bytes - (i - 32 + highest_set_bit(mask) + 1);
+    }
+  }
+  return (num_bytes - i) + sse2_count_trailing_blank(data, i);
+}
+
+KERNEL_TARGET("avx2")
+uint32_t avx2_byte_sum(const unsigned char* data, unsigned int num_bytes)
+{
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i acc = _mm256_setzero_si256();
+  unsigned int i = 0;
+  for (; i + 32 <= num_bytes; i += 32)
+  {
+    acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_loadu_si256((const __m256i*) (data + i)), zero));
+  }
+  __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+  sum = _mm_add_epi64(sum, _mm_srli_si128(sum, 8));
+  return (uint32_t) _mm_cvtsi128_si32(sum) + sse2_byte_sum(data + i, num_bytes - i);
+}
+
+const kernel_table avx2_kernels =
+{
+  kernel_set::AVX2,
+  avx2_find_mismatch,
+  avx2_is_blank,
+  avx2_count_blank,
+  avx2_count_trailing_blank,
+  avx2_byte_sum,
+  sse2_crc32_update // Folding doesn't get any faster with wider vectors
+};
+
+#endif // defined(KERNELS_X86)
+
+
+
+const kernel_table* table_for(kernel_set set)
+{
+  switch (set)
+  {
+#ifdef KERNELS_X86
+  case kernel_set::AVX2:
+    return features().avx2 ? &avx2_kernels : nullptr;
+  
+  case kernel_set::SSE2:
+    return features().sse2 ? &sse2_kernels : nullptr;
+#endif
+  
+  case kernel_set::SCALAR:
+    return &scalar_kernels;
+  
+  default:
+    return nullptr;
+  }
+}
+
+const kernel_table* best_table()
+{
+  const kernel_table* t;
+  if ((t = table_for(kernel_set::AVX2)) != nullptr) return t;
+  if ((t = table_for(kernel_set::SSE2)) != nullptr) return t;
+  return &scalar_kernels;
+}
+
+std::atomic<const kernel_table*> active_table(nullptr);
+
+inline const kernel_table* kernels()
+{
+  const kernel_table* t = active_table.load(std::memory_order_acquire);
+  if (t == nullptr)
+  {
+    // Racing threads all pick the same table, so there's no harm in a tie
+    t = best_table();
+    active_table.store(t, std::memory_order_release);
+  }
+  return t;
+}
+
+}
+
+
+
+kernel_set best_kernel_set()
+{
+  return best_table()->set;
+}
+
+kernel_set active_kernel_set()
+{
+  return kernels()->set;
+}
+
+bool kernel_set_supported(kernel_set set)
+{
+  return table_for(set) != nullptr;
+}
+
+void select_kernel_set(kernel_set set)
+{
+  const kernel_table* t = table_for(set);
+  if (t == nullptr)
+  {
+    throw std::invalid_argument(std::string("Kernel set not supported by this processor: ") + kernel_set_name(set));
+  }
+  active_table.store(t, std::memory_order_release);
+}
+
+const char* kernel_set_name(kernel_set set)
+{
+  switch (set)
+  {
+  case kernel_set::SCALAR:
+    return "scalar";
+  
+  case kernel_set::SSE2:
+    return "SSE2";
+  
+  case kernel_set::AVX2:
+    return "AVX2";
+  
+  default:
+    return "unknown";
+  }
+}
+
+
+
+unsigned int find_mismatch(const unsigned char* a, const unsigned char* b, unsigned int num_bytes)
+{
+  return kernels()->find_mismatch(a, b, num_bytes);
+}
+
+bool is_blank(const unsigned char* data, unsigned int num_bytes)
+{
+  return kernels()->is_blank(data, num_bytes);
+}
+
+unsigned int count_blank(const unsigned char* data, unsigned int num_bytes)
+{
+  return kernels()->count_blank(data, num_bytes);
+}
+
+unsigned int count_trailing_blank(const unsigned char* data, unsigned int num_bytes)
+{
+  return kernels()->count_trailing_blank(data, num_bytes);
+}
+
+uint32_t byte_sum(const unsigned char* data, unsigned int num_bytes)
+{
+  return kernels()->byte_sum(data, num_bytes);
+}
+
+uint32_t crc32_update(uint32_t crc, const unsigned char* data, unsigned int num_bytes)
+{
+  return kernels()->crc32_update(crc, data, num_bytes);
+}
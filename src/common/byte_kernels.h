@@ -0,0 +1,140 @@
+/*! \file
+ *  \brief File containing the declarations of the byte scanning kernels.
+ *  
+ *  File containing the declarations of the byte scanning kernels used by the
+ *  cartridge layer to compare, blank-check and checksum blocks of data.
+ *  
+ *  Every kernel has a scalar implementation plus SSE2 and AVX2 versions on x86
+ *  processors. The fastest set the processor supports is picked the first time
+ *  any kernel is called. All sets produce identical results.
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-15
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#ifndef __BYTE_KERNELS_H__
+#define __BYTE_KERNELS_H__
+
+#include <cstdint>
+
+/*!
+ *  \brief Enum naming the available sets of kernel implementations.
+ */
+enum class kernel_set
+{
+  /*! \brief Portable implementations that work on any processor. */
+  SCALAR,
+  
+  /*! \brief 128-bit implementations for x86 processors with SSE2. CRC-32 also
+   *         requires PCLMULQDQ and falls back to \ref SCALAR without it.
+   */
+  SSE2,
+  
+  /*! \brief 256-bit implementations for x86 processors with AVX2. */
+  AVX2
+};
+
+/*!
+ *  \brief Gets the fastest kernel set supported by this processor.
+ */
+kernel_set best_kernel_set();
+
+/*!
+ *  \brief Gets the kernel set currently used by the kernel functions.
+ */
+kernel_set active_kernel_set();
+
+/*!
+ *  \brief Checks whether this processor supports the given kernel set.
+ */
+bool kernel_set_supported(kernel_set set);
+
+/*!
+ *  \brief Switches all kernel functions to the given set. Meant for testing
+ *         and benchmarking.
+ *  
+ *  \param [in] set The kernel set to use from now on.
+ *  
+ *  \throws std::invalid_argument If this processor does not support `set`.
+ */
+void select_kernel_set(kernel_set set);
+
+/*!
+ *  \brief Gets a printable name for the given kernel set.
+ */
+const char* kernel_set_name(kernel_set set);
+
+
+
+/*!
+ *  \brief Finds the first byte at which two buffers differ.
+ *  
+ *  \param [in] a The first buffer.
+ *  \param [in] b The second buffer.
+ *  \param [in] num_bytes The number of bytes to compare.
+ *  
+ *  \returns The index of the first differing byte, or `num_bytes` if the
+ *           buffers are identical.
+ */
+unsigned int find_mismatch(const unsigned char* a, const unsigned char* b, unsigned int num_bytes);
+
+/*!
+ *  \brief Checks whether every byte of a buffer is 0xFF, the value of erased
+ *         flash memory.
+ *  
+ *  \param [in] data The buffer to check.
+ *  \param [in] num_bytes The number of bytes in `data`.
+ */
+bool is_blank(const unsigned char* data, unsigned int num_bytes);
+
+/*!
+ *  \brief Counts the run of 0xFF bytes at the beginning of a buffer.
+ *  
+ *  \param [in] data The buffer to scan.
+ *  \param [in] num_bytes The number of bytes in `data`.
+ *  
+ *  \returns The index of the first byte that isn't 0xFF, or `num_bytes` if
+ *           the whole buffer is blank.
+ */
+unsigned int count_blank(const unsigned char* data, unsigned int num_bytes);
+
+/*!
+ *  \brief Counts the run of 0xFF bytes at the end of a buffer.
+ *  
+ *  \param [in] data The buffer to scan.
+ *  \param [in] num_bytes The number of bytes in `data`.
+ *  
+ *  \returns The number of bytes that can be trimmed from the end of `data`
+ *           without losing anything but erased memory.
+ */
+unsigned int count_trailing_blank(const unsigned char* data, unsigned int num_bytes);
+
+/*!
+ *  \brief Adds up every byte of a buffer.
+ *  
+ *  Used for header checksums such as the WonderSwan's, which is the low 16
+ *  bits of this sum over the ROM.
+ *  
+ *  \param [in] data The buffer to sum.
+ *  \param [in] num_bytes The number of bytes in `data`.
+ *  
+ *  \returns The sum of all bytes, modulo 2^32.
+ */
+uint32_t byte_sum(const unsigned char* data, unsigned int num_bytes);
+
+/*!
+ *  \brief Feeds bytes into a running standard (IEEE 802.3) CRC-32 register.
+ *  
+ *  The register is not finalized: start from 0xFFFFFFFF and invert the result
+ *  once all data has been fed in. \ref crc32 takes care of this.
+ *  
+ *  \param [in] crc The running CRC register.
+ *  \param [in] data The bytes to feed in.
+ *  \param [in] num_bytes The number of bytes in `data`.
+ *  
+ *  \returns The updated CRC register.
+ */
+uint32_t crc32_update(uint32_t crc, const unsigned char* data, unsigned int num_bytes);
+
+#endif /* defined(__BYTE_KERNELS_H__) */
@@ -0,0 +1,35 @@
+/*! \file
+ *  \brief File containing the implementation of \ref crc32.
+ *  
+ *  File containing the implementation of \ref crc32.
+ *  
+ *  \see crc32
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-08
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#include "crc32.h"
+#include "byte_kernels.h"
+
+crc32::crc32()
+  : m_crc(0xFFFFFFFF)
+{
+  // Nothing else to do
+}
+
+void crc32::update(const unsigned char* data, unsigned int num_bytes)
+{
+  m_crc = crc32_update(m_crc, data, num_bytes);
+}
+
+uint32_t crc32::value() const
+{
+  return m_crc ^ 0xFFFFFFFF;
+}
+
+void crc32::reset()
+{
+  m_crc = 0xFFFFFFFF;
+}
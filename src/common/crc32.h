@@ -0,0 +1,46 @@
+/*! \file
+ *  \brief File containing the declaration of the \ref crc32 class.
+ *  
+ *  File containing the header information and declaration of the \ref crc32
+ *  class.
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-08
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#ifndef __CRC32_H__
+#define __CRC32_H__
+
+#include <cstdint>
+
+/*! \class crc32
+ *  \brief Incremental calculator for the standard (IEEE 802.3) CRC-32, as
+ *         used by zip and most ROM databases.
+ *  
+ *  Data can be fed in any number of pieces. \ref value() may be called at any
+ *  point without disturbing the running calculation.
+ */
+class crc32
+{
+public:
+  
+  /*! \brief Constructs a calculator for an empty message. */
+                        crc32();
+  
+  /*! \brief Feeds the given bytes into the running calculation. */
+  void                  update(const unsigned char* data, unsigned int num_bytes);
+  
+  /*! \brief Gets the CRC of all bytes fed in so far. */
+  uint32_t              value() const;
+  
+  /*! \brief Restarts the calculation for a new, empty message. */
+  void                  reset();
+
+private:
+  
+  /*! \brief Running, non-finalized CRC register. */
+  uint32_t              m_crc;
+};
+
+#endif /* defined(__CRC32_H__) */
@@ -0,0 +1,115 @@
+/*! \file
+ *  \brief File containing the implementations of \ref image_sink,
+ *         \ref stream_image_sink, and \ref mapped_image_sink.
+ *  
+ *  File containing the implementations of \ref image_sink,
+ *  \ref stream_image_sink, and \ref mapped_image_sink.
+ *  
+ *  \see image_sink
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-17
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#include "image_sink.h"
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+
+image_sink::~image_sink()
+{
+  // Nothing else to do
+}
+
+
+
+stream_image_sink::stream_image_sink(std::ostream& out)
+  : m_out(out), m_base(0)
+{
+  // Nothing else to do
+}
+
+void stream_image_sink::begin(unsigned int num_bytes)
+{
+  (void) num_bytes;
+  m_base = m_out.tellp();
+}
+
+unsigned char* stream_image_sink::acquire(unsigned int offset, unsigned int num_bytes, unsigned char* scratch)
+{
+  (void) offset;
+  (void) num_bytes;
+  return scratch;
+}
+
+void stream_image_sink::commit(unsigned int offset, const unsigned char* data, unsigned int num_bytes)
+{
+  if (!m_out.good())
+  {
+    throw std::runtime_error("Unable to write to image");
+  }
+  
+  // Writes are usually sequential, so avoid seeking when possible
+  if (m_base >= 0 && m_out.tellp() != m_base + (std::streamoff) offset)
+  {
+    m_out.seekp(m_base + (std::streamoff) offset);
+  }
+  
+  m_out.write((const char*) data, num_bytes);
+  if (!m_out.good())
+  {
+    throw std::runtime_error("Unable to write to image");
+  }
+}
+
+void stream_image_sink::end(unsigned int num_bytes)
+{
+  (void) num_bytes;
+  m_out.flush();
+}
+
+
+
+mapped_image_sink::mapped_image_sink(const std::string& filename)
+  : m_file()
+{
+  m_file.create(filename);
+}
+
+void mapped_image_sink::begin(unsigned int num_bytes)
+{
+  m_file.resize(num_bytes);
+}
+
+unsigned char* mapped_image_sink::acquire(unsigned int offset, unsigned int num_bytes, unsigned char* scratch)
+{
+  (void) scratch;
+  
+  if (offset > m_file.size() || num_bytes > m_file.size() - offset)
+  {
+    throw std::runtime_error("Write past end of image");
+  }
+  
+  return m_file.data() + offset;
+}
+
+void mapped_image_sink::commit(unsigned int offset, const unsigned char* data, unsigned int num_bytes)
+{
+  // Data was written in place, unless the caller filled some other buffer
+  if (data != m_file.data() + offset)
+  {
+    unsigned char* dest = acquire(offset, num_bytes, nullptr);
+    std::copy(data, data + num_bytes, dest);
+  }
+}
+
+void mapped_image_sink::end(unsigned int num_bytes)
+{
+  // Drop whatever was reserved but never filled in
+  if (num_bytes != m_file.size())
+  {
+    m_file.resize(num_bytes);
+  }
+  m_file.flush();
+}
@@ -0,0 +1,175 @@
+/*! \file
+ *  \brief File containing the declarations of \ref image_sink and its
+ *         implementations.
+ *  
+ *  File containing the header information and declarations of the
+ *  \ref image_sink interface and the \ref stream_image_sink and
+ *  \ref mapped_image_sink classes.
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-17
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#ifndef __IMAGE_SINK_H__
+#define __IMAGE_SINK_H__
+
+#include "mapped_file.h"
+#include <ios>
+#include <string>
+
+/*! \class image_sink
+ *  \brief Random-access destination for an image read from a cartridge.
+ *  
+ *  Cartridge operations announce the size of the image with
+ *  \ref begin(unsigned int), then repeatedly \ref acquire() a buffer for the
+ *  next range of bytes, fill it, and \ref commit() it. Implementations that
+ *  hold the image in memory hand out pointers into it so data can be read
+ *  straight into place; others let the caller fill a scratch buffer and copy
+ *  it out on commit. \ref end(unsigned int) finishes the image at its final
+ *  size, which is smaller than announced if the operation was cut short.
+ */
+class image_sink
+{
+public:
+  
+  /*! \brief Destructor for this object. */
+  virtual               ~image_sink();
+  
+  /*! \brief Prepares the sink for an image of the given size.
+   *  
+   *  \param [in] num_bytes The expected size of the image in bytes.
+   *  
+   *  \throws std::runtime_error If the sink cannot hold that many bytes.
+   */
+  virtual void          begin(unsigned int num_bytes) = 0;
+  
+  /*! \brief Gets a buffer to fill with a range of bytes of the image.
+   *  
+   *  \param [in] offset The offset of the first byte of the range.
+   *  \param [in] num_bytes The number of bytes in the range.
+   *  \param [in] scratch Buffer of at least `num_bytes` bytes that the sink
+   *         may hand back if it can't expose its own memory.
+   *  
+   *  \returns Pointer to fill with the range. Either points into the sink's
+   *           own memory or to `scratch`.
+   *  
+   *  \throws std::runtime_error If the range extends past the announced size
+   *          of the image.
+   */
+  virtual unsigned char* acquire(unsigned int offset, unsigned int num_bytes, unsigned char* scratch) = 0;
+  
+  /*! \brief Stores a range of bytes previously obtained with \ref acquire().
+   *  
+   *  \param [in] offset The offset the range was acquired at.
+   *  \param [in] data The pointer returned by \ref acquire().
+   *  \param [in] num_bytes The number of bytes that were filled in.
+   *  
+   *  \throws std::runtime_error If the bytes could not be stored.
+   */
+  virtual void          commit(unsigned int offset, const unsigned char* data, unsigned int num_bytes) = 0;
+  
+  /*! \brief Finishes the image.
+   *  
+   *  \param [in] num_bytes The number of bytes actually committed, from the
+   *         start of the image.
+   *  
+   *  \throws std::runtime_error If the image could not be finished.
+   */
+  virtual void          end(unsigned int num_bytes) = 0;
+};
+
+
+
+/*! \class stream_image_sink
+ *  \brief \ref image_sink that writes to an output stream.
+ *  
+ *  Ranges are filled in the caller's scratch buffer and written out to the
+ *  stream on commit.
+ */
+class stream_image_sink: public image_sink
+{
+public:
+  
+  /*! \brief Constructs a sink writing to the given stream.
+   *  
+   *  \param [in] out The stream to write to. Must outlive this object.
+   */
+                        stream_image_sink(std::ostream& out);
+  
+  /*!
+   *  \see image_sink::begin(unsigned int)
+   */
+  void                  begin(unsigned int num_bytes);
+  
+  /*!
+   *  \see image_sink::acquire(unsigned int, unsigned int, unsigned char*)
+   */
+  unsigned char*        acquire(unsigned int offset, unsigned int num_bytes, unsigned char* scratch);
+  
+  /*!
+   *  \see image_sink::commit(unsigned int, const unsigned char*, unsigned int)
+   */
+  void                  commit(unsigned int offset, const unsigned char* data, unsigned int num_bytes);
+  
+  /*!
+   *  \see image_sink::end(unsigned int)
+   */
+  void                  end(unsigned int num_bytes);
+
+private:
+  
+  /*! \brief The stream being written to. */
+  std::ostream&         m_out;
+  
+  /*! \brief Stream position the image starts at. */
+  std::streamoff        m_base;
+};
+
+
+
+/*! \class mapped_image_sink
+ *  \brief \ref image_sink backed by a memory-mapped file.
+ *  
+ *  Ranges point straight into the mapped file, so data read from the
+ *  cartridge lands in the file without being copied.
+ */
+class mapped_image_sink: public image_sink
+{
+public:
+  
+  /*! \brief Creates the given file, replacing any existing file.
+   *  
+   *  \param [in] filename The path of the file to write to.
+   *  
+   *  \throws std::runtime_error If the file cannot be created.
+   */
+                        mapped_image_sink(const std::string& filename);
+  
+  /*!
+   *  \see image_sink::begin(unsigned int)
+   */
+  void                  begin(unsigned int num_bytes);
+  
+  /*!
+   *  \see image_sink::acquire(unsigned int, unsigned int, unsigned char*)
+   */
+  unsigned char*        acquire(unsigned int offset, unsigned int num_bytes, unsigned char* scratch);
+  
+  /*!
+   *  \see image_sink::commit(unsigned int, const unsigned char*, unsigned int)
+   */
+  void                  commit(unsigned int offset, const unsigned char* data, unsigned int num_bytes);
+  
+  /*!
+   *  \see image_sink::end(unsigned int)
+   */
+  void                  end(unsigned int num_bytes);
+
+private:
+  
+  /*! \brief The mapped file. */
+  mapped_file           m_file;
+};
+
+#endif /* defined(__IMAGE_SINK_H__) */
@@ -0,0 +1,90 @@
+/*! \file
+ *  \brief File containing the implementations of \ref image_source,
+ *         \ref stream_image_source, and \ref mapped_image_source.
+ *  
+ *  File containing the implementations of \ref image_source,
+ *  \ref stream_image_source, and \ref mapped_image_source.
+ *  
+ *  \see image_source
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-17
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#include "image_source.h"
+#include <iostream>
+#include <stdexcept>
+
+image_source::~image_source()
+{
+  // Nothing else to do
+}
+
+
+
+stream_image_source::stream_image_source(std::istream& in)
+  : m_in(in), m_size(0)
+{
+  // Ensure argument type is not the standard input
+  if (&in == &std::cin)
+  {
+    throw std::invalid_argument("Standard input cannot be used in cartridge operations");
+  }
+  
+  m_in.seekg(0, m_in.end);
+  m_size = (unsigned int) m_in.tellg();
+  m_in.seekg(0, m_in.beg);
+}
+
+unsigned int stream_image_source::size() const
+{
+  return m_size;
+}
+
+const unsigned char* stream_image_source::view(unsigned int offset, unsigned int num_bytes, unsigned char* scratch)
+{
+  if (offset > m_size || num_bytes > m_size - offset)
+  {
+    throw std::runtime_error("Read past end of image");
+  }
+  
+  // Reads are usually sequential, so avoid seeking when possible
+  if ((unsigned int) m_in.tellg() != offset)
+  {
+    m_in.seekg(offset, m_in.beg);
+  }
+  
+  m_in.read((char*) scratch, num_bytes);
+  if ((unsigned int) m_in.gcount() != num_bytes)
+  {
+    throw std::runtime_error("Unable to read from image");
+  }
+  
+  return scratch;
+}
+
+
+
+mapped_image_source::mapped_image_source(const std::string& filename)
+  : m_file()
+{
+  m_file.open(filename);
+}
+
+unsigned int mapped_image_source::size() const
+{
+  return m_file.size();
+}
+
+const unsigned char* mapped_image_source::view(unsigned int offset, unsigned int num_bytes, unsigned char* scratch)
+{
+  (void) scratch;
+  
+  if (offset > m_file.size() || num_bytes > m_file.size() - offset)
+  {
+    throw std::runtime_error("Read past end of image");
+  }
+  
+  return m_file.data() + offset;
+}
@@ -0,0 +1,133 @@
+/*! \file
+ *  \brief File containing the declarations of \ref image_source and its
+ *         implementations.
+ *  
+ *  File containing the header information and declarations of the
+ *  \ref image_source interface and the \ref stream_image_source and
+ *  \ref mapped_image_source classes.
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-17
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#ifndef __IMAGE_SOURCE_H__
+#define __IMAGE_SOURCE_H__
+
+#include "mapped_file.h"
+#include <iosfwd>
+#include <string>
+
+/*! \class image_source
+ *  \brief Random-access, read-only view of an image to be written to or
+ *         compared with a cartridge.
+ *  
+ *  Cartridge operations ask for the range of bytes they need next and get
+ *  back a pointer to it. Implementations that already hold the image in
+ *  memory hand out pointers into it directly; others copy the range into a
+ *  scratch buffer supplied by the caller.
+ */
+class image_source
+{
+public:
+  
+  /*! \brief Destructor for this object. */
+  virtual               ~image_source();
+  
+  /*! \brief Gets the size of the image in bytes. */
+  virtual unsigned int  size() const = 0;
+  
+  /*! \brief Gets a view of a range of bytes of the image.
+   *  
+   *  The returned pointer stays valid until the next call to this function or
+   *  until the source is destroyed, whichever comes first.
+   *  
+   *  \param [in] offset The offset of the first byte to view.
+   *  \param [in] num_bytes The number of bytes to view.
+   *  \param [out] scratch Buffer of at least `num_bytes` bytes that the source
+   *         may copy the range into if it can't be viewed directly.
+   *  
+   *  \returns Pointer to the first byte of the range. Either points into the
+   *           source's own memory or to `scratch`.
+   *  
+   *  \throws std::runtime_error If the range extends past the end of the
+   *          image or could not be read.
+   */
+  virtual const unsigned char* view(unsigned int offset, unsigned int num_bytes, unsigned char* scratch) = 0;
+};
+
+
+
+/*! \class stream_image_source
+ *  \brief \ref image_source that reads from a seekable input stream.
+ *  
+ *  Every view is copied from the stream into the caller's scratch buffer.
+ */
+class stream_image_source: public image_source
+{
+public:
+  
+  /*! \brief Constructs a source reading from the given stream. Determines the
+   *         size of the image by seeking to the end of the stream.
+   *  
+   *  \param [in] in The stream to read from. Must outlive this object.
+   *  
+   *  \throws std::invalid_argument If `in` is the standard input.
+   */
+                        stream_image_source(std::istream& in);
+  
+  /*!
+   *  \see image_source::size()
+   */
+  unsigned int          size() const;
+  
+  /*!
+   *  \see image_source::view(unsigned int, unsigned int, unsigned char*)
+   */
+  const unsigned char*  view(unsigned int offset, unsigned int num_bytes, unsigned char* scratch);
+
+private:
+  
+  /*! \brief The stream being read from. */
+  std::istream&         m_in;
+  
+  /*! \brief Size of the stream's contents in bytes. */
+  unsigned int          m_size;
+};
+
+
+
+/*! \class mapped_image_source
+ *  \brief \ref image_source backed by a memory-mapped file.
+ *  
+ *  Views point straight into the mapped file; no data is ever copied.
+ */
+class mapped_image_source: public image_source
+{
+public:
+  
+  /*! \brief Opens and maps the given file.
+   *  
+   *  \param [in] filename The path of the file to read from.
+   *  
+   *  \throws std::runtime_error If the file cannot be opened or mapped.
+   */
+                        mapped_image_source(const std::string& filename);
+  
+  /*!
+   *  \see image_source::size()
+   */
+  unsigned int          size() const;
+  
+  /*!
+   *  \see image_source::view(unsigned int, unsigned int, unsigned char*)
+   */
+  const unsigned char*  view(unsigned int offset, unsigned int num_bytes, unsigned char* scratch);
+
+private:
+  
+  /*! \brief The mapped file. */
+  mapped_file           m_file;
+};
+
+#endif /* defined(__IMAGE_SOURCE_H__) */
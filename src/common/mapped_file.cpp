@@ -0,0 +1,260 @@
+/*! \file
+ *  \brief File containing the implementation of \ref mapped_file.
+ *  
+ *  File containing the implementation of \ref mapped_file.
+ *  
+ *  \see mapped_file
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-17
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#include "mapped_file.h"
+#include <stdexcept>
+
+#if defined(OS_WINDOWS)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+mapped_file::mapped_file()
+#if defined(OS_WINDOWS)
+  : m_file(nullptr), m_mapping(nullptr),
+#else
+  : m_fd(-1),
+#endif
+    m_writable(false), m_data(nullptr), m_size(0)
+{
+  // Nothing else to do
+}
+
+mapped_file::~mapped_file()
+{
+  close();
+}
+
+
+
+void mapped_file::open(const std::string& filename)
+{
+  close();
+
+#if defined(OS_WINDOWS)
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    throw std::runtime_error("Unable to open file");
+  }
+  
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart > 0xFFFFFFFFLL)
+  {
+    CloseHandle(file);
+    throw std::runtime_error("Unable to determine file size");
+  }
+  m_file = file;
+  m_size = (unsigned int) file_size.QuadPart;
+#else
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    throw std::runtime_error("Unable to open file");
+  }
+  
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || (unsigned long long) file_stat.st_size > 0xFFFFFFFFULL)
+  {
+    ::close(fd);
+    throw std::runtime_error("Unable to determine file size");
+  }
+  m_fd = fd;
+  m_size = (unsigned int) file_stat.st_size;
+#endif
+  
+  m_writable = false;
+  
+  try
+  {
+    map();
+  }
+  catch (std::exception& ex)
+  {
+    (void) ex;
+    close();
+    throw;
+  }
+}
+
+void mapped_file::create(const std::string& filename)
+{
+  close();
+
+#if defined(OS_WINDOWS)
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    throw std::runtime_error("Unable to create file");
+  }
+  m_file = file;
+#else
+  int fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+  {
+    throw std::runtime_error("Unable to create file");
+  }
+  m_fd = fd;
+#endif
+  
+  m_writable = true;
+  m_size = 0;
+}
+
+void mapped_file::resize(unsigned int num_bytes)
+{
+  if (!is_open() || !m_writable)
+  {
+    throw std::runtime_error("File not open for writing");
+  }
+  
+  unmap();
+
+#if defined(OS_WINDOWS)
+  LARGE_INTEGER file_size;
+  file_size.QuadPart = num_bytes;
+  if (!SetFilePointerEx((HANDLE) m_file, file_size, nullptr, FILE_BEGIN) || !SetEndOfFile((HANDLE) m_file))
+  {
+    throw std::runtime_error("Unable to resize file");
+  }
+#else
+  if (ftruncate(m_fd, (off_t) num_bytes) != 0)
+  {
+    throw std::runtime_error("Unable to resize file");
+  }
+#endif
+  
+  m_size = num_bytes;
+  map();
+}
+
+void mapped_file::flush()
+{
+  if (!m_writable || m_data == nullptr)
+  {
+    return;
+  }
+
+#if defined(OS_WINDOWS)
+  if (!FlushViewOfFile(m_data, 0) || !FlushFileBuffers((HANDLE) m_file))
+#else
+  if (msync(m_data, m_size, MS_SYNC) != 0)
+#endif
+  {
+    throw std::runtime_error("Unable to write file");
+  }
+}
+
+void mapped_file::close()
+{
+  unmap();
+
+#if defined(OS_WINDOWS)
+  if (m_file != nullptr)
+  {
+    CloseHandle((HANDLE) m_file);
+    m_file = nullptr;
+  }
+#else
+  if (m_fd >= 0)
+  {
+    ::close(m_fd);
+    m_fd = -1;
+  }
+#endif
+  
+  m_writable = false;
+  m_size = 0;
+}
+
+bool mapped_file::is_open() const
+{
+#if defined(OS_WINDOWS)
+  return m_file != nullptr;
+#else
+  return m_fd >= 0;
+#endif
+}
+
+bool mapped_file::writable() const
+{
+  return m_writable;
+}
+
+unsigned char* mapped_file::data() const
+{
+  return m_data;
+}
+
+unsigned int mapped_file::size() const
+{
+  return m_size;
+}
+
+
+
+void mapped_file::map()
+{
+  // Empty mappings aren't allowed, so empty files simply have no data pointer
+  if (m_size == 0)
+  {
+    return;
+  }
+
+#if defined(OS_WINDOWS)
+  HANDLE mapping = CreateFileMappingA((HANDLE) m_file, nullptr, (m_writable ? PAGE_READWRITE : PAGE_READONLY), 0, m_size, nullptr);
+  if (mapping == nullptr)
+  {
+    throw std::runtime_error("Unable to map file");
+  }
+  
+  void* view = MapViewOfFile(mapping, (m_writable ? FILE_MAP_WRITE : FILE_MAP_READ), 0, 0, m_size);
+  if (view == nullptr)
+  {
+    CloseHandle(mapping);
+    throw std::runtime_error("Unable to map file");
+  }
+  
+  m_mapping = mapping;
+  m_data = (unsigned char*) view;
+#else
+  void* view = mmap(nullptr, m_size, (m_writable ? PROT_READ | PROT_WRITE : PROT_READ), MAP_SHARED, m_fd, 0);
+  if (view == MAP_FAILED)
+  {
+    throw std::runtime_error("Unable to map file");
+  }
+  
+  m_data = (unsigned char*) view;
+#endif
+}
+
+void mapped_file::unmap()
+{
+  if (m_data == nullptr)
+  {
+    return;
+  }
+
+#if defined(OS_WINDOWS)
+  UnmapViewOfFile(m_data);
+  CloseHandle((HANDLE) m_mapping);
+  m_mapping = nullptr;
+#else
+  munmap(m_data, m_size);
+#endif
+  
+  m_data = nullptr;
+}
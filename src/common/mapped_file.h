@@ -0,0 +1,137 @@
+/*! \file
+ *  \brief File containing the declaration of the \ref mapped_file class.
+ *  
+ *  File containing the header information and declaration of the
+ *  \ref mapped_file class.
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-17
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#ifndef __MAPPED_FILE_H__
+#define __MAPPED_FILE_H__
+
+#include <string>
+
+/*! \class mapped_file
+ *  \brief A file whose contents are mapped into memory.
+ *  
+ *  Wraps the platform's memory mapping facilities (`mmap()` on Linux and OS X,
+ *  file mapping objects on Windows) so that a whole file can be accessed
+ *  through a single pointer. Files can be opened read-only or created for
+ *  writing, in which case they must be sized with \ref resize(unsigned int)
+ *  before anything can be written.
+ *  
+ *  Empty files are never mapped; \ref data() returns `nullptr` for them.
+ *  
+ *  This class is not thread-safe.
+ */
+class mapped_file
+{
+public:
+  
+  /*! \brief Constructs an object with no file open. */
+                        mapped_file();
+  
+  /*! \brief Destructor for this object. Unmaps and closes the file, if any. */
+                        ~mapped_file();
+  
+  
+  
+  /*! \brief Opens an existing file and maps it read-only.
+   *  
+   *  \param [in] filename The path of the file to open.
+   *  
+   *  \throws std::runtime_error If the file cannot be opened or mapped.
+   */
+  void                  open(const std::string& filename);
+  
+  /*! \brief Creates a file, or truncates an existing one, and opens it for
+   *         writing.
+   *  
+   *  The new file is empty. Use \ref resize(unsigned int) to make room for
+   *  data.
+   *  
+   *  \param [in] filename The path of the file to create.
+   *  
+   *  \throws std::runtime_error If the file cannot be created.
+   */
+  void                  create(const std::string& filename);
+  
+  /*! \brief Changes the size of a file opened with
+   *         \ref create(const std::string&) and maps it again.
+   *  
+   *  Any pointer previously returned by \ref data() becomes invalid. Growing
+   *  the file fills the new space with zeroes; shrinking it discards
+   *  everything past the new end.
+   *  
+   *  \param [in] num_bytes The new size of the file.
+   *  
+   *  \throws std::runtime_error If the file is not open for writing or cannot
+   *          be resized or mapped.
+   */
+  void                  resize(unsigned int num_bytes);
+  
+  /*! \brief Writes modified pages back to disk. Does nothing for read-only
+   *         files.
+   *  
+   *  \throws std::runtime_error If the pages cannot be written.
+   */
+  void                  flush();
+  
+  /*! \brief Unmaps and closes the file. Does nothing if no file is open. */
+  void                  close();
+  
+  /*! \brief Checks whether a file is currently open. */
+  bool                  is_open() const;
+  
+  /*! \brief Checks whether the open file was opened for writing. */
+  bool                  writable() const;
+  
+  /*! \brief Gets a pointer to the mapped contents of the file, or `nullptr`
+   *         if the file is empty or not open.
+   */
+  unsigned char*        data() const;
+  
+  /*! \brief Gets the size of the open file in bytes. */
+  unsigned int          size() const;
+
+
+
+private:
+  
+  /*! \brief Copy constructor. Deleted. */
+                        mapped_file(const mapped_file& other) = delete;
+  
+  /*! \brief Copy assignment operator. Deleted. */
+  mapped_file&          operator=(const mapped_file& other) = delete;
+  
+  /*! \brief Maps \ref m_size bytes of the open file into memory. */
+  void                  map();
+  
+  /*! \brief Releases the current mapping, if any. */
+  void                  unmap();
+
+#if defined(OS_WINDOWS)
+  /*! \brief Handle of the open file. */
+  void*                 m_file;
+  
+  /*! \brief Handle of the file mapping object backing \ref m_data. */
+  void*                 m_mapping;
+#else
+  /*! \brief Descriptor of the open file, or -1. */
+  int                   m_fd;
+#endif
+  
+  /*! \brief Whether the file was opened for writing. */
+  bool                  m_writable;
+  
+  /*! \brief Start of the mapped contents, or `nullptr`. */
+  unsigned char*        m_data;
+  
+  /*! \brief Size of the file in bytes. */
+  unsigned int          m_size;
+};
+
+#endif /* defined(__MAPPED_FILE_H__) */
@@ -0,0 +1,146 @@
+/*! \file
+ *  \brief File containing the implementation of \ref sha1.
+ *  
+ *  File containing the implementation of \ref sha1.
+ *  
+ *  \see sha1
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-08
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#include "sha1.h"
+#include <cstring>
+
+#define ROTL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+sha1::sha1()
+{
+  reset();
+}
+
+void sha1::update(const unsigned char* data, unsigned int num_bytes)
+{
+  m_num_bytes += num_bytes;
+  
+  // Top off a partially filled chunk first
+  if (m_chunk_size > 0)
+  {
+    unsigned int n = 64 - m_chunk_size;
+    if (n > num_bytes) n = num_bytes;
+    memcpy(m_chunk + m_chunk_size, data, n);
+    m_chunk_size += n;
+    data += n;
+    num_bytes -= n;
+    
+    if (m_chunk_size < 64) return;
+    process_chunk(m_chunk);
+    m_chunk_size = 0;
+  }
+  
+  // Process whole chunks straight from the caller's buffer
+  while (num_bytes >= 64)
+  {
+    process_chunk(data);
+    data += 64;
+    num_bytes -= 64;
+  }
+  
+  memcpy(m_chunk, data, num_bytes);
+  m_chunk_size = num_bytes;
+}
+
+void sha1::digest(unsigned char* digest) const
+{
+  // Pad a copy so the running calculation can continue afterwards
+  sha1 copy(*this);
+  uint64_t num_bits = m_num_bytes * 8;
+  
+  unsigned char padding[72] = { 0x80 };
+  unsigned int padding_size = (copy.m_chunk_size < 56 ? 56 - copy.m_chunk_size : 120 - copy.m_chunk_size);
+  for (int i = 0; i < 8; ++i)
+  {
+    padding[padding_size + i] = (unsigned char) (num_bits >> (56 - 8 * i));
+  }
+  copy.update(padding, padding_size + 8);
+  
+  for (int i = 0; i < 5; ++i)
+  {
+    digest[4 * i + 0] = (unsigned char) (copy.m_state[i] >> 24);
+    digest[4 * i + 1] = (unsigned char) (copy.m_state[i] >> 16);
+    digest[4 * i + 2] = (unsigned char) (copy.m_state[i] >> 8);
+    digest[4 * i + 3] = (unsigned char) (copy.m_state[i]);
+  }
+}
+
+void sha1::reset()
+{
+  m_state[0] = 0x67452301;
+  m_state[1] = 0xEFCDAB89;
+  m_state[2] = 0x98BADCFE;
+  m_state[3] = 0x10325476;
+  m_state[4] = 0xC3D2E1F0;
+  m_chunk_size = 0;
+  m_num_bytes = 0;
+}
+
+
+
+void sha1::process_chunk(const unsigned char* chunk)
+{
+  uint32_t w[80];
+  for (int i = 0; i < 16; ++i)
+  {
+    w[i] = ((uint32_t) chunk[4 * i] << 24) | ((uint32_t) chunk[4 * i + 1] << 16)
+           | ((uint32_t) chunk[4 * i + 2] << 8) | ((uint32_t) chunk[4 * i + 3]);
+  }
+  for (int i = 16; i < 80; ++i)
+  {
+    w[i] = ROTL(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+  }
+  
+  uint32_t a = m_state[0];
+  uint32_t b = m_state[1];
+  uint32_t c = m_state[2];
+  uint32_t d = m_state[3];
+  uint32_t e = m_state[4];
+  
+  for (int i = 0; i < 80; ++i)
+  {
+    uint32_t f, k;
+    if (i < 20)
+    {
+      f = (b & c) | (~b & d);
+      k = 0x5A827999;
+    }
+    else if (i < 40)
+    {
+      f = b ^ c ^ d;
+      k = 0x6ED9EBA1;
+    }
+    else if (i < 60)
+    {
+      f = (b & c) | (b & d) | (c & d);
+      k = 0x8F1BBCDC;
+    }
+    else
+    {
+      f = b ^ c ^ d;
+      k = 0xCA62C1D6;
+    }
+    
+    uint32_t temp = ROTL(a, 5) + f + e + k + w[i];
+    e = d;
+    d = c;
+    c = ROTL(b, 30);
+    b = a;
+    a = temp;
+  }
+  
+  m_state[0] += a;
+  m_state[1] += b;
+  m_state[2] += c;
+  m_state[3] += d;
+  m_state[4] += e;
+}
@@ -0,0 +1,64 @@
+/*! \file
+ *  \brief File containing the declaration of the \ref sha1 class.
+ *  
+ *  File containing the header information and declaration of the \ref sha1
+ *  class.
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-08
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#ifndef __SHA1_H__
+#define __SHA1_H__
+
+#include <cstdint>
+
+/*! \class sha1
+ *  \brief Incremental calculator for SHA-1 digests.
+ *  
+ *  Used for identifying ROM contents alongside \ref crc32, matching what ROM
+ *  databases commonly publish. Data can be fed in any number of pieces.
+ *  \ref digest() may be called at any point without disturbing the running
+ *  calculation.
+ */
+class sha1
+{
+public:
+  
+  /*! \brief Size of a digest in bytes. */
+  static const unsigned int DIGEST_SIZE = 20;
+  
+  /*! \brief Constructs a calculator for an empty message. */
+                        sha1();
+  
+  /*! \brief Feeds the given bytes into the running calculation. */
+  void                  update(const unsigned char* data, unsigned int num_bytes);
+  
+  /*! \brief Writes the digest of all bytes fed in so far to `digest`, which
+   *         must hold \ref DIGEST_SIZE bytes.
+   */
+  void                  digest(unsigned char* digest) const;
+  
+  /*! \brief Restarts the calculation for a new, empty message. */
+  void                  reset();
+
+private:
+  
+  /*! \brief Mixes a single 64-byte chunk into \ref m_state. */
+  void                  process_chunk(const unsigned char* chunk);
+  
+  /*! \brief Intermediate hash state. */
+  uint32_t              m_state[5];
+  
+  /*! \brief Bytes not yet making up a full chunk. */
+  unsigned char         m_chunk[64];
+  
+  /*! \brief Number of valid bytes in \ref m_chunk. */
+  unsigned int          m_chunk_size;
+  
+  /*! \brief Total number of bytes fed in so far. */
+  uint64_t              m_num_bytes;
+};
+
+#endif /* defined(__SHA1_H__) */
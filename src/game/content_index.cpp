@@ -0,0 +1,85 @@
+#include "content_index.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+content_index::content_index()
+  : m_entries()
+{
+  // Nothing else to do
+}
+
+bool content_index::add(unsigned int num_bytes, uint32_t crc32, const char* sha1_hex, const game_descriptor* descriptor)
+{
+  entry e;
+  e.crc32 = crc32;
+  e.num_bytes = num_bytes;
+  e.has_sha1 = (sha1_hex != nullptr && sha1_hex[0] != '\0');
+  e.descriptor = descriptor;
+  memset(e.sha1_digest, 0, sizeof(e.sha1_digest));
+  
+  if (e.has_sha1)
+  {
+    if (strlen(sha1_hex) != 2 * sha1::DIGEST_SIZE)
+    {
+      return false;
+    }
+    
+    for (unsigned int i = 0; i < 2 * sha1::DIGEST_SIZE; ++i)
+    {
+      char c = sha1_hex[i];
+      unsigned char nibble;
+      if (c >= '0' && c <= '9') nibble = (unsigned char) (c - '0');
+      else if (c >= 'a' && c <= 'f') nibble = (unsigned char) (c - 'a' + 10);
+      else if (c >= 'A' && c <= 'F') nibble = (unsigned char) (c - 'A' + 10);
+      else return false;
+      
+      e.sha1_digest[i / 2] |= (i % 2 == 0 ? nibble << 4 : nibble);
+    }
+  }
+  
+  m_entries.push_back(e);
+  return true;
+}
+
+void content_index::finalize()
+{
+  std::stable_sort(m_entries.begin(), m_entries.end(), [](const entry& a, const entry& b)
+  {
+    return a.crc32 < b.crc32;
+  });
+}
+
+const game_descriptor* content_index::find(const std::vector<content_hash>& hashes) const
+{
+  // A read usually covers more than the game, so try the largest prefix first
+  for (auto hash = hashes.rbegin(); hash != hashes.rend(); ++hash)
+  {
+    auto it = std::lower_bound(m_entries.begin(), m_entries.end(), hash->crc32, [](const entry& e, uint32_t crc32)
+    {
+      return e.crc32 < crc32;
+    });
+    
+    for (; it != m_entries.end() && it->crc32 == hash->crc32; ++it)
+    {
+      if (it->num_bytes != hash->num_bytes)
+      {
+        continue;
+      }
+      if (it->has_sha1 && memcmp(it->sha1_digest, hash->sha1_digest, sizeof(it->sha1_digest)) != 0)
+      {
+        continue;
+      }
+      return it->descriptor;
+    }
+  }
+  
+  return nullptr;
+}
+
+bool content_index::empty() const
+{
+  return m_entries.empty();
+}
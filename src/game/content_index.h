@@ -0,0 +1,41 @@
+#ifndef __CONTENT_INDEX_H__
+#define __CONTENT_INDEX_H__
+
+#include "cartridge/content_hash.h"
+#include "game_descriptor.h"
+
+#include <vector>
+
+// Index of known dumps by the hashes of their full contents. Matches are exact:
+// the size, CRC-32 and, when known, SHA-1 of a dump must all agree.
+class content_index
+{
+public:
+  content_index();
+  
+  // Adds a dump to the index. sha1_hex is a hex string, or empty if unknown.
+  // Returns false if the hashes are malformed.
+  bool add(unsigned int num_bytes, uint32_t crc32, const char* sha1_hex, const game_descriptor* descriptor);
+  
+  // Must be called once all dumps have been added and before any lookups
+  void finalize();
+  
+  const game_descriptor* find(const std::vector<content_hash>& hashes) const;
+  
+  bool empty() const;
+
+private:
+  struct entry
+  {
+    uint32_t crc32;
+    unsigned int num_bytes;
+    bool has_sha1;
+    unsigned char sha1_digest[sha1::DIGEST_SIZE];
+    const game_descriptor* descriptor;
+  };
+  
+  // Sorted by CRC-32, keeping insertion order for equal values
+  std::vector<entry> m_entries;
+};
+
+#endif // defined(__CONTENT_INDEX_H__)
@@ -2,6 +2,9 @@
 #define __GAME_CATALOG_H__
 
 #include "game_descriptor.h"
+#include "cartridge/content_hash.h"
+
+#include <vector>
 
 class cartridge;
 
@@ -9,7 +12,15 @@ class game_catalog
 {
 public:
   virtual ~game_catalog() {}
+  
+  // Returned descriptors are owned by the catalog and stay valid for as long
+  // as the catalog does. Callers must not delete them.
   virtual const game_descriptor* identify_game(cartridge* cart, int slot_num = -1) = 0;
+  
+  // Identifies a known dump from the hashes recorded by a full read of a slot,
+  // as returned by cartridge::content_hashes(). Unlike identify_game(), this
+  // tells apart hacks and translations that share a header with the original.
+  virtual const game_descriptor* identify_content(const std::vector<content_hash>& hashes) = 0;
 };
 
 #endif // defined(__GAME_CATALOG_H__)
@@ -0,0 +1,25 @@
+#ifndef __GAME_TABLE_H__
+#define __GAME_TABLE_H__
+
+// A single game as compiled into the application. Tables are generated by
+// tools/build-database and are sorted by hash, with games sharing a hash kept
+// in database order. dump_size is 0 when no content hashes are known, and sha1
+// is an empty string when only the CRC-32 is.
+struct game_table_entry
+{
+  long long hash;
+  const char* name;
+  const char* developer_name;
+  unsigned int num_bytes;
+  unsigned int dump_size;
+  unsigned int crc32;
+  const char* sha1;
+};
+
+extern const game_table_entry ngp_game_table[];
+extern const unsigned int ngp_game_table_size;
+
+extern const game_table_entry ws_game_table[];
+extern const unsigned int ws_game_table_size;
+
+#endif // defined(__GAME_TABLE_H__)
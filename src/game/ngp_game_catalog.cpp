@@ -1,33 +1,103 @@
 #include "ngp_game_catalog.h"
 
+#include <algorithm>
 #include <cstring>
 #include <string>
 #include <stdexcept>
 
 #include "cartridge/ngp_cartridge.h"
+#include "game_table.h"
 #include "sqlite/sqlite3.h"
 
 using namespace std;
 
+ngp_game_catalog::ngp_game_catalog()
+  : m_games(), m_index(), m_content_index()
+{
+  // Use the table compiled into the application; it's already sorted by hash
+  m_index.reserve(ngp_game_table_size);
+  for (unsigned int i = 0; i < ngp_game_table_size; ++i)
+  {
+    const game_table_entry& entry = ngp_game_table[i];
+    
+    m_games.emplace_back(entry.name, entry.developer_name);
+    game_descriptor& descriptor = m_games.back();
+    descriptor.system = game_descriptor::game_system::NEO_GEO_POCKET;
+    descriptor.num_bytes = entry.num_bytes;
+    
+    m_index.push_back(std::make_pair(entry.hash, &descriptor));
+    
+    if (entry.dump_size != 0)
+    {
+      m_content_index.add(entry.dump_size, entry.crc32, entry.sha1, &descriptor);
+    }
+  }
+  m_content_index.finalize();
+}
+
 ngp_game_catalog::ngp_game_catalog(const char* db_file_name)
-  : m_sqlite(nullptr)
+  : m_games(), m_index(), m_content_index()
 {
-  if (sqlite3_open_v2(db_file_name, &m_sqlite, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK)
+  sqlite3* db = nullptr;
+  if (sqlite3_open_v2(db_file_name, &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK)
   {
-    sqlite3_close_v2(m_sqlite);
+    sqlite3_close_v2(db);
     throw std::runtime_error("Unable to open database");
   }
+  
+  // Load the whole catalog up front; it's small and lookups happen often
+  string query = "SELECT `Hash`, GameName, CartSize, DumpSize, Crc32, Sha1 FROM Games ORDER BY ID";
+  sqlite3_stmt* stmt = nullptr;
+  if (sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+  {
+    sqlite3_close_v2(db);
+    throw std::runtime_error("Unable to read database");
+  }
+  
+  int error;
+  while ((error = sqlite3_step(stmt)) == SQLITE_ROW)
+  {
+    const char* game_name = (const char*) sqlite3_column_text(stmt, 1);
+    
+    m_games.emplace_back(game_name != nullptr ? game_name : "", "");
+    game_descriptor& descriptor = m_games.back();
+    descriptor.system = game_descriptor::game_system::NEO_GEO_POCKET;
+    descriptor.num_bytes = (sqlite3_column_type(stmt, 2) == SQLITE_NULL ? 0 : sqlite3_column_int(stmt, 2)) << 17;
+    
+    m_index.push_back(std::make_pair((long long) sqlite3_column_int64(stmt, 0), &descriptor));
+    
+    // Only dumps with a known size and CRC-32 can be identified by content
+    if (sqlite3_column_type(stmt, 3) != SQLITE_NULL && sqlite3_column_type(stmt, 4) != SQLITE_NULL)
+    {
+      m_content_index.add((unsigned int) sqlite3_column_int64(stmt, 3), (uint32_t) sqlite3_column_int64(stmt, 4), (const char*) sqlite3_column_text(stmt, 5), &descriptor);
+    }
+  }
+  
+  sqlite3_finalize(stmt);
+  sqlite3_close_v2(db);
+  
+  if (error != SQLITE_DONE)
+  {
+    throw std::runtime_error("Unable to read database");
+  }
+  
+  m_content_index.finalize();
+  
+  std::stable_sort(m_index.begin(), m_index.end(), [](const std::pair<long long, const game_descriptor*>& a, const std::pair<long long, const game_descriptor*>& b)
+  {
+    return a.first < b.first;
+  });
 }
 
 ngp_game_catalog::~ngp_game_catalog()
 {
-  sqlite3_close_v2(m_sqlite);
+  // Nothing else to do
 }
 
 const game_descriptor* ngp_game_catalog::identify_game(cartridge* cart, int slot_num)
 {
   // Build hash from cartridge metadata
-  // Match hash to game in database
+  // Match hash to game in catalog
   //   If multiple matches, return first
   
   
@@ -55,28 +125,24 @@ const game_descriptor* ngp_game_catalog::identify_game(cartridge* cart, int slot
   hash |= ((long long) metadata->game_version) << (1 * 8);
   hash |= ((long long) metadata->minimum_system);
   
-  // Query database for hash match in database and only get first matching result
-  string query = "SELECT GameName, CartSize FROM Games WHERE `Hash`=:hash LIMIT 1";
-  sqlite3_stmt* stmt = nullptr;
-  int error = sqlite3_prepare_v2(m_sqlite, query.c_str(), -1, &stmt, nullptr);
-  if (error != SQLITE_OK)
+  return find_game(hash);
+}
+
+const game_descriptor* ngp_game_catalog::identify_content(const std::vector<content_hash>& hashes)
+{
+  return m_content_index.find(hashes);
+}
+
+const game_descriptor* ngp_game_catalog::find_game(long long hash) const
+{
+  auto it = std::lower_bound(m_index.begin(), m_index.end(), hash, [](const std::pair<long long, const game_descriptor*>& entry, long long hash)
   {
-    return nullptr;
-  }
+    return entry.first < hash;
+  });
   
-  if (sqlite3_bind_int64(stmt, sqlite3_bind_parameter_index(stmt, ":hash"), hash) != SQLITE_OK
-      || sqlite3_step(stmt) != SQLITE_ROW)
+  if (it == m_index.end() || it->first != hash)
   {
-    sqlite3_finalize(stmt);
     return nullptr;
   }
-  
-  // Build descriptor from database result set
-  string game_name = string((const char*) sqlite3_column_text(stmt, 0));
-  game_descriptor* descriptor = new game_descriptor(game_name.c_str(), "");
-  descriptor->system = game_descriptor::game_system::NEO_GEO_POCKET;
-  descriptor->num_bytes = (sqlite3_column_type(stmt, 1) == SQLITE_NULL ? 0 : sqlite3_column_int(stmt, 1)) << 17;
-  
-  sqlite3_finalize(stmt);
-  return descriptor;
+  return it->second;
 }
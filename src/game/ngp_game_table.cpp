@@ -0,0 +1,285 @@
+// Generated by tools/build-database from ngpgames.db. Do not edit.
+
+#include "game_table.h"
+
+const game_table_entry ngp_game_table[] = {
+  { (long long) 0x0000200000001020ULL, "Simple Fractal V1.0 by Tomasz Slanina", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020003b0000104eULL, "Neo-Neo! V1.0", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000000010ULL, "Chaos 89", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000000010ULL, "Invaders by Tomasz Slanina", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000000010ULL, "Maze Demo V1.02 by Jeff Siebold", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000000010ULL, "Maze Demo V1.04_Bung by Jeff Siebold", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000000010ULL, "Maze Demo V1.05 by Jeff Siebold", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000000010ULL, "Mersenne Twister Random Number Generator", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000000010ULL, "Simple Fractal V1.1 by Tomasz Slanina", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000000010ULL, "Simple Fractal Vx.x by Tomasz Slanina", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000000010ULL, "Snake V1.0 by Ivan Mackintosh", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000000010ULL, "TPaint", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000010a00ULL, "King of Fighters R-1", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000010a00ULL, "King of Fighters R-1", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000010a00ULL, "King of Fighters R-1", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000020800ULL, "NeoGeo Cup '98", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000020800ULL, "NeoGeo Cup '98", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000126000ULL, "Puzzle Tsunagete Pon", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000231510ULL, "King of Fighters R-2", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000231510ULL, "King of Fighters R-2", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000231510ULL, "King of Fighters R-2", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000231510ULL, "King of Fighters R-2", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000231510ULL, "King of Fighters R-2", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000231510ULL, "King of Fighters R-2", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000231510ULL, "King of Fighters R-2", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000231510ULL, "King of Fighters R-2", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000293010ULL, "Puzzle Tsunagete Pon Color", "", 524288u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000390e10ULL, "NeoGeo Cup '98 Plus Color", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000495010ULL, "Puzzle Tsunagete Pon 2", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000542010ULL, "Puzzle Link", "", 524288u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000560710ULL, "SNK Vs Capcom - Card Fighters Clash - SNK Version", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000570710ULL, "SNK Vs Capcom - Card Fighters Clash - Capcom Version", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000570710ULL, "SNK Vs Capcom - Card Fighters Clash - Capcom Version", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000590510ULL, "Sonic the Hedgehog - Pocket Adventure", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000670310ULL, "SNK Vs Capcom - Card Fighters Clash - SNK Version", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000670310ULL, "SNK Vs Capcom - Card Fighters Clash - SNK Version", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000680310ULL, "SNK Vs Capcom - Card Fighters Clash - Capcom Version", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000691510ULL, "SNK Vs Capcom - Match of The Millennium", "", 4194304u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000691510ULL, "SNK Vs Capcom - Match of The Millennium", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000691510ULL, "SNK Vs Capcom - Match of The Millennium", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000691510ULL, "SNK Vs Capcom - Match of The Millennium", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000691510ULL, "SNK Vs Capcom - Match of The Millennium", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000691510ULL, "SNK Vs Capcom - Match of The Millennium", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000691510ULL, "SNK Vs Capcom - Match of The Millennium", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000763010ULL, "Puzzle Link 2", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000763010ULL, "Puzzle Link 2", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000763010ULL, "Puzzle Link 2", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004000850810ULL, "Densetsu no Ogre Battle", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004001160610ULL, "SNK Vs Capcom - Card Fighters Clash 2 - Expand Edition", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004001160610ULL, "SNK Vs Capcom - Card Fighters Clash 2 - Expand Edition", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004500080a00ULL, "Samurai Shodown!", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004500095000ULL, "Pocket Tennis", "", 524288u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004500095000ULL, "Pocket Tennis", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004500250710ULL, "Baseball Stars Color", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004500250710ULL, "Baseball Stars Color", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004500250710ULL, "Baseball Stars Color", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004500558010ULL, "Pac-Man", "", 524288u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004500558010ULL, "Pac-Man", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004500558010ULL, "Pac-Man", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004500558010ULL, "Pac-Man", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004600070300ULL, "Baseball Stars", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004600119010ULL, "Fatal Fury F-Contact", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004600211510ULL, "Metal Slug - 1st Mission", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004600211510ULL, "Metal Slug - 1st Mission", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004600211510ULL, "Metal Slug - 1st Mission", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004600211510ULL, "Metal Slug - 1st Mission", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004600211510ULL, "Metal Slug - 1st Mission", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004600301a10ULL, "Samurai Shodown! 2", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004600301a10ULL, "Samurai Shodown! 2", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004600653010ULL, "Gals Fighters", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004600933010ULL, "Gals Fighters", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004600933010ULL, "Gals Fighters", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004600933010ULL, "Gals Fighters", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004800050300ULL, "Master of Syougi", "", 524288u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004800050300ULL, "Master of Syougi", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004800270410ULL, "Master of Syougi", "", 524288u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004900360310ULL, "Dive Alert - Burn Edition", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004900370310ULL, "Dive Alert - Rebecca Version", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004900510910ULL, "Faselei!", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004900620310ULL, "Mizuki Shigeru Youkai Shashin Kan", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004900880210ULL, "Dive Alert - Matt's Version", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004900890210ULL, "Dive Alert - Becky's Version", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004900900310ULL, "Faselei!", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004900900310ULL, "Faselei!", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004b00610410ULL, "Metal Slug - 2nd Mission", "", 4194304u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004b00610410ULL, "Metal Slug - 2nd Mission", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020004e00332110ULL, "Dokodemo Mahjong", "", 524288u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020005200351110ULL, "Neo Turf Masters", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020005200351110ULL, "Neo Turf Masters", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020005200351110ULL, "Neo Turf Masters", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020005200351110ULL, "Neo Turf Masters", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020005200641f10ULL, "Last Blade, The", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020005200641f10ULL, "Last Blade, The", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020005200641f10ULL, "Last Blade, The", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020005200952410ULL, "Last Blade, The", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020006600000210ULL, "Pac-Man", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020006600000210ULL, "Sodchess V1.0.2 by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020006600000210ULL, "Sodchess V1.1.0 by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "3D Engine V2", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Columns by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Diamond Run by Ivan Mackintosh", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Hello World! (NEO Clock)", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Jumpy! by Monkey Heeded Software", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Lights! V1.0 by Roger Bacon", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Lights! V1.1 by Roger Bacon", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Lines, Triangles and Points. First Step for 3D by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Manic Miner Alpha V0.1g by Lindon Dodd", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Manic Miner Alpha V0.2a by Lindon Dodd", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Manic Miner V1.0 by Lindon Dodd", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Maze Demo V1.00 by Jeff Siebold", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Maze Demo V1.01 by Jeff Siebold", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Mines V1.0 by Ivan Mackintosh", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Multi Game Menu", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Multi Game Menu", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Multi Game Menu", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Multi Game Menu", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Multi Game Menu", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Multi Game Menu", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Music Demo 1 by Ivan Mackintosh", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Neo Centipede by Roger Bacon (04-05-2001)", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Neo Centipede by Roger Bacon (05-13-2001)", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Neo-Neo! V1.1 (with Music) (05-05-2001)", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "NeoGeo Clock Demo", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "SFX for NGPC - Example by Ivan Mackintosh", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "SFX for NGPC - Sound Generator by Ivan Mackintosh", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Shufflepuck Cafe (Beta 1) by Loic Julien", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Shufflepuck Cafe (Beta 2) by Loic Julien", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Snake V1.1 by Ivan Mackintosh", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Snake V1.2 by Ivan Mackintosh", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Snake V1.2 by Ivan Mackintosh", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Solitaire V1.0 By Ivan Mackintosh", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Starfield Array Test by Roger Bacon", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Thieves (Bung Comp Entry) by Ivan Mackintosh", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Unnamed Jumpy Platform Game by Roger Bacon (04-18-2001)", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "Unnamed Jumpy Platform Game by Roger Bacon (06-06-2001)", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008900000010ULL, "WAV Player Sample - 2'40' by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008f00000010ULL, "Hardware Test", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020008f00000010ULL, "Mainreg Test", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020009000000010ULL, "Thieves V1.0 By Ivan Mackintosh", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x002000b400000010ULL, "MOD Player for NGPC Sample by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x002000b800000010ULL, "HICOLOR Demo NEOPOP by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x002000b800000010ULL, "HICOLOR Demo REAL by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x002000c300000010ULL, "Movie Player Sample by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x002000c300000010ULL, "Movie Player by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x002000dd10010010ULL, "Syko War (Bung Comp Entry) by Mike Kasprzak", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x002000e4ffff0110ULL, "CPU Test by Judge_", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000380010ULL, "Crush Roller", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000380010ULL, "Crush Roller", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000380010ULL, "Crush Roller", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000400310ULL, "Shanghai Mini", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000410510ULL, "Puyo Pop", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000410610ULL, "Puyo Pop", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000440810ULL, "Pocket Love If", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000451410ULL, "Dark Arms - Beast Buster 1999", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000451410ULL, "Dark Arms - Beast Buster 1999", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000451410ULL, "Dark Arms - Beast Buster 1999", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000451410ULL, "Dark Arms - Beast Buster 1999", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000480410ULL, "Magical Drop Pocket", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000520310ULL, "Pachisuro Aruze Oogoku Pocket Hanabi V1.02", "", 524288u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000520510ULL, "Pachisuro Aruze Oogoku Pocket Hanabi V1.04", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000580410ULL, "Magical Drop Pocket", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000580410ULL, "Magical Drop Pocket", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000605010ULL, "Densha De GO! 2", "", 4194304u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000605010ULL, "Densha De GO! 2", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000630610ULL, "Mezase! Kanji Ou", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000740410ULL, "Pachisuro Azure Oogoku Pocket Azteca", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000790310ULL, "Pocket Reversi", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000810b10ULL, "Oekaki Puzzle", "", 524288u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000840310ULL, "Pachisuro Aruze Oogoku Pocket Ward of Lights", "", 524288u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000870710ULL, "Memories Off Pure", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010000961810ULL, "Ni-ge-ron-pa", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010001003510ULL, "Cool Cool Jam", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010001003510ULL, "Cool Cool Jam", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010001003510ULL, "Cool Cool Jam", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010001020210ULL, "Pachi-slot Aruze Oukoku Porcano 2", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x002001000104a110ULL, "Pocket Reversi", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010001060310ULL, "Picture Puzzle", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x002001000106a110ULL, "Picture Puzzle", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010001070310ULL, "Pachisuro Aruze Oogoku Pocket - Delsol 2", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010001080110ULL, "Pachisuro Aruze Oogoku Pocket - Dekahel 2", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010001100110ULL, "Pachisuro Aruze Oogoku Ohanabi", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010001120410ULL, "Pachisuro Aruze Ohgoku Pocket - E-Cup", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010001120410ULL, "Pachisuro Aruze Ohgoku Pocket - E-Cup", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x002001001234a100ULL, "Cool Cool Jam SAMPLE", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010500910b10ULL, "Koi Koi Mahjong", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010500910b10ULL, "Koi Koi Mahjong", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010801030510ULL, "Delta Warp", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010801030510ULL, "Delta Warp", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010900000010ULL, "Spacies (Newer Version) by Jim Bagley", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020010900000010ULL, "Spacies by Jim Bagley", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020011000151110ULL, "Neo Dragon's Wild", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020011000151310ULL, "Neo Dragon's Wild", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020011000151310ULL, "Neo Dragon's Wild", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020011100000010ULL, "NGPC Game Pack (Spacies & Asteroids)", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020012d00200910ULL, "Puzzle Bobble Mini", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020012d00200910ULL, "Puzzle Bobble Mini", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020012d00201010ULL, "Puzzle Bobble Mini", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020012d00310110ULL, "Bust-A-Move Pocket", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020014800702010ULL, "Neo Twenty One", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020014800702010ULL, "Neo Twenty One", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020014800702010ULL, "Neo Twenty One", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020014800702010ULL, "Neo Twenty One", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020014e00000010ULL, "Squall", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020015200460210ULL, "Pachinko Hissyou Guide Pocket Parlor", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020017400141000ULL, "Neo Cherry Master", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020017900981610ULL, "Neo Baccarat", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x002001790098a110ULL, "Neo Baccarat", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020017a00241010ULL, "Neo Cherry Master Color", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020017a00241010ULL, "Neo Cherry Master Color", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020018401092210ULL, "Infinity Cure", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x002001a700161210ULL, "Neo Mystery Bonus", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x002001a700161210ULL, "Neo Mystery Bonus", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020020000970210ULL, "Ganbare NeoPoke Kun", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020022000940410ULL, "Rockman Battle & Fighters", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020022000940410ULL, "Rockman Battle & Fighters", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020022000940410ULL, "Rockman Battle & Fighters", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020022000940410ULL, "Rockman Battle & Fighters", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020025a00000210ULL, "Anime Video", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020037500263210ULL, "Neo Poke Pro Yakyuu", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020044800920510ULL, "King of Fighters, The - Battle De Paradise", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020044801110210ULL, "Super Real Mahjong", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020044801110210ULL, "Super Real Mahjong", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020044801110210ULL, "Super Real Mahjong", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x002004eb00000010ULL, "Hi-Colour by Fuz", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x002005a500780310ULL, "Soreike! Hanafuda Doujyou", "", 524288u, 0u, 0x00000000u, "" },
+  { (long long) 0x002007db00000010ULL, "Bitmap Demo", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020095a00000010ULL, "Adventures of Gus and Rob V1, The by Mickey McMurray", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x00200a2600000010ULL, "Adventures of Gus and Rob V2, The by Mickey McMurray", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x00200de200000010ULL, "Barbarian Invaders", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x00200de200000010ULL, "Barbarian Invaders", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020215000000010ULL, "Unlimited Multidirectional Scrolling Sample by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020222500000010ULL, "Mr. Do!", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x002023dc00283010ULL, "Pocket Tennis Color", "", 524288u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020251800000010ULL, "Blocks by Ivan Mackintosh", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020264900000010ULL, "Neo Yahtzee 0.1 by Darek J Davis", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020293400000010ULL, "Dodger", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x00203ad100000010ULL, "Juno First", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020449500000010ULL, "Neo Fantasy by Darek J Davis", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x002059a30066f110ULL, "Wrestling Madness (Beta)", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x00205b0000660210ULL, "Big Bang Pro Wrestling", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x00205fa300100010ULL, "Biomotor Unitron", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x00205fa300530010ULL, "Biomotor Unitron", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x00205fa300530010ULL, "Biomotor Unitron", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x00207bfa00750210ULL, "Cool Boarders Pocket", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x00207bfa00750210ULL, "Cool Boarders Pocket", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020837900171310ULL, "Neo Derby Championship", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020883300506010ULL, "Kikouseki Unitron", "", 2097152u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020891a00820810ULL, "Evolution", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020891a0099a110ULL, "Evolution - Eternal Dungeons", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020891a0099a110ULL, "Evolution - Eternal Dungeons", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x00208eaf00000010ULL, "Puzzle Gems V1.0 by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x00208edc00000010ULL, "Puzzle Gems V1.1 by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x00209b4300000010ULL, "Dynamate V1.0EMU by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x00209b4300000010ULL, "Dynamate V1.0HW by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x00209b8d00000010ULL, "Dynamate V1.1 by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020a07800830410ULL, "Bikkuriman 2000", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020d5c600000010ULL, "PocketRace V0.02pre-alpha by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0020d62900000010ULL, "PocketRace V0.03pre-alpha by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x002184e000321510ULL, "Party Mail", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0021882c00040200ULL, "Melon Chan's Growth Diary", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x00229d6e00000010ULL, "Slideshow (Jan 17 2003) by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0022cd5d00000010ULL, "Slideshow (Jan 23 2003) by Thor", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0023264c00711010ULL, "Dynamite Slugger", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x0025e17401160610ULL, "SNK Vs Capcom - Card Fighters Clash 2 - Expand Edition", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0025e17401160610ULL, "SNK Vs Capcom - Card Fighters Clash 2 - Expand Edition", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0026000500558010ULL, "Pac-Man", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0026000500558010ULL, "Pac-Man", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0027700000283010ULL, "Super 12 in 1", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0028008d00000010ULL, "Flavors Multipac 16MB 12-13-01", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x002c000500801010ULL, "Cotton - Fantastic Night Dreams", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x002c000501050310ULL, "Cotton - Fantastic Night Dreams", "", 1048576u, 0u, 0x00000000u, "" },
+  { (long long) 0x002d800000801010ULL, "Cotton - Fantastic Night Dreams", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x002d800001050310ULL, "Cotton - Fantastic Night Dreams", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0030008d00000010ULL, "Flavor's NGPC Multi-ROM Menu V1.0", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x009fc08d00000010ULL, "Flavor's NGPC Multi-ROM Menu V2.0 BETA", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x009fc08d00000010ULL, "Flavors Multipac 12-10-01", "", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x009fc08d00000010ULL, "Flavors Multipac 12-12-01", "", 0u, 0u, 0x00000000u, "" },
+};
+
+const unsigned int ngp_game_table_size = sizeof(ngp_game_table) / sizeof(ngp_game_table[0]);
@@ -1,33 +1,107 @@
 #include "ws_game_catalog.h"
 
+#include <algorithm>
 #include <cstring>
 #include <string>
 #include <stdexcept>
 
 #include "cartridge/ws_cartridge.h"
+#include "game_table.h"
 #include "sqlite/sqlite3.h"
 
 using namespace std;
 
+ws_game_catalog::ws_game_catalog()
+  : m_games(), m_index(), m_content_index()
+{
+  // Use the table compiled into the application; it's already sorted by hash
+  m_index.reserve(ws_game_table_size);
+  for (unsigned int i = 0; i < ws_game_table_size; ++i)
+  {
+    const game_table_entry& entry = ws_game_table[i];
+    
+    m_games.emplace_back(entry.name, entry.developer_name);
+    game_descriptor& descriptor = m_games.back();
+    descriptor.system = game_descriptor::game_system::WONDERSWAN;
+    descriptor.num_bytes = ws_cartridge::calculate_game_size((int) ((entry.hash >> (4*8)) & 0xFF));
+    
+    m_index.push_back(std::make_pair(entry.hash, &descriptor));
+    
+    if (entry.dump_size != 0)
+    {
+      m_content_index.add(entry.dump_size, entry.crc32, entry.sha1, &descriptor);
+    }
+  }
+  m_content_index.finalize();
+}
+
 ws_game_catalog::ws_game_catalog(const char* db_file_name)
-  : m_sqlite(nullptr)
+  : m_games(), m_index(), m_content_index()
 {
-  if (sqlite3_open_v2(db_file_name, &m_sqlite, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK)
+  sqlite3* db = nullptr;
+  if (sqlite3_open_v2(db_file_name, &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK)
   {
-    sqlite3_close_v2(m_sqlite);
+    sqlite3_close_v2(db);
     throw std::runtime_error("Unable to open database");
   }
+  
+  // Load the whole catalog up front; it's small and lookups happen often
+  string query = "SELECT `Hash`, GameName, Developer, DumpSize, Crc32, Sha1 FROM Games ORDER BY ID";
+  sqlite3_stmt* stmt = nullptr;
+  if (sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+  {
+    sqlite3_close_v2(db);
+    throw std::runtime_error("Unable to read database");
+  }
+  
+  int error;
+  while ((error = sqlite3_step(stmt)) == SQLITE_ROW)
+  {
+    long long hash = sqlite3_column_int64(stmt, 0);
+    const char* game_name = (const char*) sqlite3_column_text(stmt, 1);
+    const char* developer_name = (const char*) sqlite3_column_text(stmt, 2);
+    
+    m_games.emplace_back(game_name != nullptr ? game_name : "", developer_name != nullptr ? developer_name : "");
+    game_descriptor& descriptor = m_games.back();
+    descriptor.system = game_descriptor::game_system::WONDERSWAN;
+    
+    // The ROM size code is part of the hash, so every match has the same size
+    descriptor.num_bytes = ws_cartridge::calculate_game_size((int) ((hash >> (4*8)) & 0xFF));
+    
+    m_index.push_back(std::make_pair(hash, &descriptor));
+    
+    // Only dumps with a known size and CRC-32 can be identified by content
+    if (sqlite3_column_type(stmt, 3) != SQLITE_NULL && sqlite3_column_type(stmt, 4) != SQLITE_NULL)
+    {
+      m_content_index.add((unsigned int) sqlite3_column_int64(stmt, 3), (uint32_t) sqlite3_column_int64(stmt, 4), (const char*) sqlite3_column_text(stmt, 5), &descriptor);
+    }
+  }
+  
+  sqlite3_finalize(stmt);
+  sqlite3_close_v2(db);
+  
+  if (error != SQLITE_DONE)
+  {
+    throw std::runtime_error("Unable to read database");
+  }
+  
+  m_content_index.finalize();
+  
+  std::stable_sort(m_index.begin(), m_index.end(), [](const std::pair<long long, const game_descriptor*>& a, const std::pair<long long, const game_descriptor*>& b)
+  {
+    return a.first < b.first;
+  });
 }
 
 ws_game_catalog::~ws_game_catalog()
 {
-  sqlite3_close_v2(m_sqlite);
+  // Nothing else to do
 }
 
 const game_descriptor* ws_game_catalog::identify_game(cartridge* cart, int slot_num)
 {
   // Build hash from cartridge metadata
-  // Match hash to cartridge in database
+  // Match hash to cartridge in catalog
   //   If multiple matches, return first
   
   
@@ -58,28 +132,24 @@ const game_descriptor* ws_game_catalog::identify_game(cartridge* cart, int slot_
   hash |= ((long long) metadata->flags) << (2*8);
   hash |= ((long long) metadata->checksum);
   
-  // Query database for hash match in database and only get 1st matching result
-  string query = "SELECT GameName, Developer FROM Games WHERE Hash=:hash LIMIT 1";
-  sqlite3_stmt* stmt = nullptr;
-  if (sqlite3_prepare(m_sqlite, query.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+  return find_game(hash);
+}
+
+const game_descriptor* ws_game_catalog::identify_content(const std::vector<content_hash>& hashes)
+{
+  return m_content_index.find(hashes);
+}
+
+const game_descriptor* ws_game_catalog::find_game(long long hash) const
+{
+  auto it = std::lower_bound(m_index.begin(), m_index.end(), hash, [](const std::pair<long long, const game_descriptor*>& entry, long long hash)
   {
-    return nullptr;
-  }
+    return entry.first < hash;
+  });
   
-  if (sqlite3_bind_int64(stmt, sqlite3_bind_parameter_index(stmt, ":hash"), hash) != SQLITE_OK
-      || sqlite3_step(stmt) != SQLITE_ROW)
+  if (it == m_index.end() || it->first != hash)
   {
-    sqlite3_finalize(stmt);
     return nullptr;
   }
-  
-  // Build descriptor from database result set
-  string game_name = string((const char*) sqlite3_column_text(stmt, 0));
-  string developer_name = string((const char*) sqlite3_column_text(stmt, 1));
-  game_descriptor* descriptor = new game_descriptor(game_name.c_str(), developer_name.c_str());
-  descriptor->system = game_descriptor::game_system::WONDERSWAN;
-  descriptor->num_bytes = ((ws_cartridge*) cart)->get_game_size(slot_num);
-  
-  sqlite3_finalize(stmt);
-  return descriptor;
+  return it->second;
 }
@@ -2,19 +2,34 @@
 #define __WS_GAME_CATALOG_H__
 
 #include "game_catalog.h"
+#include "content_index.h"
 
-struct sqlite3;
+#include <deque>
+#include <utility>
+#include <vector>
 
 class ws_game_catalog: public game_catalog
 {
 public:
+  ws_game_catalog();
   ws_game_catalog(const char* db_file_name);
   ~ws_game_catalog();
   
   const game_descriptor* identify_game(cartridge* cart, int slot_num = -1);
+  const game_descriptor* identify_content(const std::vector<content_hash>& hashes);
   
 private:
-  sqlite3* m_sqlite;
+  const game_descriptor* find_game(long long hash) const;
+  
+  // Every game in the database, loaded once on construction
+  std::deque<game_descriptor> m_games;
+  
+  // Metadata hashes paired with their games, sorted by hash. Games sharing a
+  // hash keep their database order so the first one wins.
+  std::vector<std::pair<long long, const game_descriptor*>> m_index;
+  
+  // Games with known content hashes
+  content_index m_content_index;
 };
 
 #endif // defined(__WS_GAME_CATALOG_H__)
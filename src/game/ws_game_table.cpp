@@ -0,0 +1,354 @@
+// Generated by tools/build-database from wsgames.db. Do not edit.
+
+#include "game_table.h"
+
+const game_table_entry ws_game_table[] = {
+  { (long long) 0xcd01010200040000ULL, "WonderPong by LiraNuna", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xcd01010300040000ULL, "Chaos Demo V1.0 by Charles Doty", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xcd01010300040000ULL, "Chaos Demo V1.1 by Charles Doty", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xcd01010300040000ULL, "Chaos Demo V2.0 by Charles Doty", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xcd01010300040000ULL, "Chaos Demo V2.1 by Charles Doty", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xcd01010300040000ULL, "Color Scrolling Demo by Charles Doty", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xcd01010300040000ULL, "HBlank Interrupt Demo in NASM by Goldmomo", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xcd01010300040000ULL, "HBlank Interrupt Demo in NASM by Goldmomo", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xcd01010300040000ULL, "TextDemo by Goldmomo", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xfdc7dcdfdbcefdbaULL, "Digimon Adventure 02 - D1 Tamers", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xff00ff0300040000ULL, "WonderSwan Register Diagnostic by Zalas", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xff00ff0300040000ULL, "DIASWAN by Orion_", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xff00ff0300040000ULL, "Display a Picture Sample 2 by Tharo Herberg", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xff00ff0300040000ULL, "Display a Picture Sample by Tharo Herberg", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xff00ff0300040000ULL, "Display a Picture Sample by Tharo Herberg", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xff00ff0300040000ULL, "WWWLib - BG1 & BG2 & Sprite Test by Orion_", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xff00ff0300040000ULL, "WWWLib - Full Maptest by Orion_", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xff00ff0300040000ULL, "WWWLib - TestJB by Orion_", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xff00ff0300040000ULL, "WWWLib - TestJB16 by Orion_", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xff00ff0300040000ULL, "WWWLib - TestJB4 by Orion_", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xff00ff0300040000ULL, "WonderProject First Demo by Orion_", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xff00ff0300040000ULL, "WonderProject First Demo by Orion_", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0xff00ff0300048f8eULL, "Walking Dudes Demo V1 by Zalas", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Fantaisie Impromptu by Chopin - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Fantaisie Impromptu by Chopin - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Little Fugue in G Minor by JS Bach - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Ys 1 - Boss Out - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Ys 1 - Devil's Step - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Ys 1 - Final Battle - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Ys 1 - First Step Towards Wars - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Ys 1 - Fly with Me - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Ys 1 - Fountain of Love - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Ys 1 - Holders of Power - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Ys 1 - In the Memory - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Ys 1 - Lucky - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Ys 1 - Open Your Heart - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Ys 1 - Palace - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Ys 1 - Palace of Destruction - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Ys 1 - Rest in Peace - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Ys 1 - Tears of Sylph - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Ys 1 - Tension - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Ys 1 - The Last Moment of the Dark - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000000000000ULL, "Ys 1 - The Syonin - Arranged by Atsushi Watanabe", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000204040000ULL, "Dicing Knight Patched", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000204040000ULL, "Dicing Knight Period", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000204040000ULL, "Dicing Knight Period", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000204040000ULL, "Dicing Knight Period", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000204040000ULL, "Dicing Knight Period", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000204050000ULL, "Judgement Silversword - Rebirth Edition", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000204050000ULL, "Judgement Silversword - Rebirth Edition", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000204050000ULL, "Judgement Silversword - Rebirth Edition", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000000204050000ULL, "Judgement Silversword - Rebirth Edition", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x000000060104a8b5ULL, "Star Hearts Taikenban", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x000000060204737fULL, "SD Gundam G Generation - Gather Beat", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0000800402040400ULL, "RUN=DIM Return to Earth", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0001000100040a7bULL, "Girl Demo by Dox", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0001000100041980ULL, "#Wonderwitch Promo Demo V1.2 by Dox", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0001000100042277ULL, "Wondersnake Beta by Dox", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0001000100044cafULL, "#Wonderwitch Promo Beta Demo by Dox", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0001000100047847ULL, "#Wonderwitch Promo Demo by Dox", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x000100010004877fULL, "#Wonderwitch Promo Demo V1.3 by Dox", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x000100010004a77fULL, "#Wonderwitch Promo Demo Vx.x by Dox", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x000100010004abe3ULL, "Wondersnake 2 by Dox", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x000100010004f184ULL, "Wondersnake Final Sep 11 2001 by Dox & Kojote", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x000100010004fe9dULL, "#Wonderwitch Promo Demo V1.4 by Dox", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0001000300048bc1ULL, "Color Bars Demo by Sir Dragoon", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0001000300048bc1ULL, "Color Test Demo by Sir Dragoon", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0001000300048bc1ULL, "Hello World by Sir Dragoon", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0001000301048bc1ULL, "Bank Test by Sir Dragoon", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x000117060204d85fULL, "Turntablist - DJ Battle", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0001170620041d7cULL, "Turntablist - DJ Battle", "Misc.", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010001030205e57cULL, "GunPey", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010001032005ca99ULL, "GunPey", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010001040204a854ULL, "Digimon Digital Monsters", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010001060204c9c4ULL, "Digimon Digital Monsters - Anode & Cathode Tamer - Veedramon Version", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0100020402042133ULL, "Chocobo no Fushigi na Dungeon", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0100030301048d5dULL, "Wonder Stadium", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010004030004b76bULL, "Puyo Puyo Tsu", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01000504020416c1ULL, "Digimon Digital Monsters", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010006040204331bULL, "SD Gundam - Emotional Jam", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01000704010400e6ULL, "Kosodate Quiz Doko de mo My Angel", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01000803010412faULL, "Kaze no Klonoa - Moonlight Museum", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010008030104cd78ULL, "Kaze no Klonoa - Moonlight Museum", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010009040204125bULL, "LastStand", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010009060204ca50ULL, "Uchuu Senkan Yamato", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010009060204ca50ULL, "Uchuu Senkan Yamato", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01000a040204a8adULL, "Pocket Fighter", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01000b040204116bULL, "Chaos Gear - Michibi Kareshi Mono", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01000c06020439deULL, "Vaitz Blade", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01000d03010434eaULL, "Tekken Card Challenge", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01000e040204c127ULL, "Neon Genesis Evangelion Shito Ikusei", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01000e0602043892ULL, "Meitantei Conan - Yugure no Koujo", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01000f03000426a6ULL, "WonderSwan Handy Sonar", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0100100301045700ULL, "Raku Jongg", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0100100310041f75ULL, "Raku Jongg", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010011040204a93bULL, "Makaimura", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010011040204e99aULL, "Makaimura", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010012030204d78cULL, "Meitantei Conan - Majutsushi no Chousenjou!", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0100130402043a9fULL, "Rockman & Forte - Mirai Kara no Chousen Sha", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0100130402046014ULL, "Rockman & Forte - Mirai Kara no Chousen Sha", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010014060204c94bULL, "Digimon Tamers - Digimon Medley", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010014060205b067ULL, "Terrors", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0100140620048f69ULL, "Digimon Tamers - Digimon Medley", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010015040205d5dfULL, "Mobile Suit Gundam MSVS", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01001903010453e5ULL, "Wonder Stadium '99", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01001a04020447beULL, "Card Captor Sakura - Sakura to Fushigi na Clow Card", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01001a060204f104ULL, "Digimon Tamers - Battle Spirit", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01001b060204d443ULL, "Buffers Evolution", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01001b0620041960ULL, "Buffers Evolution", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01001c0402042fdfULL, "Digimon Adventure - Anode Tamer", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01001d040204068bULL, "Digimon Adventure - Cathode Tamer", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01001e0302054920ULL, "D's Garage 21 Koubo Game - Tane wo Maku Tori", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01001e031005ec3eULL, "D's Garage 21 Koubo Game - Tane wo Maku Tori", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01001f03010507a2ULL, "Tare Pan no Gunpei", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01001f030205fa10ULL, "Tare Pan no Gunpei", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01001f0320053f2dULL, "Tare Pan no Gunpei", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010020030204b230ULL, "SD Gundam Gashapon Senki - Episode 1", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0100220402045bd8ULL, "Senkaiden - TV Animation Senkaiden Houshin Engi Yori", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010023030204023bULL, "Chou Aniki - Otoko no Tamafuda", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010024030204b4c7ULL, "Langrisser Millenium WS - The Last Century", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010025030205c4ddULL, "Sennou Millenium", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010025031005bcfaULL, "Sennou Millenium", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010026030204f9ebULL, "Final Lap 2000", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010026032004bc09ULL, "Final Lap 2000", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010027040204e18dULL, "Meitantei Conan - Nishi no Meitantei Saidai no Kiki!", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01002806020435e6ULL, "Wasabi Produce - Street Dancer", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01002902020595f0ULL, "Slither Link", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010029021005c90dULL, "Slither Link", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010029021005c90dULL, "Slither Link", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010029021005c90dULL, "Slither Link", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01002a030204c88dULL, "From TV Animation - One Piece - Mezase Kaizoku Ou", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01002a03200412aaULL, "From TV Animation - One Piece - Mezase Kaizoku Ou", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01002a060104ec95ULL, "Hunter X Hunter - Ichi O Tsugu Mono", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01002a062004c52dULL, "Hunter X Hunter - Ichi O Tsugu Mono", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01002c040104ff28ULL, "Digital Partner", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0100300802043e44ULL, "Digimon Tamers - Battle Spirit V1.5", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0100320402043c0aULL, "Digimon Adventure 02 - Tag Tamers", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0100320402043c0aULL, "Digimon Adventure 02 - Tag Tamers", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0100320402043c0aULL, "Digimon Adventure 02 - Tag Tamers", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010033030204534aULL, "Robot Works", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010033030204d68fULL, "Robot Works", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0101010602046b72ULL, "Rhyme Rider Kerorikan", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010102032005b402ULL, "GunPey Ex", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010102032005efe5ULL, "GunPey Ex", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010103060204d7cbULL, "Digimon Adventure 02 - D1 Tamers", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010103060204d7cbULL, "Digimon Adventure 02 - D1 Tamers", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0101040602044089ULL, "Senkaiden Ni - TV Animation Senkaiden Houshin Engi Yori", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01010506010509e5ULL, "Terrors 2", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010105062005ec02ULL, "Terrors 2", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010106060205092cULL, "Wonder Classic", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010107060204a556ULL, "Kidou Senshi Gundam Vol.1 -Side 7-", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01010806020460c1ULL, "Dark Eyes - Battle Gate", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01010a0602042450ULL, "SD Gundam Eiyuuden - Eiyuuden Kishi Densetsu", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01010b060204d920ULL, "SD Gundam Eiyuuden - Eiyuuden Musha Densetsu", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01010c040204fff6ULL, "Wizardry - Scenario 1 - Kyounou no Shiren Jou", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01010d060104af5dULL, "Pocket no Naka no Doraemon", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01010d0620043f68ULL, "Pocket no Naka no Doraemon", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01010f0602048951ULL, "Hunter X Hunter - Sorezore no Ketsui", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01010f0620046770ULL, "Hunter X Hunter - Sorezore no Ketsui", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0101110402048dbaULL, "Ultraman - Hikari no Kuni no Shisha", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010112080204c0c0ULL, "SD Gundam G Generation - Gather Beat 2", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0101130301047ebbULL, "Tonpusou", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0101130310045f35ULL, "Tonpusou", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010115060105b65dULL, "Last Alive", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010115062005957cULL, "Last Alive", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010116060104ed8eULL, "Star Hearts", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010117080204d80fULL, "Mobile Suit Gundam - Volume 2 - JABURO", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0101180602046903ULL, "Hunter X Hunter - Michibi Kareshi Mono", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010118062004ae1fULL, "Hunter X Hunter - Michibi Kareshi Mono", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010119060204a68fULL, "From TV Animation - One Piece - Niji no Shima Densetsu", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01011b04020424b8ULL, "Inu Yasha", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01011d0620049d27ULL, "Digimon Tamers - Brave Tamer", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01011d0620049d27ULL, "Digimon Tamers - Brave Tamer", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01011e06020485f8ULL, "From TV Animation - One Piece - Treasure Wars", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01011f0402045ad2ULL, "XI (Sai) Little", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010120041004e457ULL, "Kinniku Man Second Generations Dream Tag Match", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01012104020468f1ULL, "SD Gundam - Operation U.C.", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0101220601058174ULL, "Digimon Digital Monsters for WonderSwanColor", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0101220620051200ULL, "Digimon Digital Monsters for WonderSwanColor", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0101230601046386ULL, "Final Lap Special", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010123062004429cULL, "Final Lap Special", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010125080204a0ebULL, "Kidou Senshi Gundum Vol.3 -A BAOA QU-", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01012606020494b6ULL, "Inu Yasha Fuu'un Emaki", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010127080204d8d4ULL, "Yakusoku no Chi Riviera", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010128040204d10aULL, "Namco Super Wars", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0101290802042efdULL, "One Piece - Grand Battle Swan Colloseum", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01012a08020406d3ULL, "Arc The Lad - Kijin Fukkatsu", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01012b060104c75cULL, "Golden Axe", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01012b061004fdb3ULL, "Golden Axe", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01012c062004975bULL, "X - Card of Fate", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01012d0602043b45ULL, "Shaman King Mirai E no Ishi", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01012d060204bff2ULL, "Shaman King Mirai E no Ishi", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01012e06020403e9ULL, "Digimon Digital Monsters - D Project", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01012f080204eaa5ULL, "SD Gundam G Generation - Mono-Eye Gundams", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010131060204e82cULL, "Battle Spirit Digimon Frontier", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0101320620049783ULL, "Inu Yasha Kagome no Yumenikki", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010133080204fdeaULL, "From TV Animation - One Piece - Treasure Wars 2 - Buggy Land e Youkoso", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010134062004eb3dULL, "Kinnikuman Nisei Choujin Seisenshi", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010134062004eb3dULL, "Kinnikuman Nisei Choujin Seisenshi", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010135060204a090ULL, "Rockman EXE WS", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010135060204a090ULL, "Rockman EXE WS", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0101360602049bdeULL, "Kidou Senshi Gundam Seed", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0101360602049bdeULL, "Kidou Senshi Gundam Seed", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010138060204dd8aULL, "Naruto", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x010138060204dd8aULL, "Naruto", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0101390802048d88ULL, "Hunter X Hunter - Greed Island", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01013a0602049cc1ULL, "Kidou Senshi Gundam Giren no Yabou Tokubetsuhen Aoki no Hasha", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01013b0602048463ULL, "From TV Animation - One Piece - Chopper no Daibouken", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01013c0400045a06ULL, "Dragonball", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x01013d040004d25cULL, "Saint Seiya - Ougon Densetsu Hen Perfect Edition", "Bandai (and misc.)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0200010600048b53ULL, "Densha de Go!", "Taito", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x030001030104681aULL, "Shin Nihon Pro Wrestling Toukon Retsuden", "Tomy", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0300010310040291ULL, "Shin Nihon Pro Wrestling Toukon Retsuden", "Tomy", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0400010202047e28ULL, "Nobunaga no Yabo", "Koei", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0400010202047e28ULL, "Nobunaga no Yabo", "Koei", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0400020202044b6eULL, "Sangokushi", "Koei", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x04000402020479f1ULL, "Rekishi Simulation Sangokushi II", "Koei", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x05000103000422c0ULL, "Side Pocket", "Data East", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0500020300055053ULL, "Magical Drop", "Data East", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0500020300055053ULL, "Magical Drop", "Data East", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x060001080205dd7dULL, "Tokyo Majin Gakuen Fuju Fuuroku", "Asmik", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0700010202053a85ULL, "Keiba Yosou Shien Shinkaron", "Media Entertainment", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0700010202053a85ULL, "Keiba Yosou Shien Shinkaron", "Media Entertainment", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0800010200052d8cULL, "Crazy Climber", "Nichibutsu", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0800010200052d8cULL, "Crazy Climber", "Nichibutsu", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0a0001020004aaa6ULL, "Umizuri Ni Ikou", "Coconuts Japan", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0a0002020004ea5bULL, "Soccer Yarou! - Challenge the World", "Coconuts Japan", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0a0002020004ea5bULL, "Soccer Yarou! - Challenge the World", "Coconuts Japan", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0b000103020450cbULL, "Mahjong Touryuumon", "Sammy", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0b0002030204bf96ULL, "Nice On", "Sammy", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0b000203200410b3ULL, "Nice On", "Sammy", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0b00030201043a4fULL, "Armored Unit", "Sammy", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0b00030201043a4fULL, "Armored Unit", "Sammy", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0b00030201043a4fULL, "Armored Unit", "Sammy", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0b00040301044a8cULL, "Anchor Field Z", "Sammy", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0b00040301044a8cULL, "Anchor Field Z", "Sammy", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0b00050202044609ULL, "Shogi Touryuumon", "Sammy", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0b00050202044609ULL, "Shogi Touryuumon", "Sammy", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0b0006020204f123ULL, "Gomoku Narabe & Reversi Touryuumon", "Sammy", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0b0007040204dfbfULL, "Guilty Gear Petit", "Sammy", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0b010806020461c6ULL, "Guilty Gear Petit 2", "Sammy", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0b01080602046574ULL, "Guilty Gear Petit 2", "Sammy", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0c0001020204021dULL, "Shanghai Pocket", "Sunsoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0c00020300044ce1ULL, "Space Invaders", "Sunsoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0c000302020560dcULL, "Puzzle Bobble", "Sunsoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0c000302100563faULL, "Puzzle Bobble", "Sunsoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0c00040202043d49ULL, "Ouchan no Oekaki Logic", "Sunsoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0c00040220048265ULL, "Ouchan no Oekaki Logic", "Sunsoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0d00010301049b0aULL, "Gorakuoh TANGO!", "Mebius", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0d00010350044a84ULL, "Gorakuoh TANGO!", "Mebius", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0e000104020407e2ULL, "Super Robot Taisen Compact", "Banpresto", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0e0002030104f759ULL, "Kakuto Ryori Densetsu Bistro Recipe - Wonder Battle Hen", "Banpresto", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0e0003060204d4fdULL, "Super Robot Taisen Compact 2 - Dai Ichibu - Chijou Gekidou Hen", "Banpresto", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0e00040220040b25ULL, "Lode Runner", "Banpresto", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0e00040220040b25ULL, "Lode Runner", "Banpresto", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0e0005030204d1e0ULL, "Bokan Densetsu Buta Mo O Daterya Doronbou", "Banpresto", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0e0006060204d291ULL, "Super Robot Taisen Compact 2 - Dai Nibu - Uchuu Gekishin Hen", "Banpresto", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0e000706020486a3ULL, "Super Robot Taisen Compact 2 - Dai Sanbu - Ginga Kessen Hen", "Banpresto", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0e01080602046dbbULL, "Super Robot Taisen Compact", "Banpresto", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0e0109080204e669ULL, "Super Robot Taisen Compact 3", "Banpresto", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x0e0109080204fe69ULL, "Super Robot Taisen Compact 3", "Banpresto", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x10000102000405c0ULL, "Ganso Jajamaru Kun", "Jaleco", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x100002030104a01fULL, "Moero !! Pro Yakyu Rookies", "Jaleco", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1100010302043520ULL, "Medarot - Perfect Edition Kabuto Version", "Imagineer", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1100020302041a0dULL, "Medarot - Perfect Edition Kuwagata Version", "Imagineer", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x12000109020579f1ULL, "Beat Mania", "Konami", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x160002040104c15eULL, "Cho Denki Card Battle Yofu Makai Kikuchi Shugo", "Kobunsha", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x16010104020494cbULL, "Flash - Koibito Kun", "Kobunsha", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x160101042004d9e7ULL, "Flash - Koibito Kun", "Kobunsha", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1601020602050f71ULL, "Mikeneko Holme's Ghost Panic", "Kobunsha", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x160102062005548dULL, "Mikeneko Holme's Ghost Panic", "Kobunsha", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1700010200043e5eULL, "Trump Collection Bottom Up Teki Trump Seikatsu", "Bottom Up", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1700010200043e5eULL, "Trump Collection Bottom Up Teki Trump Seikatsu", "Bottom Up", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x170002020004e214ULL, "Trump Collection 2", "Bottom Up", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1800010302045ee3ULL, "Tetsuman", "Naxat (Mechanic Arms? Media Entertainment?)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x18000204020472e1ULL, "Clock Tower", "Naxat (Mechanic Arms? Media Entertainment?)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x18000204020472e1ULL, "Clock Tower", "Naxat (Mechanic Arms? Media Entertainment?)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x180003040104ecd6ULL, "Bakusou Dekatora Densetsu", "Naxat (Mechanic Arms? Media Entertainment?)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x180004020304fd8aULL, "Taikyoku Igo Heisei Kiin", "Naxat (Mechanic Arms? Media Entertainment?)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1800050202042785ULL, "Hanafuda Shiyou Yo", "Naxat (Mechanic Arms? Media Entertainment?)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1800050202042785ULL, "Hanafuda Shiyou Yo", "Naxat (Mechanic Arms? Media Entertainment?)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1800060402044bd1ULL, "Meta Communication Therapy nee Kiite!", "Naxat (Mechanic Arms? Media Entertainment?)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x180007060204bc15ULL, "Fire Pro Wrestling", "Naxat (Mechanic Arms? Media Entertainment?)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1800080200047dbdULL, "Glocal Hexcite", "Naxat (Mechanic Arms? Media Entertainment?)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1800080200047dbdULL, "Glocal Hexcite", "Naxat (Mechanic Arms? Media Entertainment?)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1800090302057cb8ULL, "Soroban Gu", "Naxat (Mechanic Arms? Media Entertainment?)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x19000104010438a2ULL, "Harobots", "Sunrise", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1a0001060004d142ULL, "Densha de Go! 2", "Cyberfront", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1b0001060204e8e9ULL, "Tetsujin 28 Gou", "Megahouse", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1b0001061004d8e6ULL, "Tetsujin 28 Gou", "Megahouse", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1b0003040205c862ULL, "Rainbow Islands - Putty's Party", "Megahouse", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1d000103020403beULL, "Kyoso Uma Ikusei Simulation Keiba", "Interbec", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1d0002040204048fULL, "Fever Sankyo - Koushiki Pachinko Simulation", "Interbec", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1d000204100447acULL, "Fever Sankyo - Koushiki Pachinko Simulation", "Interbec", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1d0003030204751fULL, "Dokodemo Hamster", "Interbec", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1d0004030205482eULL, "Fishing Freaks - Bass Rise", "Interbec", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1d01010402044512ULL, "Dokodemo Hamster 3 - O Dekake Saffron", "Interbec", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1e0001030204ed1aULL, "Engacho!", "NAC", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1e0001031004bc38ULL, "Engacho!", "NAC", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1f0001030204a835ULL, "Nazo Ou Pocket", "Emotion (Bandai Visual?)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1f00010320044557ULL, "Nazo Ou Pocket", "Emotion (Bandai Visual?)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1f00020402041928ULL, "Sotsugyou", "Emotion (Bandai Visual?)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x1f0003040204d61cULL, "Tanjou - Debut", "Emotion (Bandai Visual?)", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x200001030104e18fULL, "Pro Mahjong Kiwame", "Athena", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x210001040104ef01ULL, "Kiss Yori... - Seaside Serenade", "KID", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x2101010402047c2dULL, "Memories of Festa", "KID", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x220002020005921eULL, "Mingle Magnet", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x2300010202046890ULL, "Morita Shougi", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x2300010202046890ULL, "Morita Shougi", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x2400010401056af7ULL, "Uzumaki - Denshi Kaiki Hen", "Omega Micott", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x2400010410052a73ULL, "Uzumaki - Denshi Kaiki Hen", "Omega Micott", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x2400020401048555ULL, "Itou Jun Ni Uzumaki Noroi Simulation", "Omega Micott", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x24000204200416b7ULL, "Itou Jun Ni Uzumaki Noroi Simulation", "Omega Micott", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x240103062005e343ULL, "Anaza Hebun - Memory of Those Days", "Omega Micott", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x2500010602042799ULL, "Choujikuu Yousai Macross - True Love Song", "Upstar", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x2600010602053435ULL, "Ring Infinity", "Kadokawa/Megas", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x2600010620056253ULL, "Ring Infinity", "Kadokawa/Megas", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x270101060104f3deULL, "With You Mitsumete Itai", "Cocktail Soft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x270101062004375eULL, "With You Mitsumete Itai", "Cocktail Soft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x2800010602042170ULL, "Final Fantasy", "Squaresoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x280001060204db26ULL, "Final Fantasy", "Squaresoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x280004030204afe0ULL, "Hataraku Chocobo", "Squaresoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x28010206020457f3ULL, "Final Fantasy II", "Squaresoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x28010206020457f3ULL, "Final Fantasy II", "Squaresoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x28010206020457f3ULL, "Final Fantasy II", "Squaresoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x280102060204d0afULL, "Final Fantasy II", "Squaresoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x280104040204d439ULL, "Wild Card", "Squaresoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x28010504020469a8ULL, "Blue Wing Blitz", "Squaresoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x280106060204b1b2ULL, "Hanjyuku Hero - Aah Sekai yo Hanjuku Nare", "Squaresoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x2801070602048908ULL, "Romancing Saga", "Squaresoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x280108060204f194ULL, "Makai Toushi Sa-Ga", "Squaresoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x280109060204efdbULL, "Final Fantasy IV", "Squaresoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x280109060204efdbULL, "Final Fantasy IV", "Squaresoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x280109060204efdbULL, "Final Fantasy IV", "Squaresoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x280110080204264cULL, "Front Mission", "Squaresoft", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x2a00010405040000ULL, "Wondergate", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x2b01010420051d14ULL, "Kurupara!", "TomCreate", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x2d0101040204b362ULL, "Mr. Driller", "Namco", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x2d0101040204b362ULL, "Mr. Driller", "Namco", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x2e0101040104cbb9ULL, "Gensou Maden Saiyuuki Retribution", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x2e0101042004f5fdULL, "Gensou Maden Saiyuuki Retribution", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x2f0101060204f9aeULL, "Alchemist Marie & Elie - Futari no Atelier", "Gust", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x310101031005abfaULL, "Tetris", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x32010108020459f0ULL, "Gransta Chronicle", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x33010106010490eeULL, "Gekitou Crash Gear Turbo Gear Champion League", "Unknown", 0u, 0u, 0x00000000u, "" },
+  { (long long) 0x360101060204b785ULL, "Rockman EXE N1 Battle", "Capcom", 0u, 0u, 0x00000000u, "" },
+};
+
+const unsigned int ws_game_table_size = sizeof(ws_game_table) / sizeof(ws_game_table[0]);
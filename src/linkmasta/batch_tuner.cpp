@@ -0,0 +1,200 @@
+/*! \file
+ *  \brief File containing the implementation of \ref batch_tuner.
+ *  
+ *  File containing the implementation of \ref batch_tuner.
+ *  
+ *  \see batch_tuner
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-22
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#include "batch_tuner.h"
+#include <istream>
+#include <ostream>
+#include <sstream>
+
+#define TUNER_SMOOTHING         0.25
+#define TUNER_SAMPLES_PER_STEP  4
+#define TUNER_REPROBE_INTERVAL  32
+
+/*! \brief Every batch size considered, smallest first. The largest is the most
+ *         a single 64xN command can carry.
+ */
+const unsigned int TUNER_SIZES[] = { 8, 16, 32, 64, 128, 255 };
+
+
+
+batch_tuner::batch_tuner()
+  : m_candidates(), m_current(0), m_since_move(0), m_settled(0)
+{
+  for (unsigned int num_packets : TUNER_SIZES)
+  {
+    candidate c;
+    c.num_packets = num_packets;
+    c.packets_per_second = 0.0;
+    c.error_rate = 0.0;
+    c.samples = 0;
+    m_candidates.push_back(c);
+  }
+  
+  // Start where batches have always been, at the largest size
+  m_current = m_candidates.size() - 1;
+}
+
+unsigned int batch_tuner::batch_size() const
+{
+  return m_candidates[m_current].num_packets;
+}
+
+void batch_tuner::record(unsigned int num_packets, double seconds, bool succeeded)
+{
+  candidate& c = m_candidates[m_current];
+  if (succeeded && (num_packets != c.num_packets || seconds <= 0.0))
+  {
+    return;
+  }
+  
+  // Fold the batch into the running averages, taking the first one as is
+  double weight = (c.samples == 0 ? 1.0 : TUNER_SMOOTHING);
+  c.error_rate += weight * ((succeeded ? 0.0 : 1.0) - c.error_rate);
+  if (succeeded)
+  {
+    double rate = num_packets / seconds;
+    c.packets_per_second += (c.packets_per_second == 0.0 ? 1.0 : weight) * (rate - c.packets_per_second);
+  }
+  ++c.samples;
+  
+  // Back off right away after a failure
+  if (!succeeded)
+  {
+    if (m_current > 0)
+    {
+      move_to(m_current - 1);
+    }
+    return;
+  }
+  
+  if (++m_since_move >= TUNER_SAMPLES_PER_STEP)
+  {
+    decide();
+  }
+}
+
+void batch_tuner::save(std::ostream& out) const
+{
+  std::ostringstream line;
+  line << batch_size();
+  for (const candidate& c : m_candidates)
+  {
+    line << " " << c.num_packets << " " << c.packets_per_second << " " << c.error_rate << " " << c.samples;
+  }
+  out << line.str();
+}
+
+bool batch_tuner::load(std::istream& in)
+{
+  std::vector<candidate> candidates(m_candidates);
+  unsigned int           current_size;
+  unsigned int           current = candidates.size();
+  
+  if (!(in >> current_size))
+  {
+    return false;
+  }
+  for (unsigned int i = 0; i < candidates.size(); ++i)
+  {
+    candidate& c = candidates[i];
+    unsigned int num_packets;
+    if (!(in >> num_packets >> c.packets_per_second >> c.error_rate >> c.samples)
+        || num_packets != c.num_packets
+        || c.packets_per_second < 0.0 || c.error_rate < 0.0 || c.error_rate > 1.0)
+    {
+      return false;
+    }
+    if (num_packets == current_size)
+    {
+      current = i;
+    }
+  }
+  if (current == candidates.size())
+  {
+    return false;
+  }
+  
+  m_candidates = candidates;
+  m_current = current;
+  m_since_move = 0;
+  m_settled = 0;
+  return true;
+}
+
+
+
+double batch_tuner::score(const candidate& c)
+{
+  // Failed batches cost both their own time and the time to recover
+  return c.packets_per_second * (1.0 - c.error_rate) * (1.0 - c.error_rate);
+}
+
+void batch_tuner::decide()
+{
+  unsigned int best = m_current;
+  int          unexplored = -1;
+  
+  for (int step = -1; step <= 1; step += 2)
+  {
+    int i = (int) m_current + step;
+    if (i < 0 || i >= (int) m_candidates.size())
+    {
+      continue;
+    }
+    
+    if (m_candidates[i].samples < TUNER_SAMPLES_PER_STEP)
+    {
+      unexplored = i;
+    }
+    else if (score(m_candidates[i]) > score(m_candidates[best]))
+    {
+      best = i;
+    }
+  }
+  
+  if (best != m_current)
+  {
+    // A neighbour did better, go there
+    move_to(best);
+  }
+  else if (unexplored != -1)
+  {
+    // This is the best so far, so see whether the next size over does better
+    move_to(unexplored);
+  }
+  else if (++m_settled >= TUNER_REPROBE_INTERVAL)
+  {
+    // Conditions may have changed since the neighbours were measured, so have
+    // them measured again
+    for (int step = -1; step <= 1; step += 2)
+    {
+      int i = (int) m_current + step;
+      if (i >= 0 && i < (int) m_candidates.size())
+      {
+        m_candidates[i].samples = 0;
+      }
+    }
+    m_settled = 0;
+    m_since_move = 0;
+  }
+  else
+  {
+    m_since_move = 0;
+  }
+}
+
+void batch_tuner::move_to(unsigned int index)
+{
+  m_current = index;
+  m_since_move = 0;
+  m_settled = 0;
+}
@@ -0,0 +1,118 @@
+/*! \file
+ *  \brief File containing the declaration of the \ref batch_tuner class.
+ *  
+ *  File containing the header information and declaration of the
+ *  \ref batch_tuner class.
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-22
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#ifndef __BATCH_TUNER_H__
+#define __BATCH_TUNER_H__
+
+#include <iosfwd>
+#include <vector>
+
+/*! \class batch_tuner
+ *  \brief Picks the number of packets to move per read64xN or write64xN batch
+ *         from the throughput and error rate actually achieved.
+ *  
+ *  Every batch of the currently chosen size is reported through
+ *  \ref record(unsigned int, double, bool). The tuner keeps a running average
+ *  of the throughput and failure rate of each size it has tried and
+ *  hill-climbs over the sizes towards the best one: after a few batches it
+ *  tries the next size over if the current one is the best seen so far, and
+ *  otherwise moves to whichever neighbour did better. A failed batch steps
+ *  straight down to a smaller size, since smaller batches recover from stalls
+ *  faster. Once settled, the neighbouring sizes are tried again every so often
+ *  in case conditions have changed.
+ *  
+ *  The state can be saved and restored with \ref save(std::ostream&) const and
+ *  \ref load(std::istream&) so that a device doesn't start from scratch every
+ *  time it's connected.
+ *  
+ *  This class is *not* thread-safe. Access is expected to be serialized by the
+ *  claim on the device it belongs to.
+ */
+class batch_tuner
+{
+public:
+  
+  /*! \brief Constructs a tuner starting at the largest batch size. */
+                        batch_tuner();
+  
+  /*! \brief Gets the number of packets the next batch should be made of. */
+  unsigned int          batch_size() const;
+  
+  /*! \brief Reports the outcome of a batch.
+   *  
+   *  Successful batches of any size other than the current
+   *  \ref batch_size() are ignored, as they were cut short by the end of the
+   *  data rather than chosen by the tuner. Failures always count against the
+   *  current size.
+   *  
+   *  \param [in] num_packets The number of packets in the batch.
+   *  \param [in] seconds How long the batch took to complete.
+   *  \param [in] succeeded Whether the batch completed without error.
+   */
+  void                  record(unsigned int num_packets, double seconds, bool succeeded);
+  
+  /*! \brief Writes the state of the tuner as a single line of text. */
+  void                  save(std::ostream& out) const;
+  
+  /*! \brief Restores a state written by \ref save(std::ostream&) const.
+   *  
+   *  \returns True if the state was restored, false if it was malformed, in
+   *           which case the tuner is left unchanged.
+   */
+  bool                  load(std::istream& in);
+
+private:
+  
+  /*! \struct candidate
+   *  \brief What has been measured for one batch size.
+   */
+  struct candidate
+  {
+    /*! \brief The number of packets per batch. */
+    unsigned int        num_packets;
+    
+    /*! \brief Running average of the packets moved per second. */
+    double              packets_per_second;
+    
+    /*! \brief Running average of the fraction of batches that failed. */
+    double              error_rate;
+    
+    /*! \brief The number of batches measured since this size was last
+     *         (re)considered.
+     */
+    unsigned int        samples;
+  };
+  
+  /*! \brief Gets the figure of merit of a measured candidate. */
+  static double         score(const candidate& c);
+  
+  /*! \brief Moves to another candidate, or stays put, based on what has been
+   *         measured so far.
+   */
+  void                  decide();
+  
+  /*! \brief Switches to the given candidate. */
+  void                  move_to(unsigned int index);
+  
+  /*! \brief Every batch size considered, smallest first. */
+  std::vector<candidate> m_candidates;
+  
+  /*! \brief Index of the current batch size in \ref m_candidates. */
+  unsigned int          m_current;
+  
+  /*! \brief Batches measured at the current size since the last move. */
+  unsigned int          m_since_move;
+  
+  /*! \brief Decisions made in a row without moving. */
+  unsigned int          m_settled;
+};
+
+#endif /* defined(__BATCH_TUNER_H__) */
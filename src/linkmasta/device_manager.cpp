@@ -15,6 +15,7 @@
 #include "device_manager.h"
 
 #include <chrono>
+#include <stdexcept>
 
 #include "common/log.h"
 #include "usb/usb_device.h"
@@ -122,6 +123,9 @@ void device_manager::refresh_thread_function()
     // Make call to child
     refresh_device_list();
     
+    // Let go of connections left open after the last action on a device
+    close_idle_devices();
+    
     // Update refresh timer
     target_time = target_time = chrono::steady_clock::now();
     target_time += chrono::seconds(1);
@@ -129,3 +133,54 @@ void device_manager::refresh_thread_function()
   
   m_thread_dead = true;
 }
+
+void device_manager::close_idle_devices()
+{
+  vector<unsigned int> devices;
+  if (!try_get_connected_devices(devices))
+  {
+    return;
+  }
+  
+  for (auto id : devices)
+  {
+    // Leave devices alone while someone else is using them
+    try
+    {
+      if (!try_claim_device(id))
+      {
+        continue;
+      }
+    }
+    catch (std::invalid_argument& ex)
+    {
+      (void) ex;
+      // Device was disconnected in the meantime
+      continue;
+    }
+    
+    try
+    {
+      linkmasta_device* linkmasta = get_linkmasta_device(id);
+      if (linkmasta != nullptr)
+      {
+        linkmasta->close_if_idle();
+      }
+    }
+    catch (std::exception& ex)
+    {
+      (void) ex;
+      // Well... this is awkward
+    }
+    
+    try
+    {
+      release_device(id);
+    }
+    catch (std::invalid_argument& ex)
+    {
+      (void) ex;
+      // Device was disconnected in the meantime
+    }
+  }
+}
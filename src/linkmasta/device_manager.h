@@ -13,6 +13,7 @@
 #ifndef __DEVICE_MANAGER_H__
 #define __DEVICE_MANAGER_H__
 
+#include <chrono>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -24,6 +25,28 @@ class linkmasta_device;
 
 
 
+/*!
+ *  \brief Priority with which a thread waits for a claim on a
+ *         \ref linkmasta_device.
+ *  
+ *  Waiting threads with a higher priority are granted the device before
+ *  waiting threads with a lower priority. Threads waiting with the same
+ *  priority are granted the device in the order in which they began waiting.
+ */
+enum claim_priority
+{
+  /*! \brief Background housekeeping, such as polling for cartridges. */
+  CLAIM_PRIORITY_LOW,
+  
+  /*! \brief Short, user-facing queries such as reading cartridge metadata. */
+  CLAIM_PRIORITY_NORMAL,
+  
+  /*! \brief Long-running, user-initiated jobs such as flashing a cartridge. */
+  CLAIM_PRIORITY_HIGH
+};
+
+
+
 /*!
  *  \brief Manages connected \ref linkmasta_device devices.
  *  
@@ -222,8 +245,9 @@ public:
    *         provided ID.
    *  
    *  Attempts to claim the desired \ref linkamsta_device that has the provided
-   *  ID. If the device is already claimed, then function will *not* claim the
-   *  device again and will return false. If this function is successful, then
+   *  ID. If the device is already claimed, or other threads are queued waiting
+   *  to claim it, then function will *not* claim the device and will return
+   *  false. If this function is successful, then
    *  it will return true, indicating that it is safe to manipulate the device.
    *  If no \ref linkmasta_device with the provided ID exists, then an exception
    *  will be thrown.
@@ -236,6 +260,46 @@ public:
    */
   virtual bool                      try_claim_device(unsigned int id) = 0;
   
+  /*!
+   *  \brief Claims the \ref linkmasta_device that has the provided ID, blocking
+   *         until the device becomes available.
+   *  
+   *  Claims the \ref linkmasta_device that has the provided ID. If the device
+   *  is already claimed, the calling thread is put to sleep in the device's
+   *  wait queue until the claim is released and every waiter ahead of it in the
+   *  queue has been served. Waiters are ordered first by priority, then by
+   *  arrival. If no \ref linkmasta_device with the provided ID exists, then an
+   *  exception will be thrown.
+   *  
+   *  \param [in] id The ID number of the device to claim. Must be a valid ID
+   *         number of a connected \ref linkmasta_device.
+   *  \param [in] priority The priority with which to wait for the device.
+   *  
+   *  \return true if the device was claimed, false if the device was
+   *          disconnected while waiting.
+   */
+  virtual bool                      claim_device(unsigned int id, claim_priority priority = CLAIM_PRIORITY_NORMAL) = 0;
+  
+  /*!
+   *  \brief Claims the \ref linkmasta_device that has the provided ID, blocking
+   *         for at most the given amount of time.
+   *  
+   *  Behaves like \ref claim_device(unsigned int, claim_priority), except that
+   *  the calling thread gives up its place in the wait queue if the device
+   *  could not be claimed before the timeout expired. If no
+   *  \ref linkmasta_device with the provided ID exists, then an exception will
+   *  be thrown.
+   *  
+   *  \param [in] id The ID number of the device to claim. Must be a valid ID
+   *         number of a connected \ref linkmasta_device.
+   *  \param [in] timeout The maximum amount of time to wait for the device.
+   *  \param [in] priority The priority with which to wait for the device.
+   *  
+   *  \return true if the device was claimed, false if the timeout expired or
+   *          the device was disconnected while waiting.
+   */
+  virtual bool                      try_claim_device_for(unsigned int id, std::chrono::milliseconds timeout, claim_priority priority = CLAIM_PRIORITY_NORMAL) = 0;
+  
   /*!
    *  \brief Releases the claim on the \ref linkmasta_device that has the
    *         provided ID.
@@ -338,6 +402,18 @@ private:
    */
   void                              refresh_thread_function();
   
+  /*!
+   *  \brief Closes the connections of devices whose last session has been
+   *         idle for long enough.
+   *  
+   *  Called by the auto-refresh thread, so that connections are let go of for
+   *  every device, whether or not anything polls it for cartridges. Devices
+   *  that are claimed are skipped until the next time around.
+   *  
+   *  \see linkmasta_device::close_if_idle()
+   */
+  void                              close_idle_devices();
+
   
   
 private:
@@ -17,13 +17,21 @@
 #include "libusb-1.0/libusb.h"
 #include "usb/libusb_usb_device.h"
 #include "linkmasta_device.h"
+#include <cctype>
+#include <fstream>
+#include <sstream>
+
+#define TUNING_EXTENSION ".tuning"
+#define TUNING_MAGIC     "batch-tuning"
+#define TUNING_VERSION   1
 
 using namespace std;
 
 
 
-libusb_device_manager::libusb_device_manager()
-  : device_manager(), m_libusb_init(false)
+libusb_device_manager::libusb_device_manager(const std::string& tuning_directory)
+  : device_manager(), m_libusb_init(false), m_next_claim_ticket(0),
+    m_tuning_directory(tuning_directory)
 {
   m_libusb_mutex.lock();
   libusb_init(&m_libusb);
@@ -43,6 +51,7 @@ libusb_device_manager::~libusb_device_manager()
   m_connected_devices_mutex.lock();
   for (auto entry : m_connected_devices)
   {
+    save_batch_tuning(entry.second.serial_number, entry.second.linkmasta);
     delete entry.second.linkmasta;
     libusb_unref_device(entry.second.device);
   }
@@ -251,14 +260,30 @@ bool libusb_device_manager::try_claim_device(unsigned int id)
     throw std::invalid_argument("Unknown connected device ID " + std::to_string(id));
   }
   
-  auto r = it->second.claimed;
-  it->second.claimed = true;
+  // Don't cut in line in front of threads already waiting for the device
+  auto queue = m_claim_queues.find(id);
+  bool r = it->second.claimed || (queue != m_claim_queues.end() && !queue->second.empty());
+  if (!r)
+  {
+    it->second.claimed = true;
+  }
   
   m_connected_devices_mutex.unlock();
   
   return !r;
 }
 
+bool libusb_device_manager::claim_device(unsigned int id, claim_priority priority)
+{
+  return wait_for_claim(id, priority, nullptr);
+}
+
+bool libusb_device_manager::try_claim_device_for(unsigned int id, std::chrono::milliseconds timeout, claim_priority priority)
+{
+  auto deadline = chrono::steady_clock::now() + timeout;
+  return wait_for_claim(id, priority, &deadline);
+}
+
 void libusb_device_manager::release_device(unsigned int id)
 {
   m_connected_devices_mutex.lock();
@@ -274,6 +299,9 @@ void libusb_device_manager::release_device(unsigned int id)
   it->second.claimed = false;
   
   m_connected_devices_mutex.unlock();
+  
+  // Wake up anyone waiting in line for a device
+  m_claim_condition.notify_all();
 }
 
 
@@ -340,6 +368,7 @@ void libusb_device_manager::refresh_device_list()
       new_device.serial_number = usb_device->get_serial_number();
       usb_device->close();
       new_device.linkmasta = build_linkmasta_device(usb_device);
+      load_batch_tuning(new_device.serial_number, new_device.linkmasta);
       
       m_connected_devices[new_device.id] = new_device;
       libusb_ref_device(device_list[i]);
@@ -351,6 +380,8 @@ void libusb_device_manager::refresh_device_list()
   {
     if (!entry.second && !m_connected_devices[entry.first].claimed)
     {
+      save_batch_tuning(m_connected_devices[entry.first].serial_number, m_connected_devices[entry.first].linkmasta);
+      
       try {
         delete m_connected_devices[entry.first].linkmasta;
       } catch (std::exception &ex) {
@@ -365,12 +396,179 @@ void libusb_device_manager::refresh_device_list()
   
   m_connected_devices_mutex.unlock(); // UNLOCK m_connected_devices
   
+  // Wake up waiters so that any waiting on removed devices can give up
+  m_claim_condition.notify_all();
+  
   // Free the libusb list
   libusb_free_device_list(device_list, 1);
   
   m_libusb_mutex.unlock();
 }
 
+bool libusb_device_manager::wait_for_claim(unsigned int id, claim_priority priority, const chrono::steady_clock::time_point* deadline)
+{
+  unique_lock<mutex> lock(m_connected_devices_mutex); // LOCK m_connected_devices
+  
+  if (m_connected_devices.find(id) == m_connected_devices.end())
+  {
+    throw std::invalid_argument("Unknown connected device ID " + std::to_string(id));
+  }
+  
+  // Get in line
+  claim_waiter self;
+  self.ticket = m_next_claim_ticket++;
+  self.priority = priority;
+  m_claim_queues[id].push_back(self);
+  
+  // Checks whether we are at the head of the line: highest priority first,
+  // then first come, first served
+  auto is_next_in_line = [&]() -> bool
+  {
+    const std::vector<claim_waiter>& queue = m_claim_queues[id];
+    for (const claim_waiter& waiter : queue)
+    {
+      if (waiter.priority > self.priority
+          || (waiter.priority == self.priority && waiter.ticket < self.ticket))
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+  
+  bool claimed = false;
+  bool timed_out = false;
+  while (true)
+  {
+    auto it = m_connected_devices.find(id);
+    if (it == m_connected_devices.end())
+    {
+      // Device went away while we were waiting
+      break;
+    }
+    
+    if (!it->second.claimed && is_next_in_line())
+    {
+      it->second.claimed = true;
+      claimed = true;
+      break;
+    }
+    
+    if (timed_out)
+    {
+      break;
+    }
+    
+    // Sleep until something changes. On timeout, take one last look before
+    // giving up in case the device was released just as we timed out.
+    if (deadline == nullptr)
+    {
+      m_claim_condition.wait(lock);
+    }
+    else if (m_claim_condition.wait_until(lock, *deadline) == cv_status::timeout)
+    {
+      timed_out = true;
+    }
+  }
+  
+  // Get out of line
+  std::vector<claim_waiter>& queue = m_claim_queues[id];
+  for (auto waiter = queue.begin(); waiter != queue.end(); ++waiter)
+  {
+    if (waiter->ticket == self.ticket)
+    {
+      queue.erase(waiter);
+      break;
+    }
+  }
+  if (queue.empty())
+  {
+    m_claim_queues.erase(id);
+  }
+  
+  lock.unlock(); // UNLOCK m_connected_devices
+  
+  // Someone else may now be at the head of the line
+  if (!claimed)
+  {
+    m_claim_condition.notify_all();
+  }
+  
+  return claimed;
+}
+
+std::string libusb_device_manager::tuning_filename(const std::string& serial_number) const
+{
+  if (m_tuning_directory.empty() || serial_number.empty())
+  {
+    return "";
+  }
+  
+  // Serial numbers come from the device, so keep them from escaping the
+  // directory
+  std::string name = serial_number;
+  for (char& c : name)
+  {
+    if (!isalnum((unsigned char) c) && c != '-' && c != '_')
+    {
+      c = '_';
+    }
+  }
+  return m_tuning_directory + "/" + name + TUNING_EXTENSION;
+}
+
+void libusb_device_manager::load_batch_tuning(const std::string& serial_number, linkmasta_device* linkmasta) const
+{
+  std::string filename = tuning_filename(serial_number);
+  if (filename.empty() || linkmasta == nullptr)
+  {
+    return;
+  }
+  
+  std::ifstream fin(filename.c_str());
+  std::string   magic;
+  unsigned int  version;
+  if (!(fin >> magic >> version) || magic != TUNING_MAGIC || version != TUNING_VERSION)
+  {
+    return;
+  }
+  
+  // Each tuner only takes a state it recognizes, so a stale or damaged file
+  // leaves the defaults in place
+  std::string label;
+  while (fin >> label)
+  {
+    std::string line;
+    getline(fin, line);
+    std::istringstream state(line);
+    if (label == "read")
+    {
+      linkmasta->read_batch_tuner().load(state);
+    }
+    else if (label == "write")
+    {
+      linkmasta->write_batch_tuner().load(state);
+    }
+  }
+}
+
+void libusb_device_manager::save_batch_tuning(const std::string& serial_number, linkmasta_device* linkmasta) const
+{
+  std::string filename = tuning_filename(serial_number);
+  if (filename.empty() || linkmasta == nullptr)
+  {
+    return;
+  }
+  
+  std::ofstream fout(filename.c_str(), std::ios::trunc);
+  fout << TUNING_MAGIC << " " << TUNING_VERSION << "\n";
+  fout << "read ";
+  linkmasta->read_batch_tuner().save(fout);
+  fout << "\n" << "write ";
+  linkmasta->write_batch_tuner().save(fout);
+  fout << "\n";
+}
+
 bool libusb_device_manager::is_supported(unsigned int vendor_id, unsigned int product_id)
 {
   return ((vendor_id == 0x20A0 && product_id == 0x4178)       // NGP (linkmasta)
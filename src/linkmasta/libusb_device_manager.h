@@ -16,6 +16,7 @@
 
 #include "device_manager.h"
 
+#include <condition_variable>
 #include <map>
 #include <string>
 
@@ -39,8 +40,13 @@ public:
    *  \brief Class constructor. Initializes libraries and member variables.
    *  
    *  Class constructor. Initializes libraries and member variables.
+   *  
+   *  \param [in] tuning_directory Existing directory in which to keep the
+   *         batch size tuning of each device between connections, see
+   *         \ref linkmasta_device::read_batch_tuner(). If empty, every device
+   *         starts from scratch.
    */
-                            libusb_device_manager();
+                            libusb_device_manager(const std::string& tuning_directory = "");
   
   /*!
    *  \brief Class destructor. Frees dynamic memory and deinitializes libraries.
@@ -106,6 +112,16 @@ public:
    */
   bool                      try_claim_device(unsigned int id);
   
+  /*!
+   *  \see device_manager::claim_device(unsigned int, claim_priority)
+   */
+  bool                      claim_device(unsigned int id, claim_priority priority = CLAIM_PRIORITY_NORMAL);
+  
+  /*!
+   *  \see device_manager::try_claim_device_for(unsigned int, std::chrono::milliseconds, claim_priority)
+   */
+  bool                      try_claim_device_for(unsigned int id, std::chrono::milliseconds timeout, claim_priority priority = CLAIM_PRIORITY_NORMAL);
+  
   /*!
    *  \see device_manager::release_device(unsigned int)
    */
@@ -140,6 +156,47 @@ private:
    */
   static bool               is_supported(unsigned int vendor_id, unsigned int product_id);
   
+  /*!
+   *  \brief Waits in the device's claim queue until the device can be claimed
+   *         by the calling thread, the device disconnects, or the deadline
+   *         passes.
+   *  
+   *  Enqueues the calling thread in the device's wait queue and sleeps on
+   *  \ref m_claim_condition until the device is unclaimed and the calling
+   *  thread is at the head of the queue. The waiter is removed from the queue
+   *  regardless of the outcome.
+   *  
+   *  \param [in] id The ID number of the device to claim.
+   *  \param [in] priority The priority with which to wait for the device.
+   *  \param [in] deadline Optional point in time after which to give up. If
+   *         nullptr, waits indefinitely.
+   *  
+   *  \return true if the device was claimed, false if it disconnected or the
+   *          deadline passed.
+   */
+  bool                      wait_for_claim(unsigned int id, claim_priority priority, const std::chrono::steady_clock::time_point* deadline);
+  
+  /*!
+   *  \brief Gets the name of the file holding the batch size tuning of the
+   *         device with the given serial number.
+   *  
+   *  \return The path of the file, or an empty string if the tuning of the
+   *          device isn't kept.
+   */
+  std::string               tuning_filename(const std::string& serial_number) const;
+  
+  /*!
+   *  \brief Restores the batch size tuning of a newly connected device, if
+   *         any was saved. Fails silently.
+   */
+  void                      load_batch_tuning(const std::string& serial_number, linkmasta_device* linkmasta) const;
+  
+  /*!
+   *  \brief Saves the batch size tuning of a device so that it can be
+   *         restored the next time it's connected. Fails silently.
+   */
+  void                      save_batch_tuning(const std::string& serial_number, linkmasta_device* linkmasta) const;
+
   
   
 private:
@@ -200,6 +257,36 @@ private:
    *  from the \ref m_connected_devices map.
    */
   std::vector<connected_device> m_disconnected_devices;
+  
+  /*!
+   *  \brief A thread waiting in line to claim a device.
+   */
+  struct                    claim_waiter
+  {
+    /*! \brief Arrival order of the waiter, used to keep the queue FIFO. */
+    unsigned long             ticket;
+    
+    /*! \brief Priority of the waiter. Higher priorities are served first. */
+    claim_priority            priority;
+  };
+  
+  /*!
+   *  \brief Wait queues of threads blocked in \ref wait_for_claim(), keyed by
+   *         device ID. Guarded by \ref m_connected_devices_mutex.
+   */
+  std::map<unsigned int, std::vector<claim_waiter>> m_claim_queues;
+  
+  /*!
+   *  \brief Signalled whenever a device is released or disconnected so that
+   *         waiting threads can re-examine the queue.
+   */
+  std::condition_variable   m_claim_condition;
+  
+  /*! \brief The next ticket to hand out to a \ref claim_waiter. */
+  unsigned long             m_next_claim_ticket;
+  
+  /*! \brief Directory in which batch size tuning is kept, or empty. */
+  const std::string         m_tuning_directory;
 };
 
 #endif /* defined(__LIBUSB_DEVICE_MANAGER_H__) */
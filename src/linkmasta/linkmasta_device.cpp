@@ -15,11 +15,143 @@
 #include "linkmasta_device.h"
 #include <stdexcept>
 
+#define DEFAULT_IDLE_TIMEOUT 10000
+
+linkmasta_device::linkmasta_device()
+  : m_session_mutex(), m_num_sessions(0), m_session_lingering(false),
+    m_session_ended(), m_idle_timeout(DEFAULT_IDLE_TIMEOUT),
+    m_reconnecting(false), m_read_tuner(), m_write_tuner(), m_buffer_pool()
+{
+  // Nothing else to do
+}
+
+
+
+void linkmasta_device::begin_session()
+{
+  std::lock_guard<std::mutex> lock(m_session_mutex);
+  ++m_num_sessions;
+  m_session_lingering = false;
+}
+
+void linkmasta_device::end_session()
+{
+  std::lock_guard<std::mutex> lock(m_session_mutex);
+  if (m_num_sessions == 0)
+  {
+    throw std::runtime_error("No session to end");
+  }
+  
+  // Keep the connection around for a while in case another session follows
+  if (--m_num_sessions == 0)
+  {
+    m_session_lingering = true;
+    m_session_ended = std::chrono::steady_clock::now();
+  }
+}
+
+unsigned int linkmasta_device::num_sessions() const
+{
+  std::lock_guard<std::mutex> lock(m_session_mutex);
+  return m_num_sessions;
+}
+
+linkmasta_device::timeout_t linkmasta_device::idle_timeout() const
+{
+  std::lock_guard<std::mutex> lock(m_session_mutex);
+  return m_idle_timeout;
+}
+
+void linkmasta_device::set_idle_timeout(timeout_t timeout)
+{
+  std::lock_guard<std::mutex> lock(m_session_mutex);
+  m_idle_timeout = timeout;
+}
+
+bool linkmasta_device::close_if_idle()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_session_mutex);
+    if (m_num_sessions > 0 || !m_session_lingering
+        || std::chrono::steady_clock::now() - m_session_ended < std::chrono::milliseconds(m_idle_timeout))
+    {
+      return false;
+    }
+    m_session_lingering = false;
+  }
+  
+  close();
+  return true;
+}
+
+void linkmasta_device::reconnect()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_session_mutex);
+    m_reconnecting = true;
+  }
+  
+  // Sessions are left alone, they just don't get to keep this connection
+  try
+  {
+    close();
+  }
+  catch (std::exception& ex)
+  {
+    (void) ex;
+    std::lock_guard<std::mutex> lock(m_session_mutex);
+    m_reconnecting = false;
+    throw;
+  }
+  
+  {
+    std::lock_guard<std::mutex> lock(m_session_mutex);
+    m_reconnecting = false;
+  }
+  
+  open();
+}
+
+batch_tuner& linkmasta_device::read_batch_tuner()
+{
+  return m_read_tuner;
+}
+
+batch_tuner& linkmasta_device::write_batch_tuner()
+{
+  return m_write_tuner;
+}
+
+block_buffer_pool& linkmasta_device::buffer_pool()
+{
+  return m_buffer_pool;
+}
+
+bool linkmasta_device::is_session_open() const
+{
+  std::lock_guard<std::mutex> lock(m_session_mutex);
+  return !m_reconnecting && (m_num_sessions > 0 || m_session_lingering);
+}
+
+void linkmasta_device::end_lingering_session()
+{
+  std::lock_guard<std::mutex> lock(m_session_mutex);
+  m_num_sessions = 0;
+  m_session_lingering = false;
+}
+
+
+
 linkmasta_system linkmasta_device::system() const
 {
   return linkmasta_system::LINKMASTA_UNKNOWN;
 }
 
+bool linkmasta_device::probe_for_cartridge()
+{
+  return test_for_cartridge();
+}
+
 bool linkmasta_device::supports_read_bytes() const
 {
   return false;
@@ -136,9 +268,109 @@ unsigned int linkmasta_device::read_slot_size(unsigned int slot_num)
   throw std::runtime_error("ERROR: NOT SUPPORTED");
 }
 
+std::vector<linkmasta_device::word_t> linkmasta_device::run_script(const command_script& script)
+{
+  std::vector<word_t> results;
+  
+  for (auto it = script.commands().begin(); it != script.commands().end(); ++it)
+  {
+    if (it->is_read)
+    {
+      results.push_back(read_word(it->chip, it->address));
+    }
+    else
+    {
+      write_word(it->chip, it->address, it->data);
+    }
+  }
+  
+  return results;
+}
+
 bool linkmasta_device::switch_slot(unsigned int slot_num)
 {
   (void) slot_num;
   throw std::runtime_error("ERROR: NOT SUPPORTED");
 }
 
+
+
+
+linkmasta_device::command_script& linkmasta_device::command_script::write_word(chip_index chip, address_t address, word_t data)
+{
+  command c;
+  c.is_read = false;
+  c.chip = chip;
+  c.address = address;
+  c.data = data;
+  m_commands.push_back(c);
+  return *this;
+}
+
+linkmasta_device::command_script& linkmasta_device::command_script::read_word(chip_index chip, address_t address)
+{
+  command c;
+  c.is_read = true;
+  c.chip = chip;
+  c.address = address;
+  c.data = 0;
+  m_commands.push_back(c);
+  return *this;
+}
+
+const std::vector<linkmasta_device::command_script::command>& linkmasta_device::command_script::commands() const
+{
+  return m_commands;
+}
+
+
+
+linkmasta_session::linkmasta_session(linkmasta_device* linkmasta)
+  : m_linkmasta(linkmasta)
+{
+  if (m_linkmasta != nullptr)
+  {
+    m_linkmasta->begin_session();
+  }
+}
+
+linkmasta_session::linkmasta_session(const linkmasta_session& other)
+  : linkmasta_session(other.m_linkmasta)
+{
+  // Nothing else to do
+}
+
+linkmasta_session& linkmasta_session::operator=(const linkmasta_session& other)
+{
+  if (other.m_linkmasta != nullptr)
+  {
+    other.m_linkmasta->begin_session();
+  }
+  if (m_linkmasta != nullptr)
+  {
+    m_linkmasta->end_session();
+  }
+  m_linkmasta = other.m_linkmasta;
+  return *this;
+}
+
+linkmasta_session::~linkmasta_session()
+{
+  if (m_linkmasta != nullptr)
+  {
+    try
+    {
+      m_linkmasta->end_session();
+    }
+    catch (std::exception& ex)
+    {
+      (void) ex;
+      // Nothing sensible to do in a destructor
+    }
+  }
+}
+
+linkmasta_device* linkmasta_session::linkmasta() const
+{
+  return m_linkmasta;
+}
@@ -15,7 +15,12 @@
 #define __LINKMASTSA_DEVICE_H__
 
 #include "common/types.h"
+#include "common/block_buffer_pool.h"
+#include "batch_tuner.h"
+#include <chrono>
+#include <mutex>
 #include <string>
+#include <vector>
 
 class cartridge;
 class task_controller;
@@ -51,6 +56,9 @@ enum linkmasta_system
  *  Provides convenient methods for message passing and for interacting with
  *  any connected cartridge.
  *  
+ *  Connections can be kept open across many operations with sessions; see
+ *  \ref linkmasta_session.
+ *  
  *  This class is *not* thread-safe. Use caution when working in a multithreaded
  *  environment.
  */
@@ -73,6 +81,49 @@ public:
   /*! \brief Type used for indicating chip indexes in some operations. */
   typedef unsigned int     chip_index;
   
+  /*!
+   *  \class command_script
+   *  \brief Sequence of individual word reads and writes to be run back to
+   *         back by \ref run_script(const command_script&).
+   *  
+   *  Built up with \ref write_word(chip_index, address_t, word_t) and
+   *  \ref read_word(chip_index, address_t), which can be chained.
+   */
+  class command_script
+  {
+  public:
+    
+    /*! \brief A single word read or write. */
+    struct command
+    {
+      /*! \brief Whether the command reads a word rather than writing one. */
+      bool                 is_read;
+      
+      /*! \brief Index of the chip to access. */
+      chip_index           chip;
+      
+      /*! \brief Address on the chip to access. */
+      address_t            address;
+      
+      /*! \brief Word to write. Unused for reads. */
+      word_t               data;
+    };
+    
+    /*! \brief Appends a word write to the script. */
+    command_script&        write_word(chip_index chip, address_t address, word_t data);
+    
+    /*! \brief Appends a word read to the script. */
+    command_script&        read_word(chip_index chip, address_t address);
+    
+    /*! \brief Gets the commands in the script, in order. */
+    const std::vector<command>& commands() const;
+  
+  private:
+    
+    /*! \brief The commands in the script, in order. */
+    std::vector<command>   m_commands;
+  };
+  
   
   
   /*!
@@ -82,6 +133,98 @@ public:
    */
   virtual                  ~linkmasta_device() {};
   
+  
+  
+  /*!
+   *  \brief Starts a session, keeping the connection open until it ends.
+   *  
+   *  Opening and closing the connection to the underlying USB device is
+   *  expensive, and cartridge operations open and close it around every call.
+   *  While at least one session is active, calls to \ref close() leave the
+   *  connection open so that back-to-back operations and nested calls share
+   *  it. Once the last session ends, the connection lingers until it has been
+   *  idle for \ref idle_timeout() milliseconds and \ref close_if_idle() is
+   *  called.
+   *  
+   *  Sessions are counted. Every call must be balanced by a call to
+   *  \ref end_session(). Prefer a \ref linkmasta_session, which does so
+   *  automatically. Starting a session does not open the connection by
+   *  itself; the next operation does.
+   */
+  void                     begin_session();
+  
+  /*!
+   *  \brief Ends a session started with \ref begin_session().
+   *  
+   *  Does not close the connection; see \ref close_if_idle().
+   */
+  void                     end_session();
+  
+  /*! \brief Gets the number of active sessions. */
+  unsigned int             num_sessions() const;
+  
+  /*!
+   *  \brief Gets the number of milliseconds a connection may linger after the
+   *         last session ends.
+   */
+  timeout_t                idle_timeout() const;
+  
+  /*!
+   *  \brief Sets the number of milliseconds a connection may linger after the
+   *         last session ends.
+   *  
+   *  \param [in] timeout The idle timeout in milliseconds.
+   */
+  void                     set_idle_timeout(timeout_t timeout);
+  
+  /*!
+   *  \brief Closes a connection left open by a finished session once it has
+   *         been idle long enough.
+   *  
+   *  Meant to be called periodically while no one else is using the device.
+   *  The \ref device_manager does so for every connected device from its
+   *  auto-refresh thread.
+   *  
+   *  \return true if the connection was closed, false if not.
+   */
+  bool                     close_if_idle();
+  
+  /*!
+   *  \brief Drops and reestablishes the connection, even while sessions are
+   *         keeping it open.
+   *  
+   *  Meant for recovering from communication errors, where any transfers left
+   *  pending in the old connection must not be mistaken for replies to new
+   *  commands. Active sessions are unaffected and keep the new connection
+   *  open as they did the old one.
+   */
+  void                     reconnect();
+  
+  /*!
+   *  \brief Gets the tuner picking the number of packets per bulk read batch.
+   *  
+   *  Its state may be saved and restored between connections, see
+   *  \ref batch_tuner::save(std::ostream&) const.
+   */
+  batch_tuner&             read_batch_tuner();
+  
+  /*!
+   *  \brief Gets the tuner picking the number of packets per bulk write
+   *         batch.
+   *  
+   *  Its state may be saved and restored between connections, see
+   *  \ref batch_tuner::save(std::ostream&) const.
+   */
+  batch_tuner&             write_batch_tuner();
+  
+  /*!
+   *  \brief Gets the pool of buffers shared by the cartridge operations run
+   *         on this device.
+   *  
+   *  \see block_buffer_pool::high_water_mark()
+   */
+  block_buffer_pool&       buffer_pool();
+  
   /*!
    *  \brief Initializes the device using default settings.
    *  
@@ -272,6 +415,35 @@ public:
    */
   virtual void             write_word(chip_index chip, address_t address, word_t data) = 0;
   
+  /*!
+   *  \brief Runs a sequence of word reads and writes as one batch.
+   *  
+   *  Chip command sequences are made up of several word writes, each of which
+   *  costs a full command/reply round trip when sent with
+   *  \ref write_word(chip_index, address_t, word_t). Implementations may send
+   *  every command in the script before waiting on any reply, validating the
+   *  replies only once all have arrived. The commands still reach the chip in
+   *  order.
+   *  
+   *  The default implementation runs the commands one at a time with
+   *  \ref read_word(chip_index, address_t) and
+   *  \ref write_word(chip_index, address_t, word_t).
+   *  
+   *  If this method is called before the instance has been initialized via a
+   *  call to \ref init() or opened via a call to \ref open(), an exception will
+   *  be thrown.
+   *  
+   *  This is a blocking function that can take several seconds to complete.
+   *  
+   *  \param [in] script The commands to run.
+   *  
+   *  \return The words read by the script, in the order of the reads.
+   *  
+   *  \throws std::runtime_error If any command failed. All commands are sent
+   *          and all replies collected before throwing.
+   */
+  virtual std::vector<word_t> run_script(const command_script& script);
+  
   /*!
    *  \brief Tests for the existance of a connected cartridge.
    *  
@@ -293,6 +465,27 @@ public:
    */
   virtual bool             test_for_cartridge() = 0;
   
+  /*!
+   *  \brief Performs a quick check for the presence of a connected cartridge.
+   *  
+   *  Performs a quick check for the presence of a connected cartridge, using
+   *  as few USB round trips as the device allows. Unlike
+   *  \ref test_for_cartridge(), this method is intended to be called
+   *  frequently, for example when polling for cartridge insertion and removal,
+   *  and may be less thorough. The default implementation simply calls
+   *  \ref test_for_cartridge().
+   *  
+   *  If this method is called before the instance has been initialized via a
+   *  call to \ref init(), an exception will be thrown.
+   *  
+   *  If an operation fails or an error occures, this method will throw an
+   *  exception.
+   *  
+   *  \return true if the LinkMasta likely has a connected cartridge, false if
+   *          not.
+   */
+  virtual bool             probe_for_cartridge();
+  
   /*!
    *  \brief Builds a \ref cartridge object that can be used to perform
    *         high-level cartidge operations on.
@@ -729,6 +922,121 @@ public:
    *  \see supports_switch_slot()
    */
   virtual bool             switch_slot(unsigned int slot_num);
+
+
+
+protected:
+  
+  /*! \brief Constructor for the class. Starts out with no sessions. */
+                           linkmasta_device();
+  
+  /*!
+   *  \brief Checks whether an active or lingering session is keeping the
+   *         connection open.
+   *  
+   *  Implementations of \ref close() must leave the connection open when this
+   *  returns true. Always returns false while \ref reconnect() is closing the
+   *  connection.
+   */
+  bool                     is_session_open() const;
+  
+  /*!
+   *  \brief Stops any lingering session from keeping the connection open, so
+   *         that the next call to \ref close() really closes it.
+   *  
+   *  Meant for destructors.
+   */
+  void                     end_lingering_session();
+  
+  /*! \struct write64xN_batch
+   *  \brief A write64xN batch awaiting acknowledgement.
+   */
+  struct write64xN_batch
+  {
+    /*! \brief The address the batch was written to. */
+    address_t              address;
+    
+    /*! \brief The number of packets in the batch. */
+    unsigned int           num_packets;
+    
+    /*! \brief When the batch started being sent. */
+    std::chrono::steady_clock::time_point sent;
+  };
+
+
+
+private:
+  
+  /*! \brief Guards the session bookkeeping below. */
+  mutable std::mutex       m_session_mutex;
+  
+  /*! \brief Number of active sessions. */
+  unsigned int             m_num_sessions;
+  
+  /*! \brief Whether the connection is being kept open after the last session
+   *         ended.
+   */
+  bool                     m_session_lingering;
+  
+  /*! \brief When the last session ended. */
+  std::chrono::steady_clock::time_point m_session_ended;
+  
+  /*! \brief How long a connection may linger, in milliseconds. */
+  timeout_t                m_idle_timeout;
+  
+  /*! \brief Whether \ref reconnect() is closing the connection regardless of
+   *         sessions.
+   */
+  bool                     m_reconnecting;
+  
+  /*! \brief Tuner for the size of bulk read batches. */
+  batch_tuner              m_read_tuner;
+  
+  /*! \brief Tuner for the size of bulk write batches. */
+  batch_tuner              m_write_tuner;
+  
+  /*! \brief Buffers reused by cartridge operations. */
+  block_buffer_pool        m_buffer_pool;
+};
+
+
+
+/*! \class linkmasta_session
+ *  \brief Keeps a \ref linkmasta_device's connection open while it exists.
+ *  
+ *  Starts a session on construction and ends it on destruction. Copies share
+ *  the device and hold a session of their own.
+ *  
+ *  \see linkmasta_device::begin_session()
+ */
+class linkmasta_session
+{
+public:
+  
+  /*!
+   *  \brief Starts a session on the given device.
+   *  
+   *  \param [in] linkmasta The device to keep open. May be nullptr, in which
+   *         case nothing happens.
+   */
+  explicit                 linkmasta_session(linkmasta_device* linkmasta);
+  
+  /*! \brief Starts another session on the same device as `other`. */
+                           linkmasta_session(const linkmasta_session& other);
+  
+  /*! \brief Ends this session and starts one on the same device as `other`. */
+  linkmasta_session&       operator=(const linkmasta_session& other);
+  
+  /*! \brief Ends the session. */
+                           ~linkmasta_session();
+  
+  /*! \brief Gets the device kept open by this session. */
+  linkmasta_device*        linkmasta() const;
+
+private:
+  
+  /*! \brief The device kept open by this session. */
+  linkmasta_device*        m_linkmasta;
 };
 
 #endif /* defined(__LINKMASTSA_DEVICE_H__) */
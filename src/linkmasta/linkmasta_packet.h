@@ -0,0 +1,170 @@
+/*! \file
+ *  \brief File containing the building blocks of typed LinkMasta messages.
+ *  
+ *  File containing the packet type and the field templates from which the
+ *  typed message layouts in \ref ngp_linkmasta_packets.h and
+ *  \ref ws_linkmasta_packets.h are put together.
+ *  
+ *  Every field knows its byte offsets at compile time, so encoding and
+ *  decoding a message boils down to a handful of loads and stores into a
+ *  64-byte array. Layouts are checked with \ref lmpacket::fields_disjoint, so
+ *  a layout with overlapping fields or fields past the end of the packet
+ *  fails to compile.
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-20
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#ifndef __LINKMASTA_PACKET_H__
+#define __LINKMASTA_PACKET_H__
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <stdint.h>
+
+namespace lmpacket
+{
+
+/*! \brief Size in bytes of every packet exchanged with a LinkMasta. */
+constexpr std::size_t PACKET_SIZE = 64;
+
+/*! \brief A single packet exchanged with a LinkMasta. */
+typedef std::array<uint8_t, PACKET_SIZE> packet;
+
+
+
+/*! \brief Mask with one bit set for each of `count` bytes starting at
+ *         `first`.
+ */
+constexpr uint64_t byte_mask(std::size_t first, std::size_t count)
+{
+  return count == 0 ? 0 : ((uint64_t) 1 << first) | byte_mask(first + 1, count - 1);
+}
+
+
+
+/*! \struct u8_field
+ *  \brief A single byte at a fixed offset.
+ */
+template <std::size_t Offset>
+struct u8_field
+{
+  static_assert(Offset < PACKET_SIZE, "Field lies outside the packet");
+  
+  /*! \brief The bytes occupied by the field. */
+  static constexpr uint64_t mask = byte_mask(Offset, 1);
+  
+  /*! \brief Stores a value in the field. */
+  static void    put(packet& p, uint8_t value) { p[Offset] = value; }
+  
+  /*! \brief Reads the value of the field. */
+  static uint8_t get(const packet& p) { return p[Offset]; }
+};
+
+/*! \struct be16_field
+ *  \brief A 16-bit value stored most significant byte first.
+ */
+template <std::size_t Offset>
+struct be16_field
+{
+  static_assert(Offset + 2 <= PACKET_SIZE, "Field lies outside the packet");
+  
+  /*! \brief The bytes occupied by the field. */
+  static constexpr uint64_t mask = byte_mask(Offset, 2);
+  
+  /*! \brief Stores a value in the field. */
+  static void     put(packet& p, uint16_t value)
+  {
+    p[Offset]     = (uint8_t) (value >> 8);
+    p[Offset + 1] = (uint8_t) value;
+  }
+  
+  /*! \brief Reads the value of the field. */
+  static uint16_t get(const packet& p)
+  {
+    return (uint16_t) ((p[Offset] << 8) | p[Offset + 1]);
+  }
+};
+
+/*! \struct be24_field
+ *  \brief A 24-bit value stored most significant byte first. Higher bits are
+ *         dropped.
+ */
+template <std::size_t Offset>
+struct be24_field
+{
+  static_assert(Offset + 3 <= PACKET_SIZE, "Field lies outside the packet");
+  
+  /*! \brief The bytes occupied by the field. */
+  static constexpr uint64_t mask = byte_mask(Offset, 3);
+  
+  /*! \brief Stores a value in the field. */
+  static void     put(packet& p, uint32_t value)
+  {
+    p[Offset]     = (uint8_t) (value >> 16);
+    p[Offset + 1] = (uint8_t) (value >> 8);
+    p[Offset + 2] = (uint8_t) value;
+  }
+  
+  /*! \brief Reads the value of the field. */
+  static uint32_t get(const packet& p)
+  {
+    return ((uint32_t) p[Offset] << 16) | ((uint32_t) p[Offset + 1] << 8) | p[Offset + 2];
+  }
+};
+
+/*! \struct bytes_field
+ *  \brief A run of up to `Size` bytes of raw data.
+ */
+template <std::size_t Offset, std::size_t Size>
+struct bytes_field
+{
+  static_assert(Offset + Size <= PACKET_SIZE, "Field lies outside the packet");
+  
+  /*! \brief The bytes occupied by the field. */
+  static constexpr uint64_t mask = byte_mask(Offset, Size);
+  
+  /*! \brief The largest number of bytes the field can hold. */
+  static constexpr std::size_t size = Size;
+  
+  /*! \brief Copies `n` bytes into the field. `n` must not exceed `Size`. */
+  static void           put(packet& p, const uint8_t* data, std::size_t n)
+  {
+    memcpy(&p[Offset], data, n);
+  }
+  
+  /*! \brief Gets a pointer to the start of the field. */
+  static const uint8_t* get(const packet& p) { return &p[Offset]; }
+};
+
+
+
+/*! \struct fields_disjoint
+ *  \brief Checks at compile time that no two fields share a byte.
+ *  
+ *  `value` is true if the fields are disjoint. `mask` holds every byte used
+ *  by any of the fields.
+ */
+template <typename... Fields>
+struct fields_disjoint;
+
+template <>
+struct fields_disjoint<>
+{
+  static constexpr bool     value = true;
+  static constexpr uint64_t mask = 0;
+};
+
+template <typename Field, typename... Fields>
+struct fields_disjoint<Field, Fields...>
+{
+  static constexpr bool     value = (Field::mask & fields_disjoint<Fields...>::mask) == 0
+                                    && fields_disjoint<Fields...>::value;
+  static constexpr uint64_t mask = Field::mask | fields_disjoint<Fields...>::mask;
+};
+
+}
+
+#endif /* defined(__LINKMASTA_PACKET_H__) */
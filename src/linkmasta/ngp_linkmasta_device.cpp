@@ -17,8 +17,12 @@
 #include "usb/usb_device.h"
 #include "cartridge/ngp_cartridge.h"
 #include "ngp_linkmasta_messages.h"
+#include "ngp_linkmasta_packets.h"
 #include "task/task_controller.h"
+#include "common/byte_kernels.h"
+#include <cstring>
 #include <limits>
+#include <sstream>
 
 using namespace usb;
 
@@ -41,6 +45,9 @@ typedef ngp_linkmasta_device::chip_index chip_index;
 #define NGP_LINKMASTA_USB_ENDPOINT_OUT  0x02
 #define NGP_LINKMASTA_USB_RXTX_SIZE     64
 #define NGP_LINKMASTA_USB_TIMEOUT       2000
+#define NGP_LINKMASTA_ADDRESS_LIMIT     0x1000000
+#define NGP_LINKMASTA_WRITE64xN_WINDOW  2
+#define NGP_LINKMASTA_SCRIPT_WINDOW     8
 
 using namespace ngpmsg;
 
@@ -58,6 +65,8 @@ ngp_linkmasta_device::ngp_linkmasta_device(usb_device* usb_device)
 
 ngp_linkmasta_device::~ngp_linkmasta_device()
 {
+  end_lingering_session();
+  
   if (m_is_open)
   {
     try
@@ -192,6 +201,12 @@ void ngp_linkmasta_device::close()
     return;
   }
   
+  // Leave the connection open for the session holding it
+  if (is_session_open())
+  {
+    return;
+  }
+  
   m_usb_device->close();
   
   m_is_open = false;
@@ -209,16 +224,13 @@ word_t ngp_linkmasta_device::read_word(chip_index chip, address_t address)
     throw std::runtime_error("Device not opened");
   }
   
-  uint8_t data;
-  data_t buffer[NGP_LINKMASTA_USB_RXTX_SIZE] = {0};
+  packet buffer = read_command{address, (uint8_t) chip}.encode();
+  m_usb_device->write(buffer.data(), NGP_LINKMASTA_USB_RXTX_SIZE);
   
-  build_read_command(buffer, address, chip);
-  m_usb_device->write(buffer, NGP_LINKMASTA_USB_RXTX_SIZE);
-  
-  m_usb_device->read(buffer, NGP_LINKMASTA_USB_RXTX_SIZE);
-  if (get_read_reply(buffer, &address, &data))
+  m_usb_device->read(buffer.data(), NGP_LINKMASTA_USB_RXTX_SIZE);
+  if (read_reply::matches(buffer))
   {
-    return data;
+    return read_reply::decode(buffer).data;
   }
   else
   {
@@ -238,15 +250,11 @@ void ngp_linkmasta_device::write_word(chip_index chip, address_t address, word_t
     throw std::runtime_error("Device not opened");
   }
   
-  uint8_t result;
-  data_t buffer[NGP_LINKMASTA_USB_RXTX_SIZE] = {0};
-  
-  build_write_command(buffer, address, (uint8_t) data, chip);
-  m_usb_device->write(buffer, NGP_LINKMASTA_USB_RXTX_SIZE);
+  packet buffer = write_command{address, (uint8_t) data, (uint8_t) chip}.encode();
+  m_usb_device->write(buffer.data(), NGP_LINKMASTA_USB_RXTX_SIZE);
   
-  m_usb_device->read(buffer, NGP_LINKMASTA_USB_RXTX_SIZE);
-  get_result_reply(buffer, &result);
-  if (result == MSG_RESULT_SUCCESS)
+  m_usb_device->read(buffer.data(), NGP_LINKMASTA_USB_RXTX_SIZE);
+  if (result_reply::decode(buffer).success)
   {
     // Yay!
   }
@@ -256,6 +264,87 @@ void ngp_linkmasta_device::write_word(chip_index chip, address_t address, word_t
   }
 }
 
+std::vector<word_t> ngp_linkmasta_device::run_script(const command_script& script)
+{
+  // Make sure we are in a ready state
+  if (!m_was_init)
+  {
+    throw std::runtime_error("Device not initialized");
+  }
+  if (!m_is_open)
+  {
+    throw std::runtime_error("Device not opened");
+  }
+  
+  const std::vector<command_script::command>& commands = script.commands();
+  std::vector<word_t> results;
+  packet       buffer;
+  unsigned int num_sent = 0;
+  unsigned int num_received = 0;
+  std::string  error;
+  
+  try
+  {
+    while (num_received < commands.size())
+    {
+      // Keep sending commands until the window is full, then collect a reply
+      if (num_sent < commands.size() && num_sent - num_received < NGP_LINKMASTA_SCRIPT_WINDOW)
+      {
+        auto it = commands.begin() + num_sent;
+        if (it->is_read)
+        {
+          buffer = read_command{it->address, (uint8_t) it->chip}.encode();
+        }
+        else
+        {
+          buffer = write_command{it->address, (uint8_t) it->data, (uint8_t) it->chip}.encode();
+        }
+        m_usb_device->write(buffer.data(), NGP_LINKMASTA_USB_RXTX_SIZE);
+        ++num_sent;
+        continue;
+      }
+      
+      auto it = commands.begin() + num_received;
+      m_usb_device->read(buffer.data(), NGP_LINKMASTA_USB_RXTX_SIZE);
+      ++num_received;
+      
+      // Note the first failure, but keep going so no reply is left behind
+      if (it->is_read)
+      {
+        if (read_reply::matches(buffer))
+        {
+          results.push_back(read_reply::decode(buffer).data);
+        }
+        else
+        {
+          results.push_back(0);
+          if (error.empty()) error = "Error occured when reading word from device";
+        }
+      }
+      else
+      {
+        if (!result_reply::decode(buffer).success && error.empty())
+        {
+          error = "Error occured while attempting to write word to device";
+        }
+      }
+    }
+  }
+  catch (std::exception& ex)
+  {
+    (void) ex;
+    // Don't leave replies in the pipe for the next command to pick up
+    drain_script_replies(num_sent - num_received);
+    throw;
+  }
+  
+  if (!error.empty())
+  {
+    throw std::runtime_error(error);
+  }
+  return results;
+}
+
 bool ngp_linkmasta_device::test_for_cartridge()
 {
   if (is_integrated_with_cartridge())
@@ -268,6 +357,18 @@ bool ngp_linkmasta_device::test_for_cartridge()
   }
 }
 
+bool ngp_linkmasta_device::probe_for_cartridge()
+{
+  if (is_integrated_with_cartridge())
+  {
+    return true;
+  }
+  else
+  {
+    return ngp_cartridge::probe_for_cartridge(this);
+  }
+}
+
 cartridge* ngp_linkmasta_device::build_cartridge()
 {
   ngp_cartridge* cart = new ngp_cartridge(this);
@@ -307,7 +408,6 @@ unsigned int ngp_linkmasta_device::read_bytes(chip_index chip, address_t start_a
   }
   
   // Some working variables
-  data_t   _buffer[NGP_LINKMASTA_USB_RXTX_SIZE] = {0};
   unsigned int offset = 0;
   
   // Inform the controller that the task has begun
@@ -320,57 +420,87 @@ unsigned int ngp_linkmasta_device::read_bytes(chip_index chip, address_t start_a
   while ((num_bytes - offset) / NGP_LINKMASTA_USB_RXTX_SIZE >= 1
          && (controller == nullptr || !controller->is_task_cancelled()))
   {
-    // Calculate number of packets. Don't go over packet limit
+    // Calculate number of packets. Don't go over the batch size picked by the
+    // tuner, which is always within the packet limit
     unsigned int num_packets = (num_bytes - offset) / NGP_LINKMASTA_USB_RXTX_SIZE;
-    if (num_packets > std::numeric_limits<uint8_t>::max())
+    if (num_packets > read_batch_tuner().batch_size())
     {
-      num_packets = std::numeric_limits<uint8_t>::max();
+      num_packets = read_batch_tuner().batch_size();
     }
     
-    build_read64xN_command(_buffer, start_address + offset, chip, num_packets);
-    m_usb_device->write(_buffer, NGP_LINKMASTA_USB_RXTX_SIZE);
-    
-    for (unsigned int packets_i = 0; packets_i < num_packets; ++packets_i)
+    auto batch_start = std::chrono::steady_clock::now();
+    try
     {
-      // Get response from device and write directly to buffer
-      if (m_usb_device->read(&buffer[offset], NGP_LINKMASTA_USB_RXTX_SIZE) != NGP_LINKMASTA_USB_RXTX_SIZE)
-      {
-        throw std::runtime_error("Unexpected number of bytes received from USB device");
-      }
+      packet command = read64xN_command{start_address + offset, (uint8_t) chip, (uint8_t) num_packets}.encode();
+      m_usb_device->write(command.data(), NGP_LINKMASTA_USB_RXTX_SIZE);
       
-      // Update offset and inform controller of progress
-      offset += NGP_LINKMASTA_USB_RXTX_SIZE;
-      if (controller != nullptr)
+      for (unsigned int packets_i = 0; packets_i < num_packets; ++packets_i)
       {
-        controller->on_task_update(task_status::RUNNING, NGP_LINKMASTA_USB_RXTX_SIZE);
+        // Get response from device and write directly to buffer
+        if (m_usb_device->read(&buffer[offset], NGP_LINKMASTA_USB_RXTX_SIZE) != NGP_LINKMASTA_USB_RXTX_SIZE)
+        {
+          throw std::runtime_error("Unexpected number of bytes received from USB device");
+        }
+        
+        // Update offset and inform controller of progress
+        offset += NGP_LINKMASTA_USB_RXTX_SIZE;
+        if (controller != nullptr)
+        {
+          controller->on_task_update(task_status::RUNNING, NGP_LINKMASTA_USB_RXTX_SIZE);
+        }
       }
     }
+    catch (std::exception& ex)
+    {
+      (void) ex;
+      read_batch_tuner().record(num_packets, 0.0, false);
+      throw;
+    }
+    
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - batch_start;
+    read_batch_tuner().record(num_packets, elapsed.count(), true);
   }
   
-  // Get any remaining bytes of data individually
-  while (num_bytes - offset > 0
-         && (controller == nullptr || !controller->is_task_cancelled()))
+  // Fetch the aligned packets covering any remaining bytes in one go rather
+  // than reading them one at a time
+  if (num_bytes - offset > 0
+      && (controller == nullptr || !controller->is_task_cancelled()))
   {
-    build_read_command(_buffer, start_address + offset, chip);
-    m_usb_device->write(_buffer, NGP_LINKMASTA_USB_RXTX_SIZE);
-    m_usb_device->read(_buffer, NGP_LINKMASTA_USB_RXTX_SIZE);
+    unsigned int remaining = num_bytes - offset;
+    address_t    address = start_address + offset;
+    if (address >= NGP_LINKMASTA_ADDRESS_LIMIT || remaining > NGP_LINKMASTA_ADDRESS_LIMIT - address)
+    {
+      throw std::invalid_argument("Address out of range");
+    }
     
-    uint32_t address;
-    uint8_t  data;
-    if (get_read_reply(_buffer, &address, &data))
+    address_t    first_address = address - address % NGP_LINKMASTA_USB_RXTX_SIZE;
+    unsigned int num_packets = (address + remaining - first_address + NGP_LINKMASTA_USB_RXTX_SIZE - 1) / NGP_LINKMASTA_USB_RXTX_SIZE;
+    
+    // Keep the window inside the address space
+    if (first_address + num_packets * NGP_LINKMASTA_USB_RXTX_SIZE > NGP_LINKMASTA_ADDRESS_LIMIT)
     {
-      buffer[offset] = data;
+      first_address = NGP_LINKMASTA_ADDRESS_LIMIT - num_packets * NGP_LINKMASTA_USB_RXTX_SIZE;
     }
-    else
+    
+    data_t packets[2 * NGP_LINKMASTA_USB_RXTX_SIZE];
+    packet command = read64xN_command{first_address, (uint8_t) chip, (uint8_t) num_packets}.encode();
+    m_usb_device->write(command.data(), NGP_LINKMASTA_USB_RXTX_SIZE);
+    
+    for (unsigned int packets_i = 0; packets_i < num_packets; ++packets_i)
     {
-      throw std::runtime_error("ERROR");
+      if (m_usb_device->read(&packets[packets_i * NGP_LINKMASTA_USB_RXTX_SIZE], NGP_LINKMASTA_USB_RXTX_SIZE) != NGP_LINKMASTA_USB_RXTX_SIZE)
+      {
+        throw std::runtime_error("Unexpected number of bytes received from USB device");
+      }
     }
     
+    memcpy(&buffer[offset], &packets[address - first_address], remaining);
+    
     // Update offset and inform controller of progress
-    ++offset;
+    offset += remaining;
     if (controller != nullptr)
     {
-      controller->on_task_update(task_status::RUNNING, 1);
+      controller->on_task_update(task_status::RUNNING, remaining);
     }
   }
   
@@ -393,6 +523,7 @@ unsigned int ngp_linkmasta_device::program_bytes(chip_index chip, address_t star
   data_t   _buffer[NGP_LINKMASTA_USB_RXTX_SIZE] = {0};
   unsigned int offset = 0;
   uint8_t  result;
+  std::deque<write64xN_batch> pending;
   
   // Inform controller that task has started
   if (controller != nullptr)
@@ -400,47 +531,82 @@ unsigned int ngp_linkmasta_device::program_bytes(chip_index chip, address_t star
     controller->on_task_start(num_bytes);
   }
   
-  // Inform device of incoming data
-  while ((num_bytes - offset) / NGP_LINKMASTA_USB_RXTX_SIZE >= 1
-         && (controller == nullptr || !controller->is_task_cancelled()))
+  try
   {
-    // Makes sure we don't go over the packet limit
-    unsigned int num_packets = (num_bytes - offset) / NGP_LINKMASTA_USB_RXTX_SIZE;
-    if (num_packets > std::numeric_limits<uint8_t>::max())
+    // Inform device of incoming data
+    while ((num_bytes - offset) / NGP_LINKMASTA_USB_RXTX_SIZE >= 1
+           && (controller == nullptr || !controller->is_task_cancelled()))
     {
-      num_packets = std::numeric_limits<uint8_t>::max();
-    }
-    
-    build_flash_write64xN_command(_buffer, start_address + offset, chip, num_packets, bypass_mode);
-    m_usb_device->write(_buffer, NGP_LINKMASTA_USB_RXTX_SIZE);
-    
-    // Send chunks of 64 bytes to device
-    for (unsigned int packet_i = 0; packet_i < num_packets; ++packet_i)
-    {
-      build_flash_write64xN_data_packet(_buffer, &buffer[offset]);
-      m_usb_device->write(_buffer, NGP_LINKMASTA_USB_RXTX_SIZE);
+      // Erased flash already reads 0xFF, so blank packets need not be sent
+      if (is_blank(&buffer[offset], NGP_LINKMASTA_USB_RXTX_SIZE))
+      {
+        offset += NGP_LINKMASTA_USB_RXTX_SIZE;
+        if (controller != nullptr)
+        {
+          controller->on_task_update(task_status::RUNNING, NGP_LINKMASTA_USB_RXTX_SIZE);
+        }
+        continue;
+      }
       
-      // Update offset and inform controller of progress
-      offset += NGP_LINKMASTA_USB_RXTX_SIZE;
-      if (controller != nullptr)
+      // Makes sure we don't go over the batch size picked by the tuner, which
+      // is always within the packet limit
+      unsigned int max_packets = (num_bytes - offset) / NGP_LINKMASTA_USB_RXTX_SIZE;
+      if (max_packets > write_batch_tuner().batch_size())
+      {
+        max_packets = write_batch_tuner().batch_size();
+      }
+      
+      // Only send the run of packets up to the next blank one
+      unsigned int num_packets = 1;
+      while (num_packets < max_packets
+             && !is_blank(&buffer[offset + num_packets * NGP_LINKMASTA_USB_RXTX_SIZE], NGP_LINKMASTA_USB_RXTX_SIZE))
       {
-        controller->on_task_update(task_status::RUNNING, NGP_LINKMASTA_USB_RXTX_SIZE);
+        ++num_packets;
       }
+      
+      pending.push_back(write64xN_batch{start_address + offset, num_packets, std::chrono::steady_clock::now()});
+      packet command = flash_write64xN_command{start_address + offset, (uint8_t) chip, (uint8_t) num_packets, (uint8_t) bypass_mode}.encode();
+      try
+      {
+        m_usb_device->write(command.data(), NGP_LINKMASTA_USB_RXTX_SIZE);
+        
+        // Send chunks of 64 bytes to device
+        for (unsigned int packet_i = 0; packet_i < num_packets; ++packet_i)
+        {
+          // Data packets are nothing but the data itself, so send it in place
+          m_usb_device->write(&buffer[offset], NGP_LINKMASTA_USB_RXTX_SIZE);
+          
+          // Update offset and inform controller of progress
+          offset += NGP_LINKMASTA_USB_RXTX_SIZE;
+          if (controller != nullptr)
+          {
+            controller->on_task_update(task_status::RUNNING, NGP_LINKMASTA_USB_RXTX_SIZE);
+          }
+        }
+      }
+      catch (std::exception& ex)
+      {
+        (void) ex;
+        // A stalled batch tells the tuner as much as a rejected one
+        write_batch_tuner().record(num_packets, 0.0, false);
+        throw;
+      }
+      
+      // Check on the previous batch only now that this one is on its way, so
+      // the device always has the next batch queued up
+      await_write64xN_replies(pending, NGP_LINKMASTA_WRITE64xN_WINDOW - 1);
     }
     
-    // Verify that operaton worked
-    uint8_t packets_processed;
-    m_usb_device->read(_buffer, NGP_LINKMASTA_USB_RXTX_SIZE);
-    get_flash_write64xN_reply(_buffer, &result, &packets_processed);
-    
-    if(result != MSG_WRITE64xN_REPLY)
-    {
-      throw std::runtime_error("Unexpected reply from device");
-    }
-    if(packets_processed != num_packets)
-    {
-      throw std::runtime_error("Unexpected number of packets processed");
-    }
+    // Collect the acknowledgements still outstanding
+    await_write64xN_replies(pending, 0);
+  }
+  catch (std::exception& ex)
+  {
+    (void) ex;
+    // Don't leave acknowledgements behind for the next command to mistake
+    // for its own reply
+    drain_write64xN_replies(pending);
+    throw;
   }
   
   // If at least 32 bytes remain, write them
@@ -533,3 +699,101 @@ void ngp_linkmasta_device::fetch_firmware_version()
   m_firmware_minor_version = (unsigned int) minVer;
   m_firmware_version_set = true;
 }
+
+void ngp_linkmasta_device::await_write64xN_replies(std::deque<write64xN_batch>& pending, unsigned int max_pending)
+{
+  packet buffer;
+  
+  while (pending.size() > max_pending)
+  {
+    write64xN_batch batch = pending.front();
+    pending.pop_front();
+    
+    unsigned int num_bytes;
+    try
+    {
+      num_bytes = m_usb_device->read(buffer.data(), NGP_LINKMASTA_USB_RXTX_SIZE);
+    }
+    catch (std::exception& ex)
+    {
+      (void) ex;
+      // A timeout counts against the batch size as much as a bad reply
+      write_batch_tuner().record(batch.num_packets, 0.0, false);
+      throw;
+    }
+    
+    std::string error;
+    if (num_bytes != NGP_LINKMASTA_USB_RXTX_SIZE)
+    {
+      error = "Unexpected number of bytes received";
+    }
+    else
+    {
+      if (!write64xN_reply::matches(buffer))
+      {
+        error = "Unexpected reply from device";
+      }
+      else if (write64xN_reply::decode(buffer).num_packets != batch.num_packets)
+      {
+        error = "Unexpected number of packets processed";
+      }
+    }
+    
+    if (!error.empty())
+    {
+      write_batch_tuner().record(batch.num_packets, 0.0, false);
+      
+      // Drain the replies to the batches sent after the failed one
+      drain_write64xN_replies(pending);
+      
+      std::ostringstream message;
+      message << error << " for write at address 0x" << std::hex << batch.address;
+      throw std::runtime_error(message.str());
+    }
+    
+    // The time until the acknowledgement includes the time the device spent
+    // finishing the batches before this one, which is what throughput is made
+    // of with batches in flight
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - batch.sent;
+    write_batch_tuner().record(batch.num_packets, elapsed.count(), true);
+  }
+}
+
+void ngp_linkmasta_device::drain_write64xN_replies(std::deque<write64xN_batch>& pending)
+{
+  packet buffer;
+  
+  while (!pending.empty())
+  {
+    pending.pop_front();
+    try
+    {
+      m_usb_device->read(buffer.data(), NGP_LINKMASTA_USB_RXTX_SIZE);
+    }
+    catch (std::exception& ex)
+    {
+      (void) ex;
+      // The rest would only time out as well
+      pending.clear();
+    }
+  }
+}
+
+void ngp_linkmasta_device::drain_script_replies(unsigned int num_replies)
+{
+  packet buffer;
+  
+  for (unsigned int i = 0; i < num_replies; ++i)
+  {
+    try
+    {
+      m_usb_device->read(buffer.data(), NGP_LINKMASTA_USB_RXTX_SIZE);
+    }
+    catch (std::exception& ex)
+    {
+      (void) ex;
+      // The rest would only time out as well
+      return;
+    }
+  }
+}
@@ -16,6 +16,8 @@
 
 #include "linkmasta_device.h"
 #include "usb/usbfwd.h"
+#include <deque>
+#include <utility>
 
 
 
@@ -112,11 +114,21 @@ public:
    */
   void             write_word(chip_index chip, address_t address, word_t data);
   
+  /*!
+   *  \see linkmasta_device::run_script(const command_script& script)
+   */
+  std::vector<word_t> run_script(const command_script& script);
+  
   /*!
    *  \see linkmasta_device::test_for_cartridge()
    */
   bool             test_for_cartridge();
   
+  /*!
+   *  \see linkmasta_device::probe_for_cartridge()
+   */
+  bool             probe_for_cartridge();
+  
   /*!
    *  \see linkmasta_device::build_cartridge()
    */
@@ -172,6 +184,53 @@ private:
    */
   void             fetch_firmware_version();
   
+  /*!
+   *  \brief Reads and checks the acknowledgements of write64xN batches until
+   *         no more than the given number remain outstanding.
+   *  
+   *  Replies arrive in the order the batches were sent, so the oldest batch in
+   *  `pending` is always the one being acknowledged. If a reply is wrong, the
+   *  replies to all remaining batches are discarded with
+   *  \ref drain_write64xN_replies() so they don't get mistaken for replies to
+   *  later commands.
+   *  
+   *  Every batch acknowledged is recorded with the \ref write_batch_tuner(),
+   *  including those whose reply never arrives.
+   *  
+   *  \param [in,out] pending Every batch awaiting acknowledgement, oldest
+   *         first.
+   *  \param [in] max_pending The number of batches that may remain
+   *         outstanding.
+   *  
+   *  \throws std::runtime_error If the device reports an unexpected reply or
+   *          packet count. The message names the address of the failed batch.
+   */
+  void             await_write64xN_replies(std::deque<write64xN_batch>& pending, unsigned int max_pending);
+  
+  /*!
+   *  \brief Reads and discards the acknowledgements of every batch still in
+   *         `pending`, leaving it empty.
+   *  
+   *  Meant for bailing out of a write, so the next command doesn't read a
+   *  leftover acknowledgement as its own reply. Gives up on the rest as soon
+   *  as a read fails, since they would only fail the same way. Never throws.
+   *  
+   *  \param [in,out] pending Every batch awaiting acknowledgement.
+   */
+  void             drain_write64xN_replies(std::deque<write64xN_batch>& pending);
+  
+  /*!
+   *  \brief Reads and discards the replies to commands of a script that was
+   *         cut short.
+   *  
+   *  Used by \ref run_script() when a transfer fails with commands still in
+   *  flight. Gives up on the rest as soon as a read fails, like
+   *  \ref drain_write64xN_replies(). Never throws.
+   *  
+   *  \param [in] num_replies The number of replies still expected.
+   */
+  void             drain_script_replies(unsigned int num_replies);
+  
   
   
   /*!
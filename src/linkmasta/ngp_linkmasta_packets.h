@@ -0,0 +1,360 @@
+/*! \file
+ *  \brief File containing typed layouts of the messages passed to and from a
+ *         Neo Geo Pocket LinkMasta device.
+ *  
+ *  File containing typed layouts of the messages passed to and from a Neo Geo
+ *  Pocket LinkMasta device. These describe the same wire format as the
+ *  functions in \ref ngp_linkmasta_messages.h, with every field placed at
+ *  compile time.
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-20
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#ifndef __NGP_LINKMASTA_PACKETS_H__
+#define __NGP_LINKMASTA_PACKETS_H__
+
+#include "linkmasta_packet.h"
+
+namespace ngpmsg
+{
+
+using lmpacket::packet;
+
+/*! \brief Fields shared by the Neo Geo Pocket LinkMasta messages. */
+namespace layout
+{
+  typedef lmpacket::u8_field<0>         type;
+  typedef lmpacket::u8_field<1>         major_version;
+  typedef lmpacket::u8_field<2>         minor_version;
+  typedef lmpacket::be24_field<1>       address;
+  typedef lmpacket::u8_field<4>         data;
+  typedef lmpacket::u8_field<5>         chip;
+  typedef lmpacket::u8_field<6>         packet_count;
+  typedef lmpacket::u8_field<7>         byte_count;
+  typedef lmpacket::u8_field<8>         bypass_mode;
+  typedef lmpacket::bytes_field<32, 32> payload;
+  
+  constexpr uint8_t GETVERSION         = 0x00;
+  constexpr uint8_t READ_CMD           = 0x01;
+  constexpr uint8_t WRITE_CMD          = 0x02;
+  constexpr uint8_t READ_REPLY         = 0x03;
+  constexpr uint8_t READ64xN_CMD       = 0x04;
+  constexpr uint8_t FLASHWRITE32_CMD   = 0x05;
+  constexpr uint8_t FLASHWRITE_N_CMD   = 0x06;
+  constexpr uint8_t FLASHWRITE64xN_CMD = 0x07;
+  constexpr uint8_t WRITE64xN_REPLY    = 0x08;
+  constexpr uint8_t RESULT_FAIL        = 0x10;
+  constexpr uint8_t RESULT_SUCCESS     = 0x11;
+}
+
+
+
+/*! \brief Request for the firmware version. */
+struct getversion_command
+{
+  static_assert(lmpacket::fields_disjoint<layout::type>::value, "Overlapping fields");
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::GETVERSION);
+    return p;
+  }
+};
+
+/*! \brief Reply carrying the firmware version. */
+struct getversion_reply
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::major_version, layout::minor_version>::value, "Overlapping fields");
+  
+  uint8_t major_version;
+  uint8_t minor_version;
+  
+  /*! \brief Checks whether a packet holds this kind of reply. */
+  static bool matches(const packet& p) { return layout::type::get(p) == layout::GETVERSION; }
+  
+  static getversion_reply decode(const packet& p)
+  {
+    getversion_reply m;
+    m.major_version = layout::major_version::get(p);
+    m.minor_version = layout::minor_version::get(p);
+    return m;
+  }
+};
+
+/*! \brief Request to read a single byte. */
+struct read_command
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::address, layout::chip>::value, "Overlapping fields");
+  
+  uint32_t address;
+  uint8_t  chip;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::READ_CMD);
+    layout::address::put(p, address);
+    layout::chip::put(p, chip);
+    return p;
+  }
+  
+  static read_command decode(const packet& p)
+  {
+    read_command m;
+    m.address = layout::address::get(p);
+    m.chip = layout::chip::get(p);
+    return m;
+  }
+};
+
+/*! \brief Request to write a single byte. */
+struct write_command
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::address, layout::data, layout::chip>::value, "Overlapping fields");
+  
+  uint32_t address;
+  uint8_t  data;
+  uint8_t  chip;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::WRITE_CMD);
+    layout::address::put(p, address);
+    layout::data::put(p, data);
+    layout::chip::put(p, chip);
+    return p;
+  }
+  
+  static write_command decode(const packet& p)
+  {
+    write_command m;
+    m.address = layout::address::get(p);
+    m.data = layout::data::get(p);
+    m.chip = layout::chip::get(p);
+    return m;
+  }
+};
+
+/*! \brief Reply to a \ref read_command. */
+struct read_reply
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::address, layout::data, layout::chip>::value, "Overlapping fields");
+  
+  uint32_t address;
+  uint8_t  data;
+  uint8_t  chip;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::READ_REPLY);
+    layout::address::put(p, address);
+    layout::data::put(p, data);
+    layout::chip::put(p, chip);
+    return p;
+  }
+  
+  /*! \brief Checks whether a packet holds this kind of reply. */
+  static bool matches(const packet& p) { return layout::type::get(p) == layout::READ_REPLY; }
+  
+  static read_reply decode(const packet& p)
+  {
+    read_reply m;
+    m.address = layout::address::get(p);
+    m.data = layout::data::get(p);
+    m.chip = layout::chip::get(p);
+    return m;
+  }
+};
+
+/*! \brief Request to read a number of 64-byte packets. */
+struct read64xN_command
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::address, layout::chip, layout::packet_count>::value, "Overlapping fields");
+  
+  uint32_t address;
+  uint8_t  chip;
+  uint8_t  num_packets;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::READ64xN_CMD);
+    layout::address::put(p, address);
+    layout::chip::put(p, chip);
+    layout::packet_count::put(p, num_packets);
+    return p;
+  }
+  
+  static read64xN_command decode(const packet& p)
+  {
+    read64xN_command m;
+    m.address = layout::address::get(p);
+    m.chip = layout::chip::get(p);
+    m.num_packets = layout::packet_count::get(p);
+    return m;
+  }
+};
+
+/*! \brief Request to program up to 32 bytes carried in the packet itself. */
+struct flash_write_N_command
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::address, layout::chip, layout::byte_count, layout::bypass_mode, layout::payload>::value, "Overlapping fields");
+  
+  uint32_t       address;
+  uint8_t        chip;
+  uint8_t        num_bytes;
+  uint8_t        bypass_mode;
+  const uint8_t* data;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::FLASHWRITE_N_CMD);
+    layout::address::put(p, address);
+    layout::chip::put(p, chip);
+    layout::byte_count::put(p, num_bytes);
+    layout::bypass_mode::put(p, bypass_mode);
+    layout::payload::put(p, data, num_bytes);
+    return p;
+  }
+  
+  /*! \brief Decodes a packet. `data` points into the packet. */
+  static flash_write_N_command decode(const packet& p)
+  {
+    flash_write_N_command m;
+    m.address = layout::address::get(p);
+    m.chip = layout::chip::get(p);
+    m.num_bytes = layout::byte_count::get(p);
+    m.bypass_mode = layout::bypass_mode::get(p);
+    m.data = layout::payload::get(p);
+    return m;
+  }
+};
+
+/*! \brief Request to program exactly 32 bytes carried in the packet itself. */
+struct flash_write_32_command
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::address, layout::chip, layout::bypass_mode, layout::payload>::value, "Overlapping fields");
+  
+  uint32_t       address;
+  uint8_t        chip;
+  uint8_t        bypass_mode;
+  const uint8_t* data;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::FLASHWRITE32_CMD);
+    layout::address::put(p, address);
+    layout::chip::put(p, chip);
+    layout::bypass_mode::put(p, bypass_mode);
+    layout::payload::put(p, data, layout::payload::size);
+    return p;
+  }
+  
+  /*! \brief Decodes a packet. `data` points into the packet. */
+  static flash_write_32_command decode(const packet& p)
+  {
+    flash_write_32_command m;
+    m.address = layout::address::get(p);
+    m.chip = layout::chip::get(p);
+    m.bypass_mode = layout::bypass_mode::get(p);
+    m.data = layout::payload::get(p);
+    return m;
+  }
+};
+
+/*! \brief Request to program a number of 64-byte packets sent after it. */
+struct flash_write64xN_command
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::address, layout::chip, layout::packet_count, layout::bypass_mode>::value, "Overlapping fields");
+  
+  uint32_t address;
+  uint8_t  chip;
+  uint8_t  num_packets;
+  uint8_t  bypass_mode;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::FLASHWRITE64xN_CMD);
+    layout::address::put(p, address);
+    layout::chip::put(p, chip);
+    layout::packet_count::put(p, num_packets);
+    layout::bypass_mode::put(p, bypass_mode);
+    return p;
+  }
+  
+  static flash_write64xN_command decode(const packet& p)
+  {
+    flash_write64xN_command m;
+    m.address = layout::address::get(p);
+    m.chip = layout::chip::get(p);
+    m.num_packets = layout::packet_count::get(p);
+    m.bypass_mode = layout::bypass_mode::get(p);
+    return m;
+  }
+};
+
+/*! \brief Reply to a \ref flash_write64xN_command. */
+struct write64xN_reply
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::packet_count>::value, "Overlapping fields");
+  
+  uint8_t num_packets;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::WRITE64xN_REPLY);
+    layout::packet_count::put(p, num_packets);
+    return p;
+  }
+  
+  /*! \brief Checks whether a packet holds this kind of reply. */
+  static bool matches(const packet& p) { return layout::type::get(p) == layout::WRITE64xN_REPLY; }
+  
+  static write64xN_reply decode(const packet& p)
+  {
+    write64xN_reply m;
+    m.num_packets = layout::packet_count::get(p);
+    return m;
+  }
+};
+
+/*! \brief Reply reporting whether a command succeeded. */
+struct result_reply
+{
+  static_assert(lmpacket::fields_disjoint<layout::type>::value, "Overlapping fields");
+  
+  bool success;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, success ? layout::RESULT_SUCCESS : layout::RESULT_FAIL);
+    return p;
+  }
+  
+  /*! \brief Checks whether a packet holds this kind of reply. */
+  static bool matches(const packet& p)
+  {
+    return layout::type::get(p) == layout::RESULT_SUCCESS || layout::type::get(p) == layout::RESULT_FAIL;
+  }
+  
+  static result_reply decode(const packet& p)
+  {
+    result_reply m;
+    m.success = (layout::type::get(p) == layout::RESULT_SUCCESS);
+    return m;
+  }
+};
+
+}
+
+#endif /* defined(__NGP_LINKMASTA_PACKETS_H__) */
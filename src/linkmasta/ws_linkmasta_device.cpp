@@ -16,9 +16,13 @@
 #include "ws_linkmasta_device.h"
 #include "usb/usb_device.h"
 #include "ws_linkmasta_messages.h"
+#include "ws_linkmasta_packets.h"
 #include "task/task_controller.h"
+#include "common/byte_kernels.h"
 #include "cartridge/ws_cartridge.h"
+#include <cstring>
 #include <limits>
+#include <sstream>
 
 using namespace usb;
 
@@ -37,6 +41,9 @@ typedef ws_linkmasta_device::chip_index chip_index;
 #define WS_LINKMASTA_USB_ENDPOINT_OUT   0x02
 #define WS_LINKMASTA_USB_RXTX_SIZE      64
 #define WS_LINKMASTA_USB_TIMEOUT        2000
+#define WS_LINKMASTA_ADDRESS_LIMIT      0x1000000
+#define WS_LINKMASTA_WRITE64xN_WINDOW   2
+#define WS_LINKMASTA_SCRIPT_WINDOW      8
 
 using namespace wsmsg;
 
@@ -54,6 +61,8 @@ ws_linkmasta_device::ws_linkmasta_device(usb::usb_device* usb_device)
 
 ws_linkmasta_device::~ws_linkmasta_device()
 {
+  end_lingering_session();
+  
   if (m_is_open)
   {
     close();
@@ -184,6 +193,12 @@ void ws_linkmasta_device::close()
     return;
   }
   
+  // Leave the connection open for the session holding it
+  if (is_session_open())
+  {
+    return;
+  }
+  
   m_usb_device->close();
   
   m_is_open = false;
@@ -201,16 +216,13 @@ word_t ws_linkmasta_device::read_word(chip_index chip, address_t address)
     throw std::runtime_error("Device not opened");
   }
   
-  uint8_t data;
-  data_t buffer[WS_LINKMASTA_USB_RXTX_SIZE] = {0};
-  
-  build_read8_command(buffer, address, chip);
-  m_usb_device->write(buffer, WS_LINKMASTA_USB_RXTX_SIZE);
+  packet buffer = read8_command{address, (uint8_t) chip}.encode();
+  m_usb_device->write(buffer.data(), WS_LINKMASTA_USB_RXTX_SIZE);
   
-  m_usb_device->read(buffer, WS_LINKMASTA_USB_RXTX_SIZE);
-  if (get_read8_reply(buffer, &address, &data))
+  m_usb_device->read(buffer.data(), WS_LINKMASTA_USB_RXTX_SIZE);
+  if (read8_reply::matches(buffer))
   {
-    return data;
+    return read8_reply::decode(buffer).data;
   }
   else
   {
@@ -230,25 +242,108 @@ void ws_linkmasta_device::write_word(chip_index chip, address_t address, word_t
     throw std::runtime_error("Device not opened");
   }
   
-  uint8_t result;
-  data_t buffer[WS_LINKMASTA_USB_RXTX_SIZE] = {0};
-  
-  build_write8_command(buffer, address, data, chip);
-  m_usb_device->write(buffer, WS_LINKMASTA_USB_RXTX_SIZE);
+  packet buffer = write8_command{address, (uint8_t) data, (uint8_t) chip}.encode();
+  m_usb_device->write(buffer.data(), WS_LINKMASTA_USB_RXTX_SIZE);
   
-  m_usb_device->read(buffer, WS_LINKMASTA_USB_RXTX_SIZE);
-  get_result_reply(buffer, &result);
-  if (result != MSG_RESULT_SUCCESS)
+  m_usb_device->read(buffer.data(), WS_LINKMASTA_USB_RXTX_SIZE);
+  if (!result_reply::decode(buffer).success)
   {
     throw std::runtime_error("Error occured while attempting to write word");
   }
 }
 
+std::vector<word_t> ws_linkmasta_device::run_script(const command_script& script)
+{
+  // Make sure we are in a ready state
+  if (!m_was_init)
+  {
+    throw std::runtime_error("Device not initialized");
+  }
+  if (!m_is_open)
+  {
+    throw std::runtime_error("Device not opened");
+  }
+  
+  const std::vector<command_script::command>& commands = script.commands();
+  std::vector<word_t> results;
+  packet       buffer;
+  unsigned int num_sent = 0;
+  unsigned int num_received = 0;
+  std::string  error;
+  
+  try
+  {
+    while (num_received < commands.size())
+    {
+      // Keep sending commands until the window is full, then collect a reply
+      if (num_sent < commands.size() && num_sent - num_received < WS_LINKMASTA_SCRIPT_WINDOW)
+      {
+        auto it = commands.begin() + num_sent;
+        if (it->is_read)
+        {
+          buffer = read8_command{it->address, (uint8_t) it->chip}.encode();
+        }
+        else
+        {
+          buffer = write8_command{it->address, (uint8_t) it->data, (uint8_t) it->chip}.encode();
+        }
+        m_usb_device->write(buffer.data(), WS_LINKMASTA_USB_RXTX_SIZE);
+        ++num_sent;
+        continue;
+      }
+      
+      auto it = commands.begin() + num_received;
+      m_usb_device->read(buffer.data(), WS_LINKMASTA_USB_RXTX_SIZE);
+      ++num_received;
+      
+      // Note the first failure, but keep going so no reply is left behind
+      if (it->is_read)
+      {
+        if (read8_reply::matches(buffer))
+        {
+          results.push_back(read8_reply::decode(buffer).data);
+        }
+        else
+        {
+          results.push_back(0);
+          if (error.empty()) error = "Error occured while attempting to read word";
+        }
+      }
+      else
+      {
+        if (!result_reply::decode(buffer).success && error.empty())
+        {
+          error = "Error occured while attempting to write word";
+        }
+      }
+    }
+  }
+  catch (std::exception& ex)
+  {
+    (void) ex;
+    // Don't leave replies in the pipe for the next command to pick up
+    drain_script_replies(num_sent - num_received);
+    throw;
+  }
+  
+  if (!error.empty())
+  {
+    throw std::runtime_error(error);
+  }
+  return results;
+}
+
 bool ws_linkmasta_device::test_for_cartridge()
 {
   return true;
 }
 
+bool ws_linkmasta_device::probe_for_cartridge()
+{
+  // WonderSwan Flash Mastas are always integrated with their cartridge
+  return true;
+}
+
 cartridge* ws_linkmasta_device::build_cartridge()
 {
   ws_cartridge* cart = new ws_cartridge(this);
@@ -303,7 +398,6 @@ unsigned int ws_linkmasta_device::read_bytes(chip_index chip, address_t start_ad
   }
   
   // Some working variables
-  data_t   _buffer[WS_LINKMASTA_USB_RXTX_SIZE] = {0};
   unsigned int offset = 0;
   
   // Inform the controller that the task has begun
@@ -316,58 +410,87 @@ unsigned int ws_linkmasta_device::read_bytes(chip_index chip, address_t start_ad
   while ((num_bytes - offset) / WS_LINKMASTA_USB_RXTX_SIZE >= 1
          && (controller == nullptr || !controller->is_task_cancelled()))
   {
-    // Calculate number of packets. Don't go over packet limit
+    // Calculate number of packets. Don't go over the batch size picked by the
+    // tuner, which is always within the packet limit
     unsigned int num_packets = (num_bytes - offset) / WS_LINKMASTA_USB_RXTX_SIZE;
-    if (num_packets > std::numeric_limits<uint8_t>::max())
+    if (num_packets > read_batch_tuner().batch_size())
     {
-      num_packets = std::numeric_limits<uint8_t>::max();
+      num_packets = read_batch_tuner().batch_size();
     }
     
-    build_read64xN_command(_buffer, start_address + offset, num_packets, chip);
-    m_usb_device->write(_buffer, WS_LINKMASTA_USB_RXTX_SIZE);
-    
-    for (unsigned int packets_i = 0; packets_i < num_packets; ++packets_i)
+    auto batch_start = std::chrono::steady_clock::now();
+    try
     {
-      // Get response from device and write directly to buffer
-      if (m_usb_device->read(&buffer[offset], WS_LINKMASTA_USB_RXTX_SIZE) != WS_LINKMASTA_USB_RXTX_SIZE)
-      {
-        throw std::runtime_error("Unexpected number of bytes received");
-      }
+      packet command = read64xN_command{start_address + offset, (uint8_t) num_packets, (uint8_t) chip}.encode();
+      m_usb_device->write(command.data(), WS_LINKMASTA_USB_RXTX_SIZE);
       
-      // Update offset and inform controller of progress
-      offset += WS_LINKMASTA_USB_RXTX_SIZE;
-      if (controller != nullptr)
+      for (unsigned int packets_i = 0; packets_i < num_packets; ++packets_i)
       {
-        controller->on_task_update(task_status::RUNNING, WS_LINKMASTA_USB_RXTX_SIZE);
+        // Get response from device and write directly to buffer
+        if (m_usb_device->read(&buffer[offset], WS_LINKMASTA_USB_RXTX_SIZE) != WS_LINKMASTA_USB_RXTX_SIZE)
+        {
+          throw std::runtime_error("Unexpected number of bytes received");
+        }
+        
+        // Update offset and inform controller of progress
+        offset += WS_LINKMASTA_USB_RXTX_SIZE;
+        if (controller != nullptr)
+        {
+          controller->on_task_update(task_status::RUNNING, WS_LINKMASTA_USB_RXTX_SIZE);
+        }
       }
     }
+    catch (std::exception& ex)
+    {
+      (void) ex;
+      read_batch_tuner().record(num_packets, 0.0, false);
+      throw;
+    }
+    
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - batch_start;
+    read_batch_tuner().record(num_packets, elapsed.count(), true);
   }
   
-  // Get any remaining bytes of data individually
-  while (num_bytes - offset > 0
-         && (controller == nullptr || !controller->is_task_cancelled()))
+  // Fetch the aligned packets covering any remaining bytes in one go rather
+  // than reading them one at a time
+  if (num_bytes - offset > 0
+      && (controller == nullptr || !controller->is_task_cancelled()))
   {
-    build_read8_command(_buffer, start_address + offset, chip);
-    m_usb_device->write(_buffer, WS_LINKMASTA_USB_RXTX_SIZE);
+    unsigned int remaining = num_bytes - offset;
+    address_t    address = start_address + offset;
+    if (address >= WS_LINKMASTA_ADDRESS_LIMIT || remaining > WS_LINKMASTA_ADDRESS_LIMIT - address)
+    {
+      throw std::invalid_argument("Address out of range");
+    }
     
-    m_usb_device->read(_buffer, WS_LINKMASTA_USB_RXTX_SIZE);
+    address_t    first_address = address - address % WS_LINKMASTA_USB_RXTX_SIZE;
+    unsigned int num_packets = (address + remaining - first_address + WS_LINKMASTA_USB_RXTX_SIZE - 1) / WS_LINKMASTA_USB_RXTX_SIZE;
     
-    uint32_t address;
-    uint8_t data;
-    if (get_read8_reply(_buffer, &address, &data))
+    // Keep the window inside the address space
+    if (first_address + num_packets * WS_LINKMASTA_USB_RXTX_SIZE > WS_LINKMASTA_ADDRESS_LIMIT)
     {
-      buffer[offset] = (data_t) (data);
+      first_address = WS_LINKMASTA_ADDRESS_LIMIT - num_packets * WS_LINKMASTA_USB_RXTX_SIZE;
     }
-    else
+    
+    data_t packets[2 * WS_LINKMASTA_USB_RXTX_SIZE];
+    packet command = read64xN_command{first_address, (uint8_t) num_packets, (uint8_t) chip}.encode();
+    m_usb_device->write(command.data(), WS_LINKMASTA_USB_RXTX_SIZE);
+    
+    for (unsigned int packets_i = 0; packets_i < num_packets; ++packets_i)
     {
-      throw std::runtime_error("ERROR");
+      if (m_usb_device->read(&packets[packets_i * WS_LINKMASTA_USB_RXTX_SIZE], WS_LINKMASTA_USB_RXTX_SIZE) != WS_LINKMASTA_USB_RXTX_SIZE)
+      {
+        throw std::runtime_error("Unexpected number of bytes received");
+      }
     }
     
+    memcpy(&buffer[offset], &packets[address - first_address], remaining);
+    
     // Update offset and inform controller of progress
-    offset += 1;
+    offset += remaining;
     if (controller != nullptr)
     {
-      controller->on_task_update(task_status::RUNNING, 1);
+      controller->on_task_update(task_status::RUNNING, remaining);
     }
   }
   
@@ -403,6 +526,7 @@ unsigned int ws_linkmasta_device::program_bytes(chip_index chip, address_t start
   data_t   _buffer[WS_LINKMASTA_USB_RXTX_SIZE] = {0};
   unsigned int offset = 0;
   uint8_t  result;
+  std::deque<write64xN_batch> pending;
   
   // Inform controller that task has started
   if (controller != nullptr)
@@ -410,69 +534,145 @@ unsigned int ws_linkmasta_device::program_bytes(chip_index chip, address_t start
     controller->on_task_start(num_bytes);
   }
   
-  // Read in packets of 64 bytes
-  while ((num_bytes - offset) / WS_LINKMASTA_USB_RXTX_SIZE >= 1
-         && (controller == nullptr || !controller->is_task_cancelled()))
+  // Erased flash already reads 0xFF, so blank packets need not be sent. SRAM
+  // keeps whatever was there before, so every packet must be sent to it.
+  const bool sparse = (chip == target_enum::TARGET_ROM);
+  
+  try
   {
-    // Makes sure we don't go over the packet limit
-    unsigned int num_packets = (num_bytes - offset) / WS_LINKMASTA_USB_RXTX_SIZE;
-    if (num_packets > std::numeric_limits<uint8_t>::max())
+    // Read in packets of 64 bytes
+    while ((num_bytes - offset) / WS_LINKMASTA_USB_RXTX_SIZE >= 1
+           && (controller == nullptr || !controller->is_task_cancelled()))
     {
-      num_packets = std::numeric_limits<uint8_t>::max();
-    }
-    
-    // Treat writes to flash and sram differently
-    switch (chip)
-    {
-    case target_enum::TARGET_ROM:
-      build_flash_write64xN_command(_buffer, start_address + offset, num_packets);
-      break;
+      // Skip over blank packets
+      if (sparse && is_blank(&buffer[offset], WS_LINKMASTA_USB_RXTX_SIZE))
+      {
+        offset += WS_LINKMASTA_USB_RXTX_SIZE;
+        if (controller != nullptr)
+        {
+          controller->on_task_update(task_status::RUNNING, WS_LINKMASTA_USB_RXTX_SIZE);
+        }
+        continue;
+      }
       
-    case target_enum::TARGET_SRAM:
-      build_sram_write64xN_command(_buffer, start_address + offset, num_packets);
-      break;
-    }
-    m_usb_device->write(_buffer, WS_LINKMASTA_USB_RXTX_SIZE);
-    
-    // Send chunks of 64 bytes to device
-    for (unsigned int packet_i = 0; packet_i < num_packets; ++packet_i)
-    {
-      // Tread writes to flash and sram differently
+      // Makes sure we don't go over the batch size picked by the tuner, which
+      // is always within the packet limit
+      unsigned int max_packets = (num_bytes - offset) / WS_LINKMASTA_USB_RXTX_SIZE;
+      if (max_packets > write_batch_tuner().batch_size())
+      {
+        max_packets = write_batch_tuner().batch_size();
+      }
+      
+      // Only send the run of packets up to the next blank one
+      unsigned int num_packets = (sparse ? 1 : max_packets);
+      while (num_packets < max_packets
+             && !is_blank(&buffer[offset + num_packets * WS_LINKMASTA_USB_RXTX_SIZE], WS_LINKMASTA_USB_RXTX_SIZE))
+      {
+        ++num_packets;
+      }
+      
+      // Treat writes to flash and sram differently
+      pending.push_back(write64xN_batch{start_address + offset, num_packets, std::chrono::steady_clock::now()});
+      packet command;
       switch (chip)
       {
       case target_enum::TARGET_ROM:
-        build_flash_write64xN_data_packet(_buffer, &buffer[offset]);
+        command = flash_write64xN_command{start_address + offset, (uint8_t) num_packets}.encode();
         break;
-        
+      
       case target_enum::TARGET_SRAM:
-        build_sram_write64xN_data_packet(_buffer, &buffer[offset]);
+        command = sram_write64xN_command{start_address + offset, (uint8_t) num_packets}.encode();
         break;
       }
-
-      m_usb_device->write(_buffer, WS_LINKMASTA_USB_RXTX_SIZE);
-      
-      // Update offset and inform controller of progress
-      offset += WS_LINKMASTA_USB_RXTX_SIZE;
-      if (controller != nullptr)
+      try
+      {
+        m_usb_device->write(command.data(), WS_LINKMASTA_USB_RXTX_SIZE);
+        
+        // Send chunks of 64 bytes to device
+        for (unsigned int packet_i = 0; packet_i < num_packets; ++packet_i)
+        {
+          // Data packets are nothing but the data itself, so send it in place
+          m_usb_device->write(&buffer[offset], WS_LINKMASTA_USB_RXTX_SIZE);
+          
+          // Update offset and inform controller of progress
+          offset += WS_LINKMASTA_USB_RXTX_SIZE;
+          if (controller != nullptr)
+          {
+            controller->on_task_update(task_status::RUNNING, WS_LINKMASTA_USB_RXTX_SIZE);
+          }
+        }
+      }
+      catch (std::exception& ex)
       {
-        controller->on_task_update(task_status::RUNNING, WS_LINKMASTA_USB_RXTX_SIZE);
+        (void) ex;
+        // A stalled batch tells the tuner as much as a rejected one
+        write_batch_tuner().record(num_packets, 0.0, false);
+        throw;
       }
+      
+      // Check on the previous batch only now that this one is on its way, so
+      // the device always has the next batch queued up
+      await_write64xN_replies(pending, WS_LINKMASTA_WRITE64xN_WINDOW - 1);
     }
     
-    // Verify that operaton worked
-    uint8_t packets_processed;
-    m_usb_device->read(_buffer, WS_LINKMASTA_USB_RXTX_SIZE);
-    get_write64xN_reply(_buffer, &result, &packets_processed);
+    // Collect the acknowledgements still outstanding
+    await_write64xN_replies(pending, 0);
     
-    if(result != MSG_WRITE64xN_REPLY)
+    // Send whatever is left of an SRAM write as one more batch of the aligned
+    // packets covering it, so it never runs past the end of the chip. The
+    // bytes of those packets outside the data are read first, so they're
+    // written back with what they already hold.
+    if (chip == target_enum::TARGET_SRAM && num_bytes - offset > 0
+        && (controller == nullptr || !controller->is_task_cancelled()))
     {
-      throw std::runtime_error("Unexpected reply from device");
-    }
-    if(packets_processed != num_packets)
-    {
-      throw std::runtime_error("Unexpected number of packets processed");
+      unsigned int remaining = num_bytes - offset;
+      address_t    address = start_address + offset;
+      if (address >= WS_LINKMASTA_ADDRESS_LIMIT || remaining > WS_LINKMASTA_ADDRESS_LIMIT - address)
+      {
+        throw std::invalid_argument("Address out of range");
+      }
+      
+      address_t    first_address = address - address % WS_LINKMASTA_USB_RXTX_SIZE;
+      unsigned int num_packets = (address + remaining - first_address + WS_LINKMASTA_USB_RXTX_SIZE - 1) / WS_LINKMASTA_USB_RXTX_SIZE;
+      
+      data_t merged[2 * WS_LINKMASTA_USB_RXTX_SIZE];
+      read_bytes(chip, first_address, merged, num_packets * WS_LINKMASTA_USB_RXTX_SIZE);
+      memcpy(&merged[address - first_address], &buffer[offset], remaining);
+      
+      pending.push_back(write64xN_batch{first_address, num_packets, std::chrono::steady_clock::now()});
+      packet command = sram_write64xN_command{first_address, (uint8_t) num_packets}.encode();
+      try
+      {
+        m_usb_device->write(command.data(), WS_LINKMASTA_USB_RXTX_SIZE);
+        for (unsigned int packet_i = 0; packet_i < num_packets; ++packet_i)
+        {
+          m_usb_device->write(&merged[packet_i * WS_LINKMASTA_USB_RXTX_SIZE], WS_LINKMASTA_USB_RXTX_SIZE);
+        }
+      }
+      catch (std::exception& ex)
+      {
+        (void) ex;
+        write_batch_tuner().record(num_packets, 0.0, false);
+        throw;
+      }
+      await_write64xN_replies(pending, 0);
+      
+      // Update offset and inform controller of progress
+      offset += remaining;
+      if (controller != nullptr)
+      {
+        controller->on_task_update(task_status::RUNNING, remaining);
+      }
     }
   }
+  catch (std::exception& ex)
+  {
+    (void) ex;
+    // Don't leave acknowledgements behind for the next command to mistake
+    // for its own reply
+    drain_write64xN_replies(pending);
+    throw;
+  }
   
   // If at least 32 bytes remain, write them
   // Only do this if we're programming the flash chip
@@ -500,68 +700,37 @@ unsigned int ws_linkmasta_device::program_bytes(chip_index chip, address_t start
   }
   
   // If any bytes remain, write them
+  // Only do this if we're programming the flash chip
   while (num_bytes - offset > 0
-         && (controller == nullptr || !controller->is_task_cancelled()))
+         && (controller == nullptr || !controller->is_task_cancelled())
+         && chip == target_enum::TARGET_ROM)
   {
-    switch (chip)
+    unsigned int num_bytes_ = num_bytes;
+    if (num_bytes_ > WS_LINKMASTA_USB_RXTX_SIZE / 2)
+    {
+      num_bytes_ = (WS_LINKMASTA_USB_RXTX_SIZE / 2);
+    }
+    
+    build_flash_write_N_command(_buffer, start_address + offset, &buffer[offset], num_bytes_ - offset);
+    m_usb_device->write(_buffer, WS_LINKMASTA_USB_RXTX_SIZE);
+    
+    // Verify that operation worked
+    m_usb_device->read(_buffer, WS_LINKMASTA_USB_RXTX_SIZE);
+    get_result_reply(_buffer, &result);
+    if (result != MSG_RESULT_SUCCESS)
     {
-    case target_enum::TARGET_ROM:
+      if (controller != nullptr)
       {
-        unsigned int num_bytes_ = num_bytes;
-        if (num_bytes_ > WS_LINKMASTA_USB_RXTX_SIZE / 2)
-        {
-          num_bytes_ = (WS_LINKMASTA_USB_RXTX_SIZE / 2);
-        }
-        
-        build_flash_write_N_command(_buffer, start_address + offset, &buffer[offset], num_bytes_ - offset);
-        m_usb_device->write(_buffer, WS_LINKMASTA_USB_RXTX_SIZE);
-        
-        // Verify that operation worked
-        m_usb_device->read(_buffer, WS_LINKMASTA_USB_RXTX_SIZE);
-        get_result_reply(_buffer, &result);
-        if (result != MSG_RESULT_SUCCESS)
-        {
-          if (controller != nullptr)
-          {
-            controller->on_task_end(task_status::ERROR, offset);
-          }
-          throw std::runtime_error("Error occured while attempting to program bytes");
-        }
-        
-        // Update offset and inform controller of progress
-        offset += num_bytes_ - offset;
-        if (controller != nullptr)
-        {
-          controller->on_task_end(task_status::RUNNING, num_bytes - offset);
-        }
+        controller->on_task_end(task_status::ERROR, offset);
       }
-      break;
-      
-    case target_enum::TARGET_SRAM:
-      {
-        build_write8_command(_buffer, start_address + offset, buffer[offset], chip);
-        m_usb_device->write(_buffer, WS_LINKMASTA_USB_RXTX_SIZE);
-        
-        // Verify that operation worked
-        m_usb_device->read(_buffer, WS_LINKMASTA_USB_RXTX_SIZE);
-        get_result_reply(_buffer, &result);
-        if (result != MSG_RESULT_SUCCESS)
-        {
-          if (controller != nullptr)
-          {
-            controller->on_task_end(task_status::ERROR, offset);
-          }
-          throw std::runtime_error("Error occured while attempting to program bytes");
-        }
-        
-        // Update offset and inform controller of progress
-        offset += 1;
-        if (controller != nullptr)
-        {
-          controller->on_task_end(task_status::RUNNING, 1);
-        }
-      }
-      break;
+      throw std::runtime_error("Error occured while attempting to program bytes");
+    }
+    
+    // Update offset and inform controller of progress
+    offset += num_bytes_ - offset;
+    if (controller != nullptr)
+    {
+      controller->on_task_end(task_status::RUNNING, num_bytes - offset);
     }
   }
   
@@ -705,3 +874,101 @@ void ws_linkmasta_device::fetch_slot_info()
   m_num_slots = (unsigned int) numSlotsPerCart;
   m_slot_size = 1 << numAddrLinesPerSlot;
 }
+
+void ws_linkmasta_device::await_write64xN_replies(std::deque<write64xN_batch>& pending, unsigned int max_pending)
+{
+  packet buffer;
+  
+  while (pending.size() > max_pending)
+  {
+    write64xN_batch batch = pending.front();
+    pending.pop_front();
+    
+    unsigned int num_bytes;
+    try
+    {
+      num_bytes = m_usb_device->read(buffer.data(), WS_LINKMASTA_USB_RXTX_SIZE);
+    }
+    catch (std::exception& ex)
+    {
+      (void) ex;
+      // A timeout counts against the batch size as much as a bad reply
+      write_batch_tuner().record(batch.num_packets, 0.0, false);
+      throw;
+    }
+    
+    std::string error;
+    if (num_bytes != WS_LINKMASTA_USB_RXTX_SIZE)
+    {
+      error = "Unexpected number of bytes received";
+    }
+    else
+    {
+      if (!write64xN_reply::matches(buffer))
+      {
+        error = "Unexpected reply from device";
+      }
+      else if (write64xN_reply::decode(buffer).num_packets != batch.num_packets)
+      {
+        error = "Unexpected number of packets processed";
+      }
+    }
+    
+    if (!error.empty())
+    {
+      write_batch_tuner().record(batch.num_packets, 0.0, false);
+      
+      // Drain the replies to the batches sent after the failed one
+      drain_write64xN_replies(pending);
+      
+      std::ostringstream message;
+      message << error << " for write at address 0x" << std::hex << batch.address;
+      throw std::runtime_error(message.str());
+    }
+    
+    // The time until the acknowledgement includes the time the device spent
+    // finishing the batches before this one, which is what throughput is made
+    // of with batches in flight
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - batch.sent;
+    write_batch_tuner().record(batch.num_packets, elapsed.count(), true);
+  }
+}
+
+void ws_linkmasta_device::drain_write64xN_replies(std::deque<write64xN_batch>& pending)
+{
+  packet buffer;
+  
+  while (!pending.empty())
+  {
+    pending.pop_front();
+    try
+    {
+      m_usb_device->read(buffer.data(), WS_LINKMASTA_USB_RXTX_SIZE);
+    }
+    catch (std::exception& ex)
+    {
+      (void) ex;
+      // The rest would only time out as well
+      pending.clear();
+    }
+  }
+}
+
+void ws_linkmasta_device::drain_script_replies(unsigned int num_replies)
+{
+  packet buffer;
+  
+  for (unsigned int i = 0; i < num_replies; ++i)
+  {
+    try
+    {
+      m_usb_device->read(buffer.data(), WS_LINKMASTA_USB_RXTX_SIZE);
+    }
+    catch (std::exception& ex)
+    {
+      (void) ex;
+      // The rest would only time out as well
+      return;
+    }
+  }
+}
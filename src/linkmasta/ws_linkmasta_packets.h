@@ -0,0 +1,466 @@
+/*! \file
+ *  \brief File containing typed layouts of the messages passed to and from a
+ *         WonderSwan LinkMasta device.
+ *  
+ *  File containing typed layouts of the messages passed to and from a
+ *  WonderSwan LinkMasta device. These describe the same wire format as the
+ *  functions in \ref ws_linkmasta_messages.h, with every field placed at
+ *  compile time.
+ *  
+ *  \author Daniel Andrus
+ *  \date 2016-02-20
+ *  \copyright Copyright (c) 2015 7400 Circuits. All rights reserved.
+ */
+
+#ifndef __WS_LINKMASTA_PACKETS_H__
+#define __WS_LINKMASTA_PACKETS_H__
+
+#include "linkmasta_packet.h"
+
+namespace wsmsg
+{
+
+using lmpacket::packet;
+
+/*! \brief Fields shared by the WonderSwan LinkMasta messages. */
+namespace layout
+{
+  /*! \struct address
+   *  \brief Byte address split into a 24-bit word address and the low bit,
+   *         which travels separately.
+   */
+  struct address
+  {
+    typedef lmpacket::be24_field<1> word;
+    typedef lmpacket::u8_field<9>   low_bit;
+    
+    static_assert(lmpacket::fields_disjoint<word, low_bit>::value, "Overlapping fields");
+    
+    /*! \brief The bytes occupied by the field. */
+    static constexpr uint64_t mask = word::mask | low_bit::mask;
+    
+    /*! \brief Stores a value in the field. */
+    static void     put(packet& p, uint32_t value)
+    {
+      low_bit::put(p, (uint8_t) (value & 1));
+      word::put(p, value >> 1);
+    }
+    
+    /*! \brief Reads the value of the field. */
+    static uint32_t get(const packet& p)
+    {
+      return (word::get(p) << 1) | (low_bit::get(p) & 0x01);
+    }
+  };
+  
+  typedef lmpacket::u8_field<0>         type;
+  typedef lmpacket::u8_field<1>         major_version;
+  typedef lmpacket::u8_field<2>         minor_version;
+  typedef lmpacket::u8_field<1>         slot_num_fixed;
+  typedef lmpacket::u8_field<2>         slot_size_fixed;
+  typedef lmpacket::u8_field<3>         num_slots;
+  typedef lmpacket::u8_field<4>         slot_address_lines;
+  typedef lmpacket::u8_field<5>         data8;
+  typedef lmpacket::u8_field<6>         packet_count;
+  typedef lmpacket::u8_field<7>         byte_count;
+  typedef lmpacket::u8_field<10>        target;
+  typedef lmpacket::bytes_field<32, 32> payload;
+  
+  constexpr uint8_t GETVERSION         = 0x00;
+  constexpr uint8_t READ8_CMD          = 0x01;
+  constexpr uint8_t WRITE8_CMD         = 0x02;
+  constexpr uint8_t READ_REPLY         = 0x03;
+  constexpr uint8_t READ64xN_CMD       = 0x04;
+  constexpr uint8_t FLASHWRITE32_CMD   = 0x05;
+  constexpr uint8_t FLASHWRITE_N_CMD   = 0x06;
+  constexpr uint8_t FLASHWRITE64xN_CMD = 0x07;
+  constexpr uint8_t WRITE64xN_REPLY    = 0x08;
+  constexpr uint8_t SRAMWRITE64xN_CMD  = 0x10;
+  constexpr uint8_t GET_CARTINFO_CMD   = 0x11;
+  constexpr uint8_t SET_CARTSLOT_CMD   = 0x12;
+  constexpr uint8_t RESULT_FAIL        = 0x10;
+  constexpr uint8_t RESULT_SUCCESS     = 0x11;
+}
+
+
+
+/*! \brief Request for the firmware version. */
+struct getversion_command
+{
+  static_assert(lmpacket::fields_disjoint<layout::type>::value, "Overlapping fields");
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::GETVERSION);
+    return p;
+  }
+};
+
+/*! \brief Reply carrying the firmware version. */
+struct getversion_reply
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::major_version, layout::minor_version>::value, "Overlapping fields");
+  
+  uint8_t major_version;
+  uint8_t minor_version;
+  
+  /*! \brief Checks whether a packet holds this kind of reply. */
+  static bool matches(const packet& p) { return layout::type::get(p) == layout::GETVERSION; }
+  
+  static getversion_reply decode(const packet& p)
+  {
+    getversion_reply m;
+    m.major_version = layout::major_version::get(p);
+    m.minor_version = layout::minor_version::get(p);
+    return m;
+  }
+};
+
+/*! \brief Request for the slot layout of the connected cartridge. */
+struct getcartinfo_command
+{
+  static_assert(lmpacket::fields_disjoint<layout::type>::value, "Overlapping fields");
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::GET_CARTINFO_CMD);
+    return p;
+  }
+};
+
+/*! \brief Reply describing the slot layout of the connected cartridge. */
+struct getcartinfo_reply
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::slot_num_fixed, layout::slot_size_fixed, layout::num_slots, layout::slot_address_lines>::value, "Overlapping fields");
+  
+  uint8_t slot_num_fixed;
+  uint8_t slot_size_fixed;
+  uint8_t num_slots;
+  uint8_t slot_address_lines;
+  
+  /*! \brief Checks whether a packet holds this kind of reply. */
+  static bool matches(const packet& p) { return layout::type::get(p) == layout::GET_CARTINFO_CMD; }
+  
+  static getcartinfo_reply decode(const packet& p)
+  {
+    getcartinfo_reply m;
+    m.slot_num_fixed = layout::slot_num_fixed::get(p);
+    m.slot_size_fixed = layout::slot_size_fixed::get(p);
+    m.num_slots = layout::num_slots::get(p);
+    m.slot_address_lines = layout::slot_address_lines::get(p);
+    return m;
+  }
+};
+
+/*! \brief Request to switch the active cartridge slot. */
+struct set_cartslot_command
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::data8>::value, "Overlapping fields");
+  
+  uint8_t slot;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::SET_CARTSLOT_CMD);
+    layout::data8::put(p, slot);
+    return p;
+  }
+  
+  static set_cartslot_command decode(const packet& p)
+  {
+    set_cartslot_command m;
+    m.slot = layout::data8::get(p);
+    return m;
+  }
+};
+
+/*! \brief Request to read a single byte. */
+struct read8_command
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::address, layout::target>::value, "Overlapping fields");
+  
+  uint32_t address;
+  uint8_t  target;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::READ8_CMD);
+    layout::address::put(p, address);
+    layout::target::put(p, target);
+    return p;
+  }
+  
+  static read8_command decode(const packet& p)
+  {
+    read8_command m;
+    m.address = layout::address::get(p);
+    m.target = layout::target::get(p);
+    return m;
+  }
+};
+
+/*! \brief Request to write a single byte. */
+struct write8_command
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::address, layout::data8, layout::target>::value, "Overlapping fields");
+  
+  uint32_t address;
+  uint8_t  data;
+  uint8_t  target;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::WRITE8_CMD);
+    layout::address::put(p, address);
+    layout::data8::put(p, data);
+    layout::target::put(p, target);
+    return p;
+  }
+  
+  static write8_command decode(const packet& p)
+  {
+    write8_command m;
+    m.address = layout::address::get(p);
+    m.data = layout::data8::get(p);
+    m.target = layout::target::get(p);
+    return m;
+  }
+};
+
+/*! \brief Reply to a \ref read8_command. */
+struct read8_reply
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::address, layout::data8>::value, "Overlapping fields");
+  
+  uint32_t address;
+  uint8_t  data;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::READ_REPLY);
+    layout::address::put(p, address);
+    layout::data8::put(p, data);
+    return p;
+  }
+  
+  /*! \brief Checks whether a packet holds this kind of reply. */
+  static bool matches(const packet& p) { return layout::type::get(p) == layout::READ_REPLY; }
+  
+  static read8_reply decode(const packet& p)
+  {
+    read8_reply m;
+    m.address = layout::address::get(p);
+    m.data = layout::data8::get(p);
+    return m;
+  }
+};
+
+/*! \brief Request to read a number of 64-byte packets. */
+struct read64xN_command
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::address, layout::packet_count, layout::target>::value, "Overlapping fields");
+  
+  uint32_t address;
+  uint8_t  num_packets;
+  uint8_t  target;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::READ64xN_CMD);
+    layout::address::put(p, address);
+    layout::packet_count::put(p, num_packets);
+    layout::target::put(p, target);
+    return p;
+  }
+  
+  static read64xN_command decode(const packet& p)
+  {
+    read64xN_command m;
+    m.address = layout::address::get(p);
+    m.num_packets = layout::packet_count::get(p);
+    m.target = layout::target::get(p);
+    return m;
+  }
+};
+
+/*! \brief Request to program up to 32 bytes of flash carried in the packet
+ *         itself.
+ */
+struct flash_write_N_command
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::address, layout::byte_count, layout::payload>::value, "Overlapping fields");
+  
+  uint32_t       address;
+  uint8_t        num_bytes;
+  const uint8_t* data;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::FLASHWRITE_N_CMD);
+    layout::address::put(p, address);
+    layout::byte_count::put(p, num_bytes);
+    layout::payload::put(p, data, num_bytes);
+    return p;
+  }
+  
+  /*! \brief Decodes a packet. `data` points into the packet. */
+  static flash_write_N_command decode(const packet& p)
+  {
+    flash_write_N_command m;
+    m.address = layout::address::get(p);
+    m.num_bytes = layout::byte_count::get(p);
+    m.data = layout::payload::get(p);
+    return m;
+  }
+};
+
+/*! \brief Request to program exactly 32 bytes of flash carried in the packet
+ *         itself.
+ */
+struct flash_write_32_command
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::address, layout::payload>::value, "Overlapping fields");
+  
+  uint32_t       address;
+  const uint8_t* data;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::FLASHWRITE32_CMD);
+    layout::address::put(p, address);
+    layout::payload::put(p, data, layout::payload::size);
+    return p;
+  }
+  
+  /*! \brief Decodes a packet. `data` points into the packet. */
+  static flash_write_32_command decode(const packet& p)
+  {
+    flash_write_32_command m;
+    m.address = layout::address::get(p);
+    m.data = layout::payload::get(p);
+    return m;
+  }
+};
+
+/*! \brief Request to program a number of 64-byte packets of flash sent after
+ *         it.
+ */
+struct flash_write64xN_command
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::address, layout::packet_count>::value, "Overlapping fields");
+  
+  uint32_t address;
+  uint8_t  num_packets;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::FLASHWRITE64xN_CMD);
+    layout::address::put(p, address);
+    layout::packet_count::put(p, num_packets);
+    return p;
+  }
+  
+  static flash_write64xN_command decode(const packet& p)
+  {
+    flash_write64xN_command m;
+    m.address = layout::address::get(p);
+    m.num_packets = layout::packet_count::get(p);
+    return m;
+  }
+};
+
+/*! \brief Request to write a number of 64-byte packets of SRAM sent after it. */
+struct sram_write64xN_command
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::address, layout::packet_count>::value, "Overlapping fields");
+  
+  uint32_t address;
+  uint8_t  num_packets;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::SRAMWRITE64xN_CMD);
+    layout::address::put(p, address);
+    layout::packet_count::put(p, num_packets);
+    return p;
+  }
+  
+  static sram_write64xN_command decode(const packet& p)
+  {
+    sram_write64xN_command m;
+    m.address = layout::address::get(p);
+    m.num_packets = layout::packet_count::get(p);
+    return m;
+  }
+};
+
+/*! \brief Reply to a \ref flash_write64xN_command or
+ *         \ref sram_write64xN_command.
+ */
+struct write64xN_reply
+{
+  static_assert(lmpacket::fields_disjoint<layout::type, layout::packet_count>::value, "Overlapping fields");
+  
+  uint8_t num_packets;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, layout::WRITE64xN_REPLY);
+    layout::packet_count::put(p, num_packets);
+    return p;
+  }
+  
+  /*! \brief Checks whether a packet holds this kind of reply. */
+  static bool matches(const packet& p) { return layout::type::get(p) == layout::WRITE64xN_REPLY; }
+  
+  static write64xN_reply decode(const packet& p)
+  {
+    write64xN_reply m;
+    m.num_packets = layout::packet_count::get(p);
+    return m;
+  }
+};
+
+/*! \brief Reply reporting whether a command succeeded. */
+struct result_reply
+{
+  static_assert(lmpacket::fields_disjoint<layout::type>::value, "Overlapping fields");
+  
+  bool success;
+  
+  packet encode() const
+  {
+    packet p = {};
+    layout::type::put(p, success ? layout::RESULT_SUCCESS : layout::RESULT_FAIL);
+    return p;
+  }
+  
+  /*! \brief Checks whether a packet holds this kind of reply. */
+  static bool matches(const packet& p)
+  {
+    return layout::type::get(p) == layout::RESULT_SUCCESS || layout::type::get(p) == layout::RESULT_FAIL;
+  }
+  
+  static result_reply decode(const packet& p)
+  {
+    result_reply m;
+    m.success = (layout::type::get(p) == layout::RESULT_SUCCESS);
+    return m;
+  }
+};
+
+}
+
+#endif /* defined(__WS_LINKMASTA_PACKETS_H__) */
@@ -0,0 +1,298 @@
+//
+//  backup_store_tester.cpp
+//  FlashMasta
+//
+//  Created by Dan on 2/23/16.
+//  Copyright (c) 2016 7400 Circuits. All rights reserved.
+//
+
+#include "backup_store_tester.h"
+
+#include "test.h"
+#include "common/backup_store.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(OS_WINDOWS)
+#include <direct.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#define BLOCK_SIZE     0x1000
+
+namespace
+{
+
+// Fills an image with a pattern that differs from one block to the next
+vector<unsigned char> make_image(unsigned int num_bytes, unsigned char seed)
+{
+  vector<unsigned char> data(num_bytes);
+  for (unsigned int i = 0; i < num_bytes; ++i)
+  {
+    data[i] = (unsigned char) (seed + i * 7 + i / BLOCK_SIZE * 13);
+  }
+  return data;
+}
+
+vector<unsigned char> read_file(const string& filename)
+{
+  ifstream fin(filename.c_str(), ios::binary);
+  return vector<unsigned char>(istreambuf_iterator<char>(fin), istreambuf_iterator<char>());
+}
+
+void write_file(const string& filename, const vector<unsigned char>& data)
+{
+  ofstream fout(filename.c_str(), ios::binary | ios::trunc);
+  fout.write((const char*) data.data(), data.size());
+}
+
+// Lists the keys of the blocks a manifest is made of, in order
+vector<string> read_manifest_keys(const string& manifest_filename)
+{
+  ifstream fin(manifest_filename.c_str());
+  string line;
+  getline(fin, line);  // Magic and version
+  getline(fin, line);  // Image size
+  
+  vector<string> keys;
+  unsigned int offset;
+  unsigned int num_bytes;
+  string key;
+  while (fin >> hex >> offset >> num_bytes >> key)
+  {
+    keys.push_back(key);
+  }
+  return keys;
+}
+
+string block_path(const backup_store& store, const string& key)
+{
+  return store.directory() + "/blocks/" + key.substr(0, 2) + "/" + key;
+}
+
+void remove_directory(const string& path)
+{
+#if defined(OS_WINDOWS)
+  _rmdir(path.c_str());
+#else
+  rmdir(path.c_str());
+#endif
+}
+
+// Removes a store and the files a test wrote next to it. Only the blocks
+// named are removed, so every key the test stored must be given.
+void remove_store(const backup_store& store, const vector<string>& keys, const vector<string>& files)
+{
+  for (const string& file : files)
+  {
+    std::remove(file.c_str());
+  }
+  for (const string& key : keys)
+  {
+    std::remove(block_path(store, key).c_str());
+  }
+  for (const string& key : keys)
+  {
+    remove_directory(store.directory() + "/blocks/" + key.substr(0, 2));
+  }
+  remove_directory(store.directory() + "/blocks");
+  remove_directory(store.directory());
+}
+
+// Checks that exporting a manifest fails with the given complaint
+bool export_fails(const backup_store& store, const string& manifest_filename, const string& image_filename, const string& complaint, std::ostream& out, std::ostream& err)
+{
+  try
+  {
+    store.export_image(manifest_filename, image_filename);
+  }
+  catch (std::runtime_error& ex)
+  {
+    out << "    Export failed: " << ex.what() << endl;
+    if (string(ex.what()).find(complaint) == string::npos)
+    {
+      err << "  Expected the error to mention \"" << complaint << "\"" << endl;
+      return false;
+    }
+    return true;
+  }
+  
+  err << "  Export succeeded when it should have failed" << endl;
+  return false;
+}
+
+}
+
+backup_store_tester::backup_store_tester(std::istream& in, std::ostream& out, std::ostream& err)
+  : tester("backup_store_tester"), in(in), out(out), err(err)
+{
+  // ROUND TRIP
+  add_test(new test("round trip an image through the store", false, [=](std::ostream& out, std::istream& in, std::ostream& err)->bool
+  {
+    (void) in;
+    backup_store store("backup_store_tester_round_trip.tmp");
+    string manifest = "backup_store_tester_round_trip.stored";
+    string exported = "backup_store_tester_round_trip.bin";
+    
+    // Ends on a partial block
+    vector<unsigned char> image = make_image(BLOCK_SIZE * 5 / 2, 0x11);
+    store.put_image(manifest, image.data(), (unsigned int) image.size(), BLOCK_SIZE);
+    store.export_image(manifest, exported);
+    vector<unsigned char> result = read_file(exported);
+    vector<string> keys = read_manifest_keys(manifest);
+    
+    remove_store(store, keys, { manifest, exported });
+    
+    out << "    Blocks: " << keys.size() << ", exported " << result.size() << " of " << image.size() << " bytes" << endl;
+    if (keys.size() != 3)
+    {
+      err << "  Expected the image to be split into 3 blocks" << endl;
+      return false;
+    }
+    if (result != image)
+    {
+      err << "  Exported image differs from the one stored" << endl;
+      return false;
+    }
+    return true;
+  }));
+  
+  // DEDUPLICATION
+  add_test(new test("store identical blocks only once", false, [=](std::ostream& out, std::istream& in, std::ostream& err)->bool
+  {
+    (void) in;
+    backup_store store("backup_store_tester_dedup.tmp");
+    string manifest1 = "backup_store_tester_dedup1.stored";
+    string manifest2 = "backup_store_tester_dedup2.stored";
+    string exported = "backup_store_tester_dedup.bin";
+    
+    // Blocks 0 and 2 match, as do blocks 1 and 3
+    vector<unsigned char> half = make_image(BLOCK_SIZE * 2, 0x22);
+    vector<unsigned char> image(half);
+    image.insert(image.end(), half.begin(), half.end());
+    
+    store.put_image(manifest1, image.data(), (unsigned int) image.size(), BLOCK_SIZE);
+    store.put_image(manifest2, half.data(), (unsigned int) half.size(), BLOCK_SIZE);
+    string key = store.put_block(image.data(), BLOCK_SIZE);
+    
+    vector<string> keys1 = read_manifest_keys(manifest1);
+    vector<string> keys2 = read_manifest_keys(manifest2);
+    set<string> unique(keys1.begin(), keys1.end());
+    unique.insert(keys2.begin(), keys2.end());
+    
+    store.export_image(manifest1, exported);
+    vector<unsigned char> result = read_file(exported);
+    
+    remove_store(store, vector<string>(unique.begin(), unique.end()), { manifest1, manifest2, exported });
+    
+    out << "    Blocks referenced: " << (keys1.size() + keys2.size() + 1) << ", stored: " << unique.size() << endl;
+    if (keys1.size() != 4 || keys2.size() != 2)
+    {
+      err << "  Expected manifests of 4 and 2 blocks" << endl;
+      return false;
+    }
+    if (unique.size() != 2 || keys1[0] != keys1[2] || keys1[1] != keys1[3]
+        || keys2[0] != keys1[0] || keys2[1] != keys1[1] || key != keys1[0])
+    {
+      err << "  Identical blocks were stored under different keys" << endl;
+      return false;
+    }
+    if (result != image)
+    {
+      err << "  Exported image differs from the one stored" << endl;
+      return false;
+    }
+    return true;
+  }));
+  
+  // MISSING BLOCK
+  add_test(new test("refuse to export an image with a missing block", false, [=](std::ostream& out, std::istream& in, std::ostream& err)->bool
+  {
+    (void) in;
+    backup_store store("backup_store_tester_missing.tmp");
+    string manifest = "backup_store_tester_missing.stored";
+    string exported = "backup_store_tester_missing.bin";
+    
+    vector<unsigned char> image = make_image(BLOCK_SIZE * 2, 0x33);
+    store.put_image(manifest, image.data(), (unsigned int) image.size(), BLOCK_SIZE);
+    vector<string> keys = read_manifest_keys(manifest);
+    
+    bool passed = (keys.size() == 2);
+    if (passed)
+    {
+      std::remove(block_path(store, keys[1]).c_str());
+      passed = (!store.has_block(keys[1])
+                && export_fails(store, manifest, exported, "missing", out, err));
+    }
+    
+    remove_store(store, keys, { manifest, exported });
+    return passed;
+  }));
+  
+  // CORRUPT BLOCK
+  add_test(new test("refuse to export an image with a corrupt block", false, [=](std::ostream& out, std::istream& in, std::ostream& err)->bool
+  {
+    (void) in;
+    backup_store store("backup_store_tester_corrupt.tmp");
+    string manifest = "backup_store_tester_corrupt.stored";
+    string exported = "backup_store_tester_corrupt.bin";
+    
+    vector<unsigned char> image = make_image(BLOCK_SIZE * 2, 0x44);
+    store.put_image(manifest, image.data(), (unsigned int) image.size(), BLOCK_SIZE);
+    vector<string> keys = read_manifest_keys(manifest);
+    
+    bool passed = (keys.size() == 2);
+    if (passed)
+    {
+      // A block cut short
+      string path = block_path(store, keys[0]);
+      vector<unsigned char> block = read_file(path);
+      write_file(path, vector<unsigned char>(block.begin(), block.begin() + BLOCK_SIZE / 2));
+      passed = export_fails(store, manifest, exported, "unexpected size", out, err);
+      
+      // A block of the right size with a byte flipped
+      block[BLOCK_SIZE / 2] ^= 0x01;
+      write_file(path, block);
+      passed = passed && export_fails(store, manifest, exported, "corrupt", out, err);
+    }
+    
+    remove_store(store, keys, { manifest, exported });
+    return passed;
+  }));
+}
+
+backup_store_tester::~backup_store_tester()
+{
+  // Nothing else to do
+}
+
+bool backup_store_tester::prepare()
+{
+  out << "Beginning " << name() << " test preparations" << endl;
+  return true;
+}
+
+void backup_store_tester::pretests()
+{
+  out << "Beginning " << name() << " tests" << endl;
+}
+
+void backup_store_tester::posttests()
+{
+  out << "Concluded " << name() << " tests" << endl;
+}
+
+void backup_store_tester::cleanup()
+{
+  // Nothing to do
+}
@@ -0,0 +1,32 @@
+//
+//  backup_store_tester.h
+//  FlashMasta
+//
+//  Created by Dan on 2/23/16.
+//  Copyright (c) 2016 7400 Circuits. All rights reserved.
+//
+
+#ifndef __BACKUP_STORE_TESTER_H__
+#define __BACKUP_STORE_TESTER_H__
+
+#include "tester.h"
+#include <iosfwd>
+
+class backup_store_tester: public tester
+{
+public:
+  backup_store_tester(std::istream& in, std::ostream& out, std::ostream& err);
+  ~backup_store_tester();
+  
+  bool prepare();
+  void pretests();
+  void posttests();
+  void cleanup();
+
+private:
+  std::istream& in;
+  std::ostream& out;
+  std::ostream& err;
+};
+
+#endif /* defined(__BACKUP_STORE_TESTER_H__) */
@@ -0,0 +1,221 @@
+//
+//  byte_kernels_tester.cpp
+//  FlashMasta
+//
+//  Created by Dan on 2/15/16.
+//  Copyright (c) 2016 7400 Circuits. All rights reserved.
+//
+
+#include "byte_kernels_tester.h"
+
+#include "test.h"
+#include "common/byte_kernels.h"
+
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <random>
+
+using namespace std;
+
+#define FUZZ_ITERATIONS  20000
+#define FUZZ_MAX_SIZE    700
+#define BENCH_SIZE       0x40000
+#define BENCH_ITERATIONS 400
+
+namespace
+{
+
+const kernel_set all_sets[] = { kernel_set::SCALAR, kernel_set::SSE2, kernel_set::AVX2 };
+
+// Straightforward reference implementations to check the kernels against
+unsigned int ref_find_mismatch(const vector<unsigned char>& a, const vector<unsigned char>& b)
+{
+  unsigned int i = 0;
+  while (i < a.size() && a[i] == b[i]) ++i;
+  return i;
+}
+
+unsigned int ref_count_blank(const vector<unsigned char>& data)
+{
+  unsigned int i = 0;
+  while (i < data.size() && data[i] == 0xFF) ++i;
+  return i;
+}
+
+unsigned int ref_count_trailing_blank(const vector<unsigned char>& data)
+{
+  unsigned int i = 0;
+  while (i < data.size() && data[data.size() - 1 - i] == 0xFF) ++i;
+  return i;
+}
+
+uint32_t ref_byte_sum(const vector<unsigned char>& data)
+{
+  uint32_t sum = 0;
+  for (unsigned char c : data) sum += c;
+  return sum;
+}
+
+uint32_t ref_crc32(const vector<unsigned char>& data)
+{
+  uint32_t crc = 0xFFFFFFFF;
+  for (unsigned char c : data)
+  {
+    crc ^= c;
+    for (int k = 0; k < 8; ++k)
+    {
+      crc = (crc & 1) ? (0xEDB88320 ^ (crc >> 1)) : (crc >> 1);
+    }
+  }
+  return crc ^ 0xFFFFFFFF;
+}
+
+// Runs a kernel repeatedly over a buffer and reports its throughput
+void bench(std::ostream& out, const char* name, function<void ()> action)
+{
+  action(); // Warm up
+  
+  auto start = chrono::steady_clock::now();
+  for (int i = 0; i < BENCH_ITERATIONS; ++i)
+  {
+    action();
+  }
+  double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  double mb = (double) BENCH_SIZE * BENCH_ITERATIONS / (1024 * 1024);
+  
+  out << "    " << left << setw(22) << name << right << setw(10) << fixed << setprecision(1) << (mb / seconds) << " MB/s" << endl;
+}
+
+}
+
+byte_kernels_tester::byte_kernels_tester(std::istream& in, std::ostream& out, std::ostream& err)
+  : tester("byte_kernels_tester"), in(in), out(out), err(err)
+{
+  typedef function<bool (std::ostream&, std::istream&, std::ostream&)> action;
+  
+  // REUSABLE ACTIONS
+  action a_fuzz = [=](std::ostream& out, std::istream& in, std::ostream& err)->bool
+  {
+    (void) in;
+    mt19937 rng(7400);
+    unsigned int failures = 0;
+    
+    for (int iter = 0; iter < FUZZ_ITERATIONS && failures < 10; ++iter)
+    {
+      // Mix random data with blank runs broken by a single byte at random spots
+      unsigned int n = rng() % FUZZ_MAX_SIZE;
+      vector<unsigned char> a(n, 0xFF);
+      if (iter % 3 == 0)
+      {
+        for (auto& c : a) c = (unsigned char) rng();
+      }
+      else if (iter % 3 == 1 && n > 0)
+      {
+        a[rng() % n] = (unsigned char) (rng() % 0xFF);
+        a[n - 1 - rng() % n] = (unsigned char) (rng() % 0xFF);
+      }
+      vector<unsigned char> b(a);
+      if (n > 0 && rng() % 4 != 0)
+      {
+        b[rng() % n] ^= (unsigned char) (1 + rng() % 0xFF);
+      }
+      
+      for (kernel_set set : all_sets)
+      {
+        if (!kernel_set_supported(set)) continue;
+        select_kernel_set(set);
+        
+        bool ok = find_mismatch(a.data(), b.data(), n) == ref_find_mismatch(a, b)
+          && is_blank(a.data(), n) == (ref_count_blank(a) == n)
+          && count_blank(a.data(), n) == ref_count_blank(a)
+          && count_trailing_blank(a.data(), n) == ref_count_trailing_blank(a)
+          && byte_sum(a.data(), n) == ref_byte_sum(a)
+          && (crc32_update(0xFFFFFFFF, a.data(), n) ^ 0xFFFFFFFF) == ref_crc32(a);
+        if (!ok)
+        {
+          err << "  Mismatch in " << kernel_set_name(set) << " kernels for " << n << " bytes" << endl;
+          failures++;
+        }
+      }
+    }
+    
+    select_kernel_set(best_kernel_set());
+    out << "  Checked " << FUZZ_ITERATIONS << " buffers" << endl;
+    return failures == 0;
+  };
+  
+  action a_crc_vector = [=](std::ostream& out, std::istream& in, std::ostream& err)->bool
+  {
+    (void) in;
+    (void) err;
+    const char* s = "123456789";
+    uint32_t crc = crc32_update(0xFFFFFFFF, (const unsigned char*) s, 9) ^ 0xFFFFFFFF;
+    out << "  CRC-32 of \"123456789\": " << hex << crc << dec << endl;
+    return crc == 0xCBF43926;
+  };
+  
+  action a_bench = [=](std::ostream& out, std::istream& in, std::ostream& err)->bool
+  {
+    (void) in;
+    (void) err;
+    
+    // Blank buffers make every kernel scan all the way through
+    vector<unsigned char> a(BENCH_SIZE, 0xFF);
+    vector<unsigned char> b(BENCH_SIZE, 0xFF);
+    volatile uint32_t sink = 0;
+    
+    for (kernel_set set : all_sets)
+    {
+      if (!kernel_set_supported(set)) continue;
+      select_kernel_set(set);
+      
+      out << "  " << kernel_set_name(set) << ":" << endl;
+      bench(out, "find_mismatch", [&]() { sink = sink + find_mismatch(a.data(), b.data(), BENCH_SIZE); });
+      bench(out, "is_blank", [&]() { sink = sink + is_blank(a.data(), BENCH_SIZE); });
+      bench(out, "count_blank", [&]() { sink = sink + count_blank(a.data(), BENCH_SIZE); });
+      bench(out, "count_trailing_blank", [&]() { sink = sink + count_trailing_blank(a.data(), BENCH_SIZE); });
+      bench(out, "byte_sum", [&]() { sink = sink + byte_sum(a.data(), BENCH_SIZE); });
+      bench(out, "crc32_update", [&]() { sink = sink + crc32_update(0xFFFFFFFF, a.data(), BENCH_SIZE); });
+    }
+    
+    select_kernel_set(best_kernel_set());
+    return true;
+  };
+  
+  // CORRECTNESS
+  add_test(new test("compute CRC-32 check value", true, a_crc_vector));
+  add_test(new test("match reference results in every kernel set", true, a_fuzz));
+  
+  // PERFORMANCE
+  add_test(new test("benchmark kernels", false, a_bench));
+}
+
+byte_kernels_tester::~byte_kernels_tester()
+{
+  // Nothing else to do
+}
+
+bool byte_kernels_tester::prepare()
+{
+  out << "Beginning " << name() << " test preparations" << endl;
+  out << "Best kernel set: " << kernel_set_name(best_kernel_set()) << endl;
+  return true;
+}
+
+void byte_kernels_tester::pretests()
+{
+  out << "Beginning " << name() << " tests" << endl;
+}
+
+void byte_kernels_tester::posttests()
+{
+  out << "Concluded " << name() << " tests" << endl;
+}
+
+void byte_kernels_tester::cleanup()
+{
+  // Nothing to do
+}
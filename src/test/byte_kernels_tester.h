@@ -0,0 +1,32 @@
+//
+//  byte_kernels_tester.h
+//  FlashMasta
+//
+//  Created by Dan on 2/15/16.
+//  Copyright (c) 2016 7400 Circuits. All rights reserved.
+//
+
+#ifndef __BYTE_KERNELS_TESTER_H__
+#define __BYTE_KERNELS_TESTER_H__
+
+#include "tester.h"
+#include <iosfwd>
+
+class byte_kernels_tester: public tester
+{
+public:
+  byte_kernels_tester(std::istream& in, std::ostream& out, std::ostream& err);
+  ~byte_kernels_tester();
+  
+  bool prepare();
+  void pretests();
+  void posttests();
+  void cleanup();
+
+private:
+  std::istream& in;
+  std::ostream& out;
+  std::ostream& err;
+};
+
+#endif /* defined(__BYTE_KERNELS_TESTER_H__) */
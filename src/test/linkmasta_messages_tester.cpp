@@ -0,0 +1,336 @@
+//
+//  linkmasta_messages_tester.cpp
+//  FlashMasta
+//
+//  Created by Dan on 2/20/16.
+//  Copyright (c) 2016 7400 Circuits. All rights reserved.
+//
+
+#include "linkmasta_messages_tester.h"
+
+#include "test.h"
+#include "linkmasta/ngp_linkmasta_messages.h"
+#include "linkmasta/ngp_linkmasta_packets.h"
+#include "linkmasta/ws_linkmasta_messages.h"
+#include "linkmasta/ws_linkmasta_packets.h"
+
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+#include <random>
+
+using namespace std;
+
+#define FUZZ_ITERATIONS  5000
+#define BENCH_ITERATIONS 2000000
+
+namespace
+{
+
+// Compares a typed encoding with the bytes produced by the message functions
+bool same(const lmpacket::packet& p, const uint8_t* legacy, std::ostream& err, const char* name)
+{
+  if (memcmp(p.data(), legacy, lmpacket::PACKET_SIZE) == 0)
+  {
+    return true;
+  }
+  err << "  Encoding of " << name << " differs from the message functions" << endl;
+  return false;
+}
+
+// Random 24-bit address, the widest either protocol can carry
+uint32_t random_address(mt19937& rng)
+{
+  return rng() & 0xFFFFFF;
+}
+
+bool check_ngp(mt19937& rng, std::ostream& err)
+{
+  using namespace ngpmsg;
+  bool ok = true;
+  uint8_t legacy[lmpacket::PACKET_SIZE];
+  uint8_t data[32];
+  for (auto& c : data) c = (uint8_t) rng();
+  
+  uint32_t address = random_address(rng);
+  uint8_t  value = (uint8_t) rng();
+  uint8_t  chip = (uint8_t) (rng() % 2);
+  uint8_t  n = (uint8_t) (1 + rng() % 255);
+  uint8_t  bypass = (uint8_t) (rng() % 2);
+  uint8_t  num_bytes = (uint8_t) (1 + rng() % 31);
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_getversion_command(legacy);
+  ok &= same(getversion_command{}.encode(), legacy, err, "ngp getversion_command");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_read_command(legacy, address, chip);
+  ok &= same(read_command{address, chip}.encode(), legacy, err, "ngp read_command");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_write_command(legacy, address, value, chip);
+  ok &= same(write_command{address, value, chip}.encode(), legacy, err, "ngp write_command");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_read64xN_command(legacy, address, chip, n);
+  ok &= same(read64xN_command{address, chip, n}.encode(), legacy, err, "ngp read64xN_command");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_flash_write64xN_command(legacy, address, chip, n, bypass);
+  ok &= same(flash_write64xN_command{address, chip, n, bypass}.encode(), legacy, err, "ngp flash_write64xN_command");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_flash_write_32_command(legacy, address, data, chip, bypass);
+  ok &= same(flash_write_32_command{address, chip, bypass, data}.encode(), legacy, err, "ngp flash_write_32_command");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_flash_write_N_command(legacy, address, data, chip, num_bytes, bypass);
+  ok &= same(flash_write_N_command{address, chip, num_bytes, bypass, data}.encode(), legacy, err, "ngp flash_write_N_command");
+  
+  // Replies built by the message functions must decode to the same fields
+  memset(legacy, 0, sizeof(legacy));
+  build_getversion_reply(legacy, value, n);
+  lmpacket::packet p;
+  memcpy(p.data(), legacy, sizeof(legacy));
+  getversion_reply version = getversion_reply::decode(p);
+  ok &= getversion_reply::matches(p) && version.major_version == value && version.minor_version == n;
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_read_reply(legacy, (uint8_t) (address >> 16), (uint8_t) (address >> 8), (uint8_t) address, value, chip);
+  memcpy(p.data(), legacy, sizeof(legacy));
+  read_reply read = read_reply::decode(p);
+  ok &= read_reply::matches(p) && read.address == address && read.data == value && read.chip == chip;
+  ok &= same(read.encode(), legacy, err, "ngp read_reply");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_flash_write64xN_reply(legacy, n);
+  memcpy(p.data(), legacy, sizeof(legacy));
+  ok &= write64xN_reply::matches(p) && write64xN_reply::decode(p).num_packets == n;
+  ok &= same(write64xN_reply{n}.encode(), legacy, err, "ngp write64xN_reply");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_reply_success(legacy);
+  ok &= same(result_reply{true}.encode(), legacy, err, "ngp result_reply");
+  memset(legacy, 0, sizeof(legacy));
+  build_reply_fail(legacy);
+  ok &= same(result_reply{false}.encode(), legacy, err, "ngp result_reply");
+  
+  // And everything decodes back to what was encoded
+  read64xN_command r = read64xN_command::decode(read64xN_command{address, chip, n}.encode());
+  ok &= r.address == address && r.chip == chip && r.num_packets == n;
+  flash_write_N_command w = flash_write_N_command::decode(flash_write_N_command{address, chip, num_bytes, bypass, data}.encode());
+  ok &= w.address == address && w.chip == chip && w.num_bytes == num_bytes && w.bypass_mode == bypass
+    && memcmp(w.data, data, num_bytes) == 0;
+  
+  return ok;
+}
+
+bool check_ws(mt19937& rng, std::ostream& err)
+{
+  using namespace wsmsg;
+  bool ok = true;
+  uint8_t legacy[lmpacket::PACKET_SIZE];
+  uint8_t data[32];
+  for (auto& c : data) c = (uint8_t) rng();
+  
+  uint32_t address = random_address(rng);
+  uint8_t  value = (uint8_t) rng();
+  uint8_t  target = (uint8_t) (rng() % 4);
+  uint8_t  n = (uint8_t) (1 + rng() % 255);
+  uint8_t  num_bytes = (uint8_t) (1 + rng() % 31);
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_getversion_command(legacy);
+  ok &= same(getversion_command{}.encode(), legacy, err, "ws getversion_command");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_getcartinfo_command(legacy);
+  ok &= same(getcartinfo_command{}.encode(), legacy, err, "ws getcartinfo_command");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_set_cartslot_command(legacy, value);
+  ok &= same(set_cartslot_command{value}.encode(), legacy, err, "ws set_cartslot_command");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_read8_command(legacy, address, target);
+  ok &= same(read8_command{address, target}.encode(), legacy, err, "ws read8_command");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_write8_command(legacy, address, value, target);
+  ok &= same(write8_command{address, value, target}.encode(), legacy, err, "ws write8_command");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_read64xN_command(legacy, address, n, target);
+  ok &= same(read64xN_command{address, n, target}.encode(), legacy, err, "ws read64xN_command");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_flash_write64xN_command(legacy, address, n);
+  ok &= same(flash_write64xN_command{address, n}.encode(), legacy, err, "ws flash_write64xN_command");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_sram_write64xN_command(legacy, address, n);
+  ok &= same(sram_write64xN_command{address, n}.encode(), legacy, err, "ws sram_write64xN_command");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_flash_write_32_command(legacy, address, data);
+  ok &= same(flash_write_32_command{address, data}.encode(), legacy, err, "ws flash_write_32_command");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_flash_write_N_command(legacy, address, data, num_bytes);
+  ok &= same(flash_write_N_command{address, num_bytes, data}.encode(), legacy, err, "ws flash_write_N_command");
+  
+  // Replies built by the message functions must decode to the same fields
+  lmpacket::packet p;
+  memset(legacy, 0, sizeof(legacy));
+  build_getversion_reply(legacy, value, n);
+  memcpy(p.data(), legacy, sizeof(legacy));
+  getversion_reply version = getversion_reply::decode(p);
+  ok &= getversion_reply::matches(p) && version.major_version == value && version.minor_version == n;
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_getcartinfo_reply(legacy, value & 1, n & 1, value, n);
+  memcpy(p.data(), legacy, sizeof(legacy));
+  getcartinfo_reply info = getcartinfo_reply::decode(p);
+  ok &= info.slot_num_fixed == (value & 1) && info.slot_size_fixed == (n & 1)
+    && info.num_slots == value && info.slot_address_lines == n;
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_read8_reply(legacy, (uint8_t) (address >> 17), (uint8_t) (address >> 9), (uint8_t) (address >> 1), (uint8_t) (address & 1), value);
+  memcpy(p.data(), legacy, sizeof(legacy));
+  read8_reply read = read8_reply::decode(p);
+  ok &= read8_reply::matches(p) && read.address == address && read.data == value;
+  ok &= same(read.encode(), legacy, err, "ws read8_reply");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_write64xN_reply(legacy, n);
+  memcpy(p.data(), legacy, sizeof(legacy));
+  ok &= write64xN_reply::matches(p) && write64xN_reply::decode(p).num_packets == n;
+  ok &= same(write64xN_reply{n}.encode(), legacy, err, "ws write64xN_reply");
+  
+  memset(legacy, 0, sizeof(legacy));
+  build_reply_success(legacy);
+  ok &= same(result_reply{true}.encode(), legacy, err, "ws result_reply");
+  memset(legacy, 0, sizeof(legacy));
+  build_reply_fail(legacy);
+  ok &= same(result_reply{false}.encode(), legacy, err, "ws result_reply");
+  
+  // And everything decodes back to what was encoded
+  write8_command w = write8_command::decode(write8_command{address, value, target}.encode());
+  ok &= w.address == address && w.data == value && w.target == target;
+  read64xN_command r = read64xN_command::decode(read64xN_command{address, n, target}.encode());
+  ok &= r.address == address && r.num_packets == n && r.target == target;
+  
+  return ok;
+}
+
+// Encodes and decodes a message repeatedly and reports the rate
+void bench(std::ostream& out, const char* name, function<void ()> action)
+{
+  action(); // Warm up
+  
+  auto start = chrono::steady_clock::now();
+  for (int i = 0; i < BENCH_ITERATIONS; ++i)
+  {
+    action();
+  }
+  double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  
+  out << "    " << left << setw(28) << name << right << setw(10) << fixed << setprecision(1) << (BENCH_ITERATIONS / seconds / 1e6) << " M msg/s" << endl;
+}
+
+}
+
+linkmasta_messages_tester::linkmasta_messages_tester(std::istream& in, std::ostream& out, std::ostream& err)
+  : tester("linkmasta_messages_tester"), in(in), out(out), err(err)
+{
+  typedef function<bool (std::ostream&, std::istream&, std::ostream&)> action;
+  
+  // REUSABLE ACTIONS
+  action a_ngp = [=](std::ostream& out, std::istream& in, std::ostream& err)->bool
+  {
+    (void) in;
+    mt19937 rng(7400);
+    unsigned int failures = 0;
+    
+    for (int iter = 0; iter < FUZZ_ITERATIONS && failures < 10; ++iter)
+    {
+      if (!check_ngp(rng, err)) failures++;
+    }
+    
+    out << "  Checked " << FUZZ_ITERATIONS << " sets of messages" << endl;
+    return failures == 0;
+  };
+  
+  action a_ws = [=](std::ostream& out, std::istream& in, std::ostream& err)->bool
+  {
+    (void) in;
+    mt19937 rng(7400);
+    unsigned int failures = 0;
+    
+    for (int iter = 0; iter < FUZZ_ITERATIONS && failures < 10; ++iter)
+    {
+      if (!check_ws(rng, err)) failures++;
+    }
+    
+    out << "  Checked " << FUZZ_ITERATIONS << " sets of messages" << endl;
+    return failures == 0;
+  };
+  
+  action a_bench = [=](std::ostream& out, std::istream& in, std::ostream& err)->bool
+  {
+    (void) in;
+    (void) err;
+    
+    uint8_t buffer[lmpacket::PACKET_SIZE] = {0};
+    volatile uint32_t sink = 0;
+    uint32_t address = 0;
+    
+    out << "  Message functions:" << endl;
+    bench(out, "ngp read64xN command", [&]() { ngpmsg::build_read64xN_command(buffer, address += 64, 0, 8); sink = sink + buffer[3]; });
+    bench(out, "ws read64xN command", [&]() { wsmsg::build_read64xN_command(buffer, address += 64, 8, 0); sink = sink + buffer[3]; });
+    bench(out, "ngp read reply", [&]() { uint32_t a; uint8_t d; ngpmsg::get_read_reply(buffer, &a, &d); sink = sink + a + d; });
+    
+    out << "  Typed layouts:" << endl;
+    bench(out, "ngp read64xN command", [&]() { sink = sink + ngpmsg::read64xN_command{address += 64, 0, 8}.encode()[3]; });
+    bench(out, "ws read64xN command", [&]() { sink = sink + wsmsg::read64xN_command{address += 64, 8, 0}.encode()[3]; });
+    lmpacket::packet p = ngpmsg::read_reply{0x123456, 0x42, 0}.encode();
+    bench(out, "ngp read reply", [&]() { ngpmsg::read_reply r = ngpmsg::read_reply::decode(p); sink = sink + r.address + r.data; });
+    
+    return true;
+  };
+  
+  // CORRECTNESS
+  add_test(new test("match the ngp message functions", true, a_ngp));
+  add_test(new test("match the ws message functions", true, a_ws));
+  
+  // PERFORMANCE
+  add_test(new test("benchmark encode and decode", false, a_bench));
+}
+
+linkmasta_messages_tester::~linkmasta_messages_tester()
+{
+  // Nothing else to do
+}
+
+bool linkmasta_messages_tester::prepare()
+{
+  out << "Beginning " << name() << " test preparations" << endl;
+  return true;
+}
+
+void linkmasta_messages_tester::pretests()
+{
+  out << "Beginning " << name() << " tests" << endl;
+}
+
+void linkmasta_messages_tester::posttests()
+{
+  out << "Concluded " << name() << " tests" << endl;
+}
+
+void linkmasta_messages_tester::cleanup()
+{
+  // Nothing to do
+}
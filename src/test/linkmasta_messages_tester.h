@@ -0,0 +1,32 @@
+//
+//  linkmasta_messages_tester.h
+//  FlashMasta
+//
+//  Created by Dan on 2/20/16.
+//  Copyright (c) 2016 7400 Circuits. All rights reserved.
+//
+
+#ifndef __LINKMASTA_MESSAGES_TESTER_H__
+#define __LINKMASTA_MESSAGES_TESTER_H__
+
+#include "tester.h"
+#include <iosfwd>
+
+class linkmasta_messages_tester: public tester
+{
+public:
+  linkmasta_messages_tester(std::istream& in, std::ostream& out, std::ostream& err);
+  ~linkmasta_messages_tester();
+  
+  bool prepare();
+  void pretests();
+  void posttests();
+  void cleanup();
+
+private:
+  std::istream& in;
+  std::ostream& out;
+  std::ostream& err;
+};
+
+#endif /* defined(__LINKMASTA_MESSAGES_TESTER_H__) */
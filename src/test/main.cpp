@@ -9,6 +9,10 @@ using namespace std;
 #include "libusb_usb_device_tester.h"
 #include "ngp_cartridge_tester.h"
 #include "ws_linkmasta_tester.h"
+#include "byte_kernels_tester.h"
+#include "linkmasta_messages_tester.h"
+#include "ngp_cartridge_retry_tester.h"
+#include "backup_store_tester.h"
 
 
 // Function forward declarations
@@ -28,6 +32,10 @@ int main()
 //  tests.push_back(new libusb_usb_device_tester(in, out, err));
   tests.push_back(new ngp_cartridge_tester(in, out, err));
   tests.push_back(new ws_linkmasta_tester(in, out, err));
+  tests.push_back(new byte_kernels_tester(in, out, err));
+  tests.push_back(new linkmasta_messages_tester(in, out, err));
+  tests.push_back(new ngp_cartridge_retry_tester(in, out, err));
+  tests.push_back(new backup_store_tester(in, out, err));
   
   
   // Run the tests and print summary
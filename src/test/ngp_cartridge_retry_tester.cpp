@@ -0,0 +1,339 @@
+//
+//  ngp_cartridge_retry_tester.cpp
+//  FlashMasta
+//
+//  Created by Dan on 2/23/16.
+//  Copyright (c) 2016 7400 Circuits. All rights reserved.
+//
+
+#include "ngp_cartridge_retry_tester.h"
+
+#include "test.h"
+#include "linkmasta/linkmasta_device.h"
+#include "cartridge/ngp_cartridge.h"
+
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+#define CHIP_SIZE      0x200000
+#define SAVE_BLOCK     0x1FC000
+#define SEGMENT_SIZE   0x100
+
+namespace
+{
+
+// Stands in for a LinkMasta with a single 16 Mib Neo Geo Pocket flash chip
+// attached, talking to it one word at a time. Follows the chip's command
+// sequences closely enough for erasing and programming to behave like the
+// real thing, and can be told to fail the next time a given address is
+// programmed.
+class fake_ngp_linkmasta: public linkmasta_device
+{
+public:
+  fake_ngp_linkmasta()
+    : m_memory(CHIP_SIZE, 0xFF), m_open(false), m_timeout(1000),
+      m_autoselect(false), m_programming(false), m_erase_armed(false),
+      m_fail_address(0), m_fail_pending(false), m_num_erases(0),
+      m_num_closes(0)
+  {
+    // Nothing else to do
+  }
+  
+  void init() {}
+  bool is_open() const { return m_open; }
+  timeout_t timeout() const { return m_timeout; }
+  version_t firmware_version() { return "0.0"; }
+  bool is_integrated_with_cartridge() const { return false; }
+  void set_timeout(timeout_t timeout) { m_timeout = timeout; }
+  void open() { m_open = true; }
+  void close() { if (m_open && !is_session_open()) { m_open = false; m_num_closes++; } }
+  bool test_for_cartridge() { return true; }
+  cartridge* build_cartridge() { return nullptr; }
+  
+  word_t read_word(chip_index chip, address_t address)
+  {
+    // Reads from a missing chip see the last command written instead
+    if (chip != 0)
+    {
+      return 0x90;
+    }
+    
+    if (m_autoselect)
+    {
+      switch (address & 0xFF)
+      {
+      case 0x00: return 0x98;  // Manufacturer id
+      case 0x01: return 0x2F;  // Device id, 16 Mib
+      default:   return 0x00;  // Unprotected, no bypass
+      }
+    }
+    return m_memory[address % CHIP_SIZE];
+  }
+  
+  void write_word(chip_index chip, address_t address, word_t data)
+  {
+    if (chip != 0)
+    {
+      return;
+    }
+    
+    address %= CHIP_SIZE;
+    
+    if (m_programming)
+    {
+      m_programming = false;
+      if (m_fail_pending && address == m_fail_address)
+      {
+        m_fail_pending = false;
+        throw std::runtime_error("Simulated transfer error");
+      }
+      
+      // Programming can only clear bits
+      m_memory[address] &= (unsigned char) data;
+      return;
+    }
+    
+    switch (data)
+    {
+    case 0xF0:
+      m_autoselect = false;
+      m_erase_armed = false;
+      break;
+    
+    case 0x90:
+      m_autoselect = true;
+      break;
+    
+    case 0xA0:
+      m_programming = true;
+      break;
+    
+    case 0x80:
+      m_erase_armed = true;
+      break;
+    
+    case 0x30:
+      if (m_erase_armed)
+      {
+        erase_sector(address);
+      }
+      m_erase_armed = false;
+      break;
+    
+    default:
+      // Unlock cycles and anything else we don't care about
+      break;
+    }
+  }
+  
+  void fail_program_at(address_t address)
+  {
+    m_fail_address = address;
+    m_fail_pending = true;
+  }
+  
+  bool failure_pending() const { return m_fail_pending; }
+  unsigned int num_erases() const { return m_num_erases; }
+  unsigned int num_closes() const { return m_num_closes; }
+  const unsigned char* memory() const { return m_memory.data(); }
+
+private:
+  
+  // Erases the whole sector containing an address, following the chip's
+  // layout of 64 KiB sectors with the last one split into four
+  void erase_sector(address_t address)
+  {
+    address_t base;
+    unsigned int size;
+    if (address < 0x1F0000)      { base = address & ~0xFFFF; size = 0x10000; }
+    else if (address < 0x1F8000) { base = 0x1F0000;          size = 0x8000;  }
+    else if (address < 0x1FA000) { base = 0x1F8000;          size = 0x2000;  }
+    else if (address < 0x1FC000) { base = 0x1FA000;          size = 0x2000;  }
+    else                         { base = 0x1FC000;          size = 0x4000;  }
+    
+    for (unsigned int i = 0; i < size; ++i)
+    {
+      m_memory[base + i] = 0xFF;
+    }
+    m_num_erases++;
+  }
+  
+  vector<unsigned char> m_memory;
+  bool                  m_open;
+  timeout_t             m_timeout;
+  bool                  m_autoselect;
+  bool                  m_programming;
+  bool                  m_erase_armed;
+  address_t             m_fail_address;
+  bool                  m_fail_pending;
+  unsigned int          m_num_erases;
+  unsigned int          m_num_closes;
+};
+
+// Save file layout as read by ngp_cartridge::restore_cartridge_save_data()
+struct NGFheader
+{
+  uint16_t version;
+  uint16_t num_blocks;
+  uint32_t num_bytes;
+};
+
+struct NGFblock
+{
+  uint32_t address;
+  uint32_t num_bytes;
+};
+
+// Fills a segment with a pattern that can't be mistaken for another segment
+vector<unsigned char> make_segment(unsigned char seed)
+{
+  vector<unsigned char> data(SEGMENT_SIZE);
+  for (unsigned int i = 0; i < data.size(); ++i)
+  {
+    data[i] = (unsigned char) (seed + i * 7);
+  }
+  return data;
+}
+
+// Builds a save file holding the given segments at the given chip addresses
+string make_save_file(const vector<pair<uint32_t, vector<unsigned char>>>& segments)
+{
+  NGFheader header;
+  header.version = 0x53;
+  header.num_blocks = (uint16_t) segments.size();
+  header.num_bytes = sizeof(NGFheader);
+  for (auto& segment : segments)
+  {
+    header.num_bytes += sizeof(NGFblock) + (uint32_t) segment.second.size();
+  }
+  
+  ostringstream file;
+  file.write((const char*) &header, sizeof(header));
+  for (auto& segment : segments)
+  {
+    NGFblock block;
+    block.address = segment.first + 0x200000;
+    block.num_bytes = (uint32_t) segment.second.size();
+    file.write((const char*) &block, sizeof(block));
+    file.write((const char*) segment.second.data(), segment.second.size());
+  }
+  return file.str();
+}
+
+// Checks that the chip holds a segment, reporting the first bad byte if not
+bool holds(const fake_ngp_linkmasta& linkmasta, uint32_t address, const vector<unsigned char>& data, std::ostream& err)
+{
+  for (unsigned int i = 0; i < data.size(); ++i)
+  {
+    if (linkmasta.memory()[address + i] != data[i])
+    {
+      err << "  Expected 0x" << hex << (unsigned int) data[i] << " at 0x" << (address + i)
+          << ", found 0x" << (unsigned int) linkmasta.memory()[address + i] << dec << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Restores a save file to a fresh cartridge, failing once at the given address.
+// Holds a session throughout, like the UI does.
+bool restore_with_failure(fake_ngp_linkmasta& linkmasta, const string& file, uint32_t fail_address, std::ostream& out, std::ostream& err)
+{
+  ngp_cartridge cart(&linkmasta);
+  cart.init();
+  
+  linkmasta_session session(&linkmasta);
+  linkmasta.open();
+  linkmasta.fail_program_at(fail_address);
+  unsigned int erases_before = linkmasta.num_erases();
+  unsigned int closes_before = linkmasta.num_closes();
+  
+  istringstream fin(file);
+  cart.restore_cartridge_save_data(fin, 0);
+  
+  out << "    Retries: " << cart.num_retries_performed()
+      << ", erases: " << (linkmasta.num_erases() - erases_before)
+      << ", reconnects: " << (linkmasta.num_closes() - closes_before) << endl;
+  
+  if (linkmasta.failure_pending())
+  {
+    err << "  Simulated failure never happened" << endl;
+    return false;
+  }
+  if (cart.num_retries_performed() != 1)
+  {
+    err << "  Expected exactly 1 retry" << endl;
+    return false;
+  }
+  if (linkmasta.num_closes() - closes_before != 1 || !linkmasta.is_open())
+  {
+    err << "  Expected the connection to be reestablished once" << endl;
+    return false;
+  }
+  return true;
+}
+
+}
+
+ngp_cartridge_retry_tester::ngp_cartridge_retry_tester(std::istream& in, std::ostream& out, std::ostream& err)
+  : tester("ngp_cartridge_retry_tester"), in(in), out(out), err(err)
+{
+  // RETRYING THE ONLY SEGMENT IN A BLOCK
+  add_test(new test("retry a failed segment that erased its own block", false, [=](std::ostream& out, std::istream& in, std::ostream& err)->bool
+  {
+    (void) in;
+    fake_ngp_linkmasta linkmasta;
+    vector<unsigned char> segment = make_segment(0x11);
+    string file = make_save_file({ {SAVE_BLOCK, segment} });
+    
+    if (!restore_with_failure(linkmasta, file, SAVE_BLOCK + 0x80, out, err)) return false;
+    return holds(linkmasta, SAVE_BLOCK, segment, err);
+  }));
+  
+  // RETRYING A LATER SEGMENT IN A SHARED BLOCK
+  add_test(new test("retry a failed segment without losing earlier ones in its block", false, [=](std::ostream& out, std::istream& in, std::ostream& err)->bool
+  {
+    (void) in;
+    fake_ngp_linkmasta linkmasta;
+    vector<unsigned char> first = make_segment(0x22);
+    vector<unsigned char> second = make_segment(0x33);
+    string file = make_save_file({ {SAVE_BLOCK, first}, {SAVE_BLOCK + 0x1000, second} });
+    
+    if (!restore_with_failure(linkmasta, file, SAVE_BLOCK + 0x1000 + 0x80, out, err)) return false;
+    return (holds(linkmasta, SAVE_BLOCK, first, err)
+            && holds(linkmasta, SAVE_BLOCK + 0x1000, second, err));
+  }));
+}
+
+ngp_cartridge_retry_tester::~ngp_cartridge_retry_tester()
+{
+  // Nothing else to do
+}
+
+bool ngp_cartridge_retry_tester::prepare()
+{
+  out << "Beginning " << name() << " test preparations" << endl;
+  return true;
+}
+
+void ngp_cartridge_retry_tester::pretests()
+{
+  out << "Beginning " << name() << " tests" << endl;
+}
+
+void ngp_cartridge_retry_tester::posttests()
+{
+  out << "Concluded " << name() << " tests" << endl;
+}
+
+void ngp_cartridge_retry_tester::cleanup()
+{
+  // Nothing to do
+}
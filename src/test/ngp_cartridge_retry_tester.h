@@ -0,0 +1,32 @@
+//
+//  ngp_cartridge_retry_tester.h
+//  FlashMasta
+//
+//  Created by Dan on 2/23/16.
+//  Copyright (c) 2016 7400 Circuits. All rights reserved.
+//
+
+#ifndef __NGP_CARTRIDGE_RETRY_TESTER_H__
+#define __NGP_CARTRIDGE_RETRY_TESTER_H__
+
+#include "tester.h"
+#include <iosfwd>
+
+class ngp_cartridge_retry_tester: public tester
+{
+public:
+  ngp_cartridge_retry_tester(std::istream& in, std::ostream& out, std::ostream& err);
+  ~ngp_cartridge_retry_tester();
+  
+  bool prepare();
+  void pretests();
+  void posttests();
+  void cleanup();
+
+private:
+  std::istream& in;
+  std::ostream& out;
+  std::ostream& err;
+};
+
+#endif /* defined(__NGP_CARTRIDGE_RETRY_TESTER_H__) */
@@ -52,7 +52,11 @@ CartridgeInfoWidget::~CartridgeInfoWidget()
 
 void CartridgeInfoWidget::buildFromCartridge(cartridge* cart)
 {
-  while (!FlashMastaApp::getInstance()->getDeviceManager()->try_claim_device(m_device_id));
+  if (!FlashMastaApp::getInstance()->getDeviceManager()->claim_device(m_device_id))
+  {
+    // Device was disconnected while we were waiting for it
+    return;
+  }
   
   const cartridge_descriptor* descriptor = cart->descriptor();
   
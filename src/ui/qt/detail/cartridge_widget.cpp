@@ -69,7 +69,11 @@ void CartridgeWidget::refreshUi()
   setSlotsComboBoxVisible(m_cartridge->type() == cartridge_type::CARTRIDGE_FLASHMASTA);
   
   // Generate and display a name for the connected cartridge
-  while (!FlashMastaApp::getInstance()->getDeviceManager()->try_claim_device(m_device_id));
+  if (!FlashMastaApp::getInstance()->getDeviceManager()->claim_device(m_device_id))
+  {
+    // Device was disconnected while we were waiting for it
+    return;
+  }
   linkmasta_device* linkmasta = FlashMastaApp::getInstance()->getDeviceManager()->get_linkmasta_device(m_device_id);
   if (!linkmasta->is_integrated_with_cartridge())
   {
@@ -112,7 +116,6 @@ void CartridgeWidget::refreshUi()
         cartridgeName = (desc != nullptr ? desc->name : "Unrecognized Game");
         break;
       }
-      if (desc != nullptr) delete desc;
       break;
     }
     setCartridgeName(cartridgeName);
@@ -89,7 +89,11 @@ void FmCartridgeSlotWidget::buildFromCartridge(cartridge* cart, int slot)
 
 void FmCartridgeSlotWidget::buildFromNgpCartridge(ngp_cartridge* cart, int slot)
 {
-  while (!FlashMastaApp::getInstance()->getDeviceManager()->try_claim_device(m_device_id));
+  if (!FlashMastaApp::getInstance()->getDeviceManager()->claim_device(m_device_id))
+  {
+    // Device was disconnected while we were waiting for it
+    return;
+  }
   const game_descriptor* descriptor = FlashMastaApp::getInstance()->getNeoGeoGameCatalog()->identify_game(cart, slot);
   FlashMastaApp::getInstance()->getDeviceManager()->release_device(m_device_id);
   
@@ -107,17 +111,15 @@ void FmCartridgeSlotWidget::buildFromNgpCartridge(ngp_cartridge* cart, int slot)
   setSlotDeveloperNameVisible(false);
   setSlotCartNameVisible(true);
   setSlotCartName(QString(game_name.c_str()));
-  
-  // Delete our dynamically allocated descriptor
-  if (descriptor != nullptr)
-  {
-    delete descriptor;
-  }
 }
 
 void FmCartridgeSlotWidget::buildFromWsCartridge(ws_cartridge* cart, int slot)
 {
-  while (!FlashMastaApp::getInstance()->getDeviceManager()->try_claim_device(m_device_id));
+  if (!FlashMastaApp::getInstance()->getDeviceManager()->claim_device(m_device_id))
+  {
+    // Device was disconnected while we were waiting for it
+    return;
+  }
   const game_descriptor* descriptor = FlashMastaApp::getInstance()->getWonderswanGameCatalog()->identify_game(cart, slot);
   FlashMastaApp::getInstance()->getDeviceManager()->release_device(m_device_id);
   
@@ -129,12 +131,6 @@ void FmCartridgeSlotWidget::buildFromWsCartridge(ws_cartridge* cart, int slot)
   setSlotDeveloperNameVisible(true);
   setSlotDeveloperName(QString(descriptor != nullptr ? descriptor->developer_name : "Unknown"));
   setSlotCartNameVisible(false);
-  
-  // Delete our dynamically allocated descriptor
-  if (descriptor != nullptr)
-  {
-    delete descriptor;
-  }  
 }
 
 
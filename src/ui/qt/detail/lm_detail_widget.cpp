@@ -6,19 +6,21 @@
 #include "cartridge_widget.h"
 #include "linkmasta/device_manager.h"
 #include "../worker/lm_cartridge_polling_worker.h"
+#include "../worker/lm_cartridge_prefetch_worker.h"
 
 LmDetailWidget::LmDetailWidget(unsigned int device_id, QWidget *parent) :
   QWidget(parent),
   ui(new Ui::LmDetailWidget), m_device_id(device_id), m_cartridge_widget(nullptr),
-  m_pooling_thread(nullptr)
+  m_pooling_thread(nullptr), m_prefetch_thread(nullptr)
 {
   ui->setupUi(this);
   m_default_widget = ui->contentWidget;
   
   connect(FlashMastaApp::getInstance(), SIGNAL(selectedDeviceChanged(int,int)), this, SLOT(selectedDeviceChanged(int,int)));
   connect(FlashMastaApp::getInstance(), SIGNAL(selectedSlotChanged(int,int)), this, SLOT(selectedSlotChanged(int,int)));
+  connect(FlashMastaApp::getInstance(), SIGNAL(prefetchEnabledChanged(bool)), this, SLOT(prefetchEnabledChanged(bool)));
   
-  while (!FlashMastaApp::getInstance()->getDeviceManager()->try_claim_device(device_id));
+  FlashMastaApp::getInstance()->getDeviceManager()->claim_device(device_id);
   linkmasta_device* linkmasta = FlashMastaApp::getInstance()->getDeviceManager()->get_linkmasta_device(device_id);
   linkmasta->open();
   std::string ver = linkmasta->firmware_version();
@@ -69,6 +71,7 @@ LmDetailWidget::LmDetailWidget(unsigned int device_id, QWidget *parent) :
 LmDetailWidget::~LmDetailWidget()
 {
   stopPolling();
+  stopPrefetching();
   delete ui;
 }
 
@@ -101,6 +104,33 @@ void LmDetailWidget::stopPolling()
   m_pooling_thread = nullptr;
 }
 
+void LmDetailWidget::startPrefetching()
+{
+  if (m_prefetch_thread != nullptr) return;
+  
+  // Spin up a new thread with a worker to read the cartridge into memory while
+  // the device is otherwise idle
+  m_prefetch_thread = new QThread();
+  auto worker = new LmCartridgePrefetchWorker(m_device_id);
+  
+  worker->moveToThread(m_prefetch_thread);
+  connect(worker, SIGNAL(finished()), this, SLOT(prefetchFinished()));
+  connect(m_prefetch_thread, SIGNAL(started()), worker, SLOT(start()));
+  connect(m_prefetch_thread, SIGNAL(finished()), worker, SLOT(stop()));
+  connect(m_prefetch_thread, SIGNAL(finished()), worker, SLOT(deleteLater()));
+  
+  m_prefetch_thread->start(QThread::LowestPriority);
+}
+
+void LmDetailWidget::stopPrefetching()
+{
+  if (m_prefetch_thread == nullptr) return;
+  
+  m_prefetch_thread->quit();
+  m_prefetch_thread->deleteLater();
+  m_prefetch_thread = nullptr;
+}
+
 
 
 void LmDetailWidget::disableActions()
@@ -118,6 +148,10 @@ void LmDetailWidget::disableActions()
 
 void LmDetailWidget::cartridgeRemoved()
 {
+  // Whatever we read ahead belongs to the cartridge that just left
+  stopPrefetching();
+  FlashMastaApp::getInstance()->clearBlockCache(m_device_id);
+  
   m_default_widget->show();
   
   if (m_cartridge_widget != nullptr)
@@ -142,6 +176,12 @@ void LmDetailWidget::cartridgeInserted()
   ui->verticalLayout->addWidget(m_cartridge_widget, 1);
   m_cartridge_widget->show();
   m_default_widget->hide();
+  
+  if (FlashMastaApp::getInstance()->isPrefetchEnabled())
+  {
+    stopPrefetching();
+    startPrefetching();
+  }
 }
 
 void LmDetailWidget::selectedDeviceChanged(int old_device, int new_device)
@@ -163,4 +203,21 @@ void LmDetailWidget::selectedSlotChanged(int old_slot, int new_slot)
   }
 }
 
+void LmDetailWidget::prefetchEnabledChanged(bool enabled)
+{
+  if (enabled && m_cartridge_widget != nullptr)
+  {
+    startPrefetching();
+  }
+  else if (!enabled)
+  {
+    stopPrefetching();
+  }
+}
+
+void LmDetailWidget::prefetchFinished()
+{
+  stopPrefetching();
+}
+
 
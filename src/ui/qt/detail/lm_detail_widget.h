@@ -19,6 +19,8 @@ public:
   
   void startPolling();
   void stopPolling();
+  void startPrefetching();
+  void stopPrefetching();
   
 private:
   void disableActions();
@@ -28,6 +30,8 @@ public slots:
   void cartridgeInserted();
   void selectedDeviceChanged(int old_device, int new_device);
   void selectedSlotChanged(int old_slot, int new_slot);
+  void prefetchEnabledChanged(bool enabled);
+  void prefetchFinished();
   
 private:
   Ui::LmDetailWidget *ui;
@@ -36,6 +40,7 @@ private:
   QWidget* m_default_widget;
   QWidget* m_cartridge_widget;
   QThread* m_pooling_thread;
+  QThread* m_prefetch_thread;
 };
 
 #endif // __NGP_LINKMASTA_DETAIL_WIDGET_H__
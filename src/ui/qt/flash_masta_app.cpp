@@ -1,11 +1,16 @@
 #include "flash_masta_app.h"
 
 #include "common/log.h"
+#include "cartridge/block_cache.h"
+#include "common/backup_store.h"
 #include "linkmasta/libusb_device_manager.h"
 #include "game/ws_game_catalog.h"
 #include "game/ngp_game_catalog.h"
 #include "main_window.h"
 
+#include <QDir>
+#include <QStandardPaths>
+
 FlashMastaApp* FlashMastaApp::instance = nullptr;
 const int FlashMastaApp::NO_DEVICE = -1;
 const int FlashMastaApp::NO_SLOT = -1;
@@ -17,16 +22,22 @@ FlashMastaApp::FlashMastaApp(int argc, char **argv, int flags)
     m_game_backup_enabled(false), m_game_flash_enabled(false),
     m_game_verify_enabled(false), m_save_backup_enabled(false),
     m_save_restore_enabled(false), m_save_verify_enabled(false),
-    m_selected_device(NO_DEVICE), m_selected_slot(NO_SLOT)
+    m_selected_device(NO_DEVICE), m_selected_slot(NO_SLOT),
+    m_prefetch_enabled(false), m_verify_writes_enabled(false),
+    m_save_sync_enabled(false), m_backup_store_enabled(false),
+    m_backup_store(nullptr)
 {
   if (FlashMastaApp::instance == nullptr)
   {
     FlashMastaApp::instance = this;
   }
   
-  m_device_manager = new libusb_device_manager();
-  m_ws_game_catalog = new ws_game_catalog((QCoreApplication::applicationDirPath() + QString("/wsgames.db")).toStdString().c_str());
-  m_ngp_game_catalog = new ngp_game_catalog((QCoreApplication::applicationDirPath() + QString("/ngpgames.db")).toStdString().c_str());
+  // Keep what was learned about each device's transfer speeds between runs
+  QString tuning_location = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/batch_tuning";
+  QDir().mkpath(tuning_location);
+  m_device_manager = new libusb_device_manager(tuning_location.toStdString());
+  m_ws_game_catalog = new ws_game_catalog();
+  m_ngp_game_catalog = new ngp_game_catalog();
   m_main_window = new MainWindow();
   
   qRegisterMetaType<std::string>("std::string");
@@ -41,6 +52,11 @@ FlashMastaApp::~FlashMastaApp()
   delete m_device_manager;
   delete m_ws_game_catalog;
   delete m_ngp_game_catalog;
+  for (auto it = m_block_caches.begin(); it != m_block_caches.end(); ++it)
+  {
+    delete it->second;
+  }
+  delete m_backup_store;
   log_end("done");
 }
 
@@ -74,6 +90,60 @@ int FlashMastaApp::getSelectedSlot() const
   return m_selected_slot;
 }
 
+bool FlashMastaApp::isPrefetchEnabled() const
+{
+  return m_prefetch_enabled;
+}
+
+bool FlashMastaApp::isVerifyWritesEnabled() const
+{
+  return m_verify_writes_enabled;
+}
+
+bool FlashMastaApp::isSaveSyncEnabled() const
+{
+  return m_save_sync_enabled;
+}
+
+bool FlashMastaApp::isBackupStoreEnabled() const
+{
+  return m_backup_store_enabled;
+}
+
+block_cache* FlashMastaApp::getBlockCache(unsigned int device_id)
+{
+  QMutexLocker locker(&m_block_caches_mutex);
+  
+  block_cache*& cache = m_block_caches[device_id];
+  if (cache == nullptr)
+  {
+    cache = new block_cache();
+  }
+  return cache;
+}
+
+backup_store* FlashMastaApp::getBackupStore()
+{
+  if (m_backup_store == nullptr)
+  {
+    QString location = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(location);
+    m_backup_store = new backup_store((location + "/backup_store").toStdString());
+  }
+  return m_backup_store;
+}
+
+void FlashMastaApp::clearBlockCache(unsigned int device_id)
+{
+  QMutexLocker locker(&m_block_caches_mutex);
+  
+  auto it = m_block_caches.find(device_id);
+  if (it != m_block_caches.end())
+  {
+    it->second->clear();
+  }
+}
+
 
 
 // public slots:
@@ -142,6 +212,38 @@ void FlashMastaApp::setSelectedSlot(int slot_id)
   }
 }
 
+void FlashMastaApp::setPrefetchEnabled(bool enabled)
+{
+  if (m_prefetch_enabled == enabled) return;
+  
+  m_prefetch_enabled = enabled;
+  emit prefetchEnabledChanged(enabled);
+}
+
+void FlashMastaApp::setVerifyWritesEnabled(bool enabled)
+{
+  if (m_verify_writes_enabled == enabled) return;
+  
+  m_verify_writes_enabled = enabled;
+  emit verifyWritesEnabledChanged(enabled);
+}
+
+void FlashMastaApp::setSaveSyncEnabled(bool enabled)
+{
+  if (m_save_sync_enabled == enabled) return;
+  
+  m_save_sync_enabled = enabled;
+  emit saveSyncEnabledChanged(enabled);
+}
+
+void FlashMastaApp::setBackupStoreEnabled(bool enabled)
+{
+  if (m_backup_store_enabled == enabled) return;
+  
+  m_backup_store_enabled = enabled;
+  emit backupStoreEnabledChanged(enabled);
+}
+
 
 
 // private slots:
@@ -2,10 +2,14 @@
 #define __FLASH_MASTA_APP_H__
 
 #include <QApplication>
+#include <QMutex>
+#include <map>
 
 class device_manager;
 class MainWindow;
 class game_catalog;
+class block_cache;
+class backup_store;
 
 class FlashMastaApp: public QApplication
 {
@@ -20,6 +24,13 @@ public:
   game_catalog* getNeoGeoGameCatalog() const;
   int getSelectedDevice() const;
   int getSelectedSlot() const;
+  bool isPrefetchEnabled() const;
+  bool isVerifyWritesEnabled() const;
+  bool isSaveSyncEnabled() const;
+  bool isBackupStoreEnabled() const;
+  block_cache* getBlockCache(unsigned int device_id);
+  void clearBlockCache(unsigned int device_id);
+  backup_store* getBackupStore();
   
 public slots:
   void setGameBackupEnabled(bool enabled);
@@ -30,6 +41,10 @@ public slots:
   void setSaveVerifyEnabled(bool enabled);
   void setSelectedDevice(int device_id);
   void setSelectedSlot(int slot_id);
+  void setPrefetchEnabled(bool enabled);
+  void setVerifyWritesEnabled(bool enabled);
+  void setSaveSyncEnabled(bool enabled);
+  void setBackupStoreEnabled(bool enabled);
   
 private slots:
   void mainWindowDestroyed(QObject*);
@@ -43,6 +58,10 @@ signals:
   void saveVerifyEnabledChanged(bool);
   void selectedDeviceChanged(int, int);
   void selectedSlotChanged(int, int);
+  void prefetchEnabledChanged(bool);
+  void verifyWritesEnabledChanged(bool);
+  void saveSyncEnabledChanged(bool);
+  void backupStoreEnabledChanged(bool);
   
 public:
   static FlashMastaApp* getInstance();
@@ -62,6 +81,13 @@ private:
   bool m_save_verify_enabled;
   int m_selected_device;
   int m_selected_slot;
+  bool m_prefetch_enabled;
+  bool m_verify_writes_enabled;
+  bool m_save_sync_enabled;
+  bool m_backup_store_enabled;
+  std::map<unsigned int, block_cache*> m_block_caches;
+  QMutex m_block_caches_mutex;
+  backup_store* m_backup_store;
   
   static FlashMastaApp* instance;
   static const int NO_DEVICE;
@@ -4,9 +4,11 @@
 #include <algorithm>
 #include <iterator>
 #include <set>
+#include <sstream>
 #include <string>
 #include <vector>
 
+#include <QFileDialog>
 #include <QLayout>
 #include <QMessageBox>
 #include <QString>
@@ -23,6 +25,7 @@
 #include "task/ws_cartridge_backup_task.h"
 #include "task/ws_cartridge_backup_save_task.h"
 #include "task/ws_cartridge_flash_task.h"
+#include "task/ws_cartridge_multi_flash_task.h"
 #include "task/ws_cartridge_restore_save_task.h"
 #include "task/ws_cartridge_verify_task.h"
 #include "task/ws_cartridge_verify_save_task.h"
@@ -31,6 +34,9 @@
 #include "cartridge/ngp_cartridge.h"
 #include "cartridge/ws_cartridge.h"
 #include "linkmasta/linkmasta_device.h"
+#include "common/backup_store.h"
+#include "common/block_buffer_pool.h"
+#include "common/log.h"
 
 using namespace std;
 
@@ -48,9 +54,16 @@ using namespace std;
     return;\
   }\
   \
-  while (!FlashMastaApp::getInstance()->getDeviceManager()->try_claim_device(device_index));
+  if (!FlashMastaApp::getInstance()->getDeviceManager()->claim_device(device_index, CLAIM_PRIORITY_HIGH))\
+  {\
+    delete cart;\
+    return;\
+  }\
+  \
+  linkmasta_session session(FlashMastaApp::getInstance()->getDeviceManager()->get_linkmasta_device(device_index));
 
 #define POST_ACTION \
+  logBufferPoolUsage(device_index);\
   FlashMastaApp::getInstance()->getDeviceManager()->release_device(device_index);\
   delete cart;\
   emit cartridgeContentChanged(device_index, slot_index);
@@ -74,10 +87,16 @@ MainWindow::MainWindow(QWidget *parent)
   FlashMastaApp* app = FlashMastaApp::getInstance();
   connect(ui->actionBackupROM, SIGNAL(triggered(bool)), this, SLOT(triggerActionBackupGame()));
   connect(ui->actionRestoreROM, SIGNAL(triggered(bool)), this, SLOT(triggerActionFlashGame()));
+  connect(ui->actionRestoreMultipleROMs, SIGNAL(triggered(bool)), this, SLOT(triggerActionFlashMultipleGames()));
   connect(ui->actionVerifyROM, SIGNAL(triggered(bool)), this, SLOT(triggerActionVerifyGame()));
   connect(ui->actionBackupSave, SIGNAL(triggered(bool)), this, SLOT(triggerActionBackupSave()));
   connect(ui->actionRestoreSave, SIGNAL(triggered(bool)), this, SLOT(triggerActionRestoreSave()));
   connect(ui->actionVerifySave, SIGNAL(triggered(bool)), this, SLOT(triggerActionVerifySave()));
+  connect(ui->actionPrefetch, SIGNAL(toggled(bool)), app, SLOT(setPrefetchEnabled(bool)));
+  connect(ui->actionVerifyWrites, SIGNAL(toggled(bool)), app, SLOT(setVerifyWritesEnabled(bool)));
+  connect(ui->actionSaveSync, SIGNAL(toggled(bool)), app, SLOT(setSaveSyncEnabled(bool)));
+  connect(ui->actionBackupStore, SIGNAL(toggled(bool)), app, SLOT(setBackupStoreEnabled(bool)));
+  connect(ui->actionExportStored, SIGNAL(triggered(bool)), this, SLOT(triggerActionExportStored()));
   connect(app, SIGNAL(gameBackupEnabledChanged(bool)), this, SLOT(setGameBackupEnabled(bool)));
   connect(app, SIGNAL(gameFlashEnabledChanged(bool)), this, SLOT(setGameFlashEnabled(bool)));
   connect(app, SIGNAL(gameVerifyEnabledChanged(bool)), this, SLOT(setGameVerifyEnabled(bool)));
@@ -122,6 +141,7 @@ cartridge* MainWindow::buildCartridgeForDevice(int id)
   case 0x4256:       // NGP (new flashmasta)
   case 0x4178:       // NGP (linkmasta)
     cart = new ngp_cartridge(linkmasta);
+    ((ngp_cartridge*) cart)->set_cache(FlashMastaApp::getInstance()->getBlockCache(id));
     break;
     
   case 0x4252:       // WS
@@ -129,12 +149,32 @@ cartridge* MainWindow::buildCartridgeForDevice(int id)
     break;
   }
   
-  while (!FlashMastaApp::getInstance()->getDeviceManager()->try_claim_device(id));
+  if (!FlashMastaApp::getInstance()->getDeviceManager()->claim_device(id))
+  {
+    delete cart;
+    return nullptr;
+  }
   cart->init();
   FlashMastaApp::getInstance()->getDeviceManager()->release_device(id);
   return cart;
 }
 
+void MainWindow::logBufferPoolUsage(int id)
+{
+  linkmasta_device* linkmasta = FlashMastaApp::getInstance()->getDeviceManager()->get_linkmasta_device(id);
+  if (linkmasta == nullptr)
+  {
+    return;
+  }
+  
+  // Shows how much memory cartridge operations on this device have needed at
+  // once, so the pool can be sized without guessing
+  std::ostringstream message;
+  message << "Buffer pool high-water mark: " << (linkmasta->buffer_pool().high_water_mark() / 1024)
+          << " KiB, " << (linkmasta->buffer_pool().bytes_allocated() / 1024) << " KiB held";
+  log(log_level::INFO, message.str().c_str());
+}
+
 
 
 // public slots:
@@ -147,6 +187,7 @@ void MainWindow::setGameBackupEnabled(bool enabled)
 void MainWindow::setGameFlashEnabled(bool enabled)
 {
   ui->actionRestoreROM->setEnabled(enabled);
+  ui->actionRestoreMultipleROMs->setEnabled(enabled);
 }
 
 void MainWindow::setGameVerifyEnabled(bool enabled)
@@ -231,6 +272,37 @@ void MainWindow::triggerActionFlashGame()
   POST_ACTION
 }
 
+void MainWindow::triggerActionFlashMultipleGames()
+{
+  PRE_ACTION
+  
+  try
+  {
+    switch (cart->system())
+    {
+    case system_type::SYSTEM_WONDERSWAN:
+      WsCartridgeMultiFlashTask(this, cart, slot_index).go();
+      break;
+    
+    default:
+      {
+        QMessageBox msgBox(this);
+        msgBox.setText("Only WonderSwan cartridges can be written several slots at a time.");
+        msgBox.exec();
+      }
+      break;
+    }
+  }
+  catch (std::runtime_error& ex)
+  {
+    QMessageBox msgBox(this);
+    msgBox.setText(ex.what());
+    msgBox.exec();
+  }
+  
+  POST_ACTION
+}
+
 void MainWindow::triggerActionVerifyGame()
 {
   PRE_ACTION
@@ -351,6 +423,41 @@ void MainWindow::triggerActionVerifySave()
   POST_ACTION
 }
 
+void MainWindow::triggerActionExportStored()
+{
+  // Doesn't touch any device, so no need to claim one
+  QString manifest_filename = QFileDialog::getOpenFileName(
+    this, tr("Open File"), QString(),
+    tr("Stored backup (*.stored);;All files (*)"));
+  if (manifest_filename == QString::null)
+  {
+    return;
+  }
+  
+  // Suggest the name the backup was originally given
+  QString filename = manifest_filename;
+  if (filename.endsWith(".stored"))
+  {
+    filename.chop(QString(".stored").length());
+  }
+  filename = QFileDialog::getSaveFileName(this, tr("Save File"), filename, tr("All files (*)"));
+  if (filename == QString::null)
+  {
+    return;
+  }
+  
+  try
+  {
+    FlashMastaApp::getInstance()->getBackupStore()->export_image(manifest_filename.toStdString(), filename.toStdString());
+  }
+  catch (std::runtime_error& ex)
+  {
+    QMessageBox msgBox(this);
+    msgBox.setText(ex.what());
+    msgBox.exec();
+  }
+}
+
 void MainWindow::refreshDeviceList_timeout()
 {
   vector<unsigned int> connected_devices;
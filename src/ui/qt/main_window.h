@@ -21,6 +21,7 @@ public:
   
 private:
   cartridge* buildCartridgeForDevice(int id);
+  void logBufferPoolUsage(int id);
   
 public slots:
   void setGameBackupEnabled(bool enabled);
@@ -31,10 +32,12 @@ public slots:
   void setSaveVerifyEnabled(bool enabled);
   void triggerActionBackupGame();
   void triggerActionFlashGame();
+  void triggerActionFlashMultipleGames();
   void triggerActionVerifyGame();
   void triggerActionBackupSave();
   void triggerActionRestoreSave();
   void triggerActionVerifySave();
+  void triggerActionExportStored();
   void refreshDeviceList_timeout();
   
 private slots:
@@ -1,8 +1,16 @@
 #include "ngp_cartridge_backup_save_task.h"
 #include <QFileDialog>
 #include <QMessageBox>
+#include <cstdio>
 #include <fstream>
+#include <sstream>
 #include "cartridge/cartridge.h"
+#include "cartridge/ngp_cartridge.h"
+#include "cartridge/save_manifest.h"
+#include "common/backup_store.h"
+#include "../flash_masta_app.h"
+
+#define STORE_BLOCK_SIZE 0x2000
 
 NgpCartridgeBackupSaveTask::NgpCartridgeBackupSaveTask(QWidget *parent, cartridge* cart, int slot)
   : NgpCartridgeTask(parent, cart, slot)
@@ -41,8 +49,44 @@ void NgpCartridgeBackupSaveTask::run_task()
     return;
   }
   
+  // With the backup store, gather the save in memory and store it in blocks
+  if (FlashMastaApp::getInstance()->isBackupStoreEnabled())
+  {
+    backup_store*      store = FlashMastaApp::getInstance()->getBackupStore();
+    std::ostringstream buffer;
+    
+    setProgressLabel(QString("Backing up save data to backup store"));
+    m_cartridge->backup_cartridge_save_data(buffer, (m_slot == -1 ? cartridge::SLOT_ALL : m_slot), this);
+    if (!is_task_cancelled())
+    {
+      std::string data = buffer.str();
+      store->put_image(backup_store::manifest_filename_for(filename.toStdString()),
+                       (const unsigned char*) data.data(), (unsigned int) data.size(), STORE_BLOCK_SIZE);
+    }
+    return;
+  }
+  
+  // When syncing, update the file in place if the manifest still describes it.
+  // If anything else wrote to the file since, rewrite it all.
+  bool               sync = FlashMastaApp::getInstance()->isSaveSyncEnabled();
+  std::string        manifest_filename = save_manifest::filename_for(filename.toStdString());
+  save_manifest      manifest;
+  std::ios::openmode mode = std::ios::binary;
+  if (sync)
+  {
+    if (manifest.load(manifest_filename) && manifest.describes_file(filename.toStdString()))
+    {
+      // Opening for input as well keeps the existing contents
+      mode |= std::ios::in;
+    }
+    else
+    {
+      manifest.clear();
+    }
+  }
+  
   // Initialize output file
-  m_fout = new std::ofstream(filename.toStdString().c_str(), std::ios::binary);
+  m_fout = new std::ofstream(filename.toStdString().c_str(), mode);
   if (!m_fout->is_open())
   {
     delete m_fout;
@@ -64,17 +108,37 @@ void NgpCartridgeBackupSaveTask::run_task()
   // Begin task
   try
   {
+    if (sync)
+    {
+      ((ngp_cartridge*) m_cartridge)->set_sync_manifest(&manifest);
+    }
     m_cartridge->backup_cartridge_save_data(*m_fout, (m_slot == -1 ? cartridge::SLOT_ALL : m_slot), this);
+    ((ngp_cartridge*) m_cartridge)->set_sync_manifest(nullptr);
   }
   catch (std::exception& ex)
   {
     (void) ex;
+    ((ngp_cartridge*) m_cartridge)->set_sync_manifest(nullptr);
     m_fout->close();
     delete m_fout;
+    
+    // The file no longer matches the manifest
+    std::remove(manifest_filename.c_str());
     throw;
   }
   
   // Cleanup
   m_fout->close();
   delete m_fout;
+  
+  // Record what was synced, or start over next time if cut short
+  if (sync && !is_task_cancelled())
+  {
+    manifest.record_file(filename.toStdString());
+    manifest.save(manifest_filename);
+  }
+  else
+  {
+    std::remove(manifest_filename.c_str());
+  }
 }
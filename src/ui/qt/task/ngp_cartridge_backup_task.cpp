@@ -1,10 +1,13 @@
 #include "ngp_cartridge_backup_task.h"
 #include <QFileDialog>
 #include <QMessageBox>
-#include <fstream>
 #include "cartridge/cartridge.h"
+#include "cartridge/ngp_cartridge.h"
+#include "common/image_sink.h"
+#include "common/backup_store.h"
 #include "../flash_masta_app.h"
 #include "game/game_catalog.h"
+#include "game/game_descriptor.h"
 
 NgpCartridgeBackupTask::NgpCartridgeBackupTask(QWidget *parent, cartridge* cart, int slot)
   : NgpCartridgeTask(parent, cart, slot)
@@ -36,9 +39,6 @@ void NgpCartridgeBackupTask::run_task()
                                     "Would you like to back up the entire cartridge instead?",
                                     QMessageBox::No|QMessageBox::Yes, QMessageBox::Yes);
       
-      delete curr_game;
-      delete othr_game;
-      
       switch (reply)
       {
       case QMessageBox::Yes:
@@ -65,10 +65,21 @@ void NgpCartridgeBackupTask::run_task()
   }
   
   // Initialize output file
-  m_fout = new std::ofstream(filename.toStdString().c_str(), std::ios::binary);
-  if (!m_fout->is_open())
+  try
   {
-    delete m_fout;
+    if (FlashMastaApp::getInstance()->isBackupStoreEnabled())
+    {
+      m_sink = new stored_image_sink(*FlashMastaApp::getInstance()->getBackupStore(),
+                                     backup_store::manifest_filename_for(filename.toStdString()));
+    }
+    else
+    {
+      m_sink = new mapped_image_sink(filename.toStdString());
+    }
+  }
+  catch (std::exception& ex)
+  {
+    (void) ex;
     QMessageBox msgBox;
     msgBox.setText("Unable to open destination file");
     msgBox.exec();
@@ -85,20 +96,31 @@ void NgpCartridgeBackupTask::run_task()
     setProgressLabel(QString("Backing up slot " + QString::number(m_slot + 1) + QString(" to file")));
   }
   
+  // Tell the cartridge how big the game is so it can skip the padding after
+  // it. The catalog only identifies the game in the first slot, so only trust
+  // it for whole-cartridge backups when there's nothing else on the cartridge.
+  int slot = (m_slot == -1 ? cartridge::SLOT_ALL : m_slot);
+  const game_descriptor* game = FlashMastaApp::getInstance()->getNeoGeoGameCatalog()->identify_game(m_cartridge, m_slot);
+  if (game != nullptr && game->num_bytes != 0 && (m_slot != -1 || m_cartridge->num_slots() == 1))
+  {
+    ((ngp_cartridge*) m_cartridge)->set_game_size_hint(slot, game->num_bytes);
+  }
+  
   // Begin task
   try
   {
-    m_cartridge->backup_cartridge_game_data(*m_fout, (m_slot == -1 ? cartridge::SLOT_ALL : m_slot), this);
+    m_cartridge->backup_cartridge_game_data(*m_sink, slot, this);
+    ((ngp_cartridge*) m_cartridge)->set_game_size_hint(slot, 0);
+    logIdentifiedContent();
   }
   catch (std::exception& ex)
   {
     (void) ex;
-    m_fout->close();
-    delete m_fout;
+    ((ngp_cartridge*) m_cartridge)->set_game_size_hint(slot, 0);
+    delete m_sink;
     throw;
   }
   
   // Cleanup
-  m_fout->close();
-  delete m_fout;
+  delete m_sink;
 }
@@ -2,7 +2,8 @@
 #define __NGP_CARTRIDGE_BACKUP_TASK_H__
 
 #include "ngp_cartridge_task.h"
-#include <iosfwd>
+
+class image_sink;
 
 class NgpCartridgeBackupTask : public NgpCartridgeTask
 {
@@ -14,7 +15,7 @@ protected:
   void run_task();
   
 private:
-  std::ofstream* m_fout;
+  image_sink* m_sink;
 };
 
 #endif // __NGP_CARTRIDGE_BACKUP_TASK_H__
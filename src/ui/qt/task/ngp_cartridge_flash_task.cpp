@@ -1,8 +1,8 @@
 #include "ngp_cartridge_flash_task.h"
 #include <QFileDialog>
 #include <QMessageBox>
-#include <fstream>
 #include "cartridge/cartridge.h"
+#include "common/image_source.h"
 #include "../flash_masta_app.h"
 #include "game/game_catalog.h"
 
@@ -52,9 +52,6 @@ void NgpCartridgeFlashTask::run_task()
                                       ") unplayable. Are you sure you want to continue?",
                                     QMessageBox::Cancel|QMessageBox::Yes, QMessageBox::Yes);
       
-      delete curr_game;
-      delete othr_game;
-      
       switch (reply)
       {
       case QMessageBox::Yes:
@@ -80,10 +77,13 @@ void NgpCartridgeFlashTask::run_task()
   }
   
   // Initialize inputfile
-  m_fin = new std::ifstream(filename.toStdString().c_str(), std::ios::binary);
-  if (!m_fin->is_open())
+  try
   {
-    delete m_fin;
+    m_source = new mapped_image_source(filename.toStdString());
+  }
+  catch (std::exception& ex)
+  {
+    (void) ex;
     QMessageBox msgBox;
     msgBox.setText("Unable to open file");
     msgBox.exec();
@@ -91,18 +91,14 @@ void NgpCartridgeFlashTask::run_task()
   }
   
   // Gather size of file to flash
-  unsigned int file_size;
-  m_fin->seekg(0, m_fin->end);
-  file_size = m_fin->tellg();
-  m_fin->seekg(0, m_fin->beg);
+  unsigned int file_size = m_source->size();
   
   if (file_size > m_cartridge->descriptor()->num_bytes)
   {
     QMessageBox::information((QWidget*) parent(), "File Too Large",
                              "The selected file is too large to fit on this cartridge.",
                              QMessageBox::Ok);
-    m_fin->close();
-    delete m_fin;
+    delete m_source;
     return;
   }
   else if (m_slot != -1 && file_size > m_cartridge->slot_size(m_slot))
@@ -123,8 +119,7 @@ void NgpCartridgeFlashTask::run_task()
     case QMessageBox::Cancel:
     default:
       // User decides to cancel, so we cancel;
-      m_fin->close();
-      delete m_fin;
+      delete m_source;
       return;
     }
   }
@@ -149,8 +144,7 @@ void NgpCartridgeFlashTask::run_task()
     case QMessageBox::Cancel:
     default:
       // User decides to cancel, so we cancel
-      m_fin->close();
-      delete m_fin;
+      delete m_source;
       return;
       break;
     }
@@ -165,16 +159,17 @@ void NgpCartridgeFlashTask::run_task()
     setProgressLabel(QString("Flashing data from file to slot ") + QString::number(m_slot+1));
   }
   
+  m_cartridge->set_verify_writes(FlashMastaApp::getInstance()->isVerifyWritesEnabled());
+  
   // Begin task
   try
   {
-    m_cartridge->restore_cartridge_game_data(*m_fin, (m_slot == -1 ? cartridge::SLOT_ALL : m_slot), this);
+    m_cartridge->restore_cartridge_game_data(*m_source, (m_slot == -1 ? cartridge::SLOT_ALL : m_slot), this);
   }
   catch (std::exception& ex)
   {
     (void) ex;
-    m_fin->close();
-    delete m_fin;
+    delete m_source;
     
     if (is_task_cancelled())
     {
@@ -193,6 +188,5 @@ void NgpCartridgeFlashTask::run_task()
   }
   
   // Cleanup
-  m_fin->close();
-  delete m_fin;
+  delete m_source;
 }
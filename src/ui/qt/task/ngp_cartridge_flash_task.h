@@ -2,7 +2,8 @@
 #define __NGP_CARTRIDGE_FLASH_TASK_H__
 
 #include "ngp_cartridge_task.h"
-#include <iosfwd>
+
+class image_source;
 
 class NgpCartridgeFlashTask: public NgpCartridgeTask
 {
@@ -17,7 +18,7 @@ protected:
   void run_task();
   
 private:
-  std::ifstream* m_fin;
+  image_source* m_source;
 };
 
 #endif // __NGP_CARTRIDGE_FLASH_TASK_H__
@@ -1,8 +1,12 @@
 #include "ngp_cartridge_restore_save_task.h"
 #include <QFileDialog>
 #include <QMessageBox>
+#include <cstdio>
 #include <fstream>
 #include "cartridge/cartridge.h"
+#include "cartridge/ngp_cartridge.h"
+#include "cartridge/save_manifest.h"
+#include "../flash_masta_app.h"
 
 NgpCartridgeRestoreSaveTask::NgpCartridgeRestoreSaveTask(QWidget* parent, cartridge* cart, int slot)
   : NgpCartridgeTask(parent, cart, slot)
@@ -49,17 +53,31 @@ void NgpCartridgeRestoreSaveTask::run_task()
     setProgressLabel(QString("Restoring save data to slot ") + QString::number(m_slot+1));
   }
   
+  // When syncing, only blocks that differ from the file get written
+  bool          sync = FlashMastaApp::getInstance()->isSaveSyncEnabled();
+  std::string   manifest_filename = save_manifest::filename_for(filename.toStdString());
+  save_manifest manifest;
+  
   // Begin task
   try
   {
+    if (sync)
+    {
+      ((ngp_cartridge*) m_cartridge)->set_sync_manifest(&manifest);
+    }
     m_cartridge->restore_cartridge_save_data(*m_fin, (m_slot == -1 ? cartridge::SLOT_ALL : m_slot), this);
+    ((ngp_cartridge*) m_cartridge)->set_sync_manifest(nullptr);
   }
   catch (std::exception& ex)
   {
     (void) ex;
+    ((ngp_cartridge*) m_cartridge)->set_sync_manifest(nullptr);
     m_fin->close();
     delete m_fin;
     
+    // The cartridge no longer matches the manifest
+    std::remove(manifest_filename.c_str());
+    
     if (is_task_cancelled())
     {
       QMessageBox msgBox;
@@ -79,4 +97,15 @@ void NgpCartridgeRestoreSaveTask::run_task()
   // Cleanup
   m_fin->close();
   delete m_fin;
+  
+  // Record what was synced, or start over next time if cut short
+  if (sync && !is_task_cancelled())
+  {
+    manifest.record_file(filename.toStdString());
+    manifest.save(manifest_filename);
+  }
+  else if (sync)
+  {
+    std::remove(manifest_filename.c_str());
+  }
 }
@@ -31,6 +31,8 @@ protected:
   virtual void          run_task() = 0;
   virtual QString       getProgressLabel() const;
   virtual void          setProgressLabel(QString label);
+  virtual void          logIdentifiedContent();
+  virtual void          reportRetries(unsigned int num_retries, bool succeeded);
   
 protected:
   cartridge*            m_cartridge;
@@ -1,8 +1,8 @@
 #include "ngp_cartridge_verify_task.h"
 #include <QFileDialog>
 #include <QMessageBox>
-#include <fstream>
 #include "cartridge/cartridge.h"
+#include "common/image_source.h"
 #include "../flash_masta_app.h"
 #include "game/game_catalog.h"
 
@@ -36,9 +36,6 @@ void NgpCartridgeVerifyTask::run_task()
                                     "Would you like to verify the entire cartridge instead?",
                                     QMessageBox::No|QMessageBox::Yes, QMessageBox::Yes);
       
-      delete curr_game;
-      delete othr_game;
-      
       switch (reply)
       {
       case QMessageBox::Yes:
@@ -65,10 +62,13 @@ void NgpCartridgeVerifyTask::run_task()
   }
   
   // Initialize inputfile
-  m_fin = new std::ifstream(filename.toStdString().c_str(), std::ios::binary);
-  if (!m_fin->is_open())
+  try
   {
-    delete m_fin;
+    m_source = new mapped_image_source(filename.toStdString());
+  }
+  catch (std::exception& ex)
+  {
+    (void) ex;
     QMessageBox msgBox;
     msgBox.setText("Unable to open file");
     msgBox.exec();
@@ -87,8 +87,10 @@ void NgpCartridgeVerifyTask::run_task()
   // Begin task
   try
   {
-    if (m_cartridge->compare_cartridge_game_data(*m_fin, (m_slot == -1 ? cartridge::SLOT_ALL : m_slot), this) && !is_task_cancelled())
+    if (m_cartridge->compare_cartridge_game_data(*m_source, (m_slot == -1 ? cartridge::SLOT_ALL : m_slot), this) && !is_task_cancelled())
     {
+      logIdentifiedContent();
+      
       QMessageBox msgBox;
       msgBox.setText("Cartridge and file match.");
       msgBox.exec();
@@ -103,12 +105,10 @@ void NgpCartridgeVerifyTask::run_task()
   catch (std::exception& ex)
   {
     (void) ex;
-    m_fin->close();
-    delete m_fin;
+    delete m_source;
     throw;
   }
   
   // Cleanup
-  m_fin->close();
-  delete m_fin;
+  delete m_source;
 }
@@ -2,7 +2,12 @@
 #include <QFileDialog>
 #include <QMessageBox>
 #include <fstream>
+#include <sstream>
 #include "cartridge/cartridge.h"
+#include "common/backup_store.h"
+#include "../flash_masta_app.h"
+
+#define STORE_BLOCK_SIZE 0x2000
 
 WsCartridgeBackupSaveTask::WsCartridgeBackupSaveTask(QWidget *parent, cartridge* cart, int slot)
   : WsCartridgeTask(parent, cart, slot)
@@ -27,6 +32,23 @@ void WsCartridgeBackupSaveTask::run_task()
     return;
   }
   
+  // With the backup store, gather the save in memory and store it in blocks
+  if (FlashMastaApp::getInstance()->isBackupStoreEnabled())
+  {
+    backup_store*      store = FlashMastaApp::getInstance()->getBackupStore();
+    std::ostringstream buffer;
+    
+    set_progress_label("Creating game save backup in backup store");
+    m_cartridge->backup_cartridge_save_data(buffer, m_slot, this);
+    if (!is_task_cancelled())
+    {
+      std::string data = buffer.str();
+      store->put_image(backup_store::manifest_filename_for(filename.toStdString()),
+                       (const unsigned char*) data.data(), (unsigned int) data.size(), STORE_BLOCK_SIZE);
+    }
+    return;
+  }
+  
   // Initialize output file
   m_fout = new std::ofstream(filename.toStdString().c_str(), std::ios::binary);
   if (!m_fout->is_open())
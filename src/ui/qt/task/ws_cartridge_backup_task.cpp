@@ -1,8 +1,10 @@
 #include "ws_cartridge_backup_task.h"
 #include <QFileDialog>
 #include <QMessageBox>
-#include <fstream>
 #include "cartridge/cartridge.h"
+#include "common/image_sink.h"
+#include "common/backup_store.h"
+#include "../flash_masta_app.h"
 
 WsCartridgeBackupTask::WsCartridgeBackupTask(QWidget *parent, cartridge* cart, int slot)
   : WsCartridgeTask(parent, cart, slot)
@@ -28,10 +30,21 @@ void WsCartridgeBackupTask::run_task()
   }
   
   // Initialize output file
-  m_fout = new std::ofstream(filename.toStdString().c_str(), std::ios::binary);
-  if (!m_fout->is_open())
+  try
   {
-    delete m_fout;
+    if (FlashMastaApp::getInstance()->isBackupStoreEnabled())
+    {
+      m_sink = new stored_image_sink(*FlashMastaApp::getInstance()->getBackupStore(),
+                                     backup_store::manifest_filename_for(filename.toStdString()));
+    }
+    else
+    {
+      m_sink = new mapped_image_sink(filename.toStdString());
+    }
+  }
+  catch (std::exception& ex)
+  {
+    (void) ex;
     QMessageBox msgBox;
     msgBox.setText("Unable to open destination file");
     msgBox.exec();
@@ -43,17 +56,16 @@ void WsCartridgeBackupTask::run_task()
   // Begin task
   try
   {
-    m_cartridge->backup_cartridge_game_data(*m_fout, m_slot, this);
+    m_cartridge->backup_cartridge_game_data(*m_sink, m_slot, this);
+    log_identified_content();
   }
   catch (std::exception& ex)
   {
     (void) ex;
-    m_fout->close();
-    delete m_fout;
+    delete m_sink;
     throw;
   }
   
   // Cleanup
-  m_fout->close();
-  delete m_fout;
+  delete m_sink;
 }
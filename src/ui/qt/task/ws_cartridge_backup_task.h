@@ -2,7 +2,8 @@
 #define __WS_CARTRIDGE_BACKUP_TASK_H__
 
 #include "ws_cartridge_task.h"
-#include <iosfwd>
+
+class image_sink;
 
 class WsCartridgeBackupTask : public WsCartridgeTask
 {
@@ -14,7 +15,7 @@ protected:
   void run_task();
   
 private:
-  std::ofstream* m_fout;
+  image_sink* m_sink;
 };
 
 #endif // __WS_CARTRIDGE_BACKUP_TASK_H__
@@ -1,8 +1,9 @@
 #include "ws_cartridge_flash_task.h"
 #include <QFileDialog>
 #include <QMessageBox>
-#include <fstream>
 #include "cartridge/cartridge.h"
+#include "common/image_source.h"
+#include "../flash_masta_app.h"
 
 WsCartridgeFlashTask::WsCartridgeFlashTask(QWidget* parent, cartridge* cart, int slot)
   : WsCartridgeTask(parent, cart, slot)
@@ -30,10 +31,13 @@ void WsCartridgeFlashTask::run_task()
   }
   
   // Initialize inputfile
-  m_fin = new std::ifstream(filename.toStdString().c_str(), std::ios::binary);
-  if (!m_fin->is_open())
+  try
+  {
+    m_source = new mapped_image_source(filename.toStdString());
+  }
+  catch (std::exception& ex)
   {
-    delete m_fin;
+    (void) ex;
     QMessageBox msgBox;
     msgBox.setText("Unable to open file");
     msgBox.exec();
@@ -42,16 +46,17 @@ void WsCartridgeFlashTask::run_task()
   
   set_progress_label("Writing data to cartridge");
   
+  m_cartridge->set_verify_writes(FlashMastaApp::getInstance()->isVerifyWritesEnabled());
+  
   // Begin task
   try
   {
-    m_cartridge->restore_cartridge_game_data(*m_fin, m_slot, this);
+    m_cartridge->restore_cartridge_game_data(*m_source, m_slot, this);
   }
   catch (std::exception& ex)
   {
     (void) ex;
-    m_fin->close();
-    delete m_fin;
+    delete m_source;
     
     if (is_task_cancelled())
     {
@@ -70,6 +75,5 @@ void WsCartridgeFlashTask::run_task()
   }
   
   // Cleanup
-  m_fin->close();
-  delete m_fin;
+  delete m_source;
 }
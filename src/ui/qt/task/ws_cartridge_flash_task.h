@@ -2,7 +2,8 @@
 #define __WS_CARTRIDGE_FLASH_TASK_H__
 
 #include "ws_cartridge_task.h"
-#include <iosfwd>
+
+class image_source;
 
 class WsCartridgeFlashTask: public WsCartridgeTask
 {
@@ -14,7 +15,7 @@ protected:
   void run_task();
   
 private:
-  std::ifstream* m_fin;
+  image_source* m_source;
 };
 
 #endif // __WS_CARTRIDGE_FLASH_TASK_H__
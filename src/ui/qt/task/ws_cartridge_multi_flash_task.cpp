@@ -0,0 +1,102 @@
+#include "ws_cartridge_multi_flash_task.h"
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QStringList>
+#include <memory>
+#include <vector>
+#include "cartridge/ws_cartridge.h"
+#include "common/image_source.h"
+#include "../flash_masta_app.h"
+
+WsCartridgeMultiFlashTask::WsCartridgeMultiFlashTask(QWidget* parent, cartridge* cart, int slot)
+  : WsCartridgeTask(parent, cart, slot)
+{
+  // Nothing else to do
+}
+
+WsCartridgeMultiFlashTask::~WsCartridgeMultiFlashTask()
+{
+  // Nothing else to do
+}
+
+
+
+void WsCartridgeMultiFlashTask::run_task()
+{
+  ws_cartridge* cart = dynamic_cast<ws_cartridge*>(m_cartridge);
+  if (cart == nullptr)
+  {
+    return;
+  }
+  
+  // Get source files from user
+  QStringList filenames = QFileDialog::getOpenFileNames(
+    (QWidget*) this->parent(), tr("Open Files"), QString(),
+    tr("WonderSwan Color (*.wsc);;WonderSwan (*.ws);;All Files (*)"));
+  if (filenames.isEmpty())
+  {
+    // Quietly fail
+    return;
+  }
+  
+  // Files go to consecutive slots in name order, starting with the selected
+  // slot
+  filenames.sort();
+  unsigned int first_slot = (m_slot < 0 ? 0 : (unsigned int) m_slot);
+  if (first_slot + (unsigned int) filenames.size() > cart->num_slots())
+  {
+    QMessageBox msgBox;
+    msgBox.setText(QString("Only %1 slots are available from the selected slot on.").arg(cart->num_slots() - first_slot));
+    msgBox.exec();
+    return;
+  }
+  
+  // Initialize input files
+  std::vector<std::unique_ptr<image_source>> sources;
+  std::vector<ws_cartridge::slot_image> images;
+  for (int i = 0; i < filenames.size(); ++i)
+  {
+    try
+    {
+      sources.emplace_back(new mapped_image_source(filenames[i].toStdString()));
+    }
+    catch (std::exception& ex)
+    {
+      (void) ex;
+      QMessageBox msgBox;
+      msgBox.setText("Unable to open file " + filenames[i]);
+      msgBox.exec();
+      return;
+    }
+    images.push_back(ws_cartridge::slot_image{sources.back().get(), (int) (first_slot + i)});
+  }
+  
+  set_progress_label(QString("Writing %1 games to cartridge").arg(filenames.size()));
+  
+  m_cartridge->set_verify_writes(FlashMastaApp::getInstance()->isVerifyWritesEnabled());
+  
+  // Begin task
+  try
+  {
+    cart->restore_cartridge_slots(images, this);
+  }
+  catch (std::exception& ex)
+  {
+    (void) ex;
+    
+    if (is_task_cancelled())
+    {
+      QMessageBox msgBox;
+      msgBox.setText("Operation aborted: cartridge may be in an unplayable state.");
+      msgBox.exec();
+    }
+    throw;
+  }
+  
+  if (is_task_cancelled())
+  {
+    QMessageBox msgBox;
+    msgBox.setText("Operation aborted: cartridge may be in an unplayable state.");
+    msgBox.exec();
+  }
+}
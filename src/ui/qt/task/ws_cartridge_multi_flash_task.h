@@ -0,0 +1,16 @@
+#ifndef __WS_CARTRIDGE_MULTI_FLASH_TASK_H__
+#define __WS_CARTRIDGE_MULTI_FLASH_TASK_H__
+
+#include "ws_cartridge_task.h"
+
+class WsCartridgeMultiFlashTask: public WsCartridgeTask
+{
+public:
+  explicit WsCartridgeMultiFlashTask(QWidget* parent, cartridge* cart, int slot = -1);
+  ~WsCartridgeMultiFlashTask();
+
+protected:
+  void run_task();
+};
+
+#endif // __WS_CARTRIDGE_MULTI_FLASH_TASK_H__
@@ -4,10 +4,14 @@
 #include <QApplication>
 #include <fstream>
 #include <limits>
+#include <sstream>
 #include "cartridge/ws_cartridge.h"
 #include "usb/libusb_usb_device.h"
 #include "linkmasta/ws_linkmasta_device.h"
 #include "libusb-1.0/libusb.h"
+#include "common/log.h"
+#include "game/game_catalog.h"
+#include "../flash_masta_app.h"
 
 using namespace usb;
 
@@ -25,10 +29,15 @@ WsCartridgeTask::~WsCartridgeTask()
 
 void WsCartridgeTask::go()
 {
+  // Retry count is kept for the life of the cartridge, so count from here
+  unsigned int retries_before = ((ws_cartridge*) m_cartridge)->num_retries_performed();
+  bool succeeded = false;
+  
   // Begin task
   try
   {
     this->run_task();
+    succeeded = true;
   }
   catch (std::exception& ex)
   {
@@ -43,6 +52,8 @@ void WsCartridgeTask::go()
     }
   }
   
+  report_retries(((ws_cartridge*) m_cartridge)->num_retries_performed() - retries_before, succeeded);
+  
   // Cleanup
   if (m_progress != nullptr)
   {
@@ -102,3 +113,34 @@ void WsCartridgeTask::set_progress_label(QString label)
 {
   m_progress_label = label;
 }
+
+void WsCartridgeTask::log_identified_content()
+{
+  // Hashes are only available after a complete read
+  const game_descriptor* game = FlashMastaApp::getInstance()->getWonderswanGameCatalog()->identify_content(m_cartridge->content_hashes());
+  if (game != nullptr)
+  {
+    std::ostringstream message;
+    message << "Cartridge content matches known dump of " << game->name;
+    log(log_level::INFO, message.str().c_str());
+  }
+}
+
+void WsCartridgeTask::report_retries(unsigned int num_retries, bool succeeded)
+{
+  std::ostringstream message;
+  message << "Task finished after " << num_retries << " block " << (num_retries == 1 ? "retry" : "retries");
+  log(log_level::INFO, message.str().c_str());
+  
+  // Failures have already been reported, and a cancelled task doesn't care
+  if (num_retries == 0 || !succeeded || m_progress == nullptr || is_task_cancelled())
+  {
+    return;
+  }
+  
+  QMessageBox msgBox((QWidget*) this->parent());
+  msgBox.setText(QString("The operation completed, but ") + QString::number(num_retries)
+                 + (num_retries == 1 ? " block retry was" : " block retries were") + " needed.\n\n"
+                 + "If this keeps happening, try cleaning the cartridge contacts or using a different USB cable.");
+  msgBox.exec();
+}
@@ -31,6 +31,8 @@ protected:
   virtual void          run_task() = 0;
   virtual QString       get_progress_label() const;
   virtual void          set_progress_label(QString label);
+  virtual void          log_identified_content();
+  virtual void          report_retries(unsigned int num_retries, bool succeeded);
   
 protected:
   cartridge*            m_cartridge;
@@ -1,8 +1,8 @@
 #include "ws_cartridge_verify_task.h"
 #include <QFileDialog>
 #include <QMessageBox>
-#include <fstream>
 #include "cartridge/cartridge.h"
+#include "common/image_source.h"
 
 WsCartridgeVerifyTask::WsCartridgeVerifyTask(QWidget *parent, cartridge* cart, int slot)
   : WsCartridgeTask(parent, cart, slot)
@@ -28,10 +28,13 @@ void WsCartridgeVerifyTask::run_task()
   }
   
   // Initialize inputfile
-  m_fin = new std::ifstream(filename.toStdString().c_str(), std::ios::binary);
-  if (!m_fin->is_open())
+  try
   {
-    delete m_fin;
+    m_source = new mapped_image_source(filename.toStdString());
+  }
+  catch (std::exception& ex)
+  {
+    (void) ex;
     QMessageBox msgBox;
     msgBox.setText("Unable to open file");
     msgBox.exec();
@@ -43,8 +46,10 @@ void WsCartridgeVerifyTask::run_task()
   // Begin task
   try
   {
-    if (m_cartridge->compare_cartridge_game_data(*m_fin, m_slot, this) && !is_task_cancelled())
+    if (m_cartridge->compare_cartridge_game_data(*m_source, m_slot, this) && !is_task_cancelled())
     {
+      log_identified_content();
+      
       QMessageBox msgBox;
       msgBox.setText("Cartridge and file match.");
       msgBox.exec();
@@ -59,12 +64,10 @@ void WsCartridgeVerifyTask::run_task()
   catch (std::exception& ex)
   {
     (void) ex;
-    m_fin->close();
-    delete m_fin;
+    delete m_source;
     throw;
   }
   
   // Cleanup
-  m_fin->close();
-  delete m_fin;
+  delete m_source;
 }
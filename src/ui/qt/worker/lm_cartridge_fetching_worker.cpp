@@ -20,7 +20,12 @@ void LmCartridgeFetchingWorker::run()
   bool cancel = false;
   cartridge* cart = nullptr;
   std::string game_name = "";
-  while (!FlashMastaApp::getInstance()->getDeviceManager()->try_claim_device(m_device_id));
+  if (!FlashMastaApp::getInstance()->getDeviceManager()->claim_device(m_device_id))
+  {
+    // Device was disconnected while we were waiting for it
+    emit finished(cart, game_name);
+    return;
+  }
   
   m_mutex.lock();
   if (m_cancelled) cancel = true;
@@ -38,18 +43,21 @@ void LmCartridgeFetchingWorker::run()
   
   if (!cancel)
   {
+    // Share one connection between identifying the cartridge and reading it
+    linkmasta_session session(linkmasta);
+    
     cart = linkmasta->build_cartridge();
     m_mutex.lock();
     if (m_cancelled) cancel = true;
     m_mutex.unlock();
-  }
-  
-  if (!cancel)
-  {
-    game_name = cart->fetch_game_name(0);
-    m_mutex.lock();
-    if (m_cancelled) cancel = true;
-    m_mutex.unlock();
+    
+    if (!cancel)
+    {
+      game_name = cart->fetch_game_name(0);
+      m_mutex.lock();
+      if (m_cancelled) cancel = true;
+      m_mutex.unlock();
+    }
   }
   
   FlashMastaApp::getInstance()->getDeviceManager()->release_device(m_device_id);
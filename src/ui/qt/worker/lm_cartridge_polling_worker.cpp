@@ -5,11 +5,13 @@
 #include "cartridge/ngp_cartridge.h"
 #include "linkmasta/linkmasta_device.h"
 
-const int LmCartridgePollingWorker::INTERVAL = 2000; // 1k milliseconds = 1 second
+const int LmCartridgePollingWorker::MIN_INTERVAL = 250;   // milliseconds, backs off to MAX_INTERVAL
+const int LmCartridgePollingWorker::MAX_INTERVAL = 2000;
 
 LmCartridgePollingWorker::LmCartridgePollingWorker(unsigned int id, QObject *parent) :
   QObject(parent),
-  m_id(id), m_device_connected(false), m_running(false), m_timer(this)
+  m_id(id), m_device_connected(false), m_running(false),
+  m_interval(MIN_INTERVAL), m_timer(this)
 {
   // Nothing else to do
 }
@@ -19,7 +21,8 @@ LmCartridgePollingWorker::LmCartridgePollingWorker(unsigned int id, QObject *par
 void LmCartridgePollingWorker::start()
 {
   // Configure the timer to trigger periodically
-  m_timer.setInterval(INTERVAL);
+  m_interval = MIN_INTERVAL;
+  m_timer.setInterval(m_interval);
   m_timer.setSingleShot(false);
   
   // Connect all our slots
@@ -36,39 +39,60 @@ void LmCartridgePollingWorker::stop()
 
 void LmCartridgePollingWorker::run()
 {
-  if (!FlashMastaApp::getInstance()->getDeviceManager()->try_claim_device(m_id))
+  device_manager* manager = FlashMastaApp::getInstance()->getDeviceManager();
+  
+  // Don't bother probing while someone else is using the device. Whoever has
+  // it will notice soon enough if the cartridge goes away.
+  try
+  {
+    if (manager->is_device_claimed(m_id) || !manager->try_claim_device(m_id))
+    {
+      return;
+    }
+  }
+  catch (std::invalid_argument& ex)
   {
-    // Do nothing
+    (void) ex;
+    // Device was disconnected; nothing to poll
     return;
   }
   
   // This function simply tests if a cartridge was connected or disconnected
-  linkmasta_device* linkmasta = FlashMastaApp::getInstance()->getDeviceManager()->get_linkmasta_device(m_id);
+  linkmasta_device* linkmasta = manager->get_linkmasta_device(m_id);
   bool device_connected;
   
   try
   {
-    device_connected = linkmasta->test_for_cartridge();
+    device_connected = linkmasta->probe_for_cartridge();
   }
   catch (std::runtime_error& ex)
   {
     (void) ex;
     // Do nothing; fail quietly
-    FlashMastaApp::getInstance()->getDeviceManager()->release_device(m_id);
+    manager->release_device(m_id);
     return;
   }
   
   // Must release device when done using it so as to not block other functions
-  FlashMastaApp::getInstance()->getDeviceManager()->release_device(m_id);
+  manager->release_device(m_id);
   
   if (m_device_connected == device_connected)
   {
-    // No change; do nothing
+    // No change; back off a little to keep an idle bus quiet
+    if (m_interval < MAX_INTERVAL)
+    {
+      m_interval = (m_interval * 2 < MAX_INTERVAL ? m_interval * 2 : MAX_INTERVAL);
+      m_timer.setInterval(m_interval);
+    }
     return;
   }
   
   m_device_connected = device_connected;
   
+  // Something changed; poll quickly in case the operator is mid-swap
+  m_interval = MIN_INTERVAL;
+  m_timer.setInterval(m_interval);
+  
   if (m_device_connected)
   {
     emit cartridgeInserted();
@@ -78,5 +102,3 @@ void LmCartridgePollingWorker::run()
     emit cartridgeRemoved();
   }
 }
-
-
@@ -11,7 +11,8 @@ public:
   explicit LmCartridgePollingWorker(unsigned int id, QObject *parent = 0);
   
 private:
-  static const int INTERVAL;
+  static const int MIN_INTERVAL;
+  static const int MAX_INTERVAL;
   
 public slots:
   void start();
@@ -26,6 +27,7 @@ private:
   unsigned int m_id;
   bool m_device_connected;
   bool m_running;
+  int m_interval;
   
   QTimer m_timer;
 };
@@ -0,0 +1,102 @@
+#include "lm_cartridge_prefetch_worker.h"
+
+#include <sstream>
+
+#include "../flash_masta_app.h"
+#include "common/log.h"
+#include "linkmasta/device_manager.h"
+#include "linkmasta/linkmasta_device.h"
+#include "cartridge/ngp_cartridge.h"
+#include "cartridge/block_cache.h"
+
+const int LmCartridgePrefetchWorker::INTERVAL = 10;         // Between blocks while idle
+const int LmCartridgePrefetchWorker::BUSY_INTERVAL = 1000;  // While someone else has the device
+
+LmCartridgePrefetchWorker::LmCartridgePrefetchWorker(unsigned int id, QObject *parent) :
+  QObject(parent),
+  m_id(id), m_cartridge(nullptr), m_timer(this)
+{
+  // Nothing else to do
+}
+
+LmCartridgePrefetchWorker::~LmCartridgePrefetchWorker()
+{
+  delete m_cartridge;
+}
+
+
+
+void LmCartridgePrefetchWorker::start()
+{
+  m_timer.setInterval(INTERVAL);
+  m_timer.setSingleShot(false);
+  
+  connect(&m_timer, SIGNAL(timeout()), this, SLOT(run()));
+  
+  m_timer.start();
+}
+
+void LmCartridgePrefetchWorker::stop()
+{
+  m_timer.stop();
+}
+
+void LmCartridgePrefetchWorker::run()
+{
+  FlashMastaApp* app = FlashMastaApp::getInstance();
+  device_manager* manager = app->getDeviceManager();
+  
+  // Only ever read a single block per claim so that any real operation waiting
+  // on the device gets it as soon as the current block is done. Anyone
+  // waiting in line makes try_claim_device() fail, so we always yield to them.
+  try
+  {
+    if (manager->is_device_claimed(m_id) || !manager->try_claim_device(m_id))
+    {
+      m_timer.setInterval(BUSY_INTERVAL);
+      return;
+    }
+  }
+  catch (std::invalid_argument& ex)
+  {
+    (void) ex;
+    // Device was disconnected; nothing left to do
+    stop();
+    emit finished();
+    return;
+  }
+  
+  bool more = false;
+  try
+  {
+    if (m_cartridge == nullptr)
+    {
+      linkmasta_device* linkmasta = manager->get_linkmasta_device(m_id);
+      if (linkmasta->system() == LINKMASTA_NEO_GEO_POCKET)
+      {
+        m_cartridge = new ngp_cartridge(linkmasta);
+        m_cartridge->set_cache(app->getBlockCache(m_id));
+        m_cartridge->init();
+      }
+    }
+    
+    more = (m_cartridge != nullptr && m_cartridge->prefetch_block());
+  }
+  catch (std::exception& ex)
+  {
+    std::ostringstream message;
+    message << "Stopped reading ahead on device " << m_id << ": " << ex.what();
+    log(log_level::INFO, message.str().c_str());
+    more = false;
+  }
+  
+  manager->release_device(m_id);
+  
+  if (!more)
+  {
+    stop();
+    emit finished();
+    return;
+  }
+  m_timer.setInterval(INTERVAL);
+}
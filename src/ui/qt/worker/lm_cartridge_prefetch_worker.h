@@ -0,0 +1,35 @@
+#ifndef __LM_CARTRIDGE_PREFETCH_WORKER_H__
+#define __LM_CARTRIDGE_PREFETCH_WORKER_H__
+
+#include <QObject>
+#include <QTimer>
+
+class ngp_cartridge;
+
+class LmCartridgePrefetchWorker : public QObject
+{
+  Q_OBJECT
+public:
+  explicit LmCartridgePrefetchWorker(unsigned int id, QObject *parent = 0);
+  ~LmCartridgePrefetchWorker();
+
+private:
+  static const int INTERVAL;
+  static const int BUSY_INTERVAL;
+
+public slots:
+  void start();
+  void stop();
+  void run();
+
+signals:
+  void finished();
+
+private:
+  unsigned int m_id;
+  ngp_cartridge* m_cartridge;
+  
+  QTimer m_timer;
+};
+
+#endif // __LM_CARTRIDGE_PREFETCH_WORKER_H__
@@ -1,6 +1,7 @@
 DROP INDEX IF EXISTS Games_Name_ind;
 DROP INDEX IF EXISTS Games_Meta_ind;
 DROP INDEX IF EXISTS Games_Hash_ind;
+DROP INDEX IF EXISTS Games_Crc32_ind;
 DROP TABLE IF EXISTS Games;
 
 CREATE TABLE Games (
@@ -14,9 +15,13 @@ CREATE TABLE Games (
   CartName TEXT,
   GameName TEXT,
   CartChips INTEGER DEFAULT NULL,
-  CartSize INTEGER DEFAULT NULL
+  CartSize INTEGER DEFAULT NULL,
+  DumpSize INTEGER DEFAULT NULL,
+  Crc32 INTEGER DEFAULT NULL,
+  Sha1 TEXT DEFAULT NULL
 );
 
 CREATE INDEX Games_Hash_ind ON Games (`Hash`);
 CREATE INDEX Games_Meta_ind ON Games (StartupAddress, GameID, GameVersion, MinSystem);
 CREATE INDEX Games_Name_ind ON Games (CartName);
+CREATE INDEX Games_Crc32_ind ON Games (Crc32);
@@ -43,16 +43,73 @@ int main(const int argc, const char** const argv)
     new ngpcart::ngp_cart_row
   };
   
+  // Databases in the same group share a file and are built in order, one
+  // after another. Separate groups are built in parallel.
+  const int build_group[] = {
+    0,
+    1,
+    1
+  };
+  const int num_groups = 2;
+  
   // Build each database using parameters above
+  int codes[num_databases];
+  long num_rows[num_databases];
+  double seconds[num_databases];
+  for (int i = 0; i < num_databases; i++)
+  {
+    codes[i] = 0;
+    num_rows[i] = 0;
+    seconds[i] = 0;
+  }
+  
+  auto build_group_databases = [&](int group)
+  {
+    for (int i = 0; i < num_databases; i++)
+    {
+      if (build_group[i] != group) continue;
+      
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      codes[i] = build_database(db_file_name[i], schema_file_name[i], data_file_name[i], data_row[i], num_rows[i]);
+      seconds[i] = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      
+      // Later databases in the group depend on this one
+      if (codes[i] != 0) break;
+    }
+  };
+  
+  chrono::steady_clock::time_point build_start = chrono::steady_clock::now();
+  vector<thread> threads;
+  for (int g = 1; g < num_groups; g++)
+  {
+    threads.push_back(thread(build_group_databases, g));
+  }
+  build_group_databases(0);
+  for (size_t t = 0; t < threads.size(); t++)
+  {
+    threads[t].join();
+  }
+  double build_seconds = chrono::duration<double>(chrono::steady_clock::now() - build_start).count();
+  
+  // Report results
   int code = 0;
-  for (int i = 0; code == 0 && i < num_databases; i++)
+  long total_rows = 0;
+  for (int i = 0; i < num_databases; i++)
   {
-    code = build_database(db_file_name[i], schema_file_name[i], data_file_name[i], data_row[i]);
-    if (code != 0)
+    if (codes[i] != 0)
     {
-      cerr << "Failed to build database " << db_file_name[i] << endl;
+      cerr << "Failed to build database " << db_file_name[i] << " from " << data_file_name[i] << endl;
+      if (code == 0) code = codes[i];
+      continue;
     }
+    
+    total_rows += num_rows[i];
+    cout << db_file_name[i] << " <- " << data_file_name[i] << ": "
+         << num_rows[i] << " rows in " << fixed << setprecision(3) << seconds[i] << " s ("
+         << setprecision(0) << (seconds[i] > 0 ? num_rows[i] / seconds[i] : 0) << " rows/sec)" << endl;
   }
+  cout << "Total: " << total_rows << " rows in " << fixed << setprecision(3) << build_seconds << " s ("
+       << setprecision(0) << (build_seconds > 0 ? total_rows / build_seconds : 0) << " rows/sec)" << endl;
   
   // Clean up dynamically allocated objects
   for (int i = 0; i < num_databases; i++)
@@ -60,12 +117,54 @@ int main(const int argc, const char** const argv)
     delete data_row[i];
   }
   
+  
+  
+  /////////////////////////////////////////////
+  // Compile finished databases into tables  //
+  /////////////////////////////////////////////
+  
+  // Number of tables to generate
+  const int num_tables = 2;
+  
+  // SQLite database file to read from
+  const string table_db_file_name[] = {
+    ws::db_file_name,
+    ngp::db_file_name
+  };
+  
+  // Generated C++ source file
+  const string table_file_name[] = {
+    ws::table_file_name,
+    ngp::table_file_name
+  };
+  
+  // Name of the generated array
+  const string table_name[] = {
+    ws::table_name,
+    ngp::table_name
+  };
+  
+  // Query selecting hash, name, developer, and size, sorted by hash
+  const string table_query[] = {
+    ws::table_query,
+    ngp::table_query
+  };
+  
+  for (int i = 0; code == 0 && i < num_tables; i++)
+  {
+    code = generate_game_table(table_db_file_name[i], table_file_name[i], table_name[i], table_query[i]);
+    if (code != 0)
+    {
+      cerr << "Failed to generate table " << table_file_name[i] << endl;
+    }
+  }
+  
   return code;
 }
 
 
 
-int build_database(const string& db_file_name, const string& schema_file_name, const string& data_file_name, games_row* const data_row)
+int build_database(const string& db_file_name, const string& schema_file_name, const string& data_file_name, games_row* const data_row, long& num_rows)
 {
   // Declare some variables we're going to be using a lot of
   sqlite3* db;
@@ -100,11 +199,22 @@ int build_database(const string& db_file_name, const string& schema_file_name, c
   file<> games_file(data_file_name.c_str());
   games_xml.parse<0>(games_file.data());
   
-  // Add games to database
-  if (!add_games_to_db(db, &games_xml, data_row))
+  // Add games to database in a single transaction rather than one per row
+  if (!execute_query(db, "BEGIN TRANSACTION"))
+  {
+    sqlite3_close(db);
+    return 1;
+  }
+  if (!add_games_to_db(db, &games_xml, data_row, num_rows))
   {
     cerr << "An error occured while adding games to database" << endl;
   }
+  if (!execute_query(db, "COMMIT TRANSACTION"))
+  {
+    execute_query(db, "ROLLBACK TRANSACTION");
+    sqlite3_close(db);
+    return 1;
+  }
   
   // Close database connection
   sqlite3_close(db);
@@ -144,9 +254,22 @@ bool execute_file(ifstream& fin, sqlite3* db)
   return success;
 }
 
-bool add_games_to_db(sqlite3* db, const doc_t* games_xml, games_row* row)
+bool execute_query(sqlite3* db, const char* query)
+{
+  char* message = nullptr;
+  if (sqlite3_exec(db, query, nullptr, nullptr, &message) != SQLITE_OK)
+  {
+    cerr << sqlite3_errcode(db) << ": " << (message != nullptr ? message : sqlite3_errmsg(db)) << endl;
+    sqlite3_free(message);
+    return false;
+  }
+  return true;
+}
+
+bool add_games_to_db(sqlite3* db, const doc_t* games_xml, games_row* row, long& num_rows)
 {
   bool success = true;
+  statement_cache_t cache;
   
   // Parse each ROMINFO node and add to table
   node_t* rominfo_node = games_xml->first_node()->first_node();
@@ -164,27 +287,27 @@ bool add_games_to_db(sqlite3* db, const doc_t* games_xml, games_row* row)
     string query;
     if (success) query = row->insert_query();
     
+    // Fetch statements for this query, preparing them only the first time the
+    // query is seen
+    const vector<sqlite3_stmt*>* statements = nullptr;
+    if (success)
+    {
+      statements = prepare_cached(db, query, cache);
+      if (statements == nullptr)
+      {
+        success = false;
+      }
+    }
+    
     // Execute all statements in query string
-    const char* c = &(query.c_str()[0]);
     for (int q = 0;
-         success && c != &(query.c_str()[query.size()]);
+         success && q < (int) statements->size();
          q++)
     {
-      // Construct statement that uses bound parameters
-      sqlite3_stmt* stmt = nullptr;
-      if (success)
-      {
-        sqlite3_prepare_v2(db, c, -1, &stmt, &c);
-
-        // Check for statement errors
-        int errcode = sqlite3_errcode(db);
-        if (errcode != SQLITE_OK && errcode != SQLITE_ROW && errcode != SQLITE_DONE)
-        {
-          cerr << sqlite3_errcode(db) << ": " << sqlite3_errmsg(db) << endl;
-          success = false;
-        }
-      }
-
+      sqlite3_stmt* stmt = (*statements)[q];
+      sqlite3_reset(stmt);
+      sqlite3_clear_bindings(stmt);
+      
       // Bind parameters to statement
       if (success) if (!row->bind_to_stmt(stmt, q))
       {
@@ -192,25 +315,177 @@ bool add_games_to_db(sqlite3* db, const doc_t* games_xml, games_row* row)
         cerr << "An error occured while binding parameters to statement" << endl;
         success = false;
       }
-
+      
       // Insert into database
-      if (success) sqlite3_step(stmt);
-
-      // Check for query errors
-      int errcode = sqlite3_errcode(db);
-      if (success) if (errcode != SQLITE_OK && errcode != SQLITE_ROW && errcode != SQLITE_DONE)
+      if (success)
       {
-        cerr << sqlite3_errcode(db) << ": " << sqlite3_errmsg(db) << endl;
-        success = false;
+        int errcode = sqlite3_step(stmt);
+        if (errcode != SQLITE_OK && errcode != SQLITE_ROW && errcode != SQLITE_DONE)
+        {
+          cerr << sqlite3_errcode(db) << ": " << sqlite3_errmsg(db) << endl;
+          success = false;
+        }
       }
-
-      // Clean up prepared statement
-      sqlite3_finalize(stmt);
     }
+    if (success) num_rows++;
     
     // Move to next node
     if (success) rominfo_node = rominfo_node->next_sibling();
   }
   
+  finalize_cached(cache);
   return success;
 }
+
+const vector<sqlite3_stmt*>* prepare_cached(sqlite3* db, const string& query, statement_cache_t& cache)
+{
+  statement_cache_t::iterator it = cache.find(query);
+  if (it != cache.end())
+  {
+    return &it->second;
+  }
+  
+  // Prepare every statement in the query string once
+  vector<sqlite3_stmt*> statements;
+  const char* c = &(query.c_str()[0]);
+  while (c != &(query.c_str()[query.size()]))
+  {
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, c, -1, &stmt, &c) != SQLITE_OK)
+    {
+      cerr << sqlite3_errcode(db) << ": " << sqlite3_errmsg(db) << endl;
+      for (size_t i = 0; i < statements.size(); i++)
+      {
+        sqlite3_finalize(statements[i]);
+      }
+      return nullptr;
+    }
+    
+    // Trailing whitespace and comments produce no statement
+    if (stmt != nullptr)
+    {
+      statements.push_back(stmt);
+    }
+  }
+  
+  return &(cache[query] = statements);
+}
+
+void finalize_cached(statement_cache_t& cache)
+{
+  for (statement_cache_t::iterator it = cache.begin(); it != cache.end(); ++it)
+  {
+    for (size_t i = 0; i < it->second.size(); i++)
+    {
+      sqlite3_finalize(it->second[i]);
+    }
+  }
+  cache.clear();
+}
+
+int generate_game_table(const string& db_file_name, const string& table_file_name, const string& table_name, const string& query)
+{
+  sqlite3* db;
+  
+  // Open connection to the finished database
+  if (sqlite3_open_v2(db_file_name.c_str(), &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK)
+  {
+    cerr << sqlite3_errmsg(db) << endl;
+    sqlite3_close(db);
+    return 1;
+  }
+  
+  sqlite3_stmt* stmt = nullptr;
+  if (sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+  {
+    cerr << sqlite3_errcode(db) << ": " << sqlite3_errmsg(db) << endl;
+    sqlite3_close(db);
+    return 1;
+  }
+  
+  ofstream fout(table_file_name.c_str());
+  if (!fout)
+  {
+    cerr << "Unable to open table file '" << table_file_name << "'" << endl;
+    sqlite3_finalize(stmt);
+    sqlite3_close(db);
+    return 1;
+  }
+  
+  fout << "// Generated by tools/build-database from " << db_file_name << ". Do not edit." << endl;
+  fout << endl;
+  fout << "#include \"game_table.h\"" << endl;
+  fout << endl;
+  fout << "const game_table_entry " << table_name << "[] = {" << endl;
+  
+  int e;
+  while ((e = sqlite3_step(stmt)) == SQLITE_ROW)
+  {
+    unsigned long long hash = (unsigned long long) sqlite3_column_int64(stmt, 0);
+    const char* game_name = (const char*) sqlite3_column_text(stmt, 1);
+    const char* developer_name = (const char*) sqlite3_column_text(stmt, 2);
+    unsigned int num_bytes = (unsigned int) sqlite3_column_int64(stmt, 3);
+    
+    // Content hashes are only usable if we know how many bytes they cover
+    unsigned int dump_size = 0;
+    unsigned int crc32 = 0;
+    const char* sha1 = nullptr;
+    if (sqlite3_column_type(stmt, 4) != SQLITE_NULL && sqlite3_column_type(stmt, 5) != SQLITE_NULL)
+    {
+      dump_size = (unsigned int) sqlite3_column_int64(stmt, 4);
+      crc32 = (unsigned int) sqlite3_column_int64(stmt, 5);
+      sha1 = (const char*) sqlite3_column_text(stmt, 6);
+    }
+    
+    fout << "  { (long long) 0x" << hex << setw(16) << setfill('0') << hash << "ULL, "
+         << dec << setfill(' ')
+         << "\"" << escape_c_string(game_name != nullptr ? game_name : "") << "\", "
+         << "\"" << escape_c_string(developer_name != nullptr ? developer_name : "") << "\", "
+         << num_bytes << "u, "
+         << dump_size << "u, "
+         << "0x" << hex << setw(8) << setfill('0') << crc32 << "u, "
+         << dec << setfill(' ')
+         << "\"" << (sha1 != nullptr ? sha1 : "") << "\" }," << endl;
+  }
+  
+  fout << "};" << endl;
+  fout << endl;
+  fout << "const unsigned int " << table_name << "_size = sizeof(" << table_name << ") / sizeof(" << table_name << "[0]);" << endl;
+  
+  sqlite3_finalize(stmt);
+  sqlite3_close(db);
+  
+  if (e != SQLITE_DONE)
+  {
+    cerr << "An error occured while reading database " << db_file_name << endl;
+    return 1;
+  }
+  return fout.good() ? 0 : 1;
+}
+
+string escape_c_string(const string& str)
+{
+  stringstream escaped;
+  
+  for (string::const_iterator it = str.begin(); it != str.end(); ++it)
+  {
+    unsigned char c = (unsigned char) *it;
+    
+    if (c == '\\' || c == '"')
+    {
+      escaped << '\\' << c;
+    }
+    else if (c < 0x20 || c >= 0x7F || (c == '?' && it + 1 != str.end() && *(it + 1) == '?'))
+    {
+      // Octal escapes never swallow the characters that follow, unlike \x.
+      // Repeated question marks are escaped so they can't form trigraphs.
+      escaped << '\\' << oct << setw(3) << setfill('0') << (int) c << dec << setfill(' ');
+    }
+    else
+    {
+      escaped << c;
+    }
+  }
+  
+  return escaped.str();
+}
@@ -1,6 +1,8 @@
 #ifndef __BUILD_DATABASE_H__
 #define __BUILD_DATABASE_H__
 
+#include <algorithm>
+#include <cctype>
 #include <iostream>
 #include <iomanip>
 #include <fstream>
@@ -8,6 +10,9 @@
 #include <string>
 #include <cstdlib>
 #include <sstream>
+#include <map>
+#include <chrono>
+#include <thread>
 
 #include "sqlite/sqlite3.h"
 #include "rapidxml/rapidxml.hpp"
@@ -21,8 +26,15 @@ typedef xml_document<> doc_t;
 
 #include "games-row.h"
 
-int build_database(const string& db_file_name, const string& schema_file_name, const string& data_file_name, games_row* const data_row);
+typedef map<string, vector<sqlite3_stmt*>> statement_cache_t;
+
+int build_database(const string& db_file_name, const string& schema_file_name, const string& data_file_name, games_row* const data_row, long& num_rows);
 bool execute_file(ifstream& fin, sqlite3* db);
-bool add_games_to_db(sqlite3* db, const doc_t* games_xml, games_row* row);
+bool execute_query(sqlite3* db, const char* query);
+bool add_games_to_db(sqlite3* db, const doc_t* games_xml, games_row* row, long& num_rows);
+const vector<sqlite3_stmt*>* prepare_cached(sqlite3* db, const string& query, statement_cache_t& cache);
+void finalize_cached(statement_cache_t& cache);
+int generate_game_table(const string& db_file_name, const string& table_file_name, const string& table_name, const string& query);
+string escape_c_string(const string& str);
 
 #endif
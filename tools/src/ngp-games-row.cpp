@@ -13,7 +13,10 @@ string ngp_games_row::insert_query() const
     "MinSystem,"
     "License,"
     "CartName,"
-    "GameName"
+    "GameName,"
+    "DumpSize,"
+    "Crc32,"
+    "Sha1"
     ") VALUES ("
     ":hash,"
     ":gameid,"
@@ -22,7 +25,10 @@ string ngp_games_row::insert_query() const
     ":minsystem,"
     ":license,"
     ":cartname,"
-    ":gamename"
+    ":gamename,"
+    ":dumpsize,"
+    ":crc32,"
+    ":sha1"
     ")");
 }
 
@@ -46,6 +52,35 @@ bool ngp_games_row::parse_xml(const node_t* node, sqlite3* db)
     else GameName = string(n_->value());
   }
   
+  // Dump size and content hashes, all of which are optional
+  if (success)
+  {
+    DumpSize = -1;
+    Crc32 = -1;
+    Sha1 = "";
+    
+    node_t* d = node->first_node("DUMP");
+    node_t* n_;
+    if (d != nullptr && (n_ = d->first_node("FILE_SIZE")) != nullptr)
+    {
+      DumpSize = std::strtol(n_->value(), 0, 10);
+    }
+    if (d != nullptr && (n_ = d->first_node("CRC32")) != nullptr)
+    {
+      Crc32 = (long long) (std::strtoul(n_->value(), 0, 16) & 0xFFFFFFFF);
+    }
+    if (d != nullptr && (n_ = d->first_node("SHA1")) != nullptr)
+    {
+      Sha1 = string(n_->value());
+      std::transform(Sha1.begin(), Sha1.end(), Sha1.begin(), ::tolower);
+      if (Sha1.size() != 40 || Sha1.find_first_not_of("0123456789abcdef") != string::npos)
+      {
+        cerr << "Malformed XML element SHA1" << endl;
+        success = false;
+      }
+    }
+  }
+  
   // Metadata & hash
   if (success)
   {
@@ -307,6 +342,42 @@ bool ngp_games_row::bind_to_stmt(sqlite3_stmt* stmt, int query)
       cerr << "Unable to bind parameter 'gamename'" << endl;
       return false;
     }
+
+    ind = sqlite3_bind_parameter_index(stmt, ":dumpsize");
+    if (ind == 0)
+    {
+      cerr << "Unable to find index of parameter 'dumpsize'" << endl;
+      return false;
+    }
+    if ((DumpSize < 0 ? sqlite3_bind_null(stmt, ind) : sqlite3_bind_int64(stmt, ind, (long long) DumpSize)) != SQLITE_OK)
+    {
+      cerr << "Unable to bind parameter 'dumpsize'" << endl;
+      return false;
+    }
+
+    ind = sqlite3_bind_parameter_index(stmt, ":crc32");
+    if (ind == 0)
+    {
+      cerr << "Unable to find index of parameter 'crc32'" << endl;
+      return false;
+    }
+    if ((Crc32 < 0 ? sqlite3_bind_null(stmt, ind) : sqlite3_bind_int64(stmt, ind, Crc32)) != SQLITE_OK)
+    {
+      cerr << "Unable to bind parameter 'crc32'" << endl;
+      return false;
+    }
+
+    ind = sqlite3_bind_parameter_index(stmt, ":sha1");
+    if (ind == 0)
+    {
+      cerr << "Unable to find index of parameter 'sha1'" << endl;
+      return false;
+    }
+    if ((Sha1.empty() ? sqlite3_bind_null(stmt, ind) : sqlite3_bind_text(stmt, ind, Sha1.c_str(), -1, SQLITE_TRANSIENT)) != SQLITE_OK)
+    {
+      cerr << "Unable to bind parameter 'sha1'" << endl;
+      return false;
+    }
     break;
     
   default:
@@ -13,6 +13,9 @@ namespace ngp
 const string schema_file_name = "ngpschema.sql";
 const string data_file_name = "ngpgames.xml";
 const string db_file_name = "ngpgames.db";
+const string table_file_name = "ngp_game_table.cpp";
+const string table_name = "ngp_game_table";
+const string table_query = "SELECT `Hash`, GameName, '', IFNULL(CartSize, 0) << 17, DumpSize, Crc32, Sha1 FROM Games ORDER BY `Hash`, ID";
 
 class ngp_games_row : public games_row
 {
@@ -31,6 +34,9 @@ public:
   string License;
   string CartName;
   string GameName;
+  long DumpSize;
+  long long Crc32;
+  string Sha1;
 };
 
 }
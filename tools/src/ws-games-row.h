@@ -13,6 +13,9 @@ namespace ws
 const string schema_file_name = "wsschema.sql";
 const string data_file_name = "wsgames.xml";
 const string db_file_name = "wsgames.db";
+const string table_file_name = "ws_game_table.cpp";
+const string table_name = "ws_game_table";
+const string table_query = "SELECT `Hash`, GameName, Developer, 0, DumpSize, Crc32, Sha1 FROM Games ORDER BY `Hash`, ID";
 
 class ws_games_row : public games_row
 {
@@ -34,6 +37,9 @@ public:
   int RTC;
   int Checksum;
   int Flags;
+  long DumpSize;
+  long long Crc32;
+  string Sha1;
 };
 
 }
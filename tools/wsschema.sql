@@ -1,4 +1,5 @@
 DROP INDEX IF EXISTS Games_Hash_ind;
+DROP INDEX IF EXISTS Games_Crc32_ind;
 DROP TABLE IF EXISTS Games;
 
 CREATE TABLE Games (
@@ -13,7 +14,11 @@ CREATE TABLE Games (
   MapperVersion INTEGER,
   RTC INTEGER,
   `Checksum` INTEGER,
-  Flags INTEGER
+  Flags INTEGER,
+  DumpSize INTEGER DEFAULT NULL,
+  Crc32 INTEGER DEFAULT NULL,
+  Sha1 TEXT DEFAULT NULL
 );
 
 CREATE INDEX Games_Hash_ind ON Games (`Hash`);
+CREATE INDEX Games_Crc32_ind ON Games (Crc32);